@@ -0,0 +1,234 @@
+// Diagramas de decisión binaria reducidos y ordenados (ROBDD).
+//
+// Paquete compacto para representar conjuntos de estados y relaciones de
+// transición cuando la enumeración explícita (fsm_utils.bfs_reachability,
+// state_space.hpp) deja de caber: más de 10^9 estados.
+//
+//   * Tabla única: una subtabla hash por variable con los nodos (var, bajo,
+//     alto); cada función tiene un único nodo, así que la igualdad de
+//     funciones es igualdad de índices.
+//   * Caché de resultados: tabla de acceso directo para ite, and_exists,
+//     exists y restrict; una colisión sólo sobrescribe la entrada.
+//   * Recolección de basura por marcado y barrido.  Las raíces son los
+//     nodos con algún manejador Bdd vivo; se recoge sólo en puntos seguros
+//     (al empezar una operación pública) cuando los nodos superan el umbral.
+//   * Reordenación dinámica por sifting (Rudell): cada variable se desplaza
+//     por todos los niveles con intercambios de niveles adyacentes in situ y
+//     se deja donde el diagrama es menor.  Los índices de nodo y, por tanto,
+//     los manejadores existentes siguen siendo válidos.
+//
+// Las variables se identifican por su índice de creación; su nivel en el
+// orden puede cambiar al reordenar.  El gestor no es seguro entre hilos.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace graphs {
+
+class BddManager;
+
+// Manejador con cuenta de referencias externa de un nodo del gestor.  El
+// gestor debe sobrevivir a todos sus manejadores.
+class Bdd {
+public:
+    Bdd() = default;
+    Bdd(const Bdd &other);
+    Bdd(Bdd &&other) noexcept;
+    Bdd &operator=(const Bdd &other);
+    Bdd &operator=(Bdd &&other) noexcept;
+    ~Bdd();
+
+    bool valid() const { return manager_ != nullptr; }
+    bool is_zero() const { return node_ == 0; }
+    bool is_one() const { return node_ == 1; }
+    bool is_constant() const { return node_ <= 1; }
+    std::uint32_t node() const { return node_; }
+    BddManager *manager() const { return manager_; }
+
+    // Variable de la raíz y cofactores (sólo para nodos no constantes).
+    unsigned var() const;
+    Bdd low() const;
+    Bdd high() const;
+
+    // Complemento.  Es ~ y no ! como en los enteros: con ! las expresiones
+    // del tipo !x == y o !x & z parecen lógicas y los compiladores avisan.
+    Bdd operator~() const;
+    Bdd operator&(const Bdd &g) const;
+    Bdd operator|(const Bdd &g) const;
+    Bdd operator^(const Bdd &g) const;
+    Bdd &operator&=(const Bdd &g) { return *this = *this & g; }
+    Bdd &operator|=(const Bdd &g) { return *this = *this | g; }
+    Bdd &operator^=(const Bdd &g) { return *this = *this ^ g; }
+
+    friend bool operator==(const Bdd &a, const Bdd &b) { return a.manager_ == b.manager_ && a.node_ == b.node_; }
+    friend bool operator!=(const Bdd &a, const Bdd &b) { return !(a == b); }
+
+private:
+    friend class BddManager;
+    Bdd(BddManager *manager, std::uint32_t node);
+
+    BddManager *manager_ = nullptr;
+    std::uint32_t node_ = 0;
+};
+
+struct BddOptions {
+    // Tamaño inicial de la caché (se redondea a potencia de 2).
+    std::size_t cache_size = std::size_t(1) << 18;
+    // Nodos vivos a partir de los que se recoge basura (se duplica si la
+    // recolección libera menos de la mitad).
+    std::size_t gc_threshold = std::size_t(1) << 20;
+    // Límite duro de nodos; superarlo lanza std::runtime_error.
+    std::size_t max_nodes = std::size_t(1) << 28;
+    // Reordenación automática por sifting cuando los nodos tras una
+    // recolección superan reorder_threshold (que luego se duplica).
+    bool auto_reorder = false;
+    std::size_t reorder_threshold = std::size_t(1) << 16;
+    // Sifting: abandona una dirección si el diagrama crece más de este factor.
+    double max_growth = 1.2;
+};
+
+struct BddStats {
+    std::size_t live_nodes = 0;       // nodos en la tabla única (sin constantes)
+    std::size_t peak_nodes = 0;
+    std::size_t gc_runs = 0;
+    std::size_t reorderings = 0;
+    std::size_t cache_hits = 0;
+    std::size_t cache_lookups = 0;
+};
+
+class BddManager {
+public:
+    explicit BddManager(unsigned vars = 0, const BddOptions &options = {});
+    BddManager(const BddManager &) = delete;
+    BddManager &operator=(const BddManager &) = delete;
+
+    // Crea una variable al final del orden; devuelve su índice.
+    unsigned new_var();
+    unsigned num_vars() const { return static_cast<unsigned>(level_of_.size()); }
+
+    Bdd zero() { return Bdd(this, 0); }
+    Bdd one() { return Bdd(this, 1); }
+    // Literal positivo / negativo.  Lanza std::out_of_range si var no existe.
+    Bdd var(unsigned v);
+    Bdd nvar(unsigned v);
+    // Conjunción de las variables (cubo para cuantificar).
+    Bdd cube(const std::vector<unsigned> &vars);
+
+    Bdd ite(const Bdd &f, const Bdd &g, const Bdd &h);
+    // ∃ vars(cube). f
+    Bdd exists(const Bdd &f, const Bdd &cube);
+    Bdd forall(const Bdd &f, const Bdd &cube);
+    // ∃ vars(cube). f ∧ g (producto relacional) sin construir f ∧ g.
+    Bdd and_exists(const Bdd &f, const Bdd &g, const Bdd &cube);
+    // Sustituye cada variable v por map[v] (map.size() == num_vars(); el
+    // mismo índice = sin cambio).  Cualquier permutación o renombrado.
+    Bdd rename(const Bdd &f, const std::vector<unsigned> &map);
+    // Cofactor f|v=value.
+    Bdd restrict(const Bdd &f, unsigned v, bool value);
+
+    // Valor de f para la asignación (indexada por variable).
+    bool eval(const Bdd &f, const std::vector<bool> &assignment) const;
+    // Número de asignaciones de `nvars` variables que satisfacen f (f sólo
+    // debe depender de esas variables).  En double: exacto hasta 2^53.
+    double sat_count(const Bdd &f, unsigned nvars) const;
+    // Una asignación que satisface f (0/1, -1 = indiferente); vacía si f = 0.
+    std::vector<int> pick_one(const Bdd &f) const;
+    // Variables de las que depende f, en orden creciente de índice.
+    std::vector<unsigned> support(const Bdd &f) const;
+    // Nodos internos del diagrama (sin constantes).
+    std::size_t node_count(const Bdd &f) const;
+    std::size_t node_count(const std::vector<Bdd> &fs) const;
+
+    // Orden actual: order()[nivel] = variable; level(v) es su inversa.
+    std::vector<unsigned> order() const { return var_at_; }
+    unsigned level(unsigned v) const { return level_of_.at(v); }
+
+    // Recoge basura; devuelve los nodos liberados.
+    std::size_t collect_garbage();
+    // Sifting de todas las variables; devuelve los nodos vivos al terminar.
+    std::size_t reorder();
+    // Impone un orden (permutación de las variables) con intercambios
+    // adyacentes.  Lanza std::invalid_argument si no es una permutación.
+    void set_order(const std::vector<unsigned> &order);
+
+    const BddStats &stats() const { return stats_; }
+
+private:
+    friend class Bdd;
+
+    struct Node {
+        std::uint32_t var;
+        std::uint32_t low;
+        std::uint32_t high;
+        std::uint32_t next;  // cadena de la subtabla o de la lista libre
+    };
+
+    struct Subtable {
+        std::vector<std::uint32_t> buckets;
+        std::size_t count = 0;
+    };
+
+    struct CacheEntry {
+        std::uint32_t op = 0;
+        std::uint32_t f = 0, g = 0, h = 0;
+        std::uint32_t result = 0;
+    };
+
+    static constexpr std::uint32_t kNil = 0xffffffffu;
+
+    std::uint32_t level_node(std::uint32_t n) const {
+        return n <= 1 ? kNil : level_of_[nodes_[n].var];
+    }
+
+    void ref(std::uint32_t n) { ++external_[n]; }
+    void deref(std::uint32_t n) { --external_[n]; }
+
+    // Punto seguro: recolección y reordenación automáticas.
+    void maintain();
+    std::uint32_t make(std::uint32_t var, std::uint32_t low, std::uint32_t high, bool *created = nullptr);
+    std::size_t live() const { return nodes_.size() - 2 - free_count_; }
+    void check(const Bdd &f) const;
+    std::uint32_t allocate();
+    void insert(Subtable &table, std::uint32_t n);
+    void unlink(Subtable &table, std::uint32_t n);
+    void grow(Subtable &table);
+    std::size_t bucket(const Subtable &table, std::uint32_t low, std::uint32_t high) const;
+
+    bool cache_find(std::uint32_t op, std::uint32_t f, std::uint32_t g, std::uint32_t h, std::uint32_t &r);
+    void cache_store(std::uint32_t op, std::uint32_t f, std::uint32_t g, std::uint32_t h, std::uint32_t r);
+    void cache_clear();
+
+    std::uint32_t ite_rec(std::uint32_t f, std::uint32_t g, std::uint32_t h);
+    std::uint32_t exists_rec(std::uint32_t f, std::uint32_t cube);
+    std::uint32_t and_exists_rec(std::uint32_t f, std::uint32_t g, std::uint32_t cube);
+    std::uint32_t restrict_rec(std::uint32_t f, std::uint32_t var, std::uint32_t value);
+
+    void mark(std::vector<std::uint8_t> &marks, std::uint32_t root) const;
+
+    // Sifting: cuentas de referencia internas sólo durante la reordenación.
+    void begin_reordering();
+    void end_reordering();
+    void release(std::uint32_t n);
+    std::uint32_t make_referenced(std::uint32_t var, std::uint32_t low, std::uint32_t high);
+    std::size_t swap_levels(unsigned level);
+    std::size_t sift(unsigned var, std::size_t size);
+
+    BddOptions options_;
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> external_;
+    std::vector<std::uint32_t> refs_;
+    std::uint32_t free_ = kNil;
+    std::size_t free_count_ = 0;
+    std::vector<Subtable> tables_;     // por variable
+    std::vector<unsigned> level_of_;   // variable -> nivel
+    std::vector<unsigned> var_at_;     // nivel -> variable
+    std::vector<CacheEntry> cache_;
+    std::size_t gc_threshold_;
+    std::size_t reorder_threshold_;
+    BddStats stats_;
+};
+
+} // namespace graphs
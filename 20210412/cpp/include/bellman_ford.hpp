@@ -0,0 +1,40 @@
+// Caminos mínimos con pesos negativos (Bellman–Ford con cola FIFO).
+//
+// Se implementa la variante basada en cola (SPFA): sólo se reexaminan los
+// vértices cuya distancia ha mejorado.  Para detectar ciclos negativos sin
+// esperar a las n pasadas clásicas se comprueba periódicamente el grafo de
+// predecesores (cada n relajaciones, coste amortizado O(1) por relajación):
+// cualquier ciclo en ese grafo es necesariamente un ciclo negativo.
+
+#pragma once
+
+#include <vector>
+
+#include "graph.hpp"
+
+namespace graphs {
+
+struct BellmanFordResult {
+    ShortestPathTree tree;
+    // Verdadero si hay un ciclo negativo alcanzable desde el origen; en ese
+    // caso `tree` no es válido y `cycle` contiene sus vértices en el orden de
+    // recorrido (la arista de cierre va del último al primero).
+    bool negative_cycle = false;
+    std::vector<int> cycle;
+};
+
+// Bellman–Ford desde source.  Admite pesos negativos.
+BellmanFordResult bellman_ford(const Graph &g, int source);
+
+// Bellman–Ford desde un origen virtual unido a todos los vértices con peso 0.
+// Las distancias resultantes (todas <= 0) son potenciales h válidos para la
+// reponderación de Johnson: w(u,v) + h(u) - h(v) >= 0.  Detecta cualquier
+// ciclo negativo del grafo.
+BellmanFordResult bellman_ford_potentials(const Graph &g);
+
+// Caminos mínimos desde source eligiendo el algoritmo según el grafo: Dijkstra
+// si todos los pesos son no negativos y Bellman–Ford en otro caso.  Lanza
+// std::runtime_error si existe un ciclo negativo alcanzable.
+ShortestPathTree shortest_paths(const Graph &g, int source);
+
+} // namespace graphs
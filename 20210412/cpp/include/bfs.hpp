@@ -0,0 +1,97 @@
+// BFS con cambio de dirección (Beamer, Asanović y Patterson) sobre CSR.
+//
+// Cada nivel se expande de una de dos formas:
+//
+//   * descendente: los vértices de la frontera (lista) reclaman a sus
+//     sucesores no visitados;
+//   * ascendente: cada vértice no visitado busca entre sus predecesores
+//     alguno de la frontera (mapa de bits) y se detiene en el primero.
+//
+// Se pasa a ascendente cuando las aristas que salen de la frontera (m_f)
+// superan a las de los vértices sin explorar entre alpha (m_f > m_u / alpha)
+// y se vuelve a descendente cuando la frontera baja de n / beta vértices.  En
+// las fases anchas de grafos de estados o redes de mundo pequeño esto evita
+// recorrer la mayoría de las aristas.
+//
+// Ambas fases se reparten entre hilos: la descendente reclama vértices con
+// un fetch_or atómico sobre el mapa de visitados; la ascendente reparte
+// palabras de 64 vértices, de modo que cada hilo escribe sólo en las suyas.
+// El recorrido ascendente necesita las aristas entrantes: el motor guarda el
+// grafo traspuesto (o reutiliza el propio si se declara simétrico).  Con un
+// CompressedGraph el motor recorre las filas comprimidas directamente y el
+// traspuesto también se guarda comprimido.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "compressed_graph.hpp"
+#include "graph.hpp"
+
+namespace graphs {
+
+struct BfsOptions {
+    // Hilos de trabajo (0 = parallel::default_threads()).
+    unsigned threads = 0;
+    // El grafo tiene cada arista en ambos sentidos: no se construye el traspuesto.
+    bool symmetric = false;
+    // Umbrales de cambio de dirección (valores del artículo original).
+    double alpha = 15.0;
+    double beta = 18.0;
+};
+
+struct BfsResult {
+    // Saltos desde el origen; -1 si no se ha alcanzado.
+    std::vector<int> hops;
+    // Vértices alcanzados (incluido el origen).
+    std::size_t visited = 0;
+    // Niveles expandidos de forma ascendente (diagnóstico).
+    int bottom_up_levels = 0;
+};
+
+// Motor reutilizable: el traspuesto y los mapas de bits se reservan una vez
+// y se reaprovechan entre consultas.  Las consultas de un mismo motor no
+// deben solaparse; para consultas concurrentes, un motor por hilo.
+class BfsEngine {
+public:
+    explicit BfsEngine(const Graph &g, const BfsOptions &options = {});
+    explicit BfsEngine(const CompressedGraph &g, const BfsOptions &options = {});
+
+    // Saltos desde source a todos los vértices.
+    BfsResult hops(int source);
+
+    // Número de saltos de source a target o -1 si no es alcanzable.  Termina
+    // en cuanto se alcanza target.
+    int distance(int source, int target);
+    bool reachable(int source, int target) { return distance(source, target) >= 0; }
+
+    // Grafo CSR del motor (vacío si se construyó sobre un CompressedGraph).
+    const Graph &graph() const { return g_; }
+
+private:
+    int run(int source, int target, BfsResult &out);
+    // Devuelve el nivel de target (o -1); con target < 0 recorre todo.
+    template <class Adjacency>
+    int run(const Adjacency &forward, const Adjacency &backward, int source, int target,
+            BfsResult &out);
+
+    int n_ = 0;
+    std::size_t m_ = 0;
+    bool compressed_ = false;
+    Graph g_;
+    Graph reverse_;
+    CompressedGraph compressed_g_;
+    CompressedGraph compressed_reverse_;
+    BfsOptions options_;
+    std::vector<std::atomic<std::uint64_t>> visited_;
+    std::vector<std::uint64_t> front_bits_;
+    std::vector<std::uint64_t> next_bits_;
+};
+
+// Atajo para una sola consulta (equivale a BfsEngine(g, options).hops(source)).
+BfsResult bfs_hops(const Graph &g, int source, const BfsOptions &options = {});
+BfsResult bfs_hops(const CompressedGraph &g, int source, const BfsOptions &options = {});
+
+} // namespace graphs
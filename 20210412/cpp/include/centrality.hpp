@@ -0,0 +1,98 @@
+// Centralidad por vector propio y PageRank (personalizado) sobre CSR.
+//
+// Ambas son iteraciones de la potencia con un producto matriz-vector
+// disperso "pull": cada vértice acumula sus propios términos y escribe sólo
+// su puntuación, de modo que los bloques de vértices se reparten entre hilos
+// sin atómicos.  Cada iteración cuesta O(E) y usa dos vectores de
+// puntuaciones (más un inverso de grado de salida en PageRank).
+//
+//   * eigenvector_centrality: misma convención que
+//     graph_algorithms.eigenvector_centrality (x_u <- sum_{u->v} w * x_v),
+//     con un desplazamiento A + I que no cambia el vector propio pero
+//     garantiza la convergencia en grafos periódicos (p. ej. bipartitos).
+//     El resultado se normaliza para sumar 1, como en Python.
+//   * pagerank: x_v = (1 - d) p_v + d (sum_{u->v} w_uv / w_u x_u + D p_v),
+//     donde w_u es el peso de salida de u y D la masa de los vértices sin
+//     salidas.  Se recorre el grafo traspuesto (aristas entrantes).
+//
+// Aceleraciones: Gauss–Seidel por bloques fijos de vértices (dentro de un
+// bloque se usan los valores ya actualizados; el resultado no depende del
+// número de hilos) y extrapolación de Aitken cada `aitken_period`
+// iteraciones (dos vectores más).  Las puntuaciones pueden guardarse en
+// float para reducir memoria y tráfico; las sumas se acumulan en double.
+// PageRank acepta también un CompressedGraph (el traspuesto se construye
+// comprimido).
+
+#pragma once
+
+#include <vector>
+
+#include "graph.hpp"
+
+namespace graphs {
+
+class CompressedGraph;
+
+enum class RankNorm {
+    L1,
+    LInf,
+};
+
+enum class RankAcceleration {
+    None,
+    // Sólo PageRank.
+    GaussSeidel,
+    Aitken,
+};
+
+struct RankOptions {
+    // Factor de amortiguamiento de PageRank.
+    double damping = 0.85;
+    // Se para cuando la norma de la diferencia entre iteraciones es menor.
+    double tolerance = 1e-6;
+    RankNorm norm = RankNorm::L1;
+    int max_iter = 100;
+    RankAcceleration acceleration = RankAcceleration::None;
+    int aitken_period = 10;
+    // Usa los pesos de las aristas (falso = todas 1).
+    bool weighted = true;
+    // PageRank: el grafo ya contiene cada arista en ambos sentidos con el
+    // mismo peso, así que no se construye el traspuesto.
+    bool symmetric = false;
+    unsigned threads = 0;
+};
+
+template <class Scalar = double>
+struct RankResult {
+    std::vector<Scalar> scores;
+    int iterations = 0;
+    // Norma (según RankOptions::norm) de la última diferencia.
+    double residual = 0.0;
+    bool converged = false;
+};
+
+// Lanzan std::invalid_argument ante opciones no válidas y, con pesos,
+// si el grafo tiene pesos negativos (PageRank).
+template <class Scalar = double>
+RankResult<Scalar> eigenvector_centrality(const Graph &g, const RankOptions &options = {});
+
+template <class Scalar = double>
+RankResult<Scalar> pagerank(const Graph &g, const RankOptions &options = {});
+
+// PageRank con vector de teletransporte `personalization` (no negativo, se
+// normaliza para sumar 1; uno por vértice).
+template <class Scalar = double>
+RankResult<Scalar> personalized_pagerank(const Graph &g, const std::vector<double> &personalization,
+                                         const RankOptions &options = {});
+
+template <class Scalar = double>
+RankResult<Scalar> pagerank(const CompressedGraph &g, const RankOptions &options = {});
+template <class Scalar = double>
+RankResult<Scalar> personalized_pagerank(const CompressedGraph &g,
+                                         const std::vector<double> &personalization,
+                                         const RankOptions &options = {});
+
+// Vector de teletransporte uniforme sobre los vértices semilla.
+std::vector<double> seed_personalization(int n, const std::vector<int> &seeds);
+
+} // namespace graphs
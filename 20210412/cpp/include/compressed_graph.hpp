@@ -0,0 +1,234 @@
+// Grafo CSR comprimido: vecinos ordenados codificados por diferencias y
+// pesos exactos o, a petición, cuantizados.
+//
+// El CSR normal cuesta 12 bytes por arista (destino int + peso double).  Aquí
+// cada vértice ocupa un registro de bytes:
+//
+//   varint(grado) | pesos (grado x ancho) | destinos
+//
+// Los destinos se ordenan y se guardan como diferencias: el primero en
+// zigzag respecto a u (los grafos reordenados tienen vecinos cercanos) y el
+// resto como saltos no negativos.  Dos códecs de enteros:
+//
+//   * Varint: 7 bits por byte con bit de continuación (LEB128).
+//   * StreamVByte: grupos de 4 con un byte de control (2 bits de longitud
+//     por valor) seguido de los datos.  El decodificador usa una máscara
+//     pshufb por byte de control (SSSE3, elegida en tiempo de ejecución) y
+//     una versión escalar en el resto de plataformas.
+//
+// Los pesos se guardan exactos (double, el valor por defecto), en float o
+// cuantizados linealmente entre el mínimo y el máximo del grafo con 16 u 8
+// bits; si todos los pesos son iguales no se guarda ninguno.  Float32 y los
+// cuantizados son aproximados: las distancias y rangos calculados sobre el
+// grafo dejan de coincidir con los del CSR, y weight_error() acota el error
+// de cada peso.  Un grafo sin pesos con buena localidad baja a 1-2 bytes por
+// arista, con pesos de 16 bits a 3-4 y con pesos exactos a unos 9-10.
+//
+// Los algoritmos recorren las aristas con for_each_neighbor (decodifica por
+// bloques en la pila) o con el iterador de neighbors(u).  dijkstra,
+// BfsEngine y pagerank tienen sobrecargas para este tipo.  Los índices de
+// arista no son los del Graph original: cada fila queda ordenada por destino.
+// Como Graph, las copias son O(1): comparten los registros codificados.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "graph.hpp"
+
+namespace graphs {
+
+enum class NeighborCodec {
+    Varint,
+    StreamVByte,
+};
+
+enum class WeightCodec {
+    Exact,
+    Float32,
+    Quantized16,
+    Quantized8,
+};
+
+struct CompressOptions {
+    NeighborCodec neighbors = NeighborCodec::StreamVByte;
+    // Exact conserva los pesos; los demás códecs son con pérdida (ver arriba).
+    WeightCodec weights = WeightCodec::Exact;
+    unsigned threads = 0;
+};
+
+struct Neighbor {
+    int target;
+    double weight;
+};
+
+class CompressedGraph {
+public:
+    // Destinos decodificados por bloque (múltiplo de 4).
+    static constexpr std::size_t kChunk = 64;
+
+    // Estado de decodificación de una fila.
+    struct Cursor {
+        const std::uint8_t *control = nullptr;
+        const std::uint8_t *data = nullptr;
+        const std::uint8_t *weights = nullptr;
+        std::size_t degree = 0;
+        std::size_t remaining = 0;
+        std::int64_t previous = 0;
+    };
+
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Neighbor;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Neighbor;
+
+        Iterator() = default;
+
+        Neighbor operator*() const { return {buffer_[pos_], graph_->weight_at(cursor_.weights, index_)}; }
+        Iterator &operator++() {
+            ++index_;
+            if (++pos_ == count_ && cursor_.remaining > 0) {
+                count_ = graph_->next_targets(cursor_, buffer_);
+                pos_ = 0;
+            }
+            return *this;
+        }
+        bool operator==(const Iterator &o) const { return index_ == o.index_; }
+        bool operator!=(const Iterator &o) const { return index_ != o.index_; }
+
+    private:
+        friend class CompressedGraph;
+        const CompressedGraph *graph_ = nullptr;
+        Cursor cursor_;
+        int buffer_[kChunk];
+        std::size_t count_ = 0;
+        std::size_t pos_ = 0;
+        std::size_t index_ = 0;
+    };
+
+    struct NeighborRange {
+        Iterator first, last;
+        Iterator begin() const { return first; }
+        Iterator end() const { return last; }
+    };
+
+    CompressedGraph() = default;
+
+    // Comprime g.  Lanza std::invalid_argument si se pide cuantizar pesos
+    // no finitos.
+    explicit CompressedGraph(const Graph &g, const CompressOptions &options = {});
+
+    int num_vertices() const { return n_; }
+    std::size_t num_edges() const { return m_; }
+    bool has_negative_weights() const { return has_negative_weights_; }
+    NeighborCodec neighbor_codec() const { return neighbor_codec_; }
+    WeightCodec weight_codec() const { return weight_codec_; }
+
+    std::size_t degree(int u) const;
+
+    // Bytes de los registros y desplazamientos.
+    std::size_t memory_bytes() const;
+    // Cota del error absoluto de cada peso decodificado.
+    double weight_error() const { return weight_error_; }
+    // Verdadero si StreamVByte se decodifica con SIMD en esta máquina.
+    static bool simd_decode();
+
+    // Llama a f(v, w) por cada arista u->v en orden creciente de v.
+    template <class F>
+    void for_each_neighbor(int u, F &&f) const {
+        Cursor c = cursor(u);
+        int buffer[kChunk];
+        std::size_t index = 0;
+        while (c.remaining > 0) {
+            const std::size_t k = next_targets(c, buffer);
+            for (std::size_t j = 0; j < k; ++j, ++index) {
+                f(buffer[j], weight_at(c.weights, index));
+            }
+        }
+    }
+
+    NeighborRange neighbors(int u) const {
+        NeighborRange r;
+        r.first.graph_ = r.last.graph_ = this;
+        r.first.cursor_ = cursor(u);
+        r.last.index_ = r.first.cursor_.degree;
+        if (r.first.cursor_.remaining > 0) {
+            r.first.count_ = next_targets(r.first.cursor_, r.first.buffer_);
+        }
+        return r;
+    }
+
+    // CSR equivalente (filas ordenadas; pesos ya decodificados).
+    Graph decompress() const;
+
+    Cursor cursor(int u) const;
+    // Decodifica hasta kChunk destinos siguientes de la fila; devuelve cuántos.
+    std::size_t next_targets(Cursor &c, int *out) const;
+
+    double weight_at(const std::uint8_t *weights, std::size_t i) const {
+        switch (weight_width_) {
+        case 0:
+            return weight_base_;
+        case 1:
+            return weight_base_ + weights[i] * weight_step_;
+        case 2: {
+            std::uint16_t q;
+            std::memcpy(&q, weights + 2 * i, 2);
+            return weight_base_ + q * weight_step_;
+        }
+        case 4: {
+            float x;
+            std::memcpy(&x, weights + 4 * i, 4);
+            return x;
+        }
+        default: {
+            double x;
+            std::memcpy(&x, weights + 8 * i, 8);
+            return x;
+        }
+        }
+    }
+
+private:
+    friend CompressedGraph transpose(const CompressedGraph &g, unsigned threads);
+
+    // Código entero del peso i tal como se guarda.
+    std::uint64_t weight_code(const std::uint8_t *weights, std::size_t i) const;
+    template <class Rows>
+    void encode(Rows &&rows, unsigned threads);
+
+    int n_ = 0;
+    std::size_t m_ = 0;
+    bool has_negative_weights_ = false;
+    NeighborCodec neighbor_codec_ = NeighborCodec::StreamVByte;
+    WeightCodec weight_codec_ = WeightCodec::Exact;
+    // Bytes por peso (0 = todos iguales a weight_base_).
+    unsigned weight_width_ = 0;
+    double weight_base_ = 0.0;
+    double weight_step_ = 0.0;
+    double weight_error_ = 0.0;
+    // Registro de u: bytes[offsets[u], offsets[u + 1]).  Al final hay 16
+    // bytes de relleno para las lecturas SIMD de 16 bytes.
+    struct Storage {
+        std::vector<std::uint64_t> offsets;
+        std::vector<std::uint8_t> bytes;
+    };
+    // Los registros no cambian tras codificarse: las copias del grafo
+    // comparten el almacenamiento, como Graph con su propietario.
+    std::shared_ptr<const Storage> storage_;
+    const std::uint64_t *offsets_ = nullptr;
+    const std::uint8_t *bytes_ = nullptr;
+};
+
+// Grafo traspuesto, sin descomprimir los pesos (se conservan sus códigos).
+CompressedGraph transpose(const CompressedGraph &g, unsigned threads = 0);
+
+} // namespace graphs
@@ -0,0 +1,68 @@
+// Ordenación topológica y caminos en grafos dirigidos acíclicos.
+//
+// Con un orden topológico basta una pasada por los vértices para relajar
+// todas las aristas: los caminos mínimos y máximos desde un origen cuestan
+// O(V + E) y admiten pesos negativos.  El camino crítico de un DAG de tareas
+// se obtiene con una pasada hacia delante (inicio más temprano) y otra hacia
+// atrás (inicio más tardío) sobre el mismo orden.
+//
+// Todos los recorridos son iterativos, sin recursión, para admitir grafos
+// con millones de vértices.
+
+#pragma once
+
+#include <vector>
+
+#include "graph.hpp"
+
+namespace graphs {
+
+enum class TopoMethod {
+    // Kahn con cola FIFO: mismo orden que graph_algorithms.topological_sort.
+    Kahn,
+    // Postorden inverso de un DFS por índice creciente.
+    Dfs,
+};
+
+struct TopoResult {
+    // Orden topológico completo si el grafo es acíclico; vacío en otro caso.
+    std::vector<int> order;
+    // Si hay ciclo, sus vértices en orden de recorrido (la arista de cierre
+    // va del último al primero).
+    std::vector<int> cycle;
+
+    bool is_dag() const { return cycle.empty(); }
+};
+
+TopoResult topological_sort(const Graph &g, TopoMethod method = TopoMethod::Kahn);
+
+// Caminos mínimos / máximos desde source en un DAG.  Los vértices no
+// alcanzables quedan con +inf / -inf y parent -1.  Lanzan
+// std::runtime_error si el grafo tiene un ciclo y std::out_of_range si el
+// origen no existe.  La variante con `order` reutiliza un orden ya calculado.
+ShortestPathTree dag_shortest_paths(const Graph &g, int source);
+ShortestPathTree dag_longest_paths(const Graph &g, int source);
+ShortestPathTree dag_shortest_paths(const Graph &g, int source, const std::vector<int> &order);
+ShortestPathTree dag_longest_paths(const Graph &g, int source, const std::vector<int> &order);
+
+// Resultado del método del camino crítico (actividades en los vértices).
+struct CriticalPath {
+    // Duración total del proyecto.
+    double length = 0.0;
+    // Una cadena de tareas críticas de un inicio a un final.
+    std::vector<int> path;
+    std::vector<double> earliest_start;
+    std::vector<double> latest_start;
+
+    // Holgura de la tarea v; cero en las tareas críticas.
+    double slack(int v) const { return latest_start[v] - earliest_start[v]; }
+};
+
+// Camino crítico de un DAG de tareas.  durations[v] es la duración de la
+// tarea v (vacío = todas 0) y el peso de u->v es el retardo mínimo entre el
+// fin de u y el inicio de v.  Las tareas sin predecesores empiezan en 0.
+// Lanza std::runtime_error si hay un ciclo y std::invalid_argument si
+// durations no tiene un valor por vértice.
+CriticalPath critical_path(const Graph &g, const std::vector<double> &durations = {});
+
+} // namespace graphs
@@ -2,18 +2,193 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <utility>
 #include <limits>
 
+#include "graph.hpp"
+
 namespace graphs {
 
-// Representación del grafo: vector de listas de pares (vecino, peso)
-using AdjList = std::vector<std::vector<std::pair<int, double>>>;
+class CompressedGraph;
 
 // Calcula las distancias mínimas desde el nodo source en un grafo de n nodos.
 // Devuelve un vector de distancias de tamaño n. Las distancias no alcanzadas
-// quedan en infinity.
+// quedan en infinity.  Los pesos se revisan antes de empezar la búsqueda:
+// con alguno negativo se lanza std::runtime_error sin haber explorado nada.
 std::vector<double> dijkstra(int n, const AdjList &adj, int source);
 
-} // namespace graphs
\ No newline at end of file
+// Variantes sobre el grafo CSR.  Los pesos ya se validaron al construir el
+// grafo, así que el bucle de relajación no comprueba signos; si
+// g.has_negative_weights() se lanza std::runtime_error de inmediato (véase
+// shortest_paths en bellman_ford.hpp para el despacho automático).  Con
+// pesos enteros las distancias son de 64 bits y los vértices no alcanzados
+// quedan en WeightTraits<Weight>::infinity().
+template <class Vertex, class Weight>
+std::vector<Distance<Weight>> dijkstra(const BasicGraph<Vertex, Weight> &g,
+                                       typename BasicGraph<Vertex, Weight>::vertex_type source);
+template <class Vertex, class Weight>
+BasicShortestPathTree<Vertex, Weight> dijkstra_tree(const BasicGraph<Vertex, Weight> &g,
+                                                    typename BasicGraph<Vertex, Weight>::vertex_type source);
+
+// Variantes sobre el CSR comprimido (compressed_graph.hpp); con pesos
+// cuantizados las distancias heredan su error (weight_error() por arista).
+std::vector<double> dijkstra(const CompressedGraph &g, int source);
+ShortestPathTree dijkstra_tree(const CompressedGraph &g, int source);
+
+// -----------------------------------------------------------------------------
+// Consultas acotadas (isócronas y vecinos más cercanos)
+//
+// Estas variantes detienen la búsqueda en cuanto se cumple un criterio de
+// parada y devuelven un resultado disperso con los vértices asentados.  El
+// estado de la búsqueda vive en un DijkstraWorkspace reutilizable, de modo que
+// el coste de cada consulta es proporcional a la región explorada y no a n.
+
+// Estado reutilizable entre consultas.  Las etiquetas se invalidan con un
+// contador de época, por lo que no es necesario limpiar los vectores al
+// empezar una consulta nueva.  Un workspace no debe compartirse entre hilos.
+class DijkstraWorkspace {
+public:
+    DijkstraWorkspace() = default;
+    explicit DijkstraWorkspace(int n) { prepare(n); }
+
+    // Garantiza capacidad para n vértices e inicia una época nueva.
+    void prepare(int n);
+
+    int capacity() const { return static_cast<int>(dist_.size()); }
+
+    bool labeled(int v) const { return seen_[v] == epoch_; }
+    bool settled(int v) const { return done_[v] == epoch_; }
+    double dist(int v) const {
+        return labeled(v) ? dist_[v] : std::numeric_limits<double>::infinity();
+    }
+    int parent(int v) const { return labeled(v) ? parent_[v] : -1; }
+    // Índice CSR de la arista predecesora (kNoEdge si no se registró).
+    std::size_t parent_edge(int v) const { return labeled(v) ? parent_edge_[v] : kNoEdge; }
+
+    static constexpr std::size_t kNoEdge = std::numeric_limits<std::size_t>::max();
+
+    void label(int v, double d, int p, std::size_t e = kNoEdge) {
+        seen_[v] = epoch_;
+        dist_[v] = d;
+        parent_[v] = p;
+        parent_edge_[v] = e;
+    }
+    void settle(int v) { done_[v] = epoch_; }
+
+    // Cola de prioridad (min-heap sobre la distancia) reutilizada entre consultas.
+    std::vector<std::pair<double, int>> &heap() { return heap_; }
+
+private:
+    std::vector<double> dist_;
+    std::vector<int> parent_;
+    std::vector<std::size_t> parent_edge_;
+    std::vector<std::uint32_t> seen_;
+    std::vector<std::uint32_t> done_;
+    std::vector<std::pair<double, int>> heap_;
+    std::uint32_t epoch_ = 0;
+};
+
+// Criterios de parada de una consulta acotada.  Se pueden combinar: la
+// búsqueda termina con el primero que se cumpla.
+struct QueryLimits {
+    // Sólo se asientan vértices con distancia <= max_dist.
+    double max_dist = std::numeric_limits<double>::infinity();
+    // Número máximo de vértices aceptados a devolver.
+    std::size_t max_settled = std::numeric_limits<std::size_t>::max();
+    // Filtro opcional: sólo los vértices que lo cumplen se devuelven y
+    // cuentan para max_settled.  El resto se atraviesa igualmente.
+    std::function<bool(int)> accept;
+};
+
+// Resultado disperso: vértices aceptados en orden no decreciente de distancia,
+// con su distancia y su predecesor en el árbol de caminos mínimos (-1 para el
+// origen).  El predecesor puede ser un vértice no aceptado por el filtro.
+struct SparseDistances {
+    std::vector<int> vertices;
+    std::vector<double> dist;
+    std::vector<int> parent;
+
+    std::size_t size() const { return vertices.size(); }
+};
+
+// Búsqueda de Dijkstra detenida según `limits`.  Lanza std::runtime_error si
+// encuentra un peso negativo en la región explorada.
+SparseDistances dijkstra_limited(const AdjList &adj, int source, const QueryLimits &limits,
+                                 DijkstraWorkspace &ws);
+
+// Vértices a distancia <= radius de source (isócrona).
+SparseDistances dijkstra_within(const AdjList &adj, int source, double radius,
+                                DijkstraWorkspace &ws);
+
+// Los k vértices más cercanos a source (incluido el propio origen).
+SparseDistances dijkstra_nearest(const AdjList &adj, int source, std::size_t k,
+                                 DijkstraWorkspace &ws);
+
+// Los k vértices más cercanos a source que cumplen el predicado `accept`.
+SparseDistances dijkstra_nearest_if(const AdjList &adj, int source, std::size_t k,
+                                    const std::function<bool(int)> &accept,
+                                    DijkstraWorkspace &ws);
+
+// Sobrecargas sobre el grafo CSR, sin comprobación de pesos durante la búsqueda.
+SparseDistances dijkstra_limited(const Graph &g, int source, const QueryLimits &limits,
+                                 DijkstraWorkspace &ws);
+SparseDistances dijkstra_within(const Graph &g, int source, double radius,
+                                DijkstraWorkspace &ws);
+SparseDistances dijkstra_nearest(const Graph &g, int source, std::size_t k,
+                                 DijkstraWorkspace &ws);
+SparseDistances dijkstra_nearest_if(const Graph &g, int source, std::size_t k,
+                                    const std::function<bool(int)> &accept,
+                                    DijkstraWorkspace &ws);
+SparseDistances dijkstra_limited(const CompressedGraph &g, int source, const QueryLimits &limits,
+                                 DijkstraWorkspace &ws);
+
+// -----------------------------------------------------------------------------
+// Búsquedas punto a punto con exclusiones
+//
+// Los algoritmos que necesitan "borrar" vértices o aristas temporalmente
+// (p. ej. los caminos alternativos de Yen) usan una máscara en lugar de copiar
+// el grafo.  Igual que el workspace, la máscara se vacía en O(1) con una época.
+
+class SearchMask {
+public:
+    // Garantiza capacidad para n vértices y m aristas y vacía la máscara.
+    void prepare(int n, std::size_t m);
+
+    void ban_vertex(int v) { vertex_[v] = epoch_; }
+    void ban_edge(std::size_t e) { edge_[e] = epoch_; }
+    bool vertex_banned(int v) const { return vertex_[v] == epoch_; }
+    bool edge_banned(std::size_t e) const { return edge_[e] == epoch_; }
+
+private:
+    std::vector<std::uint32_t> vertex_;
+    std::vector<std::uint32_t> edge_;
+    std::uint32_t epoch_ = 0;
+};
+
+// Camino concreto: vértices, índices CSR de sus aristas y coste total.
+struct PathResult {
+    double cost = std::numeric_limits<double>::infinity();
+    std::vector<int> vertices;
+    std::vector<std::size_t> edges;
+
+    bool found() const { return !vertices.empty(); }
+};
+
+// Dijkstra de source a target que se detiene al asentar target y omite los
+// vértices y aristas excluidos por `mask` (puede ser nullptr).  El origen se
+// explora aunque esté excluido.  Requiere pesos no negativos.
+PathResult dijkstra_path(const Graph &g, int source, int target, DijkstraWorkspace &ws,
+                         const SearchMask *mask = nullptr);
+
+// Memoria de búsqueda reutilizable por los algoritmos que lanzan muchas
+// búsquedas, posiblemente desde varios hilos (véase parallel::ResourcePool).
+struct SearchScratch {
+    DijkstraWorkspace workspace;
+    SearchMask mask;
+};
+
+} // namespace graphs
@@ -0,0 +1,108 @@
+// Caminos mínimos dinámicos ante cambios de peso (estilo Ramalingam–Reps).
+//
+// Se mantienen, para un conjunto de orígenes, las distancias y el árbol de
+// caminos mínimos (arista predecesora de cada vértice).  Cuando cambia el
+// peso de una arista sólo se reparan los vértices afectados:
+//
+//   * Disminución de (u,v): si mejora dist[v] se propaga una búsqueda de
+//     Dijkstra a partir de v que sólo visita los vértices que mejoran.
+//   * Aumento de (u,v): si la arista no está en el árbol no cambia nada.  Si
+//     lo está, se recoge el subárbol que cuelga de v, se recalcula para cada
+//     vértice afectado la mejor entrada desde vértices no afectados y se
+//     ejecuta Dijkstra restringido a ese subárbol.
+//
+// El coste de cada actualización es proporcional al número de vértices
+// afectados y a sus aristas, no al tamaño del grafo.  Requiere pesos no
+// negativos.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "graph.hpp"
+
+namespace graphs {
+
+// Cambio de peso de la arista u -> v.
+struct WeightUpdate {
+    int u;
+    int v;
+    double weight;
+};
+
+class DynamicShortestPaths {
+public:
+    static constexpr std::size_t kNoEdge = std::numeric_limits<std::size_t>::max();
+
+    // Copia la estructura de g y calcula los árboles iniciales de cada origen.
+    // `threads` hilos reparan los árboles de orígenes distintos en paralelo
+    // (0 = todos los núcleos).  Lanza std::invalid_argument con pesos negativos.
+    DynamicShortestPaths(const Graph &g, std::vector<int> sources, unsigned threads = 1);
+
+    int num_vertices() const { return n_; }
+    std::size_t num_sources() const { return trees_.size(); }
+    int source(std::size_t i) const { return trees_[i].source; }
+
+    double dist(std::size_t tree, int v) const { return trees_[tree].dist[v]; }
+    const std::vector<double> &distances(std::size_t tree) const { return trees_[tree].dist; }
+    // Predecesor de v en el árbol (-1 para el origen y los no alcanzados).
+    int parent(std::size_t tree, int v) const;
+    // Camino desde el origen del árbol hasta v (vacío si no es alcanzable).
+    std::vector<int> path(std::size_t tree, int v) const;
+
+    double weight(std::size_t e) const { return weights_[e]; }
+
+    // Cambia el peso de la arista con índice CSR `e` y repara los árboles.
+    // Devuelve el número de vértices (sumado sobre todos los orígenes) cuya
+    // distancia o predecesor se ha recalculado.
+    std::size_t set_weight(std::size_t e, double weight);
+
+    // Cambia el peso de la primera arista u -> v.  Lanza std::out_of_range si
+    // no existe.
+    std::size_t update(int u, int v, double weight);
+
+    // Aplica una tanda de cambios en orden.
+    std::size_t update(const std::vector<WeightUpdate> &updates);
+
+    // Índice CSR de la primera arista u -> v, o kNoEdge.
+    std::size_t find_edge(int u, int v) const;
+
+private:
+    struct Tree {
+        int source = 0;
+        std::vector<double> dist;
+        std::vector<std::size_t> parent_edge;
+    };
+
+    // Memoria auxiliar reutilizada entre reparaciones (una por hilo).
+    struct Scratch {
+        std::vector<std::pair<double, int>> heap;
+        std::vector<int> affected;
+        std::vector<std::uint32_t> mark;
+        std::uint32_t epoch = 0;
+    };
+
+    std::size_t decrease(Tree &t, std::size_t e, Scratch &s) const;
+    std::size_t increase(Tree &t, std::size_t e, Scratch &s) const;
+    std::size_t propagate(Tree &t, Scratch &s) const;
+    std::size_t apply(std::size_t e, double old_weight);
+
+    int n_ = 0;
+    std::vector<std::size_t> offsets_;
+    std::vector<int> targets_;
+    std::vector<double> weights_;
+    std::vector<int> edge_source_;
+    // Aristas entrantes: in_edges_[in_offsets_[v] .. in_offsets_[v+1]) son
+    // índices CSR de aristas con destino v.
+    std::vector<std::size_t> in_offsets_;
+    std::vector<std::size_t> in_edges_;
+    std::vector<Tree> trees_;
+    std::vector<Scratch> scratch_;
+    unsigned threads_ = 1;
+};
+
+} // namespace graphs
@@ -0,0 +1,83 @@
+// Minimizador heurístico de dos niveles al estilo de Espresso-II.
+//
+// Quine-McCluskey (quine_mccluskey.hpp) enumera todos los implicantes
+// primos y crece exponencialmente con el número de variables.  Espresso
+// trabaja sobre listas de cubos (los mismos `Cube` de 64 bits) y mejora una
+// cobertura de forma iterativa:
+//
+//   EXPAND       agranda cada cubo hasta hacerlo primo sin cortar el
+//                conjunto OFF, intentando absorber a otros cubos;
+//   IRREDUNDANT  quita los cubos que cubre el resto de la cobertura;
+//   REDUCE       encoge cada cubo al menor que mantiene la cobertura, para
+//                que el siguiente EXPAND pueda crecer en otra dirección.
+//
+// El bucle termina cuando una vuelta no baja el coste (cubos y, a igualdad,
+// literales).  La contención de un cubo en una cobertura se comprueba con
+// la tautología del cofactor, por recursión unate; el conjunto OFF, si el
+// PLA no lo da, es el complemento de ON ∪ DC por la misma recursión.  El
+// resultado no es necesariamente mínimo, pero sí primo e irredundante.
+//
+// Los PLA de varias salidas se minimizan salida a salida (en paralelo), sin
+// compartir cubos entre salidas.
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "quine_mccluskey.hpp"
+
+namespace graphs {
+
+// Tautología y complemento de una cobertura de `num_vars` variables.
+bool tautology(const std::vector<Cube> &cover, unsigned num_vars);
+std::vector<Cube> complement(const std::vector<Cube> &cover, unsigned num_vars);
+// El cubo está contenido en la unión de la cobertura.
+bool cover_contains(const std::vector<Cube> &cover, const Cube &cube);
+
+struct EspressoOptions {
+    // Hilos para los PLA de varias salidas (0 = parallel::default_threads()).
+    unsigned threads = 0;
+    // Máximo de vueltas REDUCE/EXPAND/IRREDUNDANT (0 = hasta que no mejore).
+    unsigned max_iterations = 0;
+};
+
+// Cobertura de ON con ayuda de DC.  Con `off` vacío se calcula el
+// complemento; si no, ON y OFF no deben cortarse (std::invalid_argument).
+std::vector<Cube> espresso(const std::vector<Cube> &on, const std::vector<Cube> &dc, unsigned num_vars,
+                           const EspressoOptions &options = {});
+std::vector<Cube> espresso(const std::vector<Cube> &on, const std::vector<Cube> &dc, const std::vector<Cube> &off,
+                           unsigned num_vars, const EspressoOptions &options = {});
+
+// Patrones ordenados, con la firma de minimize_function en Python.
+std::vector<std::string> espresso_minimize(const std::vector<std::uint64_t> &minterms, unsigned num_vars,
+                                           const std::vector<std::uint64_t> &dont_cares = {},
+                                           const EspressoOptions &options = {});
+
+// PLA de Berkeley: .i, .o, .ilb, .ob, .p, .type (f, fd, fr, fdr) y .e.  En
+// la parte de salida '1' es ON, '0' OFF (tipos con r) y '-' o '2' DC (tipos
+// con d); '~' no aporta nada.
+struct Pla {
+    unsigned inputs = 0;
+    unsigned outputs = 0;
+    std::vector<std::string> input_labels;
+    std::vector<std::string> output_labels;
+    std::string type = "fd";
+    // Conjuntos de cada salida.
+    std::vector<std::vector<Cube>> on, dc, off;
+};
+
+// Lanzan std::runtime_error con el número de línea si el PLA no es válido.
+Pla parse_pla(std::istream &in);
+Pla load_pla(const std::string &path);
+// Escribe un PLA de tipo f (los conjuntos ON), agrupando en una fila las
+// salidas que comparten cubo de entrada.
+void write_pla(std::ostream &out, const Pla &pla);
+
+// Minimiza cada salida; devuelve un PLA de tipo f.
+Pla espresso(const Pla &pla, const EspressoOptions &options = {});
+
+} // namespace graphs
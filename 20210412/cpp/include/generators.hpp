@@ -0,0 +1,87 @@
+// Generadores de grafos sintéticos con semilla, para pruebas y bancos de
+// rendimiento (véase tools/bench_graphs.cpp).
+//
+// Cada familia reproduce una estructura típica:
+//
+//   * grid_2d / grid_3d: rejillas de 4 y 6 vecinos (diámetro grande, grado
+//     constante; el peor caso de las búsquedas dirigidas por frontera).
+//   * rmat: R-MAT / Kronecker estocástico con iniciador 2x2 (a, b; c, d);
+//     con los parámetros por defecto de Graph500 da grados en ley de
+//     potencias y diámetro pequeño.
+//   * random_geometric: puntos uniformes en el cuadrado unidad unidos si
+//     distan menos de `radius`; peso = distancia euclídea.
+//   * road_network: rejilla con los puntos perturbados, un árbol generador
+//     aleatorio más una fracción de las calles restantes y algunas
+//     diagonales; peso = longitud.  Grado medio ~2.5-3 y diámetro grande,
+//     como una red de carreteras.
+//
+// Todo número aleatorio sale de un hash (splitmix64) de la semilla y del
+// índice del elemento, no de un generador secuencial: el resultado es el
+// mismo en cualquier plataforma y con cualquier número de hilos.  Las
+// familias no dirigidas guardan cada arista en ambos sentidos con el mismo
+// peso.
+
+#pragma once
+
+#include <cstdint>
+
+#include "graph.hpp"
+
+namespace graphs {
+
+struct GeneratorOptions {
+    std::uint64_t seed = 1;
+    // Pesos uniformes en [min_weight, max_weight] para las familias que no
+    // usan distancias (rejillas y R-MAT); iguales = pesos constantes.
+    double min_weight = 1.0;
+    double max_weight = 1.0;
+    // Hilos de trabajo (0 = parallel::default_threads()).
+    unsigned threads = 0;
+};
+
+// Rejilla width x height de 4 vecinos; el vértice (x, y) es y * width + x.
+Graph grid_2d(int width, int height, const GeneratorOptions &options = {});
+
+// Rejilla nx x ny x nz de 6 vecinos; el vértice (x, y, z) es (z * ny + y) * nx + x.
+Graph grid_3d(int nx, int ny, int nz, const GeneratorOptions &options = {});
+
+struct RmatOptions {
+    // Probabilidades de los cuadrantes; d = 1 - a - b - c.
+    double a = 0.57;
+    double b = 0.19;
+    double c = 0.19;
+    // Perturba las probabilidades en cada nivel (evita picos artificiales
+    // en la distribución de grados).
+    bool noise = true;
+    // Renumera los vértices con una permutación aleatoria para que los de
+    // mayor grado no queden juntos al principio.
+    bool permute = true;
+    // Descarta bucles y aristas repetidas.
+    bool simple = true;
+};
+
+// Grafo dirigido de 2^scale vértices con `edges` aristas muestreadas
+// (menos si `simple` elimina repetidas).  Lanza std::invalid_argument si
+// scale no está en [0, 30] o las probabilidades no son válidas.
+Graph rmat(int scale, std::size_t edges, const RmatOptions &rmat = {},
+           const GeneratorOptions &options = {});
+
+// n puntos uniformes en [0, 1)^2 unidos si distan menos de radius.  Con
+// radius = sqrt(k / (pi n)) el grado medio es ~k.
+Graph random_geometric(int n, double radius, const GeneratorOptions &options = {});
+
+struct RoadOptions {
+    // Fracción de las calles de la rejilla que no forman parte del árbol
+    // generador y se conservan.
+    double keep = 0.35;
+    // Fracción de celdas con una diagonal.
+    double diagonals = 0.05;
+    // Desplazamiento máximo de cada punto respecto a su celda (en celdas).
+    double jitter = 0.3;
+};
+
+// Red tipo carretera sobre una rejilla width x height; siempre conexa.
+Graph road_network(int width, int height, const RoadOptions &road = {},
+                   const GeneratorOptions &options = {});
+
+} // namespace graphs
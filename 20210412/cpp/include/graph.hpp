@@ -0,0 +1,183 @@
+// Grafo dirigido ponderado en formato CSR (compressed sparse row).
+//
+// Las aristas salientes de u ocupan el rango [offsets[u], offsets[u+1]) de
+// los vectores `targets` y `weights`.  Los pesos se validan una sola vez al
+// construir el grafo y se cachea si existe alguno negativo, de modo que los
+// algoritmos pueden elegir su variante sin comprobar pesos en el bucle interno.
+//
+// Los arrays son inmutables y se comparten: copiar un Graph sólo copia
+// punteros y un contador de referencias.  Pueden residir en vectores propios
+// o en memoria externa (p. ej. un archivo mapeado, véase snapshot.hpp) que se
+// mantiene viva mientras exista alguna copia del grafo.
+//
+// Como nada modifica los arrays tras construir el grafo, todos los métodos
+// const pueden llamarse a la vez desde varios hilos sobre el mismo objeto o
+// sobre copias suyas.  Los algoritmos que reciben `const Graph &` sólo leen
+// el grafo; su estado mutable vive en espacios de trabajo (p. ej.
+// DijkstraWorkspace) que no deben compartirse entre hilos.  Véase
+// query_server.hpp para servir consultas concurrentes.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace graphs {
+
+// Tipos de vértice y de peso
+//
+// Las estructuras y algoritmos básicos son plantillas sobre el tipo de
+// identificador de vértice (int o std::int64_t para grafos de miles de
+// millones de vértices) y el de peso (double, float o enteros de 32 bits,
+// que reducen a la mitad el tráfico de memoria).  Graph, AdjList,
+// ShortestPathTree y EdgeRecord son la instancia <int, double> de siempre.
+// Las combinaciones de GRAPHS_INSTANTIATE se instancian explícitamente en
+// la biblioteca `graphs`.
+
+#define GRAPHS_INSTANTIATE(X)    \
+    X(int, double)               \
+    X(int, float)                \
+    X(int, std::int32_t)         \
+    X(std::int64_t, double)      \
+    X(std::int64_t, float)       \
+    X(std::int64_t, std::int32_t)
+
+// Distancias acumuladas: los pesos reales suman en su propio tipo y los
+// enteros en 64 bits; "infinito" es el máximo si el tipo no lo tiene.
+template <class Weight>
+struct WeightTraits {
+    using distance_type = std::conditional_t<std::is_floating_point_v<Weight>, Weight, std::int64_t>;
+
+    static constexpr distance_type infinity() {
+        if constexpr (std::numeric_limits<distance_type>::has_infinity) {
+            return std::numeric_limits<distance_type>::infinity();
+        } else {
+            return std::numeric_limits<distance_type>::max();
+        }
+    }
+    // Verdadero para +infinito y, en tipos reales, también para -infinito.
+    static bool is_infinite(distance_type d) {
+        if constexpr (std::is_floating_point_v<distance_type>) {
+            return std::isinf(d);
+        } else {
+            return d == infinity();
+        }
+    }
+};
+
+template <class Weight>
+using Distance = typename WeightTraits<Weight>::distance_type;
+
+// Representación del grafo: vector de listas de pares (vecino, peso)
+template <class Vertex, class Weight>
+using BasicAdjList = std::vector<std::vector<std::pair<Vertex, Weight>>>;
+using AdjList = BasicAdjList<int, double>;
+
+// Vista de sólo lectura sobre un array contiguo.
+template <class T>
+class ArrayView {
+public:
+    ArrayView() = default;
+    ArrayView(const T *data, std::size_t size) : data_(data), size_(size) {}
+
+    const T *data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const T &operator[](std::size_t i) const { return data_[i]; }
+    const T *begin() const { return data_; }
+    const T *end() const { return data_ + size_; }
+
+    std::vector<T> to_vector() const { return std::vector<T>(data_, data_ + size_); }
+
+private:
+    const T *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+template <class Vertex, class Weight>
+class BasicGraph {
+public:
+    using vertex_type = Vertex;
+    using weight_type = Weight;
+
+    BasicGraph();
+
+    // Construye el CSR a partir de listas de adyacencia, conservando el orden
+    // de las aristas de cada vértice.
+    explicit BasicGraph(const BasicAdjList<Vertex, Weight> &adj);
+
+    // Adopta arrays CSR ya construidos.  Lanza std::invalid_argument si los
+    // desplazamientos no son monótonos, algún destino está fuera de rango o
+    // algún peso es NaN.
+    BasicGraph(std::vector<std::size_t> offsets, std::vector<Vertex> targets, std::vector<Weight> weights);
+
+    // Grafo sobre memoria externa, sin copiarla.  `owner` mantiene viva esa
+    // memoria mientras el grafo (o alguna copia) exista.  Valida igual que el
+    // constructor anterior.
+    static BasicGraph view(ArrayView<std::size_t> offsets, ArrayView<Vertex> targets,
+                           ArrayView<Weight> weights, std::shared_ptr<const void> owner);
+
+    // Igual que view() pero sin validar: el llamante garantiza que los arrays
+    // son coherentes y aporta el indicador de pesos negativos ya calculado
+    // (p. ej. leído de la cabecera de un snapshot).
+    static BasicGraph trusted_view(ArrayView<std::size_t> offsets, ArrayView<Vertex> targets,
+                                   ArrayView<Weight> weights, std::shared_ptr<const void> owner,
+                                   bool has_negative_weights);
+
+    Vertex num_vertices() const { return n_; }
+    std::size_t num_edges() const { return m_; }
+
+    // Verdadero si alguna arista tiene peso estrictamente negativo.
+    bool has_negative_weights() const { return has_negative_weights_; }
+
+    std::size_t edge_begin(Vertex u) const { return offsets_[u]; }
+    std::size_t edge_end(Vertex u) const { return offsets_[u + 1]; }
+    std::size_t degree(Vertex u) const { return offsets_[u + 1] - offsets_[u]; }
+    Vertex target(std::size_t e) const { return targets_[e]; }
+    Weight weight(std::size_t e) const { return weights_[e]; }
+
+    ArrayView<std::size_t> offsets() const { return {offsets_, static_cast<std::size_t>(n_) + 1}; }
+    ArrayView<Vertex> targets() const { return {targets_, m_}; }
+    ArrayView<Weight> weights() const { return {weights_, m_}; }
+
+private:
+    void attach(ArrayView<std::size_t> offsets, ArrayView<Vertex> targets, ArrayView<Weight> weights,
+                std::shared_ptr<const void> owner);
+    void validate();
+
+    const std::size_t *offsets_ = nullptr;
+    const Vertex *targets_ = nullptr;
+    const Weight *weights_ = nullptr;
+    Vertex n_ = 0;
+    std::size_t m_ = 0;
+    bool has_negative_weights_ = false;
+    std::shared_ptr<const void> owner_;
+};
+
+using Graph = BasicGraph<int, double>;
+
+// Árbol de caminos mínimos desde un origen: distancias (infinito si no se
+// alcanza) y predecesor de cada vértice (-1 para el origen y los no alcanzados).
+template <class Vertex, class Weight>
+struct BasicShortestPathTree {
+    using vertex_type = Vertex;
+
+    std::vector<Distance<Weight>> dist;
+    std::vector<Vertex> parent;
+};
+
+using ShortestPathTree = BasicShortestPathTree<int, double>;
+
+// Reconstruye el camino source -> target a partir de los predecesores.
+// Devuelve un vector vacío si target no es alcanzable.
+template <class Vertex, class Weight>
+std::vector<Vertex> extract_path(const BasicShortestPathTree<Vertex, Weight> &tree,
+                                 typename BasicShortestPathTree<Vertex, Weight>::vertex_type target);
+
+} // namespace graphs
@@ -0,0 +1,95 @@
+// Construcción paralela de grafos CSR a partir de listas de aristas.
+//
+// En lugar de crecer listas de adyacencia con push_back, el constructor hace
+// tres pasadas sobre las aristas ya leídas:
+//
+//   1. cuenta el grado de salida de cada vértice (contadores atómicos),
+//   2. convierte los grados en desplazamientos con una suma prefija paralela,
+//   3. reparte cada arista en su hueco del CSR.
+//
+// Después ordena cada fila por destino (el resultado no depende del número
+// de hilos) y, si se pide, elimina aristas repetidas.  La memoria extra es un
+// contador por vértice; los arrays finales se reservan una sola vez.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "graph.hpp"
+
+namespace graphs {
+
+template <class Vertex, class Weight>
+struct BasicEdgeRecord {
+    using vertex_type = Vertex;
+
+    Vertex u;
+    Vertex v;
+    Weight w;
+};
+
+using EdgeRecord = BasicEdgeRecord<int, double>;
+
+struct BuildOptions {
+    // Conserva una sola arista u->v por par; se queda con la de menor peso.
+    bool deduplicate = false;
+    // Añade v->u por cada arista u->v (los bucles no se duplican).
+    bool symmetrize = false;
+    // Descarta las aristas u->u.
+    bool drop_self_loops = false;
+    // Hilos de trabajo (0 = parallel::default_threads()).
+    unsigned threads = 0;
+    // Sólo lectores de texto: si todos los identificadores son enteros no
+    // negativos se usan como índices (n = máximo + 1, sin nombres).  Con
+    // identificadores dispersos reserva vértices que no aparecen.
+    bool numeric_ids = false;
+};
+
+// Construye un grafo de n vértices a partir de uno o varios lotes de aristas
+// (p. ej. uno por hilo de lectura).  Lanza std::out_of_range si algún extremo
+// no está en [0, n) y std::invalid_argument si algún peso es NaN.
+template <class Vertex, class Weight>
+BasicGraph<Vertex, Weight> build_csr(typename BasicEdgeRecord<Vertex, Weight>::vertex_type n,
+                                     const std::vector<std::vector<BasicEdgeRecord<Vertex, Weight>>> &batches,
+                                     const BuildOptions &options = {});
+template <class Vertex, class Weight>
+BasicGraph<Vertex, Weight> build_csr(typename BasicEdgeRecord<Vertex, Weight>::vertex_type n,
+                                     const std::vector<BasicEdgeRecord<Vertex, Weight>> &edges,
+                                     const BuildOptions &options = {});
+
+// Instancia <int, double>; admite también listas entre llaves.
+Graph build_csr(int n, const std::vector<std::vector<EdgeRecord>> &batches,
+                const BuildOptions &options = {});
+Graph build_csr(int n, const std::vector<EdgeRecord> &edges, const BuildOptions &options = {});
+
+// Grafo traspuesto (aristas invertidas) con el mismo procedimiento.
+template <class Vertex, class Weight>
+BasicGraph<Vertex, Weight> transpose(const BasicGraph<Vertex, Weight> &g, unsigned threads = 0);
+
+// Acumula aristas y construye el grafo al final.  El número de vértices
+// crece con los identificadores usados (o con add_vertices).
+template <class Vertex, class Weight>
+class BasicGraphBuilder {
+public:
+    explicit BasicGraphBuilder(BuildOptions options = {}) : options_(options) {}
+
+    void reserve(std::size_t edges) { edges_.reserve(edges); }
+    void add_vertices(Vertex n) { n_ = std::max(n_, n); }
+    void add_edge(Vertex u, Vertex v, Weight w = Weight(1));
+
+    Vertex num_vertices() const { return n_; }
+    std::size_t num_edges() const { return edges_.size(); }
+
+    BasicGraph<Vertex, Weight> build() const { return build_csr<Vertex, Weight>(n_, edges_, options_); }
+
+private:
+    BuildOptions options_;
+    std::vector<BasicEdgeRecord<Vertex, Weight>> edges_;
+    Vertex n_ = 0;
+};
+
+using GraphBuilder = BasicGraphBuilder<int, double>;
+
+} // namespace graphs
@@ -0,0 +1,48 @@
+// Lectura de grafos desde los formatos de texto del repositorio.
+//
+//   * CSV de aristas (`data/samples/graph_edges.csv`): una arista por línea
+//     con `origen,destino[,peso]`; el peso por defecto es 1.0.  Una línea con
+//     un solo campo declara un vértice aislado.
+//   * JSON de adyacencia: objeto nodo -> lista de vecinos, donde cada vecino
+//     puede ser un identificador (`"0": [1, 2]`), un par `[vecino, peso]`
+//     (`dijkstra_adj.json`) o un objeto `{"to": v, "weight": w}` como el que
+//     acepta `scripts/graphs_cli.py`.
+//
+// El CSV se lee en trozos paralelos.  Los nodos se identifican por su texto
+// y reciben índices consecutivos por orden de aparición, igual que en el
+// JSON y en scripts/graphs_cli.py: cada trozo numera sus nombres por
+// separado y después se fusionan en orden.  Con BuildOptions::numeric_ids,
+// si todos los identificadores son enteros no negativos se usan
+// directamente como índices (n = máximo + 1) y no se guardan nombres.  El
+// grafo se monta con build_csr (graph_builder.hpp), de modo que las
+// opciones de deduplicación y simetrización valen para ambos formatos.
+// Los errores de lectura o de formato lanzan std::runtime_error indicando la
+// línea.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "graph.hpp"
+#include "graph_builder.hpp"
+
+namespace graphs {
+
+// Grafo con el nombre original de cada vértice (names[i] es el nodo i).
+// Con BuildOptions::numeric_ids y un CSV numérico names queda vacío.
+struct LabeledGraph {
+    Graph graph;
+    std::vector<std::string> names;
+
+    // Índice del nodo con ese nombre o -1 (sin nombres, el número mismo).
+    int find(const std::string &name) const;
+};
+
+LabeledGraph read_edge_list_csv(const std::string &path, const BuildOptions &options = {});
+LabeledGraph read_adjacency_json(const std::string &path, const BuildOptions &options = {});
+
+// Elige el lector por la extensión (.csv o .json).
+LabeledGraph read_graph_file(const std::string &path, const BuildOptions &options = {});
+
+} // namespace graphs
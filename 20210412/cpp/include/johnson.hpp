@@ -0,0 +1,64 @@
+// Caminos mínimos entre todos los pares (algoritmo de Johnson).
+//
+// Si el grafo tiene pesos negativos se ejecuta un único Bellman–Ford desde un
+// origen virtual para obtener potenciales h y se reponderan las aristas con
+// w'(u,v) = w(u,v) + h(u) - h(v) >= 0.  Después se lanza un Dijkstra por
+// origen, repartidos entre varios hilos, y se deshace la reponderación.  Con
+// pesos no negativos el paso de Bellman–Ford se omite.
+//
+// El resultado puede volcarse en una matriz de distancias organizada en
+// bloques o entregarse fila a fila a una función de retorno, de modo que la
+// matriz n×n completa no tenga que residir en memoria.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "graph.hpp"
+
+namespace graphs {
+
+// Matriz de distancias n×n almacenada por bloques cuadrados de tile×tile
+// contiguos en memoria, para que los accesos por bloques de filas y columnas
+// cercanas compartan líneas de caché.
+class TiledDistanceMatrix {
+public:
+    explicit TiledDistanceMatrix(int n = 0, int tile = 64);
+
+    int size() const { return n_; }
+    int tile_size() const { return tile_; }
+
+    double at(int i, int j) const { return data_[index(i, j)]; }
+    double &at(int i, int j) { return data_[index(i, j)]; }
+
+    // Copia una fila completa (de tamaño n) en la matriz.
+    void set_row(int i, const std::vector<double> &row);
+    // Devuelve una copia de la fila i.
+    std::vector<double> row(int i) const;
+
+private:
+    std::size_t index(int i, int j) const {
+        std::size_t tile_id = static_cast<std::size_t>(i / tile_) * tiles_per_row_ + j / tile_;
+        return tile_id * tile_ * tile_ + static_cast<std::size_t>(i % tile_) * tile_ + j % tile_;
+    }
+
+    int n_ = 0;
+    int tile_ = 1;
+    std::size_t tiles_per_row_ = 0;
+    std::vector<double> data_;
+};
+
+// Recibe la fila de distancias desde `source`.  Las llamadas se serializan
+// (nunca hay dos simultáneas) pero llegan en orden arbitrario de origen.
+using DistanceRowCallback = std::function<void(int source, const std::vector<double> &row)>;
+
+// Johnson con volcado por filas.  `threads` = 0 usa todos los núcleos.
+// Lanza std::runtime_error si el grafo contiene un ciclo negativo.
+void johnson_apsp_rows(const Graph &g, const DistanceRowCallback &on_row, unsigned threads = 0);
+
+// Johnson con resultado en una matriz por bloques.
+TiledDistanceMatrix johnson_apsp(const Graph &g, unsigned threads = 0, int tile = 64);
+
+} // namespace graphs
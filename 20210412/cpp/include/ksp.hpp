@@ -0,0 +1,36 @@
+// K caminos mínimos simples (sin bucles) entre dos vértices: algoritmo de Yen.
+//
+// Partiendo del camino mínimo, cada iteración toma el último camino aceptado
+// y, para cada vértice de desviación ("spur"), busca el mejor camino que
+// comparte el prefijo ("root") hasta ese vértice pero sale por una arista
+// distinta.  Las exclusiones de Yen (vértices del prefijo y aristas ya usadas
+// por caminos con el mismo prefijo) se aplican con SearchMask, sin copiar el
+// grafo.  Las búsquedas de desviación de una iteración son independientes y
+// se reparten entre hilos, cada uno con un SearchScratch de una reserva común.
+// Requiere pesos no negativos.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "dijkstra.hpp"
+#include "parallel.hpp"
+
+namespace graphs {
+
+using SearchPool = parallel::ResourcePool<SearchScratch>;
+
+// Devuelve hasta k caminos simples de source a target en orden no decreciente
+// de coste (menos si no existen tantos).  Se usan `threads` hilos para las
+// búsquedas de desviación (0 = todos los núcleos).  Lanza std::runtime_error
+// si el grafo tiene pesos negativos.
+std::vector<PathResult> k_shortest_paths(const Graph &g, int source, int target, std::size_t k,
+                                         unsigned threads = 0);
+
+// Igual que la anterior pero reutilizando los espacios de trabajo de `pool`
+// entre llamadas, lo que evita reservar memoria O(n) en cada consulta.
+std::vector<PathResult> k_shortest_paths(const Graph &g, int source, int target, std::size_t k,
+                                         SearchPool &pool, unsigned threads = 0);
+
+} // namespace graphs
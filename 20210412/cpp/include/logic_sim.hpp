@@ -0,0 +1,122 @@
+// Simulación por rodajas de bits (bit-sliced) de circuitos combinacionales.
+//
+// fsm_utils.check_equivalence llama a dos funciones de Python por cada
+// combinación de entradas.  Aquí el circuito (construido a mano, a partir de
+// expresiones o de un fichero .bench de ISCAS) se compila a una lista de
+// instrucciones lógicas sobre palabras: cada bit de una palabra es un vector
+// de entrada distinto, así que una instrucción evalúa la puerta para 64
+// vectores en escalar, 256 con AVX2 o 512 con AVX-512 (se elige en tiempo de
+// ejecución).  Las entradas se recorren por bloques de 512 vectores, cuyos
+// patrones de entrada se generan sin tabla.  Los registros se reutilizan
+// según la última lectura de cada nodo, de modo que el estado de trabajo
+// cabe en caché aunque el circuito tenga muchas puertas.
+//
+// La comprobación de equivalencia simula el miter (XOR de las salidas
+// emparejadas) en trozos del espacio de entradas repartidos entre hilos; en
+// cuanto un trozo encuentra una diferencia, los trozos posteriores se
+// saltan.  El contraejemplo devuelto es siempre el de menor índice.  Para
+// circuitos con más entradas, sat_equivalence.hpp.
+//
+// El vector de entrada número k asigna a la entrada i el bit i de k.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace graphs {
+
+enum class GateKind : std::uint8_t { Input, Const0, Const1, Buf, Not, And, Or, Xor, Nand, Nor, Xnor };
+
+// Red de puertas de una o dos entradas en orden topológico: cada puerta sólo
+// puede leer nodos creados antes que ella.
+class Circuit {
+public:
+    struct Node {
+        GateKind kind;
+        std::uint32_t a, b;
+    };
+
+    explicit Circuit(unsigned inputs = 0);
+
+    unsigned inputs() const { return static_cast<unsigned>(input_nodes_.size()); }
+    std::size_t size() const { return nodes_.size(); }
+    const Node &node(std::uint32_t id) const { return nodes_[id]; }
+
+    std::uint32_t add_input(const std::string &name = {});
+    std::uint32_t input(unsigned i) const;
+    std::uint32_t constant(bool value);
+    // Lanza std::invalid_argument si algún operando no existe todavía o si
+    // el tipo no es una puerta.
+    std::uint32_t add_gate(GateKind kind, std::uint32_t a, std::uint32_t b = 0);
+    void add_output(std::uint32_t node, const std::string &name = {});
+
+    const std::vector<std::uint32_t> &outputs() const { return outputs_; }
+    const std::vector<std::string> &input_names() const { return input_names_; }
+    const std::vector<std::string> &output_names() const { return output_names_; }
+
+private:
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> input_nodes_;
+    std::vector<std::string> input_names_;
+    std::vector<std::uint32_t> outputs_;
+    std::vector<std::string> output_names_;
+};
+
+// Una salida por expresión, con la sintaxis de
+// boolean_logic.pattern_to_expression: nombres de `inputs`, 0, 1, ~ (o !),
+// &, ^ y | (de más a menos prioridad) y paréntesis.  Lanza
+// std::invalid_argument con la posición si la expresión no es válida.
+Circuit parse_expressions(const std::vector<std::string> &outputs, const std::vector<std::string> &inputs);
+
+// Formato .bench de ISCAS: INPUT(x), OUTPUT(y) y y = AND(a, b, ...) con
+// AND, OR, NAND, NOR, XOR, XNOR, NOT y BUF (o BUFF); las puertas de más de
+// dos entradas se descomponen en árbol.  Las definiciones pueden aparecer
+// en cualquier orden.  Lanza std::runtime_error con el número de línea si
+// el fichero no es válido o tiene ciclos.
+Circuit parse_bench(std::istream &in);
+Circuit load_bench(const std::string &path);
+
+// Miter de dos circuitos con las mismas entradas: la salida i es el XOR de
+// las salidas i de `a` y `b`.  Lanza std::invalid_argument si difieren en
+// número de entradas o de salidas.
+Circuit build_miter(const Circuit &a, const Circuit &b);
+
+// Valores de las salidas para el vector de entrada `assignment`.
+std::vector<bool> evaluate(const Circuit &circuit, std::uint64_t assignment);
+
+struct SimOptions {
+    // 0 = parallel::default_threads().
+    unsigned threads = 0;
+    // Anchura de las instrucciones (64, 256 o 512 vectores); 0 = la mayor
+    // disponible (simd_lanes()).  Si la máquina no tiene la pedida se usa la
+    // mayor de las inferiores.
+    unsigned lanes = 0;
+};
+
+// Tabla de verdad: bit k de la palabra w de table[o] es la salida o para el
+// vector 64·w + k.  Como mucho 32 entradas (std::invalid_argument).
+std::vector<std::vector<std::uint64_t>> truth_table(const Circuit &circuit, const SimOptions &options = {});
+
+struct EquivalenceResult {
+    bool equivalent = true;
+    // Si no son equivalentes: el vector de entrada de menor índice en el que
+    // difieren y la primera salida distinta.
+    std::uint64_t counterexample = 0;
+    unsigned output = 0;
+    // Vectores de entrada simulados (incluye los de trozos completos que se
+    // evaluaron antes de conocer la diferencia).
+    std::uint64_t evaluated = 0;
+};
+
+// Comparación exhaustiva de dos circuitos (como mucho 63 entradas, aunque
+// en la práctica no más de 40; std::invalid_argument si no).
+EquivalenceResult check_equivalence(const Circuit &a, const Circuit &b, const SimOptions &options = {});
+
+// Vectores que evalúa cada instrucción en esta máquina: 64, 256 o 512.
+unsigned simd_lanes();
+
+} // namespace graphs
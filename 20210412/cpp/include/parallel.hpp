@@ -0,0 +1,190 @@
+// Utilidades mínimas de paralelismo basadas en std::thread.
+//
+// Se reparte un rango de índices [0, count) entre varios hilos con un
+// contador atómico, de modo que los trabajos de coste irregular se equilibran
+// solos.  Todas las funciones están definidas en línea en este encabezado.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallel {
+
+// Número de hilos por defecto: los núcleos disponibles (al menos 1).
+// Se consulta una sola vez: hardware_concurrency() puede costar una llamada
+// al sistema y se usa en cada reparto.
+inline unsigned default_threads() {
+    static const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    return hw;
+}
+
+// Número de hilos que usará for_each_index para `count` índices.
+inline unsigned effective_threads(std::size_t count, unsigned threads, std::size_t grain = 1) {
+    if (threads == 0) {
+        threads = default_threads();
+    }
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t blocks = (count + grain - 1) / grain;
+    return static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, blocks)));
+}
+
+// Ejecuta body(worker, i) para cada i en [0, count) usando `threads` hilos
+// (0 = default_threads()).  `worker` identifica al hilo en [0, threads) y
+// permite indexar estado privado por hilo.  Los índices se reparten en
+// bloques de `grain` elementos.  La primera excepción lanzada por body se
+// propaga al llamante una vez terminados todos los hilos.
+template <class Body>
+void for_each_index(std::size_t count, unsigned threads, std::size_t grain, Body &&body) {
+    threads = effective_threads(count, threads, grain);
+    grain = std::max<std::size_t>(grain, 1);
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            body(0u, i);
+        }
+        return;
+    }
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto run = [&](unsigned worker) {
+        try {
+            for (;;) {
+                std::size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+                if (begin >= count) {
+                    break;
+                }
+                std::size_t end = std::min(count, begin + grain);
+                for (std::size_t i = begin; i < end; ++i) {
+                    body(worker, i);
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next.store(count, std::memory_order_relaxed);
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(run, t);
+    }
+    run(0);
+    for (auto &th : pool) {
+        th.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Suma prefija exclusiva en el sitio: values[i] pasa a ser la suma de
+// values[0..i).  Devuelve el total.  Se hace por bloques: cada hilo suma su
+// bloque, se acumulan los totales de bloque y cada hilo propaga su base.
+template <class T>
+T exclusive_scan(std::vector<T> &values, unsigned threads = 0) {
+    const std::size_t n = values.size();
+    const std::size_t min_block = 1 << 16;
+    threads = effective_threads(n, threads, min_block);
+    if (threads <= 1) {
+        T sum{};
+        for (auto &v : values) {
+            T x = v;
+            v = sum;
+            sum += x;
+        }
+        return sum;
+    }
+    const std::size_t block = (n + threads - 1) / threads;
+    std::vector<T> totals(threads, T{});
+    for_each_index(threads, threads, 1, [&](unsigned, std::size_t b) {
+        const std::size_t begin = b * block, end = std::min(n, begin + block);
+        T sum{};
+        for (std::size_t i = begin; i < end; ++i) {
+            T x = values[i];
+            values[i] = sum;
+            sum += x;
+        }
+        totals[b] = sum;
+    });
+    T base{};
+    for (auto &t : totals) {
+        T x = t;
+        t = base;
+        base += x;
+    }
+    for_each_index(threads, threads, 1, [&](unsigned, std::size_t b) {
+        const std::size_t begin = b * block, end = std::min(n, begin + block);
+        for (std::size_t i = begin; i < end; ++i) {
+            values[i] += totals[b];
+        }
+    });
+    return base;
+}
+
+// Reserva de objetos reutilizables (p. ej. espacios de trabajo de búsqueda)
+// compartida entre hilos.  acquire() entrega un objeto libre o crea uno nuevo;
+// el objeto vuelve a la reserva al destruirse el Lease.  Sólo la entrega y la
+// devolución toman el cerrojo: el uso del objeto es exclusivo del hilo.
+template <class T>
+class ResourcePool {
+public:
+    class Lease {
+    public:
+        Lease(ResourcePool &pool, std::unique_ptr<T> item) : pool_(&pool), item_(std::move(item)) {}
+        Lease(Lease &&) noexcept = default;
+        Lease &operator=(Lease &&) = delete;
+        ~Lease() {
+            if (item_) {
+                pool_->release(std::move(item_));
+            }
+        }
+        T &operator*() const { return *item_; }
+        T *operator->() const { return item_.get(); }
+
+    private:
+        ResourcePool *pool_;
+        std::unique_ptr<T> item_;
+    };
+
+    Lease acquire() {
+        std::unique_ptr<T> item;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_.empty()) {
+                item = std::move(free_.back());
+                free_.pop_back();
+            }
+        }
+        if (!item) {
+            item = std::make_unique<T>();
+        }
+        return Lease(*this, std::move(item));
+    }
+
+    // Objetos actualmente libres en la reserva.
+    std::size_t idle() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return free_.size();
+    }
+
+private:
+    void release(std::unique_ptr<T> item) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(std::move(item));
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<T>> free_;
+};
+
+} // namespace parallel
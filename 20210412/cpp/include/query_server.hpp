@@ -0,0 +1,114 @@
+// Servidor de consultas de caminos mínimos concurrentes sobre un único grafo.
+//
+// Todos los hilos leen el mismo CSR inmutable a través de un SharedGraph, de
+// modo que no hace falta que cada uno tenga su propia copia de las listas de
+// adyacencia.  El estado mutable de cada búsqueda (distancias, predecesores,
+// montículo) vive en un DijkstraWorkspace que el servidor presta desde una
+// reserva común: cada hilo trabajador toma uno al empezar un lote y lo
+// devuelve al terminar, así que en régimen estable no se reserva memoria
+// O(n) por consulta.
+//
+// run() reparte un vector de consultas (s, t) entre hilos y mide la latencia
+// de cada una; el resultado incluye el rendimiento del lote (consultas por
+// segundo) y los percentiles de latencia.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "dijkstra.hpp"
+#include "parallel.hpp"
+
+namespace graphs {
+
+// Asa inmutable y compartible de un grafo.  Copiarla sólo copia un puntero
+// con contador de referencias; todas las copias ven el mismo Graph, que no
+// puede modificarse a través de ellas.  Es segura para leer desde cualquier
+// número de hilos a la vez (véase graph.hpp).
+class SharedGraph {
+public:
+    SharedGraph();
+    explicit SharedGraph(Graph g);
+    explicit SharedGraph(const AdjList &adj);
+
+    const Graph &graph() const { return *graph_; }
+    const Graph &operator*() const { return *graph_; }
+    const Graph *operator->() const { return graph_.get(); }
+
+    int num_vertices() const { return graph_->num_vertices(); }
+    std::size_t num_edges() const { return graph_->num_edges(); }
+
+    // Número de asas que comparten el grafo.
+    long use_count() const { return graph_.use_count(); }
+
+private:
+    std::shared_ptr<const Graph> graph_;
+};
+
+struct QueryRequest {
+    int source;
+    int target;
+};
+
+struct BatchOptions {
+    // Hilos trabajadores (0 = todos los núcleos).
+    unsigned threads = 0;
+    // Si es verdadero se devuelven también los vértices de cada camino.
+    bool paths = false;
+};
+
+// Rendimiento de un lote.  Las latencias están en microsegundos de reloj de
+// pared por consulta; los percentiles usan el criterio del rango más
+// cercano sobre las latencias ordenadas.
+struct LatencyStats {
+    std::size_t queries = 0;
+    double seconds = 0.0;     // duración total del lote
+    double throughput = 0.0;  // consultas por segundo
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+// Resultados en el mismo orden que las consultas: coste (infinito si t no es
+// alcanzable) y, con BatchOptions::paths, los vértices del camino (vacío si
+// no existe).
+struct BatchResult {
+    std::vector<double> cost;
+    std::vector<std::vector<int>> paths;
+    LatencyStats stats;
+};
+
+class QueryServer {
+public:
+    // Lanza std::runtime_error si el grafo tiene pesos negativos.
+    explicit QueryServer(SharedGraph graph);
+
+    const SharedGraph &graph() const { return graph_; }
+
+    // Consultas individuales.  Pueden llamarse desde varios hilos a la vez:
+    // cada llamada toma un workspace de la reserva.  Lanzan
+    // std::out_of_range si algún extremo no es un vértice.
+    double distance(int source, int target) const;
+    PathResult path(int source, int target) const;
+
+    // Resuelve el lote con `options.threads` hilos.  Todas las consultas se
+    // validan antes de empezar (std::out_of_range con la primera inválida).
+    BatchResult run(const std::vector<QueryRequest> &requests, const BatchOptions &options = {}) const;
+
+    // Workspaces creados y ahora libres en la reserva.
+    std::size_t idle_workspaces() const { return pool_.idle(); }
+
+private:
+    SharedGraph graph_;
+    mutable parallel::ResourcePool<DijkstraWorkspace> pool_;
+};
+
+// Estadísticas de un conjunto de latencias (microsegundos) medidas durante
+// `seconds` segundos.  Ordena `latencies`.
+LatencyStats summarize_latencies(std::vector<double> &latencies, double seconds);
+
+} // namespace graphs
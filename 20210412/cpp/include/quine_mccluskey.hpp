@@ -0,0 +1,57 @@
+// Quine-McCluskey con cubos de bits: versión nativa de
+// lib/boolean_logic.py::_quine_mccluskey.
+//
+// Un cubo (implicante) es un par de palabras de 64 bits: `mask` marca las
+// variables presentes y `value` su valor (a 0 en las posiciones
+// indiferentes).  La variable 0 es el bit más significativo del patrón, como
+// en Python: el mintérmino 6 con 3 variables es "110".
+//
+// El algoritmo es el de Python nivel a nivel (cubos con el mismo número de
+// guiones), pero en vez de comparar cada par de grupos adyacentes busca la
+// pareja de cada cubo en una tabla hash: dos cubos se combinan si tienen la
+// misma máscara y sus valores difieren en un solo bit, así que basta probar
+// value | bit para cada bit presente a 0.  Los cubos de un nivel se reparten
+// entre hilos y los del nivel siguiente se deduplican antes de seguir.  El
+// resultado son los mismos patrones '0'/'1'/'-' que devuelve Python, en el
+// mismo orden (sorted).
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace graphs {
+
+struct Cube {
+    std::uint64_t value = 0;
+    std::uint64_t mask = 0;
+
+    bool covers(std::uint64_t minterm) const { return (minterm & mask) == value; }
+    friend bool operator==(const Cube &a, const Cube &b) { return a.value == b.value && a.mask == b.mask; }
+    friend bool operator!=(const Cube &a, const Cube &b) { return !(a == b); }
+};
+
+// Patrón '0'/'1'/'-' de `num_vars` caracteres y su inverso.  pattern_to_cube
+// lanza std::invalid_argument con otros caracteres o más de 64.
+std::string cube_to_pattern(const Cube &cube, unsigned num_vars);
+Cube pattern_to_cube(const std::string &pattern);
+
+struct QmOptions {
+    // Hilos de trabajo (0 = parallel::default_threads()).
+    unsigned threads = 0;
+};
+
+// Implicantes primos de minterms ∪ dont_cares que cubren algún mintérmino,
+// en el orden de sus patrones.  Lanza std::invalid_argument si num_vars no
+// está en [1, 64] o algún término no cabe en num_vars bits.
+std::vector<Cube> prime_implicants(const std::vector<std::uint64_t> &minterms,
+                                   const std::vector<std::uint64_t> &dont_cares, unsigned num_vars,
+                                   const QmOptions &options = {});
+
+// Lo mismo como patrones: igual que sorted(_quine_mccluskey(...)) en Python.
+std::vector<std::string> quine_mccluskey(const std::vector<std::uint64_t> &minterms,
+                                         const std::vector<std::uint64_t> &dont_cares, unsigned num_vars,
+                                         const QmOptions &options = {});
+
+} // namespace graphs
@@ -0,0 +1,76 @@
+// Reordenación de vértices para mejorar la localidad de memoria.
+//
+// Con identificadores arbitrarios, cada relajación de Dijkstra lee dist[v] de
+// una línea de caché distinta.  Estas pasadas calculan una permutación que
+// coloca juntos los vértices vecinos y reescriben el CSR con los nuevos
+// identificadores.  Todas trabajan sobre la estructura no dirigida subyacente
+// (aristas salientes y entrantes) y procesan cada componente por separado.
+//
+//   * Cuthill–McKee inverso (RCM): BFS desde un vértice pseudo-periférico
+//     visitando los vecinos por grado creciente; minimiza el ancho de banda.
+//   * BFS / DFS: recorridos simples desde el vértice de menor índice de cada
+//     componente (o desde `root` si se indica).
+//   * Particiones: bisección recursiva por niveles de BFS hasta bloques de
+//     `block_size` vértices, que quedan contiguos en el nuevo orden.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "graph.hpp"
+
+namespace graphs {
+
+// Permutación de vértices con sus dos sentidos:
+//   new_of_old[v] = nuevo identificador del vértice original v
+//   old_of_new[i] = vértice original que ocupa la posición i
+struct Permutation {
+    std::vector<int> new_of_old;
+    std::vector<int> old_of_new;
+
+    int size() const { return static_cast<int>(new_of_old.size()); }
+    int to_new(int old_id) const { return new_of_old[old_id]; }
+    int to_old(int new_id) const { return old_of_new[new_id]; }
+
+    // Reordena valores indexados por vértice original al nuevo orden.
+    template <class T>
+    std::vector<T> to_new_order(const std::vector<T> &by_old) const {
+        std::vector<T> out(by_old.size());
+        for (std::size_t i = 0; i < old_of_new.size(); ++i) {
+            out[i] = by_old[old_of_new[i]];
+        }
+        return out;
+    }
+
+    // Devuelve al orden original valores indexados por el nuevo identificador
+    // (p. ej. el vector de distancias de una consulta sobre el grafo permutado).
+    template <class T>
+    std::vector<T> to_old_order(const std::vector<T> &by_new) const {
+        std::vector<T> out(by_new.size());
+        for (std::size_t i = 0; i < old_of_new.size(); ++i) {
+            out[old_of_new[i]] = by_new[i];
+        }
+        return out;
+    }
+
+    // Construye la permutación a partir de la lista old_of_new.  Lanza
+    // std::invalid_argument si no es una permutación de [0, n).
+    static Permutation from_order(std::vector<int> old_of_new);
+};
+
+Permutation rcm_order(const Graph &g);
+Permutation bfs_order(const Graph &g, int root = -1);
+Permutation dfs_order(const Graph &g, int root = -1);
+Permutation partition_order(const Graph &g, int block_size = 256);
+
+// Reescribe el grafo con los nuevos identificadores.  Las aristas de cada
+// vértice quedan ordenadas por destino, por lo que los índices CSR de las
+// aristas no se conservan.
+Graph permute(const Graph &g, const Permutation &perm);
+
+// Ancho de banda max |u - v| sobre las aristas (u,v), útil para
+// comparar ordenaciones.
+int bandwidth(const Graph &g);
+
+} // namespace graphs
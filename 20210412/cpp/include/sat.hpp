@@ -0,0 +1,146 @@
+// Resolvedor SAT CDCL compacto.
+//
+// Aprendizaje de cláusulas por conflicto con el esquema habitual:
+//
+//   * propagación unitaria con dos literales vigilados por cláusula (y un
+//     literal "bloqueante" en cada entrada de la lista de vigilancia para no
+//     tocar la cláusula si ya está satisfecha);
+//   * análisis 1-UIP con minimización local de la cláusula aprendida;
+//   * heurística de decisión VSIDS (montículo por actividad con decaimiento)
+//     y memoria de la última polaridad de cada variable;
+//   * reinicios según la secuencia de Luby;
+//   * borrado periódico de la mitad menos activa de las cláusulas
+//     aprendidas, salvo las que son razón de una asignación o tienen LBD
+//     (niveles de decisión distintos) <= 2.
+//
+// Es incremental: se pueden añadir cláusulas entre llamadas a solve() y
+// resolver bajo suposiciones (literales fijados sólo para esa llamada).  Lo
+// aprendido se conserva entre llamadas, que es lo que hace barato
+// comprobar muchas propiedades sobre una misma codificación.
+//
+// Los literales siguen el convenio DIMACS: +v y -v para la variable v >= 1.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace graphs {
+
+enum class SatResult { Sat, Unsat, Unknown };
+
+struct SatStats {
+    std::uint64_t decisions = 0;
+    std::uint64_t propagations = 0;
+    std::uint64_t conflicts = 0;
+    std::uint64_t restarts = 0;
+    std::uint64_t learned = 0;
+    std::uint64_t deleted = 0;
+};
+
+class SatSolver {
+public:
+    explicit SatSolver(unsigned vars = 0);
+
+    unsigned vars() const { return static_cast<unsigned>(activity_.size()); }
+    // Crea una variable y la devuelve (como literal positivo).
+    int new_var();
+
+    // Añade una cláusula; las variables que aún no existen se crean.
+    // Devuelve false si la fórmula ya es insatisfacible (sin suposiciones).
+    // Lanza std::invalid_argument con el literal 0.
+    bool add_clause(const std::vector<int> &literals);
+
+    // Busca un modelo que además haga ciertas las suposiciones.  Con
+    // `conflict_limit` > 0 devuelve Unknown si se alcanzan tantos conflictos
+    // en esta llamada.
+    SatResult solve(const std::vector<int> &assumptions = {}, std::uint64_t conflict_limit = 0);
+
+    // Tras Sat: valor del literal en el modelo.  Lanza std::out_of_range.
+    bool value(int literal) const;
+    // Tras Unsat: suposiciones que bastan para la contradicción (vacío si la
+    // fórmula es insatisfacible por sí sola).
+    const std::vector<int> &failed_assumptions() const { return failed_; }
+
+    bool okay() const { return ok_; }
+    std::size_t clauses() const { return problem_clauses_; }
+    std::size_t learned_clauses() const { return learned_count_; }
+    const SatStats &stats() const { return stats_; }
+
+private:
+    using Lit = std::uint32_t;
+    static constexpr std::uint32_t kNoReason = ~std::uint32_t(0);
+
+    struct Clause {
+        std::vector<Lit> lits;
+        double activity = 0;
+        unsigned lbd = 0;
+        bool learned = false;
+        bool deleted = false;
+    };
+    struct Watch {
+        std::uint32_t clause;
+        Lit blocker;
+    };
+
+    std::uint8_t lit_value(Lit l) const;
+    unsigned level(std::uint32_t v) const { return level_[v]; }
+    unsigned decision_level() const { return static_cast<unsigned>(trail_lim_.size()); }
+    Lit encode(int literal);
+
+    void grow(std::uint32_t vars);
+    std::uint32_t attach(std::vector<Lit> lits, bool learned);
+    void assign(Lit l, std::uint32_t reason);
+    std::uint32_t propagate();
+    void analyze(std::uint32_t conflict, std::vector<Lit> &learnt, unsigned &back_level);
+    void analyze_final(Lit p);
+    void backtrack(unsigned level);
+    bool locked(std::uint32_t c) const;
+    void reduce_learned();
+    void collect_garbage();
+
+    void bump_var(std::uint32_t v);
+    void bump_clause(Clause &c);
+    void heap_insert(std::uint32_t v);
+    std::uint32_t heap_pop();
+    void heap_up(std::size_t i);
+    void heap_down(std::size_t i);
+
+    bool ok_ = true;
+    std::vector<Clause> clauses_;
+    std::size_t problem_clauses_ = 0;
+    std::size_t learned_count_ = 0;
+    std::size_t deleted_slots_ = 0;
+    std::vector<std::vector<Watch>> watches_;
+
+    std::vector<std::uint8_t> assigns_;
+    std::vector<std::uint8_t> polarity_;
+    std::vector<unsigned> level_;
+    std::vector<std::uint32_t> reason_;
+    std::vector<Lit> trail_;
+    std::vector<std::size_t> trail_lim_;
+    std::size_t qhead_ = 0;
+
+    std::vector<double> activity_;
+    double var_inc_ = 1;
+    double clause_inc_ = 1;
+    std::vector<std::uint32_t> heap_;
+    std::vector<std::int64_t> heap_pos_;
+
+    std::vector<std::uint8_t> seen_;
+    std::vector<std::uint8_t> model_;
+    std::vector<int> failed_;
+    double max_learned_ = 0;
+    SatStats stats_;
+};
+
+// Formato DIMACS CNF ("p cnf V C", cláusulas terminadas en 0, comentarios
+// con "c").  Lanza std::runtime_error con el número de línea si el fichero
+// no es válido.
+SatSolver parse_dimacs(std::istream &in);
+SatSolver load_dimacs(const std::string &path);
+
+} // namespace graphs
@@ -0,0 +1,61 @@
+// Equivalencia combinacional por SAT.
+//
+// La simulación exhaustiva de logic_sim.hpp deja de ser viable hacia las 30
+// o 40 entradas.  Aquí los dos circuitos se codifican una sola vez con
+// Tseitin sobre las mismas variables de entrada (NOT y BUF no crean
+// variables: reutilizan el literal de su operando, con el signo cambiado en
+// el caso de NOT; NAND, NOR y XNOR son la negación de AND, OR y XOR).  Cada
+// par de salidas recibe una variable d_i con d_i -> (a_i XOR b_i), y cada
+// par se comprueba con solve({d_i}) sobre el mismo resolvedor (sat.hpp):
+// UNSAT significa que las salidas son iguales para toda entrada y SAT da un
+// contraejemplo.  Las cláusulas aprendidas para un par se reutilizan en los
+// siguientes, y cada equivalencia ya demostrada se añade como cláusulas
+// a_i <-> b_i.  Las salidas que resultan ser el mismo literal se dan por
+// equivalentes sin llamar al resolvedor.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "logic_sim.hpp"
+#include "sat.hpp"
+
+namespace graphs {
+
+// Añade a `solver` las cláusulas de Tseitin de `circuit` y devuelve el
+// literal de cada nodo.  Si `input_literals` no está vacío, la entrada i usa
+// ese literal (para compartir entradas entre circuitos); si no, se crean
+// variables nuevas.  Lanza std::invalid_argument si el tamaño no coincide
+// con el número de entradas.
+std::vector<int> encode_tseitin(const Circuit &circuit, SatSolver &solver,
+                                const std::vector<int> &input_literals = {});
+
+struct SatEquivalenceOptions {
+    // Conflictos por par de salidas (0 = sin límite); al agotarse el par
+    // queda como Unknown.
+    std::uint64_t conflict_limit = 0;
+    // Con false se comprueban todos los pares aunque alguno difiera.
+    bool stop_at_first = true;
+};
+
+struct SatEquivalenceResult {
+    // Sólo si todos los pares dan Unsat.  Con algún Unknown y ningún Sat es
+    // false pero sin contraejemplo (no se sabe).
+    bool equivalent = true;
+    // Resultado por par de salidas (Unsat = iguales); los pares que no se
+    // llegaron a comprobar quedan como Unknown.
+    std::vector<SatResult> outputs;
+    // Primer par distinto y valores de las entradas que lo muestran.
+    unsigned output = 0;
+    std::vector<bool> counterexample;
+    SatStats stats;
+};
+
+// Lanza std::invalid_argument si los circuitos difieren en número de
+// entradas o de salidas.
+SatEquivalenceResult check_equivalence_sat(const Circuit &a, const Circuit &b,
+                                           const SatEquivalenceOptions &options = {});
+
+} // namespace graphs
@@ -0,0 +1,59 @@
+// Componentes fuertemente conexas, condensación y detección de ciclos.
+//
+// Todos los recorridos usan pilas explícitas, de modo que grafos de estados
+// con millones de vértices no agotan la pila del programa.
+//
+//   * Tarjan: una sola pasada DFS, O(V + E).
+//   * Kosaraju: postorden en el grafo y segunda pasada en el traspuesto.
+//   * ForwardBackward: variante paralela (Fleischer–Hendrickson–Pinar).  Se
+//     recortan primero en paralelo los vértices sin entradas o sin salidas
+//     (componentes triviales); después, para un pivote, la intersección de
+//     sus alcanzables hacia delante y hacia atrás es su componente y el resto
+//     se divide en tres subproblemas independientes.  Los subproblemas
+//     grandes usan BFS paralelos; los pequeños se reparten entre hilos y se
+//     resuelven con Tarjan restringido.
+//
+// En todos los casos las componentes se numeran en orden topológico de la
+// condensación: toda arista entre componentes va de un índice menor a uno mayor.
+
+#pragma once
+
+#include <vector>
+
+#include "graph.hpp"
+
+namespace graphs {
+
+enum class SccMethod {
+    Tarjan,
+    Kosaraju,
+    ForwardBackward,
+};
+
+struct SccResult {
+    // component[v] en [0, count).
+    std::vector<int> component;
+    int count = 0;
+
+    // Número de vértices de cada componente.
+    std::vector<int> sizes() const;
+};
+
+SccResult strongly_connected_components(const Graph &g, SccMethod method = SccMethod::Tarjan,
+                                        unsigned threads = 0);
+
+// Grafo de componentes: una arista c1->c2 (c1 != c2) si alguna arista del
+// grafo une ambas componentes, con el menor de sus pesos.  Es un DAG.
+Graph condensation(const Graph &g, const SccResult &scc, unsigned threads = 0);
+
+// Verdadero si hay algún ciclo (incluidos bucles u->u).  Con source >= 0
+// sólo cuentan los ciclos alcanzables desde source, como en
+// fsm_utils.has_cycle.
+bool has_cycle(const Graph &g, int source = -1);
+
+// Un ciclo testigo en el mismo sentido que has_cycle, con sus vértices en
+// orden de recorrido (la arista de cierre va del último al primero); vacío
+// si no hay ciclo.
+std::vector<int> find_cycle(const Graph &g, int source = -1);
+
+} // namespace graphs
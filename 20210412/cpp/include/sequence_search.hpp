@@ -0,0 +1,172 @@
+// Generación de secuencias de eventos por backtracking con poda por
+// invariantes: versión nativa de
+// alg/backtracking_sequence_validator.py::generate_sequences.
+//
+// El autómata es una tabla de transiciones indexada por enteros
+// (estado * eventos + evento, -1 = sin transición).  Los invariantes son de
+// dos tipos:
+//
+//   * De paso: una Condition sobre (from, event, to) escrita con
+//     combinadores C++ o con un pequeño lenguaje de texto, p. ej.
+//
+//         event == reset -> from == SAFE
+//
+//     (operadores !, &&, ||, -> y paréntesis; átomos from/to/event ==/!=
+//     nombre, true y false).  Se compilan una vez en una máscara de
+//     transiciones permitidas, de modo que la búsqueda sólo consulta tablas.
+//   * De camino: un PathPredicate de C++ sobre el prefijo completo
+//     (estados y eventos), como invariant_ok en Python.  Se evalúa en cada
+//     nodo tras los de paso.
+//
+// Memoización (estado, profundidad): antes de buscar se cuenta hacia atrás
+// cuántas continuaciones válidas (según la tabla y los invariantes de paso)
+// quedan desde cada estado a cada profundidad.  Una rama cuyo par
+// (estado, profundidad) no tiene continuaciones se corta sin explorarla, así
+// que el coste de la enumeración es proporcional a las secuencias
+// devueltas.  La poda es exacta para los invariantes de paso y segura con
+// los de camino (sólo restringen más).  Con sólo invariantes de paso,
+// count() responde con la misma tabla sin enumerar nada.
+//
+// La búsqueda se reparte entre hilos por robo de trabajo: cada hilo explora
+// su prefijo en profundidad y, si hay hilos ociosos, cede a su cola los
+// hermanos pendientes del nivel más superficial; los ociosos roban de las
+// colas ajenas la tarea más antigua (el subárbol mayor).  Las secuencias se
+// devuelven en el mismo orden que el DFS de Python (orden lexicográfico de
+// los índices de evento), con cualquier número de hilos.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace graphs {
+
+class TransitionTable {
+public:
+    static constexpr int kNone = -1;
+
+    TransitionTable(int states, int events);
+    // Tabla con nombres (los índices siguen el orden de los vectores).
+    TransitionTable(std::vector<std::string> states, std::vector<std::string> events);
+
+    int num_states() const { return states_; }
+    int num_events() const { return events_; }
+
+    // Lanza std::out_of_range si algún índice no es válido.
+    void set(int from, int event, int to);
+    void set(const std::string &from, const std::string &event, const std::string &to);
+    int next(int from, int event) const { return next_[static_cast<std::size_t>(from) * events_ + event]; }
+
+    // Índice de un nombre; lanza std::invalid_argument si no existe.
+    int state_index(const std::string &name) const;
+    int event_index(const std::string &name) const;
+    const std::vector<std::string> &state_names() const { return state_names_; }
+    const std::vector<std::string> &event_names() const { return event_names_; }
+
+private:
+    int states_;
+    int events_;
+    std::vector<int> next_;
+    std::vector<std::string> state_names_;
+    std::vector<std::string> event_names_;
+};
+
+// Predicado sobre un paso (from, event, to).  Valor inmutable: combinar
+// condiciones comparte los subárboles.
+class Condition {
+public:
+    Condition();  // siempre verdadera
+
+    static Condition constant(bool value);
+    static Condition from(int state);
+    static Condition to(int state);
+    static Condition event(int event);
+
+    friend Condition operator!(const Condition &a);
+    friend Condition operator&&(const Condition &a, const Condition &b);
+    friend Condition operator||(const Condition &a, const Condition &b);
+    // a -> b
+    friend Condition implies(const Condition &a, const Condition &b);
+
+    bool operator()(int from, int event, int to) const;
+
+    struct Node;
+
+private:
+    explicit Condition(std::shared_ptr<const Node> node) : node_(std::move(node)) {}
+    std::shared_ptr<const Node> node_;
+};
+
+// Traduce el lenguaje de texto; los nombres se buscan en la tabla y también
+// se aceptan índices numéricos.  Lanza std::invalid_argument con la posición
+// del error.
+Condition parse_condition(const std::string &text, const TransitionTable &table);
+
+// Prefijo actual: states[0..depth] y events[0..depth).
+struct SequencePath {
+    const int *states;
+    const int *events;
+    int depth;
+};
+
+using PathPredicate = std::function<bool(const SequencePath &)>;
+
+struct SequenceOptions {
+    // Máximo de secuencias devueltas (0 = todas); son las primeras en orden DFS.
+    std::size_t limit = 0;
+    // Hilos de trabajo (0 = parallel::default_threads()).
+    unsigned threads = 0;
+    // Poda por la tabla (estado, profundidad); desactivarla sólo sirve para medir.
+    bool memoize = true;
+};
+
+struct SequenceResult {
+    // Secuencias de índices de evento, en orden DFS.
+    std::vector<std::vector<int>> sequences;
+    // Nodos generados (pasos permitidos por la tabla y los invariantes de paso).
+    std::size_t nodes = 0;
+    // Ramas cortadas por la memoización.
+    std::size_t pruned = 0;
+    // Tareas robadas entre hilos.
+    std::size_t steals = 0;
+};
+
+class SequenceGenerator {
+public:
+    SequenceGenerator(TransitionTable table, int start);
+
+    const TransitionTable &table() const { return table_; }
+
+    // Añade invariantes (se combinan con "y").
+    void require(const Condition &step);
+    void require(const std::string &step);
+    void require_path(PathPredicate path);
+
+    // Secuencias de exactamente `length` eventos que respetan los invariantes
+    // en cada prefijo.  Lanza std::invalid_argument si length < 0.  Los
+    // invariantes de camino se llaman desde varios hilos a la vez.
+    SequenceResult generate(int length, const SequenceOptions &options = {}) const;
+
+    // Número de secuencias válidas de longitud `length`.  Satura en
+    // UINT64_MAX (y pone *overflow a verdadero).  Con invariantes de camino
+    // enumera; si no, es inmediato.
+    std::uint64_t count(int length, bool *overflow = nullptr, unsigned threads = 0) const;
+
+private:
+    // Transición permitida por la tabla y los invariantes de paso, o -1.
+    int step(int from, int event) const { return allowed_[static_cast<std::size_t>(from) * table_.num_events() + event]; }
+    // completions[d * S + s]: continuaciones válidas desde s con d eventos ya dados.
+    std::vector<std::uint64_t> completions(int length, bool &overflow) const;
+
+    TransitionTable table_;
+    int start_;
+    std::vector<int> allowed_;
+    std::vector<PathPredicate> path_;
+};
+
+} // namespace graphs
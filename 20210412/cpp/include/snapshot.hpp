@@ -0,0 +1,76 @@
+// Instantáneas binarias de grafos CSR con carga por mapeo de memoria.
+//
+// Formato (orden de bytes del anfitrión, comprobado al cargar):
+//
+//   cabecera fija | desplazamientos | destinos (int32) | pesos (double) | nombres
+//
+// Cada sección empieza en un múltiplo de 64 bytes, de modo que al mapear el
+// archivo los arrays quedan alineados y el grafo puede apuntar directamente a
+// ellos sin copiarlos.  La cabecera guarda el número de vértices y aristas,
+// el indicador de pesos negativos (con validate = false no hace falta
+// recorrer los pesos al cargar) y, opcionalmente, un CRC-32 por sección.
+//
+// Los desplazamientos pueden guardarse en bruto (64 bits, sin copia al
+// cargar), en 32 bits o como grados codificados en varint (LEB128).  Los dos
+// últimos ocupan menos en disco pero se decodifican a memoria propia al
+// cargar; destinos y pesos siguen sin copiarse.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "graph.hpp"
+
+namespace graphs {
+
+enum class OffsetEncoding : std::uint32_t {
+    Raw64 = 0,
+    Raw32 = 1,
+    VarintDegrees = 2,
+};
+
+struct SnapshotOptions {
+    OffsetEncoding offsets = OffsetEncoding::Raw64;
+    // Calcula y guarda un CRC-32 por sección.
+    bool checksums = true;
+};
+
+struct SnapshotLoadOptions {
+    // Recalcula los CRC de las secciones (lee el archivo completo).
+    bool verify_checksums = false;
+    // Revalida los arrays como el constructor de Graph (desplazamientos
+    // monótonos, destinos en rango, pesos no NaN; recorre todas las
+    // aristas).  Desactivarla construye el grafo con Graph::trusted_view y
+    // sólo es seguro con archivos de confianza: un archivo truncado o dañado
+    // produce entonces lecturas fuera de rango en los algoritmos.
+    bool validate = true;
+    // Decodifica la tabla de nombres de vértices, si existe.
+    bool load_names = true;
+};
+
+struct Snapshot {
+    Graph graph;
+    std::vector<std::string> names;
+    // Verdadero si los desplazamientos se usan directamente desde el mapeo.
+    bool zero_copy_offsets = false;
+};
+
+// Escribe el grafo (y opcionalmente los nombres de sus vértices) en `path`.
+// Lanza std::runtime_error ante errores de escritura y std::invalid_argument
+// si la codificación elegida no admite el tamaño del grafo.
+void write_snapshot(const std::string &path, const Graph &g, const SnapshotOptions &options = {},
+                    const std::vector<std::string> *names = nullptr);
+
+// Mapea el archivo en memoria y construye el grafo sobre él.  El mapeo se
+// libera cuando desaparece la última copia del grafo.  Lanza
+// std::runtime_error si el archivo no es una instantánea válida, si los
+// arrays no forman un CSR coherente (salvo con validate = false) o si falla
+// una comprobación solicitada.
+Snapshot load_snapshot(const std::string &path, const SnapshotLoadOptions &options = {});
+
+// CRC-32 (polinomio IEEE 802.3) de un bloque de bytes, encadenable.
+std::uint32_t crc32(const void *data, std::size_t size, std::uint32_t crc = 0);
+
+} // namespace graphs
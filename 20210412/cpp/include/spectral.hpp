@@ -0,0 +1,106 @@
+// Laplaciana dispersa, vector de Fiedler y bisección espectral.
+//
+// La Laplaciana se aplica como operador sobre el CSR, sin formar la matriz
+// densa.  Igual que graph_algorithms.laplacian_matrix, se trabaja sobre el
+// grafo no dirigido subyacente con W = A + A^T (los bucles no cuentan):
+//
+//   * combinatoria: L = D - W
+//   * normalizada:  L = I - D^{-1/2} W D^{-1/2}  (filas nulas en vértices aislados)
+//
+// El núcleo conocido (vector constante, o D^{1/2}·1 en la normalizada) se
+// deflaciona y el par de Fiedler se obtiene con LOBPCG por bloques
+// precondicionado con la diagonal (Jacobi).  Cada iteración aplica el
+// operador a un bloque de vectores, O(E) por vector, y guarda unos pocos
+// vectores de tamaño n; nada es O(n^2).
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "graph.hpp"
+
+namespace graphs {
+
+enum class LaplacianKind {
+    Combinatorial,
+    Normalized,
+};
+
+class LaplacianOperator {
+public:
+    // Lanza std::invalid_argument si el grafo tiene pesos negativos.
+    explicit LaplacianOperator(const Graph &g, LaplacianKind kind = LaplacianKind::Combinatorial,
+                               unsigned threads = 0);
+
+    int size() const { return w_.num_vertices(); }
+    LaplacianKind kind() const { return kind_; }
+
+    // Matriz de pesos simétrica W (sin bucles, aristas repetidas sumadas).
+    const Graph &adjacency() const { return w_; }
+    const std::vector<double> &degrees() const { return degree_; }
+
+    // y = L x.
+    void apply(const std::vector<double> &x, std::vector<double> &y) const;
+    double diagonal(int u) const;
+    // Cota superior del radio espectral (2 max d o 2).
+    double norm_bound() const;
+    // Vector unitario del núcleo conocido.
+    std::vector<double> null_vector() const;
+
+    // Operador sobre un W ya simétrico y sin bucles (p. ej. un subgrafo).
+    static LaplacianOperator from_symmetric(Graph w, LaplacianKind kind, unsigned threads = 0);
+
+private:
+    LaplacianOperator() = default;
+    void init(Graph w, LaplacianKind kind, unsigned threads);
+
+    Graph w_;
+    LaplacianKind kind_ = LaplacianKind::Combinatorial;
+    unsigned threads_ = 0;
+    std::vector<double> degree_;
+    std::vector<double> inv_sqrt_degree_;
+};
+
+struct FiedlerOptions {
+    // Residuo relativo ||L x - theta x|| / norm_bound().
+    double tolerance = 1e-8;
+    int max_iter = 1000;
+    // Vectores del bloque de LOBPCG; más de uno ayuda con autovalores próximos.
+    int block_size = 2;
+    std::uint32_t seed = 63;
+    unsigned threads = 0;
+};
+
+struct FiedlerResult {
+    double value = 0.0;
+    std::vector<double> vector;
+    int iterations = 0;
+    double residual = 0.0;
+    bool converged = false;
+};
+
+// Segundo autovalor más pequeño de L y su vector propio (unitario).  Con
+// menos de dos vértices devuelve 0 y un vector vacío.
+FiedlerResult fiedler_vector(const LaplacianOperator &L, const FiedlerOptions &options = {});
+
+// Valor de Fiedler de la Laplaciana combinatoria, como
+// graph_algorithms.fiedler_value.
+double fiedler_value(const Graph &g, const FiedlerOptions &options = {});
+
+struct SpectralPartition {
+    // part[v] en [0, parts).
+    std::vector<int> part;
+    int parts = 0;
+    // Peso total de las aristas de W entre partes distintas.
+    double cut_weight = 0.0;
+};
+
+// Bisección espectral recursiva en `parts` partes de tamaño equilibrado: cada
+// parte se divide por el cuantil de su vector de Fiedler (proporcional al
+// número de partes de cada lado) y se repite sobre los subgrafos inducidos.
+SpectralPartition spectral_partition(const Graph &g, int parts,
+                                     LaplacianKind kind = LaplacianKind::Combinatorial,
+                                     const FiedlerOptions &options = {});
+
+} // namespace graphs
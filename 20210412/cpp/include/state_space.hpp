@@ -0,0 +1,223 @@
+// Exploración explícita de espacios de estados (alcanzabilidad de FSM).
+//
+// Es la versión nativa de fsm_utils.bfs_reachability para máquinas de
+// estados cuyo espacio alcanzable llega a 10^8 estados (p. ej. el modelo de
+// ciclo de scan de plc/twincat/src/FSMParidad.TcPOU con sus entradas).  El
+// sistema se describe con una función de sucesores (TransitionSystem) sobre
+// estados codificados como vectores de bits de ancho fijo: `state_words()`
+// palabras de 64 bits, con los bits sobrantes a cero (los estados se
+// comparan palabra a palabra).  BitLayout ayuda a repartir los campos.
+//
+// El recorrido es un BFS por niveles: los estados de la frontera se
+// reparten entre hilos, cada hilo genera sus sucesores y los inserta en un
+// conjunto de visitados común dividido en particiones con cerrojo propio.
+// El conjunto puede ser:
+//
+//   * Exact: direccionamiento abierto con los estados completos y el
+//     predecesor de cada uno (exacto; ~16 bytes por estado + sus palabras).
+//   * HashCompaction: sólo una huella de 64 bits por estado y la de su
+//     predecesor (16 bytes por estado).  Dos estados con la misma huella se
+//     confunden y el segundo no se explora; la probabilidad de alguna
+//     omisión es ~n^2 / 2^65.
+//   * Bitstate: supertraza de Holzmann, un mapa de 2^bitstate_log2 bits con
+//     k funciones hash.  Cabe en memoria fija y cualquier número de estados
+//     pero puede omitir una fracción (véase omission_estimate).
+//
+// Ante un estado que viola el invariante se devuelve un contraejemplo de
+// longitud mínima: la cadena de predecesores (Exact), la cadena de huellas
+// reproducida desde el estado inicial (HashCompaction) o, en Bitstate, una
+// segunda exploración con compactación limitada a la profundidad del error.
+// Las acciones de la traza son las etiquetas con que la función de
+// sucesores emitió cada estado.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "graph.hpp"
+
+namespace graphs {
+
+using StateWord = std::uint64_t;
+using State = std::vector<StateWord>;
+
+// Campo de bits [offset, offset + width) dentro de un estado.
+struct BitField {
+    unsigned offset = 0;
+    unsigned width = 0;
+};
+
+// Reparto de campos consecutivos en las palabras de un estado.  Un campo
+// puede cruzar el límite entre dos palabras.
+class BitLayout {
+public:
+    // Añade un campo de `width` bits (1..64).  Lanza std::invalid_argument
+    // con otro ancho.
+    BitField add(unsigned width);
+
+    unsigned bits() const { return bits_; }
+    std::size_t words() const { return (bits_ + 63) / 64; }
+
+    static std::uint64_t get(const StateWord *s, BitField f) {
+        const unsigned w = f.offset / 64, b = f.offset % 64;
+        std::uint64_t v = s[w] >> b;
+        if (b + f.width > 64) {
+            v |= s[w + 1] << (64 - b);
+        }
+        return f.width == 64 ? v : v & ((std::uint64_t(1) << f.width) - 1);
+    }
+    static void set(StateWord *s, BitField f, std::uint64_t value) {
+        const std::uint64_t mask = f.width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << f.width) - 1;
+        value &= mask;
+        const unsigned w = f.offset / 64, b = f.offset % 64;
+        s[w] = (s[w] & ~(mask << b)) | (value << b);
+        if (b + f.width > 64) {
+            const unsigned spill = 64 - b;
+            s[w + 1] = (s[w + 1] & ~(mask >> spill)) | (value >> spill);
+        }
+    }
+
+private:
+    unsigned bits_ = 0;
+};
+
+// Estados emitidos por una función de sucesores.  Cada push() reserva un
+// estado a cero que el llamante rellena; `action` etiqueta la transición.
+class SuccessorSink {
+public:
+    explicit SuccessorSink(std::size_t words = 0) : words_(words) {}
+
+    StateWord *push(int action = -1);
+    // Copia de `from` lista para modificar.
+    StateWord *push_copy(const StateWord *from, int action = -1);
+
+    std::size_t size() const { return actions_.size(); }
+    std::size_t words() const { return words_; }
+    const StateWord *state(std::size_t i) const { return data_.data() + i * words_; }
+    int action(std::size_t i) const { return actions_[i]; }
+    void clear() {
+        data_.clear();
+        actions_.clear();
+    }
+
+private:
+    std::size_t words_;
+    std::vector<StateWord> data_;
+    std::vector<int> actions_;
+};
+
+// Sistema de transiciones.  successors() se llama a la vez desde varios
+// hilos con sumideros distintos: no debe modificar estado compartido.
+class TransitionSystem {
+public:
+    virtual ~TransitionSystem() = default;
+    virtual std::size_t state_words() const = 0;
+    virtual void initial_states(SuccessorSink &out) const = 0;
+    virtual void successors(const StateWord *state, SuccessorSink &out) const = 0;
+};
+
+// Sistema a partir de funciones (p. ej. lambdas en pruebas y herramientas).
+class FunctionSystem : public TransitionSystem {
+public:
+    using Generator = std::function<void(SuccessorSink &)>;
+    using Successors = std::function<void(const StateWord *, SuccessorSink &)>;
+
+    FunctionSystem(std::size_t words, Generator initial, Successors successors)
+        : words_(words), initial_(std::move(initial)), successors_(std::move(successors)) {}
+
+    std::size_t state_words() const override { return words_; }
+    void initial_states(SuccessorSink &out) const override { initial_(out); }
+    void successors(const StateWord *state, SuccessorSink &out) const override { successors_(state, out); }
+
+private:
+    std::size_t words_;
+    Generator initial_;
+    Successors successors_;
+};
+
+// Grafo explícito como sistema de transiciones: el estado es el vértice y la
+// acción el índice CSR de la arista (equivale a bfs_reachability en Python).
+class GraphSystem : public TransitionSystem {
+public:
+    GraphSystem(Graph g, std::vector<int> initial) : g_(std::move(g)), initial_(std::move(initial)) {}
+
+    std::size_t state_words() const override { return 1; }
+    void initial_states(SuccessorSink &out) const override;
+    void successors(const StateWord *state, SuccessorSink &out) const override;
+
+private:
+    Graph g_;
+    std::vector<int> initial_;
+};
+
+enum class VisitedMode {
+    Exact,
+    HashCompaction,
+    Bitstate,
+};
+
+// Invariante: verdadero si el estado es correcto.  Se evalúa desde varios
+// hilos a la vez.
+using StatePredicate = std::function<bool(const StateWord *)>;
+
+struct ExploreOptions {
+    VisitedMode mode = VisitedMode::Exact;
+    // Hilos de trabajo (0 = parallel::default_threads()).
+    unsigned threads = 0;
+    // Límites (0 / -1 = sin límite); al alcanzarlos complete = false.
+    std::size_t max_states = 0;
+    int max_depth = -1;
+    // Bitstate: 2^bitstate_log2 bits y bitstate_hashes funciones hash.
+    unsigned bitstate_log2 = 30;
+    unsigned bitstate_hashes = 3;
+    // Reconstruye el contraejemplo al encontrar una violación.
+    bool trace = true;
+};
+
+// Secuencia de estados desde un estado inicial; actions[i] es la etiqueta de
+// la transición states[i] -> states[i + 1].
+struct Trace {
+    std::vector<State> states;
+    std::vector<int> actions;
+
+    bool empty() const { return states.empty(); }
+};
+
+struct ExploreResult {
+    // Estados distintos almacenados y sucesores generados.
+    std::size_t states = 0;
+    std::size_t transitions = 0;
+    // Niveles BFS expandidos (profundidad máxima alcanzada).
+    int depth = 0;
+    // Se exploró todo el espacio alcanzable (sin límites ni violación).
+    bool complete = false;
+    bool violated = false;
+    // Profundidad del estado que viola el invariante (-1 si no hay).
+    int violation_depth = -1;
+    Trace counterexample;
+    // Memoria del conjunto de visitados en bytes.
+    std::size_t memory_bytes = 0;
+    // Cota aproximada de la probabilidad de haber omitido estados por
+    // colisiones de hash (0 en modo Exact).
+    double omission_estimate = 0.0;
+};
+
+// Explora los estados alcanzables comprobando `invariant` en cada uno (vacío
+// = sin invariante) y se detiene en la primera profundidad con una violación.
+ExploreResult explore(const TransitionSystem &system, const StatePredicate &invariant,
+                      const ExploreOptions &options = {});
+
+// Busca un estado que cumpla `target`; el contraejemplo es el camino hasta él.
+inline ExploreResult find_reachable(const TransitionSystem &system, const StatePredicate &target,
+                                    const ExploreOptions &options = {}) {
+    return explore(system, [&](const StateWord *s) { return !target(s); }, options);
+}
+
+// Hash de 64 bits de un estado (el usado por los conjuntos de visitados).
+std::uint64_t hash_state(const StateWord *state, std::size_t words, std::uint64_t seed = 0);
+
+} // namespace graphs
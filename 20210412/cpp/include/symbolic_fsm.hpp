@@ -0,0 +1,113 @@
+// Alcanzabilidad simbólica de máquinas de estados con BDD.
+//
+// Complemento de state_space.hpp para espacios de estados que no caben
+// enumerados: los conjuntos de estados y la relación de transición son BDD
+// (bdd.hpp).  Cada bit de estado tiene una variable actual x_i y una
+// siguiente x'_i, intercaladas en el orden inicial; las entradas del scan son
+// variables aparte que se cuantifican en cada paso.
+//
+// La relación es una conjunción de particiones (una por bit con set_next,
+// o restricciones arbitrarias con add_constraint) que nunca se construye
+// entera: la imagen aplica las particiones una a una con and_exists y
+// cuantifica cada variable en cuanto ninguna partición posterior la usa
+// (cuantificación temprana).  La alcanzabilidad itera la imagen de la
+// frontera hasta el punto fijo y guarda los anillos de cada profundidad para
+// reconstruir un contraejemplo de longitud mínima.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "bdd.hpp"
+
+namespace graphs {
+
+class SymbolicFsm {
+public:
+    // Crea 2 * state_bits + input_bits variables en `manager`, que debe
+    // sobrevivir a la máquina.
+    SymbolicFsm(BddManager &manager, unsigned state_bits, unsigned input_bits = 0);
+
+    BddManager &manager() const { return *manager_; }
+    unsigned state_bits() const { return static_cast<unsigned>(current_.size()); }
+    unsigned input_bits() const { return static_cast<unsigned>(inputs_.size()); }
+
+    // Literales de x_i, x'_i y de la entrada j.  Lanzan std::out_of_range.
+    Bdd current(unsigned i) const;
+    Bdd next(unsigned i) const;
+    Bdd input(unsigned j) const;
+
+    // x'_i = f(x, entradas).  Un bit sin función ni restricción queda libre.
+    void set_next(unsigned i, const Bdd &f);
+    // Partición arbitraria de la relación sobre (x, entradas, x').
+    void add_constraint(const Bdd &relation);
+
+    // Sucesores / predecesores de un conjunto de estados (sobre x).
+    Bdd image(const Bdd &states);
+    Bdd preimage(const Bdd &states);
+
+    // Estado concreto (bits de x) como BDD y número de estados de un conjunto.
+    Bdd state(const std::vector<bool> &bits);
+    double count(const Bdd &states) const;
+    // Un estado del conjunto (los bits indiferentes a 0).
+    std::vector<bool> pick_state(const Bdd &states) const;
+    // Entradas que llevan de `from` a `to`; vacío si no hay transición.
+    std::vector<bool> inputs_between(const std::vector<bool> &from, const std::vector<bool> &to);
+
+private:
+    struct Schedule {
+        Bdd before;                // variables que ninguna partición usa
+        std::vector<Bdd> after;    // cuantificables tras cada partición
+    };
+
+    const Schedule &schedule(bool forward);
+    Bdd apply(const Bdd &states, const Schedule &schedule);
+    std::vector<unsigned> swap_map() const;
+
+    BddManager *manager_;
+    std::vector<unsigned> current_, next_, inputs_;
+    std::vector<Bdd> parts_;
+    Schedule forward_, backward_;
+    bool scheduled_ = false;
+};
+
+struct ReachOptions {
+    // Profundidad máxima (-1 = hasta el punto fijo).
+    int max_depth = -1;
+    // Reconstruye el contraejemplo al encontrar un estado malo.
+    bool trace = true;
+};
+
+// Estados (y entradas) de un contraejemplo; inputs[i] lleva de states[i] a
+// states[i + 1].
+struct SymbolicTrace {
+    std::vector<std::vector<bool>> states;
+    std::vector<std::vector<bool>> inputs;
+
+    bool empty() const { return states.empty(); }
+};
+
+struct ReachResult {
+    Bdd reached;
+    // Número de estados alcanzados (double: exacto hasta 2^53).
+    double states = 0;
+    // Profundidad máxima alcanzada (imágenes que añadieron estados).
+    int depth = 0;
+    // Punto fijo alcanzado sin violación.
+    bool complete = false;
+    bool violated = false;
+    int violation_depth = -1;
+    SymbolicTrace counterexample;
+    // Nodos BDD de cada frontera (para seguir el crecimiento).
+    std::vector<std::size_t> frontier_nodes;
+};
+
+// Estados alcanzables desde `initial`.
+ReachResult reachable(SymbolicFsm &fsm, const Bdd &initial, const ReachOptions &options = {});
+
+// Como reachable, pero se detiene en la primera profundidad que toca `bad`
+// (el complemento del invariante) y devuelve un contraejemplo mínimo.
+ReachResult check_invariant(SymbolicFsm &fsm, const Bdd &initial, const Bdd &bad, const ReachOptions &options = {});
+
+} // namespace graphs
@@ -0,0 +1,103 @@
+// Problema de cobertura unate (selección de implicantes primos).
+//
+// minimize_function de lib/boolean_logic.py devuelve todos los implicantes
+// primos; aquí se elige el subconjunto de coste mínimo que cubre todos los
+// mintérminos.  La matriz tiene una fila por elemento a cubrir y una columna
+// por candidato, con coste entero por columna.
+//
+// El resolvedor reduce la matriz hasta un punto fijo:
+//
+//   * columnas esenciales (la única de alguna fila) entran en la solución;
+//   * una fila cuyo conjunto de columnas contiene al de otra sobra;
+//   * una columna cuyas filas están contenidas en las de otra no más cara
+//     sobra;
+//
+// y ramifica sobre la fila con menos columnas (ramificación y poda con
+// conjuntos de bits).  La cota inferior es la suma de los costes mínimos de
+// un conjunto de filas independientes (sin columnas en común).  Una
+// solución voraz (mejor proporción filas nuevas / coste) da la primera cota
+// superior y es la respuesta si se agota el tiempo o la matriz es demasiado
+// grande para representarla densa.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "quine_mccluskey.hpp"
+
+namespace graphs {
+
+class CoverMatrix {
+public:
+    CoverMatrix(std::size_t rows, std::size_t columns);
+
+    std::size_t rows() const { return rows_; }
+    std::size_t columns() const { return columns_.size(); }
+    // Marca que `column` cubre `row`.  Lanza std::out_of_range.
+    void set(std::size_t row, std::size_t column);
+    // Filas que cubre una columna (en el orden en que se marcaron).
+    const std::vector<std::uint32_t> &column(std::size_t c) const { return columns_.at(c); }
+
+private:
+    std::size_t rows_;
+    std::vector<std::vector<std::uint32_t>> columns_;
+};
+
+struct CoverOptions {
+    // Coste de cada columna (vacío = todas 1).
+    std::vector<unsigned> costs;
+    // Segundos para la búsqueda exacta (<= 0 = sólo la solución voraz).
+    double time_budget = 1.0;
+    // Por encima de filas * columnas bits no se intenta la búsqueda exacta.
+    std::size_t max_dense_bits = std::size_t(1) << 31;
+};
+
+struct CoverResult {
+    // Columnas elegidas, en orden creciente.
+    std::vector<std::size_t> columns;
+    std::uint64_t cost = 0;
+    // La búsqueda terminó: la solución es de coste mínimo.
+    bool optimal = false;
+    // Columnas esenciales en la matriz original.
+    std::size_t essentials = 0;
+    // Nodos de la ramificación y cota inferior en la raíz.
+    std::size_t nodes = 0;
+    std::uint64_t lower_bound = 0;
+};
+
+// Lanza std::invalid_argument si alguna fila no tiene columnas o el tamaño
+// de costs no coincide.
+CoverResult solve_cover(const CoverMatrix &matrix, const CoverOptions &options = {});
+
+struct MinimizeOptions {
+    // Hilos para la generación de primos (0 = parallel::default_threads()).
+    unsigned threads = 0;
+    // Presupuesto de la cobertura exacta en segundos.
+    double time_budget = 1.0;
+};
+
+struct MinimizeResult {
+    // Cobertura mínima en el orden de sus patrones.
+    std::vector<Cube> cover;
+    std::vector<std::string> patterns;
+    std::size_t primes = 0;
+    bool optimal = false;
+};
+
+// Suma de productos mínima: primero el menor número de términos y, a
+// igualdad, el menor número de literales.  Lanza std::invalid_argument si
+// la función es tan grande que el peso de un término no cabe en los costes
+// de 32 bits (unos 6·10^7 mintérminos con 64 variables).
+MinimizeResult minimize_cover(const std::vector<std::uint64_t> &minterms,
+                              const std::vector<std::uint64_t> &dont_cares, unsigned num_vars,
+                              const MinimizeOptions &options = {});
+
+// Patrones de minimize_cover, con la firma de minimize_function en Python.
+std::vector<std::string> minimize_function(const std::vector<std::uint64_t> &minterms, unsigned num_vars,
+                                           const std::vector<std::uint64_t> &dont_cares = {},
+                                           const MinimizeOptions &options = {});
+
+} // namespace graphs
@@ -0,0 +1,788 @@
+#include "bdd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace graphs {
+
+namespace {
+
+enum Op : std::uint32_t { kIte = 1, kExists, kAndExists, kRestrict };
+
+constexpr std::size_t kInitialBuckets = 64;
+
+std::uint64_t mix(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+std::size_t cache_hash(std::uint32_t op, std::uint32_t f, std::uint32_t g, std::uint32_t h) {
+    return static_cast<std::size_t>(mix(mix((std::uint64_t(op) << 32) | f) ^ ((std::uint64_t(g) << 32) | h)));
+}
+
+std::size_t round_up_pow2(std::size_t n) {
+    std::size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Manejadores
+
+Bdd::Bdd(BddManager *manager, std::uint32_t node) : manager_(manager), node_(node) {
+    manager_->ref(node_);
+}
+
+Bdd::Bdd(const Bdd &other) : manager_(other.manager_), node_(other.node_) {
+    if (manager_) {
+        manager_->ref(node_);
+    }
+}
+
+Bdd::Bdd(Bdd &&other) noexcept : manager_(other.manager_), node_(other.node_) {
+    other.manager_ = nullptr;
+    other.node_ = 0;
+}
+
+Bdd &Bdd::operator=(const Bdd &other) {
+    if (other.manager_) {
+        other.manager_->ref(other.node_);
+    }
+    if (manager_) {
+        manager_->deref(node_);
+    }
+    manager_ = other.manager_;
+    node_ = other.node_;
+    return *this;
+}
+
+Bdd &Bdd::operator=(Bdd &&other) noexcept {
+    if (this != &other) {
+        if (manager_) {
+            manager_->deref(node_);
+        }
+        manager_ = other.manager_;
+        node_ = other.node_;
+        other.manager_ = nullptr;
+        other.node_ = 0;
+    }
+    return *this;
+}
+
+Bdd::~Bdd() {
+    if (manager_) {
+        manager_->deref(node_);
+    }
+}
+
+unsigned Bdd::var() const {
+    if (is_constant()) {
+        throw std::logic_error("Bdd constante sin variable");
+    }
+    return manager_->nodes_[node_].var;
+}
+
+Bdd Bdd::low() const {
+    if (is_constant()) {
+        throw std::logic_error("Bdd constante sin cofactores");
+    }
+    return Bdd(manager_, manager_->nodes_[node_].low);
+}
+
+Bdd Bdd::high() const {
+    if (is_constant()) {
+        throw std::logic_error("Bdd constante sin cofactores");
+    }
+    return Bdd(manager_, manager_->nodes_[node_].high);
+}
+
+Bdd Bdd::operator~() const {
+    return manager_->ite(*this, manager_->zero(), manager_->one());
+}
+
+Bdd Bdd::operator&(const Bdd &g) const {
+    return manager_->ite(*this, g, manager_->zero());
+}
+
+Bdd Bdd::operator|(const Bdd &g) const {
+    return manager_->ite(*this, manager_->one(), g);
+}
+
+Bdd Bdd::operator^(const Bdd &g) const {
+    return manager_->ite(*this, ~g, g);
+}
+
+// ---------------------------------------------------------------------------
+// Tabla única y caché
+
+BddManager::BddManager(unsigned vars, const BddOptions &options)
+    : options_(options), gc_threshold_(std::max<std::size_t>(options.gc_threshold, 1)),
+      reorder_threshold_(options.reorder_threshold) {
+    // Constantes 0 y 1: nunca en la tabla única ni en la lista libre.
+    nodes_.push_back({kNil, 0, 0, kNil});
+    nodes_.push_back({kNil, 1, 1, kNil});
+    external_.assign(2, 0);
+    cache_.resize(round_up_pow2(std::max<std::size_t>(options.cache_size, 1024)));
+    for (unsigned v = 0; v < vars; ++v) {
+        new_var();
+    }
+}
+
+unsigned BddManager::new_var() {
+    const unsigned v = num_vars();
+    level_of_.push_back(v);
+    var_at_.push_back(v);
+    tables_.emplace_back();
+    tables_.back().buckets.assign(kInitialBuckets, kNil);
+    return v;
+}
+
+void BddManager::check(const Bdd &f) const {
+    if (f.manager_ != this) {
+        throw std::invalid_argument("Bdd de otro gestor o vacío");
+    }
+}
+
+std::size_t BddManager::bucket(const Subtable &table, std::uint32_t low, std::uint32_t high) const {
+    return static_cast<std::size_t>(mix((std::uint64_t(low) << 32) | high)) & (table.buckets.size() - 1);
+}
+
+void BddManager::insert(Subtable &table, std::uint32_t n) {
+    if (table.count >= table.buckets.size()) {
+        grow(table);
+    }
+    std::uint32_t &head = table.buckets[bucket(table, nodes_[n].low, nodes_[n].high)];
+    nodes_[n].next = head;
+    head = n;
+    ++table.count;
+}
+
+void BddManager::unlink(Subtable &table, std::uint32_t n) {
+    std::uint32_t *link = &table.buckets[bucket(table, nodes_[n].low, nodes_[n].high)];
+    while (*link != n) {
+        link = &nodes_[*link].next;
+    }
+    *link = nodes_[n].next;
+    --table.count;
+}
+
+void BddManager::grow(Subtable &table) {
+    std::vector<std::uint32_t> old(table.buckets.size() * 2, kNil);
+    old.swap(table.buckets);
+    for (std::uint32_t head : old) {
+        while (head != kNil) {
+            const std::uint32_t next = nodes_[head].next;
+            std::uint32_t &slot = table.buckets[bucket(table, nodes_[head].low, nodes_[head].high)];
+            nodes_[head].next = slot;
+            slot = head;
+            head = next;
+        }
+    }
+}
+
+std::uint32_t BddManager::allocate() {
+    if (free_ != kNil) {
+        const std::uint32_t n = free_;
+        free_ = nodes_[n].next;
+        --free_count_;
+        external_[n] = 0;
+        return n;
+    }
+    if (nodes_.size() >= options_.max_nodes || nodes_.size() >= kNil) {
+        throw std::runtime_error("BDD: se superó el límite de nodos");
+    }
+    nodes_.push_back({});
+    external_.push_back(0);
+    if (!refs_.empty()) {
+        refs_.push_back(0);
+    }
+    return static_cast<std::uint32_t>(nodes_.size() - 1);
+}
+
+std::uint32_t BddManager::make(std::uint32_t var, std::uint32_t low, std::uint32_t high, bool *created) {
+    if (created) {
+        *created = false;
+    }
+    if (low == high) {
+        return low;
+    }
+    Subtable &table = tables_[var];
+    for (std::uint32_t n = table.buckets[bucket(table, low, high)]; n != kNil; n = nodes_[n].next) {
+        if (nodes_[n].low == low && nodes_[n].high == high) {
+            return n;
+        }
+    }
+    const std::uint32_t n = allocate();
+    nodes_[n] = {var, low, high, kNil};
+    insert(table, n);
+    stats_.peak_nodes = std::max(stats_.peak_nodes, live());
+    if (created) {
+        *created = true;
+    }
+    return n;
+}
+
+bool BddManager::cache_find(std::uint32_t op, std::uint32_t f, std::uint32_t g, std::uint32_t h, std::uint32_t &r) {
+    ++stats_.cache_lookups;
+    const CacheEntry &e = cache_[cache_hash(op, f, g, h) & (cache_.size() - 1)];
+    if (e.op == op && e.f == f && e.g == g && e.h == h) {
+        ++stats_.cache_hits;
+        r = e.result;
+        return true;
+    }
+    return false;
+}
+
+void BddManager::cache_store(std::uint32_t op, std::uint32_t f, std::uint32_t g, std::uint32_t h, std::uint32_t r) {
+    CacheEntry &e = cache_[cache_hash(op, f, g, h) & (cache_.size() - 1)];
+    e = {op, f, g, h, r};
+}
+
+void BddManager::cache_clear() {
+    std::fill(cache_.begin(), cache_.end(), CacheEntry{});
+}
+
+// ---------------------------------------------------------------------------
+// Operaciones
+
+void BddManager::maintain() {
+    if (live() >= gc_threshold_) {
+        collect_garbage();
+        if (live() * 2 > gc_threshold_) {
+            gc_threshold_ *= 2;
+        }
+    }
+    if (options_.auto_reorder && live() >= reorder_threshold_) {
+        reorder();
+        reorder_threshold_ = std::max(reorder_threshold_, 2 * live());
+    }
+}
+
+Bdd BddManager::var(unsigned v) {
+    if (v >= num_vars()) {
+        throw std::out_of_range("Variable BDD inexistente");
+    }
+    maintain();
+    return Bdd(this, make(v, 0, 1));
+}
+
+Bdd BddManager::nvar(unsigned v) {
+    if (v >= num_vars()) {
+        throw std::out_of_range("Variable BDD inexistente");
+    }
+    maintain();
+    return Bdd(this, make(v, 1, 0));
+}
+
+Bdd BddManager::cube(const std::vector<unsigned> &vars) {
+    std::vector<unsigned> sorted;
+    for (unsigned v : vars) {
+        if (v >= num_vars()) {
+            throw std::out_of_range("Variable BDD inexistente");
+        }
+        sorted.push_back(v);
+    }
+    std::sort(sorted.begin(), sorted.end(), [&](unsigned a, unsigned b) { return level_of_[a] > level_of_[b]; });
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    maintain();
+    std::uint32_t r = 1;
+    for (unsigned v : sorted) {
+        r = make(v, 0, r);
+    }
+    return Bdd(this, r);
+}
+
+std::uint32_t BddManager::ite_rec(std::uint32_t f, std::uint32_t g, std::uint32_t h) {
+    if (f == 1) {
+        return g;
+    }
+    if (f == 0) {
+        return h;
+    }
+    if (g == h) {
+        return g;
+    }
+    if (g == 1 && h == 0) {
+        return f;
+    }
+    // Normalización: ite(f, f, h) = ite(f, 1, h) e ite(f, g, f) = ite(f, g, 0).
+    if (g == f) {
+        g = 1;
+    }
+    if (h == f) {
+        h = 0;
+    }
+    std::uint32_t r;
+    if (cache_find(kIte, f, g, h, r)) {
+        return r;
+    }
+    const std::uint32_t top = std::min({level_node(f), level_node(g), level_node(h)});
+    const std::uint32_t v = var_at_[top];
+    auto lo = [&](std::uint32_t n) { return level_node(n) == top ? nodes_[n].low : n; };
+    auto hi = [&](std::uint32_t n) { return level_node(n) == top ? nodes_[n].high : n; };
+    const std::uint32_t r0 = ite_rec(lo(f), lo(g), lo(h));
+    const std::uint32_t r1 = ite_rec(hi(f), hi(g), hi(h));
+    r = make(v, r0, r1);
+    cache_store(kIte, f, g, h, r);
+    return r;
+}
+
+std::uint32_t BddManager::exists_rec(std::uint32_t f, std::uint32_t cube) {
+    if (f <= 1) {
+        return f;
+    }
+    const std::uint32_t level = level_node(f);
+    while (cube > 1 && level_node(cube) < level) {
+        cube = nodes_[cube].high;
+    }
+    if (cube <= 1) {
+        return f;
+    }
+    std::uint32_t r;
+    if (cache_find(kExists, f, cube, 0, r)) {
+        return r;
+    }
+    const Node n = nodes_[f];
+    if (level_node(cube) == level) {
+        const std::uint32_t rest = nodes_[cube].high;
+        const std::uint32_t r0 = exists_rec(n.low, rest);
+        r = r0 == 1 ? 1 : ite_rec(r0, 1, exists_rec(n.high, rest));
+    } else {
+        const std::uint32_t r0 = exists_rec(n.low, cube);
+        r = make(n.var, r0, exists_rec(n.high, cube));
+    }
+    cache_store(kExists, f, cube, 0, r);
+    return r;
+}
+
+std::uint32_t BddManager::and_exists_rec(std::uint32_t f, std::uint32_t g, std::uint32_t cube) {
+    if (f == 0 || g == 0) {
+        return 0;
+    }
+    if (f == 1 || f == g) {
+        return exists_rec(g, cube);
+    }
+    if (g == 1) {
+        return exists_rec(f, cube);
+    }
+    if (f > g) {
+        std::swap(f, g);
+    }
+    const std::uint32_t top = std::min(level_node(f), level_node(g));
+    while (cube > 1 && level_node(cube) < top) {
+        cube = nodes_[cube].high;
+    }
+    if (cube <= 1) {
+        return ite_rec(f, g, 0);
+    }
+    std::uint32_t r;
+    if (cache_find(kAndExists, f, g, cube, r)) {
+        return r;
+    }
+    auto lo = [&](std::uint32_t n) { return level_node(n) == top ? nodes_[n].low : n; };
+    auto hi = [&](std::uint32_t n) { return level_node(n) == top ? nodes_[n].high : n; };
+    if (level_node(cube) == top) {
+        const std::uint32_t rest = nodes_[cube].high;
+        const std::uint32_t r0 = and_exists_rec(lo(f), lo(g), rest);
+        r = r0 == 1 ? 1 : ite_rec(r0, 1, and_exists_rec(hi(f), hi(g), rest));
+    } else {
+        const std::uint32_t r0 = and_exists_rec(lo(f), lo(g), cube);
+        r = make(var_at_[top], r0, and_exists_rec(hi(f), hi(g), cube));
+    }
+    cache_store(kAndExists, f, g, cube, r);
+    return r;
+}
+
+std::uint32_t BddManager::restrict_rec(std::uint32_t f, std::uint32_t var, std::uint32_t value) {
+    if (f <= 1 || level_node(f) > level_of_[var]) {
+        return f;
+    }
+    const Node n = nodes_[f];
+    if (n.var == var) {
+        return value ? n.high : n.low;
+    }
+    std::uint32_t r;
+    if (cache_find(kRestrict, f, var, value, r)) {
+        return r;
+    }
+    const std::uint32_t r0 = restrict_rec(n.low, var, value);
+    r = make(n.var, r0, restrict_rec(n.high, var, value));
+    cache_store(kRestrict, f, var, value, r);
+    return r;
+}
+
+Bdd BddManager::ite(const Bdd &f, const Bdd &g, const Bdd &h) {
+    check(f);
+    check(g);
+    check(h);
+    maintain();
+    return Bdd(this, ite_rec(f.node_, g.node_, h.node_));
+}
+
+Bdd BddManager::exists(const Bdd &f, const Bdd &cube) {
+    check(f);
+    check(cube);
+    maintain();
+    return Bdd(this, exists_rec(f.node_, cube.node_));
+}
+
+Bdd BddManager::forall(const Bdd &f, const Bdd &cube) {
+    return ~exists(~f, cube);
+}
+
+Bdd BddManager::and_exists(const Bdd &f, const Bdd &g, const Bdd &cube) {
+    check(f);
+    check(g);
+    check(cube);
+    maintain();
+    return Bdd(this, and_exists_rec(f.node_, g.node_, cube.node_));
+}
+
+Bdd BddManager::rename(const Bdd &f, const std::vector<unsigned> &map) {
+    check(f);
+    if (map.size() != num_vars()) {
+        throw std::invalid_argument("El renombrado debe dar una variable por cada variable del gestor");
+    }
+    for (unsigned v : map) {
+        if (v >= num_vars()) {
+            throw std::out_of_range("Variable BDD inexistente");
+        }
+    }
+    maintain();
+    // Composición con ite: válida para cualquier renombrado, aunque altere
+    // el orden relativo de las variables.
+    std::unordered_map<std::uint32_t, std::uint32_t> memo;
+    auto rec = [&](auto &&self, std::uint32_t n) -> std::uint32_t {
+        if (n <= 1) {
+            return n;
+        }
+        const auto it = memo.find(n);
+        if (it != memo.end()) {
+            return it->second;
+        }
+        const Node node = nodes_[n];
+        const std::uint32_t r0 = self(self, node.low);
+        const std::uint32_t r1 = self(self, node.high);
+        const std::uint32_t r = ite_rec(make(map[node.var], 0, 1), r1, r0);
+        memo.emplace(n, r);
+        return r;
+    };
+    return Bdd(this, rec(rec, f.node_));
+}
+
+Bdd BddManager::restrict(const Bdd &f, unsigned v, bool value) {
+    check(f);
+    if (v >= num_vars()) {
+        throw std::out_of_range("Variable BDD inexistente");
+    }
+    maintain();
+    return Bdd(this, restrict_rec(f.node_, v, value ? 1 : 0));
+}
+
+// ---------------------------------------------------------------------------
+// Consultas
+
+bool BddManager::eval(const Bdd &f, const std::vector<bool> &assignment) const {
+    check(f);
+    if (assignment.size() < num_vars()) {
+        throw std::invalid_argument("La asignación no cubre todas las variables");
+    }
+    std::uint32_t n = f.node_;
+    while (n > 1) {
+        n = assignment[nodes_[n].var] ? nodes_[n].high : nodes_[n].low;
+    }
+    return n == 1;
+}
+
+double BddManager::sat_count(const Bdd &f, unsigned nvars) const {
+    check(f);
+    // Fracción de asignaciones que satisfacen cada subdiagrama: no depende
+    // de los niveles, así que sirve con cualquier orden.
+    std::unordered_map<std::uint32_t, double> memo;
+    auto rec = [&](auto &&self, std::uint32_t n) -> double {
+        if (n <= 1) {
+            return n;
+        }
+        const auto it = memo.find(n);
+        if (it != memo.end()) {
+            return it->second;
+        }
+        const double r = 0.5 * (self(self, nodes_[n].low) + self(self, nodes_[n].high));
+        memo.emplace(n, r);
+        return r;
+    };
+    return std::ldexp(rec(rec, f.node_), static_cast<int>(nvars));
+}
+
+std::vector<int> BddManager::pick_one(const Bdd &f) const {
+    check(f);
+    if (f.node_ == 0) {
+        return {};
+    }
+    std::vector<int> out(num_vars(), -1);
+    for (std::uint32_t n = f.node_; n > 1;) {
+        const Node &node = nodes_[n];
+        if (node.low != 0) {
+            out[node.var] = 0;
+            n = node.low;
+        } else {
+            out[node.var] = 1;
+            n = node.high;
+        }
+    }
+    return out;
+}
+
+void BddManager::mark(std::vector<std::uint8_t> &marks, std::uint32_t root) const {
+    std::vector<std::uint32_t> stack{root};
+    while (!stack.empty()) {
+        const std::uint32_t n = stack.back();
+        stack.pop_back();
+        if (n <= 1 || marks[n]) {
+            continue;
+        }
+        marks[n] = 1;
+        stack.push_back(nodes_[n].low);
+        stack.push_back(nodes_[n].high);
+    }
+}
+
+std::vector<unsigned> BddManager::support(const Bdd &f) const {
+    check(f);
+    std::vector<std::uint8_t> marks(nodes_.size(), 0);
+    mark(marks, f.node_);
+    std::vector<std::uint8_t> used(num_vars(), 0);
+    for (std::size_t n = 2; n < marks.size(); ++n) {
+        if (marks[n]) {
+            used[nodes_[n].var] = 1;
+        }
+    }
+    std::vector<unsigned> out;
+    for (unsigned v = 0; v < num_vars(); ++v) {
+        if (used[v]) {
+            out.push_back(v);
+        }
+    }
+    return out;
+}
+
+std::size_t BddManager::node_count(const Bdd &f) const {
+    return node_count(std::vector<Bdd>{f});
+}
+
+std::size_t BddManager::node_count(const std::vector<Bdd> &fs) const {
+    std::vector<std::uint8_t> marks(nodes_.size(), 0);
+    for (const Bdd &f : fs) {
+        check(f);
+        mark(marks, f.node_);
+    }
+    return static_cast<std::size_t>(std::count(marks.begin(), marks.end(), std::uint8_t(1)));
+}
+
+// ---------------------------------------------------------------------------
+// Recolección de basura
+
+std::size_t BddManager::collect_garbage() {
+    std::vector<std::uint8_t> marks(nodes_.size(), 0);
+    for (std::uint32_t n = 2; n < nodes_.size(); ++n) {
+        if (external_[n] > 0) {
+            mark(marks, n);
+        }
+    }
+    std::size_t freed = 0;
+    for (Subtable &table : tables_) {
+        for (std::uint32_t &head : table.buckets) {
+            std::uint32_t *link = &head;
+            while (*link != kNil) {
+                const std::uint32_t n = *link;
+                if (marks[n]) {
+                    link = &nodes_[n].next;
+                    continue;
+                }
+                *link = nodes_[n].next;
+                --table.count;
+                nodes_[n] = {kNil, 0, 0, free_};
+                free_ = n;
+                ++free_count_;
+                ++freed;
+            }
+        }
+    }
+    // Las entradas de la caché pueden apuntar a nodos liberados.
+    cache_clear();
+    ++stats_.gc_runs;
+    stats_.live_nodes = live();
+    return freed;
+}
+
+// ---------------------------------------------------------------------------
+// Reordenación
+
+void BddManager::begin_reordering() {
+    collect_garbage();
+    // Referencias internas: padres en la tabla única más manejadores.
+    refs_.assign(nodes_.size(), 0);
+    for (std::uint32_t n = 2; n < nodes_.size(); ++n) {
+        if (nodes_[n].var == kNil) {
+            continue;
+        }
+        refs_[n] += external_[n];
+        ++refs_[nodes_[n].low];
+        ++refs_[nodes_[n].high];
+    }
+}
+
+void BddManager::end_reordering() {
+    refs_.clear();
+    refs_.shrink_to_fit();
+    cache_clear();
+    stats_.live_nodes = live();
+}
+
+void BddManager::release(std::uint32_t n) {
+    if (n <= 1 || --refs_[n] > 0) {
+        return;
+    }
+    const Node node = nodes_[n];
+    unlink(tables_[node.var], n);
+    nodes_[n] = {kNil, 0, 0, free_};
+    free_ = n;
+    ++free_count_;
+    release(node.low);
+    release(node.high);
+}
+
+std::uint32_t BddManager::make_referenced(std::uint32_t var, std::uint32_t low, std::uint32_t high) {
+    bool created;
+    const std::uint32_t n = make(var, low, high, &created);
+    if (created) {
+        refs_[n] = 0;
+        ++refs_[low];
+        ++refs_[high];
+    }
+    ++refs_[n];
+    return n;
+}
+
+// Intercambia las variables de los niveles `level` y `level + 1`.  Los nodos
+// de la variable superior x que dependen de la inferior y se reescriben in
+// situ como nodos de y, con hijos nuevos de x; el resto sólo cambia de nivel.
+std::size_t BddManager::swap_levels(unsigned level) {
+    const unsigned x = var_at_[level], y = var_at_[level + 1];
+    Subtable &tx = tables_[x];
+    std::vector<std::uint32_t> xs;
+    xs.reserve(tx.count);
+    for (std::uint32_t &head : tx.buckets) {
+        for (std::uint32_t n = head; n != kNil; n = nodes_[n].next) {
+            xs.push_back(n);
+        }
+        head = kNil;
+    }
+    tx.count = 0;
+    auto depends_on_y = [&](std::uint32_t n) { return n > 1 && nodes_[n].var == y; };
+    std::vector<std::uint32_t> moving;
+    for (std::uint32_t n : xs) {
+        if (depends_on_y(nodes_[n].low) || depends_on_y(nodes_[n].high)) {
+            moving.push_back(n);
+        } else {
+            insert(tx, n);
+        }
+    }
+    for (std::uint32_t n : moving) {
+        const std::uint32_t f0 = nodes_[n].low, f1 = nodes_[n].high;
+        const std::uint32_t f00 = depends_on_y(f0) ? nodes_[f0].low : f0;
+        const std::uint32_t f01 = depends_on_y(f0) ? nodes_[f0].high : f0;
+        const std::uint32_t f10 = depends_on_y(f1) ? nodes_[f1].low : f1;
+        const std::uint32_t f11 = depends_on_y(f1) ? nodes_[f1].high : f1;
+        // n = y ? (x ? f11 : f01) : (x ? f10 : f00)
+        const std::uint32_t low = make_referenced(x, f00, f10);
+        const std::uint32_t high = make_referenced(x, f01, f11);
+        release(f0);
+        release(f1);
+        nodes_[n] = {y, low, high, kNil};
+        insert(tables_[y], n);
+    }
+    std::swap(var_at_[level], var_at_[level + 1]);
+    level_of_[x] = level + 1;
+    level_of_[y] = level;
+    return live();
+}
+
+std::size_t BddManager::sift(unsigned var, std::size_t size) {
+    const unsigned bottom = num_vars() - 1;
+    unsigned at = level_of_[var], best_level = at;
+    std::size_t best = size;
+    auto too_big = [&](std::size_t s) { return static_cast<double>(s) > options_.max_growth * static_cast<double>(best); };
+    // Hacia el extremo más cercano primero.
+    const bool down_first = at > bottom / 2;
+    for (int pass = 0; pass < 2; ++pass) {
+        const bool down = (pass == 0) == down_first;
+        while (down ? at < bottom : at > 0) {
+            size = down ? swap_levels(at++) : swap_levels(--at);
+            if (size < best) {
+                best = size;
+                best_level = at;
+            } else if (too_big(size)) {
+                break;
+            }
+        }
+    }
+    while (at < best_level) {
+        swap_levels(at++);
+    }
+    while (at > best_level) {
+        swap_levels(--at);
+    }
+    return best;
+}
+
+std::size_t BddManager::reorder() {
+    if (num_vars() < 2) {
+        return live();
+    }
+    begin_reordering();
+    std::vector<unsigned> vars(num_vars());
+    for (unsigned v = 0; v < num_vars(); ++v) {
+        vars[v] = v;
+    }
+    // Primero las variables con más nodos.
+    std::stable_sort(vars.begin(), vars.end(),
+                     [&](unsigned a, unsigned b) { return tables_[a].count > tables_[b].count; });
+    std::size_t size = live();
+    for (unsigned v : vars) {
+        size = sift(v, size);
+    }
+    end_reordering();
+    ++stats_.reorderings;
+    return live();
+}
+
+void BddManager::set_order(const std::vector<unsigned> &order) {
+    std::vector<std::uint8_t> seen(num_vars(), 0);
+    if (order.size() != num_vars()) {
+        throw std::invalid_argument("El orden debe contener todas las variables");
+    }
+    for (unsigned v : order) {
+        if (v >= num_vars() || seen[v]) {
+            throw std::invalid_argument("El orden no es una permutación de las variables");
+        }
+        seen[v] = 1;
+    }
+    begin_reordering();
+    for (unsigned target = 0; target < order.size(); ++target) {
+        for (unsigned at = level_of_[order[target]]; at > target; --at) {
+            swap_levels(at - 1);
+        }
+    }
+    end_reordering();
+}
+
+} // namespace graphs
@@ -0,0 +1,143 @@
+#include "bellman_ford.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+
+#include "dijkstra.hpp"
+
+namespace graphs {
+
+namespace {
+
+// Busca un ciclo en el grafo de predecesores recorriendo cada cadena de
+// padres una sola vez (O(n)).  Devuelve un vértice del ciclo o -1.
+int find_parent_cycle(const std::vector<int> &parent, std::vector<std::uint32_t> &walk) {
+    const int n = static_cast<int>(parent.size());
+    std::fill(walk.begin(), walk.end(), 0);
+    for (int start = 0; start < n; ++start) {
+        if (walk[start] != 0) {
+            continue;
+        }
+        const std::uint32_t id = static_cast<std::uint32_t>(start) + 1;
+        int v = start;
+        while (v != -1 && walk[v] == 0) {
+            walk[v] = id;
+            v = parent[v];
+        }
+        if (v != -1 && walk[v] == id) {
+            return v;
+        }
+    }
+    return -1;
+}
+
+std::vector<int> collect_cycle(const std::vector<int> &parent, int on_cycle) {
+    std::vector<int> cycle;
+    int v = on_cycle;
+    do {
+        cycle.push_back(v);
+        v = parent[v];
+    } while (v != on_cycle);
+    // Los predecesores apuntan hacia atrás: se invierte para obtener el sentido de las aristas.
+    std::reverse(cycle.begin(), cycle.end());
+    return cycle;
+}
+
+// Núcleo común: todos los vértices de `sources` parten con distancia 0.
+BellmanFordResult run_bellman_ford(const Graph &g, const std::vector<int> &sources) {
+    const int n = g.num_vertices();
+    BellmanFordResult result;
+    auto &dist = result.tree.dist;
+    auto &parent = result.tree.parent;
+    dist.assign(n, std::numeric_limits<double>::infinity());
+    parent.assign(n, -1);
+    std::vector<bool> in_queue(n, false);
+    std::vector<int> passes(n, 0);
+    std::vector<std::uint32_t> walk(n);
+    std::deque<int> queue;
+
+    // Comprueba el grafo de predecesores y, si hay ciclo, lo deja en result.
+    auto detect_cycle = [&]() {
+        int c = find_parent_cycle(parent, walk);
+        if (c == -1) {
+            return false;
+        }
+        result.negative_cycle = true;
+        result.cycle = collect_cycle(parent, c);
+        return true;
+    };
+
+    // Con un único origen, mejorar su distancia ya prueba un ciclo negativo y
+    // se comprueba en el acto.  Con varios (origen virtual) no: una arista
+    // negativa entrante basta, así que sólo queda la comprobación periódica.
+    const int single_source = sources.size() == 1 ? sources[0] : -1;
+    for (int s : sources) {
+        dist[s] = 0.0;
+        queue.push_back(s);
+        in_queue[s] = true;
+    }
+    std::size_t since_check = 0;
+    while (!queue.empty()) {
+        int u = queue.front();
+        queue.pop_front();
+        in_queue[u] = false;
+        // Cota clásica: sin ciclos negativos un vértice sale de la cola como
+        // mucho n-1 veces.  Sirve de respaldo a la comprobación periódica.
+        if (++passes[u] > n && detect_cycle()) {
+            return result;
+        }
+        const double du = dist[u];
+        for (std::size_t e = g.edge_begin(u), end = g.edge_end(u); e < end; ++e) {
+            int v = g.target(e);
+            double alt = du + g.weight(e);
+            if (alt < dist[v]) {
+                dist[v] = alt;
+                parent[v] = u;
+                if (v == single_source || ++since_check >= static_cast<std::size_t>(n)) {
+                    since_check = 0;
+                    if (detect_cycle()) {
+                        return result;
+                    }
+                }
+                if (!in_queue[v]) {
+                    in_queue[v] = true;
+                    queue.push_back(v);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+BellmanFordResult bellman_ford(const Graph &g, int source) {
+    if (source < 0 || source >= g.num_vertices()) {
+        throw std::out_of_range("Nodo origen fuera de rango");
+    }
+    return run_bellman_ford(g, {source});
+}
+
+BellmanFordResult bellman_ford_potentials(const Graph &g) {
+    std::vector<int> all(g.num_vertices());
+    for (int v = 0; v < g.num_vertices(); ++v) {
+        all[v] = v;
+    }
+    return run_bellman_ford(g, all);
+}
+
+ShortestPathTree shortest_paths(const Graph &g, int source) {
+    if (!g.has_negative_weights()) {
+        return dijkstra_tree(g, source);
+    }
+    BellmanFordResult result = bellman_ford(g, source);
+    if (result.negative_cycle) {
+        throw std::runtime_error("El grafo contiene un ciclo negativo alcanzable");
+    }
+    return std::move(result.tree);
+}
+
+} // namespace graphs
@@ -0,0 +1,262 @@
+#include "bfs.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "graph_builder.hpp"
+#include "parallel.hpp"
+
+namespace graphs {
+
+namespace {
+
+constexpr std::size_t kFrontierGrain = 256;
+constexpr std::size_t kWordGrain = 64;
+
+inline std::uint64_t bit(int v) { return std::uint64_t(1) << (v & 63); }
+
+// Índice del bit menos significativo activo (x != 0).
+inline int lowest_bit(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int k = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++k;
+    }
+    return k;
+#endif
+}
+
+// Contadores por hilo de un nivel.
+struct LevelCounts {
+    std::size_t vertices = 0;
+    std::size_t edges = 0;
+    bool found = false;
+};
+
+LevelCounts sum(const std::vector<LevelCounts> &parts) {
+    LevelCounts total;
+    for (const auto &p : parts) {
+        total.vertices += p.vertices;
+        total.edges += p.edges;
+        total.found = total.found || p.found;
+    }
+    return total;
+}
+
+// Acceso a los vecinos de cada representación.
+struct CsrAdjacency {
+    const Graph &g;
+    std::size_t degree(int u) const { return g.degree(u); }
+    template <class F>
+    void for_each(int u, F &&f) const {
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            f(g.target(e));
+        }
+    }
+    // Se detiene en el primer vecino que cumple pred.
+    template <class P>
+    bool any(int u, P &&pred) const {
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            if (pred(g.target(e))) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+struct CompressedAdjacency {
+    const CompressedGraph &g;
+    std::size_t degree(int u) const { return g.degree(u); }
+    template <class F>
+    void for_each(int u, F &&f) const {
+        g.for_each_neighbor(u, [&](int v, double) { f(v); });
+    }
+    template <class P>
+    bool any(int u, P &&pred) const {
+        for (const Neighbor &nb : g.neighbors(u)) {
+            if (pred(nb.target)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+void check_vertex(int n, int v, const char *what) {
+    if (v < 0 || v >= n) {
+        throw std::out_of_range(what);
+    }
+}
+
+} // namespace
+
+BfsEngine::BfsEngine(const Graph &g, const BfsOptions &options)
+    : n_(g.num_vertices()), m_(g.num_edges()), g_(g),
+      reverse_(options.symmetric ? g : transpose(g, options.threads)), options_(options),
+      visited_((static_cast<std::size_t>(n_) + 63) / 64), front_bits_(visited_.size(), 0),
+      next_bits_(visited_.size(), 0) {}
+
+BfsEngine::BfsEngine(const CompressedGraph &g, const BfsOptions &options)
+    : n_(g.num_vertices()), m_(g.num_edges()), compressed_(true), compressed_g_(g),
+      compressed_reverse_(options.symmetric ? g : transpose(g, options.threads)), options_(options),
+      visited_((static_cast<std::size_t>(n_) + 63) / 64), front_bits_(visited_.size(), 0),
+      next_bits_(visited_.size(), 0) {}
+
+BfsResult BfsEngine::hops(int source) {
+    BfsResult out;
+    out.hops.assign(n_, -1);
+    run(source, -1, out);
+    return out;
+}
+
+int BfsEngine::distance(int source, int target) {
+    check_vertex(n_, target, "Nodo destino fuera de rango");
+    BfsResult out;
+    return run(source, target, out);
+}
+
+int BfsEngine::run(int source, int target, BfsResult &out) {
+    if (compressed_) {
+        return run(CompressedAdjacency{compressed_g_}, CompressedAdjacency{compressed_reverse_}, source,
+                   target, out);
+    }
+    return run(CsrAdjacency{g_}, CsrAdjacency{reverse_}, source, target, out);
+}
+
+template <class Adjacency>
+int BfsEngine::run(const Adjacency &forward, const Adjacency &backward, int source, int target,
+                   BfsResult &out) {
+    const int n = n_;
+    check_vertex(n, source, "Nodo origen fuera de rango");
+    const std::size_t words = visited_.size();
+    int *hops = out.hops.empty() ? nullptr : out.hops.data();
+    for (auto &w : visited_) {
+        w.store(0, std::memory_order_relaxed);
+    }
+    visited_[source >> 6].store(bit(source), std::memory_order_relaxed);
+    if (hops) {
+        hops[source] = 0;
+    }
+    out.visited = 1;
+    if (source == target) {
+        return 0;
+    }
+
+    std::vector<int> queue{source};
+    std::vector<int> next;
+    std::vector<std::vector<int>> local;
+    std::vector<LevelCounts> counts;
+    bool bottom_up = false;
+    std::size_t frontier_vertices = 1;
+    std::size_t frontier_edges = forward.degree(source);
+    std::size_t unexplored_edges = m_ - frontier_edges;
+
+    for (int level = 0; frontier_vertices > 0; ++level) {
+        if (!bottom_up && frontier_edges > unexplored_edges / options_.alpha) {
+            std::fill(front_bits_.begin(), front_bits_.end(), 0);
+            for (int v : queue) {
+                front_bits_[v >> 6] |= bit(v);
+            }
+            bottom_up = true;
+        } else if (bottom_up && frontier_vertices < n / options_.beta) {
+            queue.clear();
+            for (std::size_t w = 0; w < words; ++w) {
+                for (std::uint64_t b = front_bits_[w]; b; b &= b - 1) {
+                    queue.push_back(static_cast<int>(w * 64 + lowest_bit(b)));
+                }
+            }
+            bottom_up = false;
+        }
+
+        if (bottom_up) {
+            // Cada tarea procesa palabras completas: visited_ y next_bits_ de
+            // esas palabras sólo los escribe ese hilo.
+            const unsigned workers = parallel::effective_threads(words, options_.threads, kWordGrain);
+            counts.assign(workers, {});
+            auto scan_word = [&](unsigned worker, std::size_t w) {
+                LevelCounts &c = counts[worker];
+                std::uint64_t seen = visited_[w].load(std::memory_order_relaxed);
+                std::uint64_t claimed = 0;
+                const int base = static_cast<int>(w * 64);
+                const int limit = std::min(64, n - base);
+                std::uint64_t todo = ~seen & (limit == 64 ? ~std::uint64_t(0) : bit(limit) - 1);
+                for (; todo; todo &= todo - 1) {
+                    const int v = base + lowest_bit(todo);
+                    if (backward.any(v, [&](int p) { return (front_bits_[p >> 6] & bit(p)) != 0; })) {
+                        claimed |= bit(v);
+                        if (hops) {
+                            hops[v] = level + 1;
+                        }
+                        ++c.vertices;
+                        c.edges += forward.degree(v);
+                        c.found = c.found || v == target;
+                    }
+                }
+                next_bits_[w] = claimed;
+                if (claimed) {
+                    visited_[w].store(seen | claimed, std::memory_order_relaxed);
+                }
+            };
+            parallel::for_each_index(words, workers, kWordGrain, scan_word);
+            std::swap(front_bits_, next_bits_);
+            ++out.bottom_up_levels;
+        } else {
+            const unsigned workers =
+                parallel::effective_threads(queue.size(), options_.threads, kFrontierGrain);
+            counts.assign(workers, {});
+            local.resize(workers);
+            for (auto &l : local) {
+                l.clear();
+            }
+            auto expand = [&](unsigned worker, std::size_t i) {
+                LevelCounts &c = counts[worker];
+                forward.for_each(queue[i], [&](int v) {
+                    auto &word = visited_[v >> 6];
+                    if (word.load(std::memory_order_relaxed) & bit(v)) {
+                        return;
+                    }
+                    if (word.fetch_or(bit(v), std::memory_order_relaxed) & bit(v)) {
+                        return;
+                    }
+                    if (hops) {
+                        hops[v] = level + 1;
+                    }
+                    local[worker].push_back(v);
+                    ++c.vertices;
+                    c.edges += forward.degree(v);
+                    c.found = c.found || v == target;
+                });
+            };
+            parallel::for_each_index(queue.size(), workers, kFrontierGrain, expand);
+            next.clear();
+            for (const auto &l : local) {
+                next.insert(next.end(), l.begin(), l.end());
+            }
+            std::swap(queue, next);
+        }
+
+        const LevelCounts level_counts = sum(counts);
+        out.visited += level_counts.vertices;
+        if (level_counts.found) {
+            return level + 1;
+        }
+        frontier_vertices = level_counts.vertices;
+        frontier_edges = level_counts.edges;
+        unexplored_edges -= frontier_edges;
+    }
+    return -1;
+}
+
+BfsResult bfs_hops(const Graph &g, int source, const BfsOptions &options) {
+    return BfsEngine(g, options).hops(source);
+}
+
+BfsResult bfs_hops(const CompressedGraph &g, int source, const BfsOptions &options) {
+    return BfsEngine(g, options).hops(source);
+}
+
+} // namespace graphs
@@ -0,0 +1,367 @@
+#include "centrality.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "compressed_graph.hpp"
+#include "graph_builder.hpp"
+#include "parallel.hpp"
+
+namespace graphs {
+
+namespace {
+
+// Bloque fijo de vértices: unidad de reparto y de Gauss–Seidel.
+constexpr std::size_t kBlock = 4096;
+
+// Sumas parciales de un hilo en una pasada.
+struct Partial {
+    double diff_sum = 0.0;
+    double diff_max = 0.0;
+    double mass = 0.0;
+    double dangling = 0.0;
+
+    void diff(double d) {
+        d = std::fabs(d);
+        diff_sum += d;
+        diff_max = std::max(diff_max, d);
+    }
+};
+
+// Ejecuta body(begin, end, partial) por bloques y suma los parciales.
+template <class Body>
+Partial for_each_block(int n, unsigned threads, Body &&body) {
+    const std::size_t blocks = (static_cast<std::size_t>(n) + kBlock - 1) / kBlock;
+    const unsigned workers = parallel::effective_threads(blocks, threads);
+    std::vector<Partial> parts(workers);
+    parallel::for_each_index(blocks, workers, 1, [&](unsigned worker, std::size_t b) {
+        const int begin = static_cast<int>(b * kBlock);
+        const int end = static_cast<int>(std::min<std::size_t>(n, (b + 1) * kBlock));
+        body(begin, end, parts[worker]);
+    });
+    Partial total;
+    for (const auto &p : parts) {
+        total.diff_sum += p.diff_sum;
+        total.diff_max = std::max(total.diff_max, p.diff_max);
+        total.mass += p.mass;
+        total.dangling += p.dangling;
+    }
+    return total;
+}
+
+double residual(const Partial &p, RankNorm norm) {
+    return norm == RankNorm::L1 ? p.diff_sum : p.diff_max;
+}
+
+void check_options(const RankOptions &o) {
+    if (!(o.tolerance > 0.0) || o.max_iter < 1) {
+        throw std::invalid_argument("Tolerancia e iteraciones deben ser positivas");
+    }
+    if (o.acceleration == RankAcceleration::Aitken && o.aitken_period < 3) {
+        throw std::invalid_argument("El periodo de Aitken debe ser al menos 3");
+    }
+}
+
+// Historia para la extrapolación de Aitken: guarda x^{k-2} y x^{k-1} y
+// extrapola en x^k al final de cada periodo.  Devuelve si ha extrapolado.
+template <class Scalar>
+class Aitken {
+public:
+    Aitken(const RankOptions &o, int n) : enabled_(o.acceleration == RankAcceleration::Aitken),
+                                          period_(o.aitken_period) {
+        if (enabled_) {
+            h0_.resize(n);
+            h1_.resize(n);
+        }
+    }
+
+    bool step(int iteration, std::vector<Scalar> &x, unsigned threads) {
+        if (!enabled_) {
+            return false;
+        }
+        const int phase = iteration % period_;
+        if (phase == period_ - 2) {
+            h0_ = x;
+        } else if (phase == period_ - 1) {
+            h1_ = x;
+        } else if (phase == 0) {
+            for_each_block(static_cast<int>(x.size()), threads, [&](int begin, int end, Partial &) {
+                for (int i = begin; i < end; ++i) {
+                    const double d1 = double(x[i]) - h1_[i];
+                    const double d2 = double(x[i]) - 2.0 * h1_[i] + h0_[i];
+                    if (std::fabs(d2) > 1e-300) {
+                        x[i] = static_cast<Scalar>(std::max(0.0, double(x[i]) - d1 * d1 / d2));
+                    }
+                }
+            });
+            return true;
+        }
+        return false;
+    }
+
+private:
+    bool enabled_;
+    int period_;
+    std::vector<Scalar> h0_, h1_;
+};
+
+template <class Scalar>
+void scale(std::vector<Scalar> &x, double factor, unsigned threads) {
+    for_each_block(static_cast<int>(x.size()), threads, [&](int begin, int end, Partial &) {
+        for (int i = begin; i < end; ++i) {
+            x[i] = static_cast<Scalar>(x[i] * factor);
+        }
+    });
+}
+
+template <class Scalar>
+double sum_of_squares(const std::vector<Scalar> &x, unsigned threads) {
+    return for_each_block(static_cast<int>(x.size()), threads, [&](int begin, int end, Partial &p) {
+               for (int i = begin; i < end; ++i) {
+                   p.mass += double(x[i]) * x[i];
+               }
+           }).mass;
+}
+
+// Recorrido f(v, w) de las aristas de u en cada representación.
+template <class F>
+void each_edge(const Graph &g, int u, F &&f) {
+    for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+        f(g.target(e), g.weight(e));
+    }
+}
+
+template <class F>
+void each_edge(const CompressedGraph &g, int u, F &&f) {
+    g.for_each_neighbor(u, f);
+}
+
+template <class Scalar, class G>
+RankResult<Scalar> run_pagerank(const G &g, const std::vector<double> *teleport,
+                                const RankOptions &o) {
+    check_options(o);
+    if (!(o.damping >= 0.0 && o.damping < 1.0)) {
+        throw std::invalid_argument("El amortiguamiento debe estar en [0, 1)");
+    }
+    if (o.weighted && g.has_negative_weights()) {
+        throw std::invalid_argument("PageRank no admite pesos negativos");
+    }
+    const int n = g.num_vertices();
+    RankResult<Scalar> out;
+    if (n == 0) {
+        out.converged = true;
+        return out;
+    }
+    const unsigned threads = o.threads;
+    const double d = o.damping;
+    const double uniform = 1.0 / n;
+    auto p = [&](int v) { return teleport ? (*teleport)[v] : uniform; };
+    const G in = o.symmetric ? g : transpose(g, threads);
+
+    // inv_out[u] = 1 / peso de salida (0 en vértices sin salidas).
+    std::vector<Scalar> inv_out(n);
+    std::vector<Scalar> cur(n), next(n);
+    double dangling = for_each_block(n, threads, [&](int begin, int end, Partial &part) {
+                          for (int u = begin; u < end; ++u) {
+                              double w = 0.0;
+                              each_edge(g, u, [&](int, double we) { w += o.weighted ? we : 1.0; });
+                              inv_out[u] = static_cast<Scalar>(w > 0.0 ? 1.0 / w : 0.0);
+                              cur[u] = static_cast<Scalar>(p(u));
+                              if (w <= 0.0) {
+                                  part.dangling += p(u);
+                              }
+                          }
+                      }).dangling;
+
+    const bool gauss_seidel = o.acceleration == RankAcceleration::GaussSeidel;
+    Aitken<Scalar> aitken(o, n);
+    for (int it = 1; it <= o.max_iter; ++it) {
+        Partial step = for_each_block(n, threads, [&](int begin, int end, Partial &part) {
+            for (int v = begin; v < end; ++v) {
+                double acc = 0.0;
+                each_edge(in, v, [&](int u, double we) {
+                    // Gauss–Seidel: dentro del bloque, valores ya actualizados.
+                    const double xu = gauss_seidel && u >= begin && u < v ? next[u] : cur[u];
+                    acc += (o.weighted ? we : 1.0) * xu * inv_out[u];
+                });
+                const double value = (1.0 - d + d * dangling) * p(v) + d * acc;
+                next[v] = static_cast<Scalar>(value);
+                part.diff(value - cur[v]);
+                part.mass += value;
+                if (inv_out[v] == 0) {
+                    part.dangling += value;
+                }
+            }
+        });
+        dangling = step.dangling;
+        std::swap(cur, next);
+        // Jacobi conserva la masa; Gauss–Seidel y Aitken no: se renormaliza.
+        const bool extrapolated = aitken.step(it, cur, threads);
+        if (extrapolated) {
+            const Partial after = for_each_block(n, threads, [&](int begin, int end, Partial &part) {
+                for (int v = begin; v < end; ++v) {
+                    part.mass += cur[v];
+                    if (inv_out[v] == 0) {
+                        part.dangling += cur[v];
+                    }
+                }
+            });
+            step.mass = after.mass;
+            dangling = after.dangling;
+        }
+        if ((gauss_seidel || extrapolated) && step.mass > 0.0) {
+            scale(cur, 1.0 / step.mass, threads);
+            dangling /= step.mass;
+        }
+        out.iterations = it;
+        out.residual = residual(step, o.norm);
+        if (!extrapolated && out.residual < o.tolerance) {
+            out.converged = true;
+            break;
+        }
+    }
+    out.scores = std::move(cur);
+    return out;
+}
+
+} // namespace
+
+template <class Scalar>
+RankResult<Scalar> eigenvector_centrality(const Graph &g, const RankOptions &o) {
+    check_options(o);
+    if (o.acceleration == RankAcceleration::GaussSeidel) {
+        throw std::invalid_argument("Gauss–Seidel sólo se aplica a PageRank");
+    }
+    const int n = g.num_vertices();
+    const unsigned threads = o.threads;
+    RankResult<Scalar> out;
+    std::vector<Scalar> cur(n, static_cast<Scalar>(n ? 1.0 / std::sqrt(double(n)) : 0.0)), next(n);
+    Aitken<Scalar> aitken(o, n);
+    for (int it = 1; it <= o.max_iter && n > 0; ++it) {
+        const double norm2 = for_each_block(n, threads, [&](int begin, int end, Partial &part) {
+                                 for (int u = begin; u < end; ++u) {
+                                     double acc = cur[u];
+                                     for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+                                         acc += (o.weighted ? g.weight(e) : 1.0) * cur[g.target(e)];
+                                     }
+                                     next[u] = static_cast<Scalar>(acc);
+                                     part.mass += acc * acc;
+                                 }
+                             }).mass;
+        if (norm2 == 0.0) {
+            std::fill(cur.begin(), cur.end(), Scalar(0));
+            break;
+        }
+        const double inv = 1.0 / std::sqrt(norm2);
+        Partial step = for_each_block(n, threads, [&](int begin, int end, Partial &part) {
+            for (int u = begin; u < end; ++u) {
+                next[u] = static_cast<Scalar>(next[u] * inv);
+                part.diff(double(next[u]) - cur[u]);
+            }
+        });
+        std::swap(cur, next);
+        const bool extrapolated = aitken.step(it, cur, threads);
+        if (extrapolated) {
+            scale(cur, 1.0 / std::sqrt(sum_of_squares(cur, threads)), threads);
+        }
+        out.iterations = it;
+        out.residual = residual(step, o.norm);
+        if (!extrapolated && out.residual < o.tolerance) {
+            out.converged = true;
+            break;
+        }
+    }
+    // Normalización final por la suma, como en graph_algorithms.py.
+    double total = for_each_block(n, threads, [&](int begin, int end, Partial &part) {
+                       for (int u = begin; u < end; ++u) {
+                           part.mass += cur[u];
+                       }
+                   }).mass;
+    if (total != 0.0) {
+        scale(cur, 1.0 / total, threads);
+    }
+    out.scores = std::move(cur);
+    return out;
+}
+
+template <class Scalar>
+RankResult<Scalar> pagerank(const Graph &g, const RankOptions &options) {
+    return run_pagerank<Scalar>(g, nullptr, options);
+}
+
+template <class Scalar>
+RankResult<Scalar> pagerank(const CompressedGraph &g, const RankOptions &options) {
+    return run_pagerank<Scalar>(g, nullptr, options);
+}
+
+namespace {
+
+// Teletransporte normalizado a partir de una personalización no negativa.
+std::vector<double> teleport_vector(int n, const std::vector<double> &personalization) {
+    if (personalization.size() != static_cast<std::size_t>(n)) {
+        throw std::invalid_argument("Se necesita un valor de personalización por vértice");
+    }
+    double total = 0.0;
+    for (double x : personalization) {
+        if (!(x >= 0.0)) {
+            throw std::invalid_argument("La personalización debe ser no negativa");
+        }
+        total += x;
+    }
+    if (total <= 0.0) {
+        throw std::invalid_argument("La personalización no puede ser nula");
+    }
+    std::vector<double> teleport(personalization);
+    for (double &x : teleport) {
+        x /= total;
+    }
+    return teleport;
+}
+
+} // namespace
+
+template <class Scalar>
+RankResult<Scalar> personalized_pagerank(const Graph &g, const std::vector<double> &personalization,
+                                         const RankOptions &options) {
+    const std::vector<double> teleport = teleport_vector(g.num_vertices(), personalization);
+    return run_pagerank<Scalar>(g, &teleport, options);
+}
+
+template <class Scalar>
+RankResult<Scalar> personalized_pagerank(const CompressedGraph &g,
+                                         const std::vector<double> &personalization,
+                                         const RankOptions &options) {
+    const std::vector<double> teleport = teleport_vector(g.num_vertices(), personalization);
+    return run_pagerank<Scalar>(g, &teleport, options);
+}
+
+std::vector<double> seed_personalization(int n, const std::vector<int> &seeds) {
+    std::vector<double> p(n, 0.0);
+    for (int s : seeds) {
+        if (s < 0 || s >= n) {
+            throw std::out_of_range("Vértice semilla fuera de rango");
+        }
+        p[s] = 1.0;
+    }
+    return p;
+}
+
+template RankResult<double> eigenvector_centrality<double>(const Graph &, const RankOptions &);
+template RankResult<float> eigenvector_centrality<float>(const Graph &, const RankOptions &);
+template RankResult<double> pagerank<double>(const Graph &, const RankOptions &);
+template RankResult<float> pagerank<float>(const Graph &, const RankOptions &);
+template RankResult<double> personalized_pagerank<double>(const Graph &, const std::vector<double> &,
+                                                          const RankOptions &);
+template RankResult<float> personalized_pagerank<float>(const Graph &, const std::vector<double> &,
+                                                        const RankOptions &);
+template RankResult<double> pagerank<double>(const CompressedGraph &, const RankOptions &);
+template RankResult<float> pagerank<float>(const CompressedGraph &, const RankOptions &);
+template RankResult<double> personalized_pagerank<double>(const CompressedGraph &,
+                                                          const std::vector<double> &,
+                                                          const RankOptions &);
+template RankResult<float> personalized_pagerank<float>(const CompressedGraph &,
+                                                        const std::vector<double> &,
+                                                        const RankOptions &);
+
+} // namespace graphs
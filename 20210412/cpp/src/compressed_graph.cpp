@@ -0,0 +1,462 @@
+#include "compressed_graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "parallel.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GRAPHS_SVB_SSSE3 1
+#include <immintrin.h>
+#endif
+
+namespace graphs {
+
+namespace {
+
+// Bloque fijo de vértices: unidad de reparto al codificar.
+constexpr std::size_t kBlock = 4096;
+// Relleno al final de los registros para las lecturas de 16 bytes.
+constexpr std::size_t kPadding = 16;
+
+using Row = std::vector<std::pair<int, std::uint64_t>>;
+
+inline std::uint32_t zigzag(std::int64_t x) {
+    return static_cast<std::uint32_t>((static_cast<std::uint64_t>(x) << 1) ^
+                                      static_cast<std::uint64_t>(x >> 63));
+}
+
+inline std::int64_t unzigzag(std::uint32_t x) {
+    return static_cast<std::int64_t>(x >> 1) ^ -static_cast<std::int64_t>(x & 1);
+}
+
+void put_varint(std::uint64_t x, std::vector<std::uint8_t> &out) {
+    while (x >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(x | 0x80));
+        x >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(x));
+}
+
+inline std::uint64_t get_varint(const std::uint8_t *&p) {
+    std::uint64_t x = 0;
+    for (int shift = 0;; shift += 7) {
+        const std::uint8_t b = *p++;
+        x |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+        if (!(b & 0x80)) {
+            return x;
+        }
+    }
+}
+
+inline unsigned byte_length(std::uint32_t x) {
+    return x < (1u << 8) ? 1 : x < (1u << 16) ? 2 : x < (1u << 24) ? 3 : 4;
+}
+
+// Tablas de StreamVByte por byte de control: longitud de los datos del
+// grupo y máscara pshufb que lleva cada valor a su carril de 32 bits.
+struct StreamVByteTables {
+    std::uint8_t length[256];
+    alignas(16) std::uint8_t shuffle[256][16];
+
+    StreamVByteTables() {
+        for (int c = 0; c < 256; ++c) {
+            int offset = 0;
+            for (int lane = 0; lane < 4; ++lane) {
+                const int len = ((c >> (2 * lane)) & 3) + 1;
+                for (int b = 0; b < 4; ++b) {
+                    shuffle[c][4 * lane + b] = b < len ? static_cast<std::uint8_t>(offset + b) : 0x80;
+                }
+                offset += len;
+            }
+            length[c] = static_cast<std::uint8_t>(offset);
+        }
+    }
+};
+
+const StreamVByteTables &svb_tables() {
+    static const StreamVByteTables tables;
+    return tables;
+}
+
+inline std::uint32_t get_bytes(const std::uint8_t *p, unsigned len) {
+    std::uint32_t x = 0;
+    for (unsigned b = 0; b < len; ++b) {
+        x |= static_cast<std::uint32_t>(p[b]) << (8 * b);
+    }
+    return x;
+}
+
+// Decodifica `count` valores (count <= 4) de un grupo.
+const std::uint8_t *decode_group_scalar(std::uint8_t control, const std::uint8_t *data,
+                                        std::size_t count, std::uint32_t *out) {
+    for (std::size_t lane = 0; lane < count; ++lane) {
+        const unsigned len = ((control >> (2 * lane)) & 3) + 1;
+        out[lane] = get_bytes(data, len);
+        data += len;
+    }
+    return data;
+}
+
+const std::uint8_t *decode_groups_scalar(const std::uint8_t *control, const std::uint8_t *data,
+                                         std::size_t groups, std::uint32_t *out) {
+    for (std::size_t g = 0; g < groups; ++g) {
+        data = decode_group_scalar(control[g], data, 4, out + 4 * g);
+    }
+    return data;
+}
+
+#ifdef GRAPHS_SVB_SSSE3
+__attribute__((target("ssse3"))) const std::uint8_t *
+decode_groups_ssse3(const std::uint8_t *control, const std::uint8_t *data, std::size_t groups,
+                    std::uint32_t *out) {
+    const StreamVByteTables &t = svb_tables();
+    for (std::size_t g = 0; g < groups; ++g) {
+        const std::uint8_t c = control[g];
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+        const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i *>(t.shuffle[c]));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4 * g), _mm_shuffle_epi8(bytes, mask));
+        data += t.length[c];
+    }
+    return data;
+}
+
+bool has_ssse3() {
+    static const bool ok = __builtin_cpu_supports("ssse3");
+    return ok;
+}
+#endif
+
+const std::uint8_t *decode_groups(const std::uint8_t *control, const std::uint8_t *data,
+                                  std::size_t groups, std::uint32_t *out) {
+#ifdef GRAPHS_SVB_SSSE3
+    if (has_ssse3()) {
+        return decode_groups_ssse3(control, data, groups, out);
+    }
+#endif
+    return decode_groups_scalar(control, data, groups, out);
+}
+
+template <class T>
+void put_raw(T value, std::vector<std::uint8_t> &out) {
+    std::uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void encode_row(int u, const Row &row, NeighborCodec codec, unsigned width,
+                std::vector<std::uint8_t> &out) {
+    const std::size_t d = row.size();
+    put_varint(d, out);
+    for (const auto &[v, code] : row) {
+        switch (width) {
+        case 1:
+            out.push_back(static_cast<std::uint8_t>(code));
+            break;
+        case 2:
+            put_raw(static_cast<std::uint16_t>(code), out);
+            break;
+        case 4:
+            put_raw(static_cast<std::uint32_t>(code), out);
+            break;
+        case 8:
+            put_raw(code, out);
+            break;
+        default:
+            break;
+        }
+    }
+    std::int64_t previous = u;
+    auto raw = [&](std::size_t i) {
+        const std::int64_t t = row[i].first;
+        const std::uint32_t x = i == 0 ? zigzag(t - previous) : static_cast<std::uint32_t>(t - previous);
+        previous = t;
+        return x;
+    };
+    if (codec == NeighborCodec::Varint) {
+        for (std::size_t i = 0; i < d; ++i) {
+            put_varint(raw(i), out);
+        }
+        return;
+    }
+    const std::size_t control = out.size();
+    out.resize(out.size() + (d + 3) / 4, 0);
+    for (std::size_t i = 0; i < d; ++i) {
+        const std::uint32_t x = raw(i);
+        const unsigned len = byte_length(x);
+        out[control + i / 4] |= static_cast<std::uint8_t>((len - 1) << (2 * (i % 4)));
+        for (unsigned b = 0; b < len; ++b) {
+            out.push_back(static_cast<std::uint8_t>(x >> (8 * b)));
+        }
+    }
+}
+
+} // namespace
+
+template <class Rows>
+void CompressedGraph::encode(Rows &&rows, unsigned threads) {
+    const std::size_t n = static_cast<std::size_t>(n_);
+    const std::size_t blocks = (n + kBlock - 1) / kBlock;
+    std::vector<std::vector<std::uint8_t>> chunks(blocks);
+    auto storage = std::make_shared<Storage>();
+    auto &offsets = storage->offsets;
+    auto &bytes = storage->bytes;
+    // offsets[u] guarda primero el tamaño del registro de u.
+    offsets.assign(n + 1, 0);
+    parallel::for_each_index(blocks, threads, 1, [&](unsigned, std::size_t b) {
+        Row row;
+        auto &out = chunks[b];
+        for (std::size_t u = b * kBlock; u < std::min(n, (b + 1) * kBlock); ++u) {
+            row.clear();
+            rows(static_cast<int>(u), row);
+            const std::size_t before = out.size();
+            encode_row(static_cast<int>(u), row, neighbor_codec_, weight_width_, out);
+            offsets[u] = out.size() - before;
+        }
+    });
+    const std::uint64_t total = parallel::exclusive_scan(offsets, threads);
+    bytes.assign(total + kPadding, 0);
+    parallel::for_each_index(blocks, threads, 1, [&](unsigned, std::size_t b) {
+        std::copy(chunks[b].begin(), chunks[b].end(), bytes.begin() + offsets[b * kBlock]);
+        std::vector<std::uint8_t>().swap(chunks[b]);
+    });
+    offsets_ = offsets.data();
+    bytes_ = bytes.data();
+    storage_ = std::move(storage);
+}
+
+CompressedGraph::CompressedGraph(const Graph &g, const CompressOptions &options)
+    : n_(g.num_vertices()), m_(g.num_edges()), has_negative_weights_(g.has_negative_weights()),
+      neighbor_codec_(options.neighbors), weight_codec_(options.weights) {
+    double lo = std::numeric_limits<double>::infinity();
+    double hi = -lo;
+    bool finite = true;
+    for (double w : g.weights()) {
+        lo = std::min(lo, w);
+        hi = std::max(hi, w);
+        finite = finite && std::isfinite(w);
+    }
+    const bool quantized = weight_codec_ == WeightCodec::Quantized16 || weight_codec_ == WeightCodec::Quantized8;
+    if (m_ == 0 || lo == hi) {
+        weight_width_ = 0;
+        weight_base_ = m_ == 0 ? 0.0 : lo;
+    } else if (quantized) {
+        if (!finite) {
+            throw std::invalid_argument("No se pueden cuantizar pesos no finitos");
+        }
+        const double levels = weight_codec_ == WeightCodec::Quantized16 ? 65535.0 : 255.0;
+        weight_width_ = weight_codec_ == WeightCodec::Quantized16 ? 2 : 1;
+        weight_base_ = lo;
+        weight_step_ = (hi - lo) / levels;
+        weight_error_ = weight_step_ / 2.0;
+    } else if (weight_codec_ == WeightCodec::Float32) {
+        weight_width_ = 4;
+        weight_error_ = finite ? std::max(std::fabs(lo), std::fabs(hi)) * std::ldexp(1.0, -24) : 0.0;
+    } else {
+        weight_width_ = 8;
+    }
+
+    auto code = [&](double w) -> std::uint64_t {
+        switch (weight_width_) {
+        case 0:
+            return 0;
+        case 1:
+        case 2: {
+            const double levels = weight_width_ == 2 ? 65535.0 : 255.0;
+            return static_cast<std::uint64_t>(std::clamp(std::llround((w - weight_base_) / weight_step_),
+                                                         0LL, static_cast<long long>(levels)));
+        }
+        case 4: {
+            const float f = static_cast<float>(w);
+            std::uint32_t bits;
+            std::memcpy(&bits, &f, 4);
+            return bits;
+        }
+        default: {
+            std::uint64_t bits;
+            std::memcpy(&bits, &w, 8);
+            return bits;
+        }
+        }
+    };
+    encode(
+        [&](int u, Row &row) {
+            for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+                row.emplace_back(g.target(e), code(g.weight(e)));
+            }
+            std::sort(row.begin(), row.end());
+        },
+        options.threads);
+}
+
+std::size_t CompressedGraph::degree(int u) const {
+    const std::uint8_t *p = bytes_ + offsets_[u];
+    return static_cast<std::size_t>(get_varint(p));
+}
+
+std::size_t CompressedGraph::memory_bytes() const {
+    if (!storage_) {
+        return 0;
+    }
+    return storage_->bytes.size() + storage_->offsets.size() * sizeof(std::uint64_t);
+}
+
+bool CompressedGraph::simd_decode() {
+#ifdef GRAPHS_SVB_SSSE3
+    return has_ssse3();
+#else
+    return false;
+#endif
+}
+
+CompressedGraph::Cursor CompressedGraph::cursor(int u) const {
+    Cursor c;
+    const std::uint8_t *p = bytes_ + offsets_[u];
+    c.degree = c.remaining = static_cast<std::size_t>(get_varint(p));
+    c.weights = p;
+    p += c.degree * weight_width_;
+    if (neighbor_codec_ == NeighborCodec::StreamVByte) {
+        c.control = p;
+        p += (c.degree + 3) / 4;
+    }
+    c.data = p;
+    c.previous = u;
+    return c;
+}
+
+std::size_t CompressedGraph::next_targets(Cursor &c, int *out) const {
+    const std::size_t k = std::min(c.remaining, kChunk);
+    std::uint32_t raw[kChunk];
+    if (neighbor_codec_ == NeighborCodec::Varint) {
+        for (std::size_t j = 0; j < k; ++j) {
+            raw[j] = static_cast<std::uint32_t>(get_varint(c.data));
+        }
+    } else {
+        // Los bloques empiezan en frontera de grupo; sólo el último de la
+        // fila puede acabar en un grupo incompleto.
+        const std::size_t groups = k / 4;
+        c.data = decode_groups(c.control, c.data, groups, raw);
+        c.control += groups;
+        if (k % 4) {
+            c.data = decode_group_scalar(*c.control++, c.data, k % 4, raw + 4 * groups);
+        }
+    }
+    std::size_t j = 0;
+    if (c.remaining == c.degree && k > 0) {
+        c.previous += unzigzag(raw[0]);
+        out[0] = static_cast<int>(c.previous);
+        j = 1;
+    }
+    for (; j < k; ++j) {
+        c.previous += raw[j];
+        out[j] = static_cast<int>(c.previous);
+    }
+    c.remaining -= k;
+    return k;
+}
+
+std::uint64_t CompressedGraph::weight_code(const std::uint8_t *weights, std::size_t i) const {
+    switch (weight_width_) {
+    case 0:
+        return 0;
+    case 1:
+        return weights[i];
+    case 2: {
+        std::uint16_t x;
+        std::memcpy(&x, weights + 2 * i, 2);
+        return x;
+    }
+    case 4: {
+        std::uint32_t x;
+        std::memcpy(&x, weights + 4 * i, 4);
+        return x;
+    }
+    default: {
+        std::uint64_t x;
+        std::memcpy(&x, weights + 8 * i, 8);
+        return x;
+    }
+    }
+}
+
+Graph CompressedGraph::decompress() const {
+    std::vector<std::size_t> offsets(static_cast<std::size_t>(n_) + 1, 0);
+    for (int u = 0; u < n_; ++u) {
+        offsets[u] = degree(u);
+    }
+    parallel::exclusive_scan(offsets, 0);
+    std::vector<int> targets(m_);
+    std::vector<double> weights(m_);
+    parallel::for_each_index(static_cast<std::size_t>(n_), 0, kBlock, [&](unsigned, std::size_t u) {
+        std::size_t e = offsets[u];
+        for_each_neighbor(static_cast<int>(u), [&](int v, double w) {
+            targets[e] = v;
+            weights[e] = w;
+            ++e;
+        });
+    });
+    return Graph(std::move(offsets), std::move(targets), std::move(weights));
+}
+
+CompressedGraph transpose(const CompressedGraph &g, unsigned threads) {
+    const std::size_t n = static_cast<std::size_t>(g.n_);
+    CompressedGraph t;
+    t.n_ = g.n_;
+    t.m_ = g.m_;
+    t.has_negative_weights_ = g.has_negative_weights_;
+    t.neighbor_codec_ = g.neighbor_codec_;
+    t.weight_codec_ = g.weight_codec_;
+    t.weight_width_ = g.weight_width_;
+    t.weight_base_ = g.weight_base_;
+    t.weight_step_ = g.weight_step_;
+    t.weight_error_ = g.weight_error_;
+
+    // Grados de entrada, desplazamientos y reparto con cursores atómicos;
+    // los pesos viajan con su código, sin recuantizar.
+    std::vector<std::atomic<std::size_t>> cursor(n + 1);
+    parallel::for_each_index(n, threads, kBlock, [&](unsigned, std::size_t u) {
+        g.for_each_neighbor(static_cast<int>(u), [&](int v, double) {
+            cursor[v].fetch_add(1, std::memory_order_relaxed);
+        });
+    });
+    std::vector<std::size_t> offsets(n + 1, 0);
+    for (std::size_t v = 0; v < n; ++v) {
+        offsets[v] = cursor[v].load(std::memory_order_relaxed);
+    }
+    parallel::exclusive_scan(offsets, threads);
+    for (std::size_t v = 0; v <= n; ++v) {
+        cursor[v].store(offsets[v], std::memory_order_relaxed);
+    }
+    std::vector<int> sources(g.m_);
+    std::vector<std::uint64_t> codes(g.m_);
+    parallel::for_each_index(n, threads, kBlock, [&](unsigned, std::size_t u) {
+        CompressedGraph::Cursor c = g.cursor(static_cast<int>(u));
+        int buffer[CompressedGraph::kChunk];
+        std::size_t index = 0;
+        while (c.remaining > 0) {
+            const std::size_t k = g.next_targets(c, buffer);
+            for (std::size_t j = 0; j < k; ++j, ++index) {
+                const std::size_t pos = cursor[buffer[j]].fetch_add(1, std::memory_order_relaxed);
+                sources[pos] = static_cast<int>(u);
+                codes[pos] = g.weight_code(c.weights, index);
+            }
+        }
+    });
+    t.encode(
+        [&](int v, Row &row) {
+            for (std::size_t p = offsets[v]; p < offsets[v + 1]; ++p) {
+                row.emplace_back(sources[p], codes[p]);
+            }
+            std::sort(row.begin(), row.end());
+        },
+        threads);
+    return t;
+}
+
+} // namespace graphs
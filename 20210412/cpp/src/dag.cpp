@@ -0,0 +1,224 @@
+#include "dag.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace graphs {
+
+namespace {
+
+constexpr char kWhite = 0, kGray = 1, kBlack = 2;
+
+// DFS iterativo por índice creciente sobre los vértices con allowed[v] (todos
+// si allowed es nulo).  Añade el postorden a `post` si se pide.  Devuelve el
+// primer ciclo encontrado o un vector vacío.
+std::vector<int> dfs(const Graph &g, const std::vector<char> *allowed, std::vector<int> *post) {
+    const int n = g.num_vertices();
+    std::vector<char> color(n, kWhite);
+    std::vector<std::pair<int, std::size_t>> stack;
+    auto usable = [&](int v) { return !allowed || (*allowed)[v]; };
+    for (int root = 0; root < n; ++root) {
+        if (color[root] != kWhite || !usable(root)) {
+            continue;
+        }
+        color[root] = kGray;
+        stack.emplace_back(root, g.edge_begin(root));
+        while (!stack.empty()) {
+            auto &[u, next] = stack.back();
+            if (next == g.edge_end(u)) {
+                color[u] = kBlack;
+                if (post) {
+                    post->push_back(u);
+                }
+                stack.pop_back();
+                continue;
+            }
+            int v = g.target(next++);
+            if (!usable(v) || color[v] == kBlack) {
+                continue;
+            }
+            if (color[v] == kGray) {
+                // Arista de retroceso: el ciclo es el tramo de la pila desde v.
+                std::vector<int> cycle;
+                std::size_t k = stack.size();
+                while (stack[k - 1].first != v) {
+                    --k;
+                }
+                for (; k <= stack.size(); ++k) {
+                    cycle.push_back(stack[k - 1].first);
+                }
+                return cycle;
+            }
+            color[v] = kGray;
+            stack.emplace_back(v, g.edge_begin(v));
+        }
+    }
+    return {};
+}
+
+TopoResult kahn(const Graph &g) {
+    const int n = g.num_vertices();
+    std::vector<int> indeg(n, 0);
+    for (std::size_t e = 0; e < g.num_edges(); ++e) {
+        ++indeg[g.target(e)];
+    }
+    TopoResult out;
+    auto &queue = out.order;
+    queue.reserve(n);
+    for (int v = 0; v < n; ++v) {
+        if (indeg[v] == 0) {
+            queue.push_back(v);
+        }
+    }
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        int u = queue[head];
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            if (--indeg[g.target(e)] == 0) {
+                queue.push_back(g.target(e));
+            }
+        }
+    }
+    if (queue.size() < static_cast<std::size_t>(n)) {
+        // Los vértices no extraídos contienen al menos un ciclo.
+        std::vector<char> left(n, 0);
+        for (int v = 0; v < n; ++v) {
+            left[v] = indeg[v] > 0;
+        }
+        out.cycle = dfs(g, &left, nullptr);
+        out.order.clear();
+    }
+    return out;
+}
+
+std::vector<int> require_order(const Graph &g) {
+    TopoResult topo = topological_sort(g);
+    if (!topo.is_dag()) {
+        throw std::runtime_error("El grafo no es un DAG: ciclo por el vértice " +
+                                 std::to_string(topo.cycle.front()));
+    }
+    return std::move(topo.order);
+}
+
+// Relaja las aristas en orden topológico desde source.  better(a, b) indica
+// si la distancia a mejora a b; `none` marca los vértices no alcanzados.
+template <class Better>
+ShortestPathTree relax_in_order(const Graph &g, int source, const std::vector<int> &order,
+                                double none, Better better) {
+    const int n = g.num_vertices();
+    if (source < 0 || source >= n) {
+        throw std::out_of_range("Nodo origen fuera de rango");
+    }
+    if (order.size() != static_cast<std::size_t>(n)) {
+        throw std::invalid_argument("El orden topológico no cubre todos los vértices");
+    }
+    ShortestPathTree tree;
+    tree.dist.assign(n, none);
+    tree.parent.assign(n, -1);
+    tree.dist[source] = 0.0;
+    // Los vértices anteriores al origen en el orden no son alcanzables.
+    auto it = std::find(order.begin(), order.end(), source);
+    for (; it != order.end(); ++it) {
+        const int u = *it;
+        const double d = tree.dist[u];
+        if (d == none) {
+            continue;
+        }
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            const int v = g.target(e);
+            const double alt = d + g.weight(e);
+            if (better(alt, tree.dist[v])) {
+                tree.dist[v] = alt;
+                tree.parent[v] = u;
+            }
+        }
+    }
+    return tree;
+}
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+} // namespace
+
+TopoResult topological_sort(const Graph &g, TopoMethod method) {
+    if (method == TopoMethod::Kahn) {
+        return kahn(g);
+    }
+    TopoResult out;
+    out.order.reserve(g.num_vertices());
+    out.cycle = dfs(g, nullptr, &out.order);
+    if (out.is_dag()) {
+        std::reverse(out.order.begin(), out.order.end());
+    } else {
+        out.order.clear();
+    }
+    return out;
+}
+
+ShortestPathTree dag_shortest_paths(const Graph &g, int source, const std::vector<int> &order) {
+    return relax_in_order(g, source, order, kInf, [](double a, double b) { return a < b; });
+}
+
+ShortestPathTree dag_longest_paths(const Graph &g, int source, const std::vector<int> &order) {
+    return relax_in_order(g, source, order, -kInf, [](double a, double b) { return a > b; });
+}
+
+ShortestPathTree dag_shortest_paths(const Graph &g, int source) {
+    return dag_shortest_paths(g, source, require_order(g));
+}
+
+ShortestPathTree dag_longest_paths(const Graph &g, int source) {
+    return dag_longest_paths(g, source, require_order(g));
+}
+
+CriticalPath critical_path(const Graph &g, const std::vector<double> &durations) {
+    const int n = g.num_vertices();
+    if (!durations.empty() && durations.size() != static_cast<std::size_t>(n)) {
+        throw std::invalid_argument("Se necesita una duración por tarea");
+    }
+    auto duration = [&](int v) { return durations.empty() ? 0.0 : durations[v]; };
+    const std::vector<int> order = require_order(g);
+
+    CriticalPath out;
+    auto &es = out.earliest_start;
+    auto &ls = out.latest_start;
+    es.assign(n, 0.0);
+    std::vector<int> parent(n, -1);
+    int last = -1;
+    for (int u : order) {
+        const double finish = es[u] + duration(u);
+        if (last < 0 || finish > out.length) {
+            out.length = finish;
+            last = u;
+        }
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            const int v = g.target(e);
+            const double start = finish + g.weight(e);
+            if (start > es[v]) {
+                es[v] = start;
+                parent[v] = u;
+            }
+        }
+    }
+    out.length = std::max(out.length, 0.0);
+
+    ls.resize(n);
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        const int u = *it;
+        double latest_finish = out.length;
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            latest_finish = std::min(latest_finish, ls[g.target(e)] - g.weight(e));
+        }
+        ls[u] = latest_finish - duration(u);
+    }
+
+    for (int v = last; v != -1; v = parent[v]) {
+        out.path.push_back(v);
+    }
+    std::reverse(out.path.begin(), out.path.end());
+    return out;
+}
+
+} // namespace graphs
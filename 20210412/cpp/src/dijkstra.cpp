@@ -1,6 +1,10 @@
 #include "dijkstra.hpp"
 
+#include <algorithm>
 #include <queue>
+#include <stdexcept>
+
+#include "compressed_graph.hpp"
 
 namespace graphs {
 
@@ -10,12 +14,88 @@ struct NodeCmp {
     }
 };
 
-std::vector<double> dijkstra(int n, const AdjList &adj, int source) {
-    std::vector<double> dist(n, std::numeric_limits<double>::infinity());
+namespace {
+
+// Recorrido de aristas sobre listas de adyacencia.
+struct AdjEdges {
+    const AdjList &adj;
+    template <class F>
+    void operator()(int u, F &&relax) const {
+        for (const auto &edge : adj[u]) {
+            relax(edge.first, edge.second);
+        }
+    }
+};
+
+// Igual que AdjEdges pero comprobando el signo de cada peso; se usa en las
+// consultas acotadas sobre AdjList, donde revisar todo el grafo costaría O(E).
+struct CheckedAdjEdges {
+    const AdjList &adj;
+    template <class F>
+    void operator()(int u, F &&relax) const {
+        for (const auto &edge : adj[u]) {
+            if (edge.second < 0.0) {
+                throw std::runtime_error("Dijkstra no admite pesos negativos");
+            }
+            relax(edge.first, edge.second);
+        }
+    }
+};
+
+// Recorrido de aristas sobre el CSR; los pesos ya están validados.
+template <class G>
+struct CsrEdges {
+    const G &g;
+    template <class F>
+    void operator()(typename G::vertex_type u, F &&relax) const {
+        for (std::size_t e = g.edge_begin(u), end = g.edge_end(u); e < end; ++e) {
+            relax(g.target(e), g.weight(e));
+        }
+    }
+};
+
+// Recorrido de aristas sobre el CSR comprimido, decodificando por bloques.
+struct CompressedEdges {
+    const CompressedGraph &g;
+    template <class F>
+    void operator()(int u, F &&relax) const {
+        g.for_each_neighbor(u, relax);
+    }
+};
+
+template <class Vertex>
+void check_source(Vertex n, Vertex source) {
+    if (source < 0 || source >= n) {
+        throw std::out_of_range("Nodo origen fuera de rango");
+    }
+}
+
+template <class G>
+void require_non_negative(const G &g) {
+    if (g.has_negative_weights()) {
+        throw std::runtime_error("Dijkstra no admite pesos negativos");
+    }
+}
+
+// Orden del montículo por distancia (igual que NodeCmp, para cualquier tipo).
+struct DistanceGreater {
+    template <class P>
+    bool operator()(const P &a, const P &b) const {
+        return a.first > b.first;
+    }
+};
+
+template <class Vertex, class D, class Edges>
+void full_search(Vertex n, Vertex source, const Edges &edges, std::vector<D> &dist,
+                 std::vector<Vertex> *parent) {
+    dist.assign(n, WeightTraits<D>::infinity());
+    if (parent) {
+        parent->assign(n, -1);
+    }
     std::vector<bool> visited(n, false);
-    dist[source] = 0.0;
-    std::priority_queue<std::pair<double, int>, std::vector<std::pair<double, int>>, NodeCmp> pq;
-    pq.emplace(0.0, source);
+    dist[source] = D(0);
+    std::priority_queue<std::pair<D, Vertex>, std::vector<std::pair<D, Vertex>>, DistanceGreater> pq;
+    pq.emplace(D(0), source);
     while (!pq.empty()) {
         auto [d, u] = pq.top();
         pq.pop();
@@ -23,20 +103,268 @@ std::vector<double> dijkstra(int n, const AdjList &adj, int source) {
             continue;
         }
         visited[u] = true;
-        for (const auto &edge : adj[u]) {
-            int v = edge.first;
-            double w = edge.second;
-            if (w < 0.0) {
-                throw std::runtime_error("Dijkstra no admite pesos negativos");
-            }
-            double alt = d + w;
+        edges(u, [&](Vertex v, auto w) {
+            const D alt = d + static_cast<D>(w);
             if (alt < dist[v]) {
                 dist[v] = alt;
+                if (parent) {
+                    (*parent)[v] = u;
+                }
                 pq.emplace(alt, v);
             }
+        });
+    }
+}
+
+template <class Edges>
+SparseDistances limited_search(int n, int source, const QueryLimits &limits, const Edges &edges,
+                               DijkstraWorkspace &ws) {
+    check_source(n, source);
+    SparseDistances out;
+    if (limits.max_settled == 0 || limits.max_dist < 0.0) {
+        return out;
+    }
+    ws.prepare(n);
+    auto &heap = ws.heap();
+    NodeCmp cmp;
+    ws.label(source, 0.0, -1);
+    heap.emplace_back(0.0, source);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), cmp);
+        auto [d, u] = heap.back();
+        heap.pop_back();
+        if (ws.settled(u)) {
+            continue;
+        }
+        // El montículo extrae en orden no decreciente: el resto queda fuera del radio.
+        if (d > limits.max_dist) {
+            break;
+        }
+        ws.settle(u);
+        if (!limits.accept || limits.accept(u)) {
+            out.vertices.push_back(u);
+            out.dist.push_back(d);
+            out.parent.push_back(ws.parent(u));
+            if (out.vertices.size() >= limits.max_settled) {
+                break;
+            }
         }
+        edges(u, [&](int v, double w) {
+            double alt = d + w;
+            if (alt <= limits.max_dist && alt < ws.dist(v)) {
+                ws.label(v, alt, u);
+                heap.emplace_back(alt, v);
+                std::push_heap(heap.begin(), heap.end(), cmp);
+            }
+        });
     }
+    return out;
+}
+
+} // namespace
+
+std::vector<double> dijkstra(int n, const AdjList &adj, int source) {
+    check_source(n, source);
+    // Validación previa: un peso negativo se rechaza antes de hacer trabajo.
+    for (const auto &edges : adj) {
+        for (const auto &edge : edges) {
+            if (edge.second < 0.0) {
+                throw std::runtime_error("Dijkstra no admite pesos negativos");
+            }
+        }
+    }
+    std::vector<double> dist;
+    full_search(n, source, AdjEdges{adj}, dist, static_cast<std::vector<int> *>(nullptr));
     return dist;
 }
 
-} // namespace graphs
\ No newline at end of file
+template <class Vertex, class Weight>
+std::vector<Distance<Weight>> dijkstra(const BasicGraph<Vertex, Weight> &g,
+                                       typename BasicGraph<Vertex, Weight>::vertex_type source) {
+    check_source(g.num_vertices(), source);
+    require_non_negative(g);
+    std::vector<Distance<Weight>> dist;
+    full_search(g.num_vertices(), source, CsrEdges<BasicGraph<Vertex, Weight>>{g}, dist,
+                static_cast<std::vector<Vertex> *>(nullptr));
+    return dist;
+}
+
+template <class Vertex, class Weight>
+BasicShortestPathTree<Vertex, Weight> dijkstra_tree(const BasicGraph<Vertex, Weight> &g,
+                                                    typename BasicGraph<Vertex, Weight>::vertex_type source) {
+    check_source(g.num_vertices(), source);
+    require_non_negative(g);
+    BasicShortestPathTree<Vertex, Weight> tree;
+    full_search(g.num_vertices(), source, CsrEdges<BasicGraph<Vertex, Weight>>{g}, tree.dist, &tree.parent);
+    return tree;
+}
+
+#define GRAPHS_DIJKSTRA(V, W)                                                                 \
+    template std::vector<Distance<W>> dijkstra<V, W>(const BasicGraph<V, W> &, V);          \
+    template BasicShortestPathTree<V, W> dijkstra_tree<V, W>(const BasicGraph<V, W> &, V);
+GRAPHS_INSTANTIATE(GRAPHS_DIJKSTRA)
+#undef GRAPHS_DIJKSTRA
+
+std::vector<double> dijkstra(const CompressedGraph &g, int source) {
+    check_source(g.num_vertices(), source);
+    require_non_negative(g);
+    std::vector<double> dist;
+    full_search(g.num_vertices(), source, CompressedEdges{g}, dist, static_cast<std::vector<int> *>(nullptr));
+    return dist;
+}
+
+ShortestPathTree dijkstra_tree(const CompressedGraph &g, int source) {
+    check_source(g.num_vertices(), source);
+    require_non_negative(g);
+    ShortestPathTree tree;
+    full_search(g.num_vertices(), source, CompressedEdges{g}, tree.dist, &tree.parent);
+    return tree;
+}
+
+void DijkstraWorkspace::prepare(int n) {
+    if (n > capacity()) {
+        dist_.resize(n);
+        parent_.resize(n);
+        parent_edge_.resize(n);
+        seen_.resize(n, 0);
+        done_.resize(n, 0);
+    }
+    heap_.clear();
+    if (++epoch_ == 0) {
+        // Desbordamiento del contador: se limpian los sellos una sola vez.
+        std::fill(seen_.begin(), seen_.end(), 0);
+        std::fill(done_.begin(), done_.end(), 0);
+        epoch_ = 1;
+    }
+}
+
+void SearchMask::prepare(int n, std::size_t m) {
+    if (static_cast<std::size_t>(n) > vertex_.size()) {
+        vertex_.resize(n, 0);
+    }
+    if (m > edge_.size()) {
+        edge_.resize(m, 0);
+    }
+    if (++epoch_ == 0) {
+        std::fill(vertex_.begin(), vertex_.end(), 0);
+        std::fill(edge_.begin(), edge_.end(), 0);
+        epoch_ = 1;
+    }
+}
+
+PathResult dijkstra_path(const Graph &g, int source, int target, DijkstraWorkspace &ws,
+                         const SearchMask *mask) {
+    const int n = g.num_vertices();
+    check_source(n, source);
+    if (target < 0 || target >= n) {
+        throw std::out_of_range("Nodo destino fuera de rango");
+    }
+    require_non_negative(g);
+    PathResult out;
+    if (mask && mask->vertex_banned(target)) {
+        return out;
+    }
+    ws.prepare(n);
+    auto &heap = ws.heap();
+    NodeCmp cmp;
+    ws.label(source, 0.0, -1);
+    heap.emplace_back(0.0, source);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), cmp);
+        auto [d, u] = heap.back();
+        heap.pop_back();
+        if (ws.settled(u)) {
+            continue;
+        }
+        ws.settle(u);
+        if (u == target) {
+            out.cost = d;
+            for (int v = target; v != source; v = ws.parent(v)) {
+                out.vertices.push_back(v);
+                out.edges.push_back(ws.parent_edge(v));
+            }
+            out.vertices.push_back(source);
+            std::reverse(out.vertices.begin(), out.vertices.end());
+            std::reverse(out.edges.begin(), out.edges.end());
+            return out;
+        }
+        for (std::size_t e = g.edge_begin(u), end = g.edge_end(u); e < end; ++e) {
+            int v = g.target(e);
+            if (mask && (mask->edge_banned(e) || mask->vertex_banned(v))) {
+                continue;
+            }
+            double alt = d + g.weight(e);
+            if (alt < ws.dist(v)) {
+                ws.label(v, alt, u, e);
+                heap.emplace_back(alt, v);
+                std::push_heap(heap.begin(), heap.end(), cmp);
+            }
+        }
+    }
+    return out;
+}
+
+SparseDistances dijkstra_limited(const AdjList &adj, int source, const QueryLimits &limits,
+                                 DijkstraWorkspace &ws) {
+    return limited_search(static_cast<int>(adj.size()), source, limits, CheckedAdjEdges{adj}, ws);
+}
+
+SparseDistances dijkstra_limited(const Graph &g, int source, const QueryLimits &limits,
+                                 DijkstraWorkspace &ws) {
+    require_non_negative(g);
+    return limited_search(g.num_vertices(), source, limits, CsrEdges<Graph>{g}, ws);
+}
+
+SparseDistances dijkstra_limited(const CompressedGraph &g, int source, const QueryLimits &limits,
+                                 DijkstraWorkspace &ws) {
+    require_non_negative(g);
+    return limited_search(g.num_vertices(), source, limits, CompressedEdges{g}, ws);
+}
+
+SparseDistances dijkstra_within(const AdjList &adj, int source, double radius,
+                                DijkstraWorkspace &ws) {
+    QueryLimits limits;
+    limits.max_dist = radius;
+    return dijkstra_limited(adj, source, limits, ws);
+}
+
+SparseDistances dijkstra_within(const Graph &g, int source, double radius,
+                                DijkstraWorkspace &ws) {
+    QueryLimits limits;
+    limits.max_dist = radius;
+    return dijkstra_limited(g, source, limits, ws);
+}
+
+SparseDistances dijkstra_nearest(const AdjList &adj, int source, std::size_t k,
+                                 DijkstraWorkspace &ws) {
+    QueryLimits limits;
+    limits.max_settled = k;
+    return dijkstra_limited(adj, source, limits, ws);
+}
+
+SparseDistances dijkstra_nearest(const Graph &g, int source, std::size_t k,
+                                 DijkstraWorkspace &ws) {
+    QueryLimits limits;
+    limits.max_settled = k;
+    return dijkstra_limited(g, source, limits, ws);
+}
+
+SparseDistances dijkstra_nearest_if(const AdjList &adj, int source, std::size_t k,
+                                    const std::function<bool(int)> &accept,
+                                    DijkstraWorkspace &ws) {
+    QueryLimits limits;
+    limits.max_settled = k;
+    limits.accept = accept;
+    return dijkstra_limited(adj, source, limits, ws);
+}
+
+SparseDistances dijkstra_nearest_if(const Graph &g, int source, std::size_t k,
+                                    const std::function<bool(int)> &accept,
+                                    DijkstraWorkspace &ws) {
+    QueryLimits limits;
+    limits.max_settled = k;
+    limits.accept = accept;
+    return dijkstra_limited(g, source, limits, ws);
+}
+
+} // namespace graphs
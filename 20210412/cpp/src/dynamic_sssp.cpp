@@ -0,0 +1,243 @@
+#include "dynamic_sssp.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "parallel.hpp"
+
+namespace graphs {
+
+namespace {
+
+struct NodeCmp {
+    bool operator()(const std::pair<double, int> &a, const std::pair<double, int> &b) const {
+        return a.first > b.first;
+    }
+};
+
+void push(std::vector<std::pair<double, int>> &heap, double d, int v) {
+    heap.emplace_back(d, v);
+    std::push_heap(heap.begin(), heap.end(), NodeCmp{});
+}
+
+std::uint32_t next_epoch(std::vector<std::uint32_t> &mark, std::uint32_t &epoch) {
+    if (++epoch == 0) {
+        std::fill(mark.begin(), mark.end(), 0);
+        epoch = 1;
+    }
+    return epoch;
+}
+
+} // namespace
+
+DynamicShortestPaths::DynamicShortestPaths(const Graph &g, std::vector<int> sources, unsigned threads)
+    : n_(g.num_vertices()), offsets_(g.offsets().to_vector()), targets_(g.targets().to_vector()),
+      weights_(g.weights().to_vector()) {
+    if (g.has_negative_weights()) {
+        throw std::invalid_argument("Los caminos mínimos dinámicos requieren pesos no negativos");
+    }
+    edge_source_.resize(targets_.size());
+    in_offsets_.assign(n_ + 1, 0);
+    for (int u = 0; u < n_; ++u) {
+        for (std::size_t e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+            edge_source_[e] = u;
+            ++in_offsets_[targets_[e] + 1];
+        }
+    }
+    for (int v = 0; v < n_; ++v) {
+        in_offsets_[v + 1] += in_offsets_[v];
+    }
+    in_edges_.resize(targets_.size());
+    std::vector<std::size_t> fill(in_offsets_.begin(), in_offsets_.end() - 1);
+    for (std::size_t e = 0; e < targets_.size(); ++e) {
+        in_edges_[fill[targets_[e]]++] = e;
+    }
+
+    threads_ = parallel::effective_threads(sources.size(), threads);
+    scratch_.resize(threads_);
+    for (auto &s : scratch_) {
+        s.mark.assign(n_, 0);
+    }
+    trees_.resize(sources.size());
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        if (sources[i] < 0 || sources[i] >= n_) {
+            throw std::out_of_range("Nodo origen fuera de rango");
+        }
+        trees_[i].source = sources[i];
+    }
+    // Árboles iniciales: una propagación desde cada origen con todo a infinito.
+    parallel::for_each_index(trees_.size(), threads_, 1, [&](unsigned worker, std::size_t i) {
+        Tree &t = trees_[i];
+        Scratch &s = scratch_[worker];
+        t.dist.assign(n_, std::numeric_limits<double>::infinity());
+        t.parent_edge.assign(n_, kNoEdge);
+        t.dist[t.source] = 0.0;
+        s.heap.clear();
+        push(s.heap, 0.0, t.source);
+        propagate(t, s);
+    });
+}
+
+int DynamicShortestPaths::parent(std::size_t tree, int v) const {
+    std::size_t e = trees_[tree].parent_edge[v];
+    return e == kNoEdge ? -1 : edge_source_[e];
+}
+
+std::vector<int> DynamicShortestPaths::path(std::size_t tree, int v) const {
+    std::vector<int> out;
+    if (std::isinf(trees_[tree].dist[v])) {
+        return out;
+    }
+    for (int x = v; x != -1; x = parent(tree, x)) {
+        out.push_back(x);
+    }
+    std::reverse(out.begin(), out.end());
+    return out;
+}
+
+std::size_t DynamicShortestPaths::find_edge(int u, int v) const {
+    if (u < 0 || u >= n_) {
+        return kNoEdge;
+    }
+    for (std::size_t e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+        if (targets_[e] == v) {
+            return e;
+        }
+    }
+    return kNoEdge;
+}
+
+std::size_t DynamicShortestPaths::update(int u, int v, double weight) {
+    std::size_t e = find_edge(u, v);
+    if (e == kNoEdge) {
+        throw std::out_of_range("La arista no existe en el grafo");
+    }
+    return set_weight(e, weight);
+}
+
+std::size_t DynamicShortestPaths::update(const std::vector<WeightUpdate> &updates) {
+    std::size_t touched = 0;
+    for (const auto &up : updates) {
+        touched += update(up.u, up.v, up.weight);
+    }
+    return touched;
+}
+
+std::size_t DynamicShortestPaths::set_weight(std::size_t e, double weight) {
+    if (e >= weights_.size()) {
+        throw std::out_of_range("Índice de arista fuera de rango");
+    }
+    if (!(weight >= 0.0)) {
+        throw std::invalid_argument("Los caminos mínimos dinámicos requieren pesos no negativos");
+    }
+    double old_weight = weights_[e];
+    if (weight == old_weight) {
+        return 0;
+    }
+    weights_[e] = weight;
+    return apply(e, old_weight);
+}
+
+std::size_t DynamicShortestPaths::apply(std::size_t e, double old_weight) {
+    const bool decreased = weights_[e] < old_weight;
+    std::vector<std::size_t> touched(trees_.size(), 0);
+    parallel::for_each_index(trees_.size(), threads_, 1, [&](unsigned worker, std::size_t i) {
+        touched[i] = decreased ? decrease(trees_[i], e, scratch_[worker])
+                               : increase(trees_[i], e, scratch_[worker]);
+    });
+    std::size_t total = 0;
+    for (std::size_t t : touched) {
+        total += t;
+    }
+    return total;
+}
+
+std::size_t DynamicShortestPaths::decrease(Tree &t, std::size_t e, Scratch &s) const {
+    const int u = edge_source_[e];
+    const int v = targets_[e];
+    const double alt = t.dist[u] + weights_[e];
+    if (!(alt < t.dist[v])) {
+        return 0;
+    }
+    t.dist[v] = alt;
+    t.parent_edge[v] = e;
+    s.heap.clear();
+    push(s.heap, alt, v);
+    return propagate(t, s);
+}
+
+std::size_t DynamicShortestPaths::increase(Tree &t, std::size_t e, Scratch &s) const {
+    const int v = targets_[e];
+    if (t.parent_edge[v] != e) {
+        // La arista no pertenece al árbol: ninguna distancia cambia.
+        return 0;
+    }
+    // 1. Subárbol afectado: v y todos los vértices cuyo camino pasa por v.
+    const std::uint32_t epoch = next_epoch(s.mark, s.epoch);
+    s.affected.clear();
+    s.affected.push_back(v);
+    s.mark[v] = epoch;
+    for (std::size_t i = 0; i < s.affected.size(); ++i) {
+        int x = s.affected[i];
+        for (std::size_t f = offsets_[x]; f < offsets_[x + 1]; ++f) {
+            int y = targets_[f];
+            if (t.parent_edge[y] == f && s.mark[y] != epoch) {
+                s.mark[y] = epoch;
+                s.affected.push_back(y);
+            }
+        }
+    }
+    // 2. Mejor entrada de cada vértice afectado desde la parte no afectada.
+    s.heap.clear();
+    for (int y : s.affected) {
+        double best = std::numeric_limits<double>::infinity();
+        std::size_t best_edge = kNoEdge;
+        for (std::size_t k = in_offsets_[y]; k < in_offsets_[y + 1]; ++k) {
+            std::size_t f = in_edges_[k];
+            int z = edge_source_[f];
+            if (s.mark[z] == epoch) {
+                continue;
+            }
+            double alt = t.dist[z] + weights_[f];
+            if (alt < best) {
+                best = alt;
+                best_edge = f;
+            }
+        }
+        t.dist[y] = best;
+        t.parent_edge[y] = best_edge;
+        if (best_edge != kNoEdge) {
+            push(s.heap, best, y);
+        }
+    }
+    // 3. Dijkstra dentro del subárbol: los vértices no afectados ya son óptimos.
+    propagate(t, s);
+    return s.affected.size();
+}
+
+std::size_t DynamicShortestPaths::propagate(Tree &t, Scratch &s) const {
+    std::size_t settled = 0;
+    auto &heap = s.heap;
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), NodeCmp{});
+        auto [d, x] = heap.back();
+        heap.pop_back();
+        if (d > t.dist[x]) {
+            continue;
+        }
+        ++settled;
+        for (std::size_t f = offsets_[x]; f < offsets_[x + 1]; ++f) {
+            int y = targets_[f];
+            double alt = d + weights_[f];
+            if (alt < t.dist[y]) {
+                t.dist[y] = alt;
+                t.parent_edge[y] = f;
+                push(heap, alt, y);
+            }
+        }
+    }
+    return settled;
+}
+
+} // namespace graphs
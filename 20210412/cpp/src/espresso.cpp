@@ -0,0 +1,769 @@
+#include "espresso.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include "parallel.hpp"
+
+namespace graphs {
+
+namespace {
+
+// Por encima de este tamaño no se eliminan cubos contenidos en otros
+// (coste cuadrático).
+constexpr std::size_t kMaxContainmentPass = 8192;
+// Cubos que puede producir el cálculo del conjunto OFF; por encima EXPAND
+// comprueba la contención en ON ∪ DC en su lugar.
+constexpr std::size_t kComplementBudget = std::size_t(1) << 18;
+// Cubos que EXPAND intenta absorber con cada cubo.  Comprobando la
+// contención (mucho más caro que con el conjunto OFF) sólo se prueban los
+// que están a uno o dos literales.
+constexpr std::size_t kMaxAbsorbAttempts = 256;
+constexpr std::size_t kMaxContainmentAttempts = 16;
+constexpr unsigned kMaxContainmentRaise = 2;
+
+const Cube kUniverse{0, 0};
+
+unsigned literals(const Cube &c) { return static_cast<unsigned>(std::bitset<64>(c.mask).count()); }
+
+bool intersects(const Cube &a, const Cube &b) { return ((a.value ^ b.value) & a.mask & b.mask) == 0; }
+
+// a contiene a b.
+bool contains(const Cube &a, const Cube &b) {
+    return (a.mask & ~b.mask) == 0 && ((a.value ^ b.value) & a.mask) == 0;
+}
+
+Cube supercube(const Cube &a, const Cube &b) {
+    const std::uint64_t mask = a.mask & b.mask & ~(a.value ^ b.value);
+    return {a.value & mask, mask};
+}
+
+std::uint64_t full_mask(unsigned num_vars) {
+    return num_vars == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << num_vars) - 1;
+}
+
+void check_cubes(const std::vector<Cube> &cubes, unsigned num_vars) {
+    const std::uint64_t full = full_mask(num_vars);
+    for (const Cube &c : cubes) {
+        if ((c.mask & ~full) || (c.value & ~c.mask)) {
+            throw std::invalid_argument("Cubo fuera de rango para " + std::to_string(num_vars) + " variables");
+        }
+    }
+}
+
+// Cubos de F (salvo el índice `skip`) y de D restringidos a `c`: las
+// variables de c desaparecen.
+std::vector<Cube> cofactor(const std::vector<Cube> &f, const Cube &c, std::size_t skip = ~std::size_t(0),
+                           const std::vector<Cube> *d = nullptr) {
+    std::vector<Cube> out;
+    auto add = [&](const Cube &e) {
+        if (intersects(e, c)) {
+            out.push_back({e.value & ~c.mask, e.mask & ~c.mask});
+        }
+    };
+    for (std::size_t i = 0; i < f.size(); ++i) {
+        if (i != skip) {
+            add(f[i]);
+        }
+    }
+    if (d) {
+        for (const Cube &e : *d) {
+            add(e);
+        }
+    }
+    return out;
+}
+
+std::vector<Cube> cofactor(const std::vector<Cube> &f, std::uint64_t bit, bool value) {
+    return cofactor(f, Cube{value ? bit : 0, bit});
+}
+
+bool has_universe(const std::vector<Cube> &f) {
+    return std::any_of(f.begin(), f.end(), [](const Cube &c) { return c.mask == 0; });
+}
+
+// Variables con literal positivo y negativo en la cobertura.
+void polarities(const std::vector<Cube> &f, std::uint64_t &pos, std::uint64_t &neg) {
+    pos = neg = 0;
+    for (const Cube &c : f) {
+        pos |= c.mask & c.value;
+        neg |= c.mask & ~c.value;
+    }
+}
+
+// Variable de `among` con más peso: cada cubo cuenta 2^-literales, de modo
+// que mandan los cubos grandes, que son los que antes cierran una rama.
+std::uint64_t split_variable(const std::vector<Cube> &f, std::uint64_t among) {
+    double weight[64] = {};
+    for (const Cube &c : f) {
+        const double w = std::ldexp(1.0, -static_cast<int>(literals(c)));
+        for (std::uint64_t rest = c.mask & among; rest; rest &= rest - 1) {
+            weight[__builtin_ctzll(rest)] += w;
+        }
+    }
+    return std::uint64_t(1) << (std::max_element(weight, weight + 64) - weight);
+}
+
+// Busca un punto que no cubra ningún cubo fijando las variables una a una
+// al valor que menos peso (suma de 2^-literales, el número esperado de
+// cubos que cubren un punto al azar) deja en juego.  Si el peso inicial es
+// menor que 1 siempre lo encuentra; si no, puede fallar.
+bool uncovered_point(const std::vector<Cube> &f, std::uint64_t &point) {
+    // Cubos de cada variable, en un solo vector.
+    std::uint32_t start[65] = {};
+    for (const Cube &c : f) {
+        for (std::uint64_t rest = c.mask; rest; rest &= rest - 1) {
+            ++start[__builtin_ctzll(rest) + 1];
+        }
+    }
+    for (unsigned v = 0; v < 64; ++v) {
+        start[v + 1] += start[v];
+    }
+    std::vector<std::uint32_t> cubes(start[64]);
+    std::uint32_t next[64];
+    std::copy(start, start + 64, next);
+    std::vector<double> weight(f.size());
+    for (std::size_t i = 0; i < f.size(); ++i) {
+        weight[i] = std::ldexp(1.0, -static_cast<int>(literals(f[i])));
+        for (std::uint64_t rest = f[i].mask; rest; rest &= rest - 1) {
+            cubes[next[__builtin_ctzll(rest)]++] = static_cast<std::uint32_t>(i);
+        }
+    }
+    point = 0;
+    for (unsigned v = 0; v < 64; ++v) {
+        const std::uint64_t bit = std::uint64_t(1) << v;
+        double high = 0.0, low = 0.0;
+        for (std::uint32_t k = start[v]; k < start[v + 1]; ++k) {
+            const std::uint32_t i = cubes[k];
+            (f[i].value & bit ? high : low) += weight[i];
+        }
+        const std::uint64_t value = high < low ? bit : 0;
+        point |= value;
+        for (std::uint32_t k = start[v]; k < start[v + 1]; ++k) {
+            const std::uint32_t i = cubes[k];
+            weight[i] = (f[i].value & bit) == value ? 2 * weight[i] : 0.0;
+        }
+    }
+    // Cada cubo queda con peso 1 (cubre el punto) o 0.
+    return std::all_of(weight.begin(), weight.end(), [](double w) { return w == 0.0; });
+}
+
+// Tautología por recursión unate.  Si no lo es y `witness` no es nulo,
+// deja en él un punto que F no cubre.
+bool taut(std::vector<Cube> f, std::uint64_t *witness = nullptr) {
+    // Valores fijados por la reducción unate, que dejan fuera de juego a
+    // los cubos quitados.
+    std::uint64_t fixed = 0, fixed_value = 0;
+    auto fail = [&](std::uint64_t point) {
+        if (witness) {
+            *witness = (point & ~fixed) | fixed_value;
+        }
+        return false;
+    };
+    for (;;) {
+        if (f.empty()) {
+            return fail(0);
+        }
+        if (has_universe(f)) {
+            return true;
+        }
+        // Con peso menor que 1 no hay tautología y la búsqueda del punto no
+        // falla; si no, sólo se intenta cuando se pide el testigo.
+        double weight = 0.0;
+        for (const Cube &c : f) {
+            weight += std::ldexp(1.0, -static_cast<int>(literals(c)));
+        }
+        std::uint64_t point = 0;
+        if (weight < 1.0 - 1e-9 || witness) {
+            if (!witness || uncovered_point(f, point)) {
+                return fail(point);
+            }
+        }
+        std::uint64_t pos, neg;
+        polarities(f, pos, neg);
+        const std::uint64_t binate = pos & neg, unate = (pos | neg) & ~binate;
+        if (unate) {
+            // Reducción unate: F es tautología si y sólo si lo son los cubos
+            // que no dependen de variables unate.
+            fixed |= unate;
+            fixed_value |= neg & unate;
+            f.erase(std::remove_if(f.begin(), f.end(), [unate](const Cube &c) { return (c.mask & unate) != 0; }),
+                    f.end());
+            continue;
+        }
+        const std::uint64_t x = split_variable(f, binate);
+        std::uint64_t *sub = witness ? &point : nullptr;
+        if (!taut(cofactor(f, x, true), sub)) {
+            return fail(point | x);
+        }
+        if (!taut(cofactor(f, x, false), sub)) {
+            return fail(point & ~x);
+        }
+        return true;
+    }
+}
+
+// Quita los cubos contenidos en otros.
+void remove_contained(std::vector<Cube> &f) {
+    std::sort(f.begin(), f.end(), [](const Cube &a, const Cube &b) {
+        const unsigned la = literals(a), lb = literals(b);
+        return la != lb ? la < lb : (a.mask != b.mask ? a.mask < b.mask : a.value < b.value);
+    });
+    f.erase(std::unique(f.begin(), f.end()), f.end());
+    if (f.size() > kMaxContainmentPass) {
+        return;
+    }
+    std::vector<Cube> kept;
+    for (const Cube &c : f) {
+        if (std::none_of(kept.begin(), kept.end(), [&](const Cube &k) { return contains(k, c); })) {
+            kept.push_back(c);
+        }
+    }
+    f.swap(kept);
+}
+
+// Complemento por recursión de Shannon.  `budget` limita los cubos
+// producidos en total; devuelve false si se agota.
+bool complement_rec(const std::vector<Cube> &f, std::size_t &budget, std::vector<Cube> &out) {
+    out.clear();
+    if (f.empty()) {
+        out.push_back(kUniverse);
+    } else if (has_universe(f)) {
+        return true;
+    } else if (f.size() == 1) {
+        // De Morgan: un cubo por literal negado.
+        for (std::uint64_t rest = f[0].mask; rest; rest &= rest - 1) {
+            const std::uint64_t bit = rest & (~rest + 1);
+            out.push_back({~f[0].value & bit, bit});
+        }
+    } else {
+        std::uint64_t pos, neg;
+        polarities(f, pos, neg);
+        const std::uint64_t x = split_variable(f, (pos & neg) ? (pos & neg) : (pos | neg));
+        std::vector<Cube> high, low;
+        if (!complement_rec(cofactor(f, x, true), budget, high) || !complement_rec(cofactor(f, x, false), budget, low)) {
+            return false;
+        }
+        // Los cubos que salen en las dos mitades no necesitan la variable.
+        auto key = [](const Cube &a, const Cube &b) { return a.mask != b.mask ? a.mask < b.mask : a.value < b.value; };
+        std::sort(high.begin(), high.end(), key);
+        std::sort(low.begin(), low.end(), key);
+        std::size_t i = 0, j = 0;
+        while (i < high.size() || j < low.size()) {
+            if (j == low.size() || (i < high.size() && key(high[i], low[j]))) {
+                out.push_back({high[i].value | x, high[i].mask | x});
+                ++i;
+            } else if (i == high.size() || key(low[j], high[i])) {
+                out.push_back({low[j].value, low[j].mask | x});
+                ++j;
+            } else {
+                out.push_back(high[i]);
+                ++i;
+                ++j;
+            }
+        }
+        remove_contained(out);
+    }
+    if (out.size() > budget) {
+        budget = 0;
+        return false;
+    }
+    budget -= out.size();
+    return true;
+}
+
+std::vector<Cube> complement_all(const std::vector<Cube> &f) {
+    std::size_t budget = ~std::size_t(0);
+    std::vector<Cube> out;
+    complement_rec(f, budget, out);
+    return out;
+}
+
+// Supercubo del complemento de F; false si F es tautología.  Una variable
+// queda fijada a v en el supercubo si y sólo si F cubre todo el semiespacio
+// opuesto, es decir, si el cofactor en ¬v es tautología.  Un punto fuera de
+// F decide v, y cada punto nuevo libera las variables en que difiere.
+bool supercube_of_complement(const std::vector<Cube> &f, Cube &out) {
+    std::uint64_t point;
+    if (taut(f, &point)) {
+        return false;
+    }
+    std::uint64_t pos, neg;
+    polarities(f, pos, neg);
+    const std::uint64_t support = pos | neg;
+    std::uint64_t free = 0;
+    out = kUniverse;
+    for (std::uint64_t rest = support; rest; rest &= rest - 1) {
+        const std::uint64_t bit = rest & (~rest + 1);
+        if (free & bit) {
+            continue;
+        }
+        std::uint64_t other;
+        if (taut(cofactor(f, bit, !(point & bit)), &other)) {
+            out = {out.value | (point & bit), out.mask | bit};
+        } else {
+            free |= (((other & ~bit) | (~point & bit)) ^ point) & support;
+        }
+    }
+    return true;
+}
+
+std::pair<std::size_t, std::size_t> cost(const std::vector<Cube> &f) {
+    std::size_t lits = 0;
+    for (const Cube &c : f) {
+        lits += literals(c);
+    }
+    return {f.size(), lits};
+}
+
+// EXPAND: cada cubo, de los más grandes a los más pequeños, crece hacia
+// otros cubos de F mientras siga siendo implicante y después hasta ser
+// primo.  Con el conjunto OFF, para no cortar un cubo r hay que conservar al
+// menos un literal de los que le separan de r (su fila de bloqueo) y el cubo
+// final es un conjunto mínimo de literales que toca todas las filas.  Sin él
+// (complemento demasiado grande) cada subida se comprueba por contención en
+// `care` = ON ∪ DC.
+std::vector<Cube> expand(std::vector<Cube> f, const std::vector<Cube> *off, const std::vector<Cube> &care) {
+    std::sort(f.begin(), f.end(), [](const Cube &a, const Cube &b) { return literals(a) < literals(b); });
+    std::vector<char> covered(f.size(), 0);
+    std::vector<std::uint64_t> blocks(off ? off->size() : 0);
+    std::vector<Cube> out;
+    for (std::size_t i = 0; i < f.size(); ++i) {
+        if (covered[i]) {
+            continue;
+        }
+        Cube cur = f[i];
+        for (std::size_t k = 0; k < blocks.size(); ++k) {
+            blocks[k] = cur.mask & (*off)[k].mask & (cur.value ^ (*off)[k].value);
+            if (blocks[k] == 0) {
+                throw std::invalid_argument("El conjunto ON corta al conjunto OFF");
+            }
+        }
+        // Literales obligatorios: los únicos de alguna fila.
+        auto essential = [&]() {
+            std::uint64_t e = 0;
+            for (std::uint64_t b : blocks) {
+                const std::uint64_t live = b & cur.mask;
+                if ((live & (live - 1)) == 0) {
+                    e |= live;
+                }
+            }
+            return e;
+        };
+        auto feasible = [&](const Cube &c) {
+            return off ? std::all_of(blocks.begin(), blocks.end(), [&](std::uint64_t b) { return (b & c.mask) != 0; })
+                       : taut(cofactor(care, c));
+        };
+        std::uint64_t fixed = essential();
+
+        // Absorber los cubos más cercanos que se puedan.
+        std::vector<std::pair<unsigned, std::size_t>> near;
+        for (std::size_t j = i + 1; j < f.size(); ++j) {
+            if (!covered[j]) {
+                const std::uint64_t raise = cur.mask & ~supercube(cur, f[j]).mask;
+                const unsigned distance = static_cast<unsigned>(std::bitset<64>(raise).count());
+                if (!(raise & fixed) && (off || distance <= kMaxContainmentRaise)) {
+                    near.push_back({distance, j});
+                }
+            }
+        }
+        std::sort(near.begin(), near.end());
+        near.resize(std::min(near.size(), off ? kMaxAbsorbAttempts : kMaxContainmentAttempts));
+        for (const auto &entry : near) {
+            const Cube sup = supercube(cur, f[entry.second]);
+            const std::uint64_t raise = cur.mask & ~sup.mask;
+            if (raise != 0 && !(raise & fixed) && feasible(sup)) {
+                cur = sup;
+                fixed = essential();
+            }
+        }
+
+        if (off) {
+            // Conjunto mínimo de literales que toca todas las filas (voraz y
+            // luego sin sobrantes): el cubo resultante es primo.
+            std::uint64_t keep = fixed;
+            std::vector<std::uint64_t> open;
+            for (std::uint64_t b : blocks) {
+                if (!(b & keep)) {
+                    open.push_back(b & cur.mask);
+                }
+            }
+            while (!open.empty()) {
+                unsigned count[64] = {};
+                for (std::uint64_t b : open) {
+                    for (std::uint64_t rest = b; rest; rest &= rest - 1) {
+                        ++count[__builtin_ctzll(rest)];
+                    }
+                }
+                const unsigned v = static_cast<unsigned>(std::max_element(count, count + 64) - count);
+                const std::uint64_t bit = std::uint64_t(1) << v;
+                keep |= bit;
+                open.erase(std::remove_if(open.begin(), open.end(), [bit](std::uint64_t b) { return (b & bit) != 0; }),
+                           open.end());
+            }
+            for (std::uint64_t rest = keep & ~fixed; rest; rest &= rest - 1) {
+                const std::uint64_t bit = rest & (~rest + 1);
+                if (feasible({cur.value & (keep & ~bit), keep & ~bit})) {
+                    keep &= ~bit;
+                }
+            }
+            cur = {cur.value & keep, keep};
+        } else {
+            // Como cur ya está dentro de `care`, subir un literal sólo exige
+            // comprobar la mitad opuesta, que corta a menos cubos.  Un literal
+            // que no se pudo subir tampoco se podrá con un cubo mayor: basta
+            // una pasada.
+            for (std::uint64_t rest = cur.mask; rest; rest &= rest - 1) {
+                const std::uint64_t bit = rest & (~rest + 1);
+                if (feasible({cur.value ^ bit, cur.mask})) {
+                    cur = {cur.value & ~bit, cur.mask & ~bit};
+                }
+            }
+        }
+
+        for (std::size_t j = i + 1; j < f.size(); ++j) {
+            if (!covered[j] && contains(cur, f[j])) {
+                covered[j] = 1;
+            }
+        }
+        out.push_back(cur);
+    }
+    remove_contained(out);
+    return out;
+}
+
+// IRREDUNDANT: los cubos que cubre el resto (con D) se quitan de uno en
+// uno, de los más pequeños a los más grandes, comprobando de nuevo cada vez.
+std::vector<Cube> irredundant(const std::vector<Cube> &f, const std::vector<Cube> &d) {
+    std::vector<std::size_t> redundant;
+    for (std::size_t i = 0; i < f.size(); ++i) {
+        if (taut(cofactor(f, f[i], i, &d))) {
+            redundant.push_back(i);
+        }
+    }
+    std::sort(redundant.begin(), redundant.end(),
+              [&](std::size_t a, std::size_t b) { return literals(f[a]) > literals(f[b]); });
+    std::vector<char> keep(f.size(), 1);
+    for (std::size_t i : redundant) {
+        std::vector<Cube> rest;
+        for (std::size_t j = 0; j < f.size(); ++j) {
+            if (keep[j] && j != i) {
+                rest.push_back(f[j]);
+            }
+        }
+        if (taut(cofactor(rest, f[i], ~std::size_t(0), &d))) {
+            keep[i] = 0;
+        }
+    }
+    std::vector<Cube> out;
+    for (std::size_t i = 0; i < f.size(); ++i) {
+        if (keep[i]) {
+            out.push_back(f[i]);
+        }
+    }
+    return out;
+}
+
+// REDUCE: cada cubo, de los más grandes a los más pequeños, se sustituye
+// por su intersección con el supercubo de lo que sólo él cubre.
+std::vector<Cube> reduce(std::vector<Cube> f, const std::vector<Cube> &d) {
+    std::sort(f.begin(), f.end(), [](const Cube &a, const Cube &b) { return literals(a) < literals(b); });
+    std::vector<char> alive(f.size(), 1);
+    for (std::size_t i = 0; i < f.size(); ++i) {
+        std::vector<Cube> rest;
+        for (std::size_t j = 0; j < f.size(); ++j) {
+            if (alive[j] && j != i) {
+                rest.push_back(f[j]);
+            }
+        }
+        Cube sup;
+        if (!supercube_of_complement(cofactor(rest, f[i], ~std::size_t(0), &d), sup)) {
+            alive[i] = 0;
+            continue;
+        }
+        f[i] = {f[i].value | sup.value, f[i].mask | sup.mask};
+    }
+    std::vector<Cube> out;
+    for (std::size_t i = 0; i < f.size(); ++i) {
+        if (alive[i]) {
+            out.push_back(f[i]);
+        }
+    }
+    return out;
+}
+
+std::vector<Cube> join(const std::vector<Cube> &a, const std::vector<Cube> &b) {
+    std::vector<Cube> out = a;
+    out.insert(out.end(), b.begin(), b.end());
+    return out;
+}
+
+// `off` nulo: EXPAND por contención en ON ∪ DC.
+std::vector<Cube> run_espresso(std::vector<Cube> f, const std::vector<Cube> &d, const std::vector<Cube> *off,
+                               const EspressoOptions &options) {
+    if (f.empty()) {
+        return f;
+    }
+    remove_contained(f);
+    const std::vector<Cube> care = off ? std::vector<Cube>() : join(f, d);
+    std::vector<Cube> best = irredundant(expand(f, off, care), d);
+    auto best_cost = cost(best);
+    for (unsigned it = 0; options.max_iterations == 0 || it < options.max_iterations; ++it) {
+        std::vector<Cube> next = irredundant(expand(reduce(best, d), off, care), d);
+        const auto next_cost = cost(next);
+        if (next_cost >= best_cost) {
+            break;
+        }
+        best.swap(next);
+        best_cost = next_cost;
+    }
+    std::sort(best.begin(), best.end(),
+              [](const Cube &a, const Cube &b) { return a.mask != b.mask ? a.mask < b.mask : a.value < b.value; });
+    return best;
+}
+
+[[noreturn]] void pla_error(std::size_t line, const std::string &what) {
+    throw std::runtime_error("PLA no válido (línea " + std::to_string(line) + "): " + what);
+}
+
+void check_vars(unsigned num_vars) {
+    if (num_vars == 0 || num_vars > 64) {
+        throw std::invalid_argument("El número de variables debe estar entre 1 y 64");
+    }
+}
+
+// Con el conjunto OFF explícito (aunque esté vacío): lo que no es ON ni OFF
+// también es indiferente.
+std::vector<Cube> espresso_with_off(const std::vector<Cube> &on, const std::vector<Cube> &dc,
+                                    const std::vector<Cube> &off, unsigned num_vars,
+                                    const EspressoOptions &options) {
+    check_vars(num_vars);
+    check_cubes(on, num_vars);
+    check_cubes(dc, num_vars);
+    check_cubes(off, num_vars);
+    return run_espresso(on, join(dc, complement_all(join(on, off))), &off, options);
+}
+
+} // namespace
+
+bool tautology(const std::vector<Cube> &cover, unsigned num_vars) {
+    check_cubes(cover, num_vars);
+    return taut(cover);
+}
+
+std::vector<Cube> complement(const std::vector<Cube> &cover, unsigned num_vars) {
+    check_cubes(cover, num_vars);
+    return complement_all(cover);
+}
+
+bool cover_contains(const std::vector<Cube> &cover, const Cube &cube) { return taut(cofactor(cover, cube)); }
+
+std::vector<Cube> espresso(const std::vector<Cube> &on, const std::vector<Cube> &dc, unsigned num_vars,
+                           const EspressoOptions &options) {
+    check_vars(num_vars);
+    check_cubes(on, num_vars);
+    check_cubes(dc, num_vars);
+    std::size_t budget = kComplementBudget;
+    std::vector<Cube> off;
+    const bool small = complement_rec(join(on, dc), budget, off);
+    return run_espresso(on, dc, small ? &off : nullptr, options);
+}
+
+std::vector<Cube> espresso(const std::vector<Cube> &on, const std::vector<Cube> &dc, const std::vector<Cube> &off,
+                           unsigned num_vars, const EspressoOptions &options) {
+    if (off.empty()) {
+        return espresso(on, dc, num_vars, options);
+    }
+    return espresso_with_off(on, dc, off, num_vars, options);
+}
+
+std::vector<std::string> espresso_minimize(const std::vector<std::uint64_t> &minterms, unsigned num_vars,
+                                           const std::vector<std::uint64_t> &dont_cares,
+                                           const EspressoOptions &options) {
+    check_vars(num_vars);
+    const std::uint64_t full = full_mask(num_vars);
+    std::vector<Cube> on, dc;
+    for (std::uint64_t m : minterms) {
+        on.push_back({m, full});
+    }
+    for (std::uint64_t m : dont_cares) {
+        dc.push_back({m, full});
+    }
+    std::vector<std::string> out;
+    for (const Cube &c : espresso(on, dc, num_vars, options)) {
+        out.push_back(cube_to_pattern(c, num_vars));
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+Pla parse_pla(std::istream &in) {
+    Pla pla;
+    bool have_inputs = false, have_outputs = false;
+    std::string text;
+    std::size_t line = 0;
+    auto prepare = [&](std::size_t at) {
+        if (!have_inputs || !have_outputs) {
+            pla_error(at, "faltan .i o .o antes de los cubos");
+        }
+        if (pla.on.empty()) {
+            pla.on.resize(pla.outputs);
+            pla.dc.resize(pla.outputs);
+            pla.off.resize(pla.outputs);
+        }
+    };
+    while (std::getline(in, text)) {
+        ++line;
+        const std::size_t hash = text.find('#');
+        if (hash != std::string::npos) {
+            text.erase(hash);
+        }
+        std::istringstream fields(text);
+        std::string head;
+        if (!(fields >> head)) {
+            continue;
+        }
+        if (head[0] == '.') {
+            if (head == ".e" || head == ".end") {
+                break;
+            }
+            if (head == ".i" || head == ".o") {
+                unsigned n = 0;
+                if (!(fields >> n) || n == 0 || !pla.on.empty()) {
+                    pla_error(line, head + " necesita un número positivo antes de los cubos");
+                }
+                if (head == ".i") {
+                    if (n > 64) {
+                        pla_error(line, "más de 64 entradas");
+                    }
+                    pla.inputs = n;
+                    have_inputs = true;
+                } else {
+                    pla.outputs = n;
+                    have_outputs = true;
+                }
+            } else if (head == ".ilb" || head == ".ob") {
+                auto &labels = head == ".ilb" ? pla.input_labels : pla.output_labels;
+                labels.clear();
+                for (std::string name; fields >> name;) {
+                    labels.push_back(name);
+                }
+            } else if (head == ".type") {
+                fields >> pla.type;
+                if (pla.type != "f" && pla.type != "fd" && pla.type != "fr" && pla.type != "fdr") {
+                    pla_error(line, "tipo no soportado: " + pla.type);
+                }
+            } else if (head != ".p") {
+                pla_error(line, "directiva no soportada: " + head);
+            }
+            continue;
+        }
+        prepare(line);
+        std::string row = head;
+        for (std::string part; fields >> part;) {
+            row += part;
+        }
+        if (row.size() != pla.inputs + pla.outputs) {
+            pla_error(line, "se esperaban " + std::to_string(pla.inputs + pla.outputs) + " caracteres");
+        }
+        Cube c;
+        for (unsigned i = 0; i < pla.inputs; ++i) {
+            const char ch = row[i];
+            c.value <<= 1;
+            c.mask <<= 1;
+            if (ch == '0' || ch == '1') {
+                c.mask |= 1;
+                c.value |= ch == '1';
+            } else if (ch != '-' && ch != '2') {
+                pla_error(line, std::string("carácter de entrada no válido: ") + ch);
+            }
+        }
+        const bool with_dc = pla.type.find('d') != std::string::npos;
+        const bool with_off = pla.type.find('r') != std::string::npos;
+        for (unsigned o = 0; o < pla.outputs; ++o) {
+            const char ch = row[pla.inputs + o];
+            if (ch == '1' || ch == '4') {
+                pla.on[o].push_back(c);
+            } else if (ch == '-' || ch == '2') {
+                if (with_dc) {
+                    pla.dc[o].push_back(c);
+                }
+            } else if (ch == '0') {
+                if (with_off) {
+                    pla.off[o].push_back(c);
+                }
+            } else if (ch != '~' && ch != '3') {
+                pla_error(line, std::string("carácter de salida no válido: ") + ch);
+            }
+        }
+    }
+    prepare(line);
+    if (!pla.input_labels.empty() && pla.input_labels.size() != pla.inputs) {
+        pla_error(line, ".ilb no tiene un nombre por entrada");
+    }
+    if (!pla.output_labels.empty() && pla.output_labels.size() != pla.outputs) {
+        pla_error(line, ".ob no tiene un nombre por salida");
+    }
+    return pla;
+}
+
+Pla load_pla(const std::string &path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("No se puede abrir el archivo: " + path);
+    }
+    return parse_pla(in);
+}
+
+void write_pla(std::ostream &out, const Pla &pla) {
+    std::map<std::string, std::string> rows;
+    for (unsigned o = 0; o < pla.outputs && o < pla.on.size(); ++o) {
+        for (const Cube &c : pla.on[o]) {
+            std::string &outs = rows[cube_to_pattern(c, pla.inputs)];
+            if (outs.empty()) {
+                outs.assign(pla.outputs, '0');
+            }
+            outs[o] = '1';
+        }
+    }
+    out << ".i " << pla.inputs << "\n.o " << pla.outputs << "\n";
+    for (const auto *labels : {&pla.input_labels, &pla.output_labels}) {
+        if (!labels->empty()) {
+            out << (labels == &pla.input_labels ? ".ilb" : ".ob");
+            for (const std::string &name : *labels) {
+                out << ' ' << name;
+            }
+            out << '\n';
+        }
+    }
+    out << ".type f\n.p " << rows.size() << '\n';
+    for (const auto &row : rows) {
+        out << row.first << ' ' << row.second << '\n';
+    }
+    out << ".e\n";
+}
+
+Pla espresso(const Pla &pla, const EspressoOptions &options) {
+    Pla result;
+    result.inputs = pla.inputs;
+    result.outputs = pla.outputs;
+    result.input_labels = pla.input_labels;
+    result.output_labels = pla.output_labels;
+    result.type = "f";
+    result.on.resize(pla.outputs);
+    result.dc.resize(pla.outputs);
+    result.off.resize(pla.outputs);
+    const bool with_off = pla.type.find('r') != std::string::npos;
+    parallel::for_each_index(pla.outputs, options.threads, 1, [&](unsigned, std::size_t o) {
+        result.on[o] = with_off ? espresso_with_off(pla.on.at(o), pla.dc.at(o), pla.off.at(o), pla.inputs, options)
+                                : espresso(pla.on.at(o), pla.dc.at(o), pla.inputs, options);
+    });
+    return result;
+}
+
+} // namespace graphs
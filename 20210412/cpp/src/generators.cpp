@@ -0,0 +1,344 @@
+#include "generators.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "graph_builder.hpp"
+#include "parallel.hpp"
+
+namespace graphs {
+
+namespace {
+
+// Flujos independientes de números aleatorios (uno por uso).
+enum Stream : std::uint64_t {
+    kWeightStream = 1,
+    kRmatStream,
+    kNoiseStream,
+    kPermuteStream,
+    kPointStream,
+    kTreeStream,
+    kKeepStream,
+    kDiagonalStream,
+};
+
+constexpr std::size_t kEdgeBlock = 1 << 16;
+constexpr std::size_t kVertexBlock = 4096;
+
+std::uint64_t mix(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// Número pseudoaleatorio i del flujo `stream` para la semilla dada.
+std::uint64_t draw(std::uint64_t seed, Stream stream, std::uint64_t i) {
+    return mix(mix(seed ^ mix(stream)) + i);
+}
+
+// Real uniforme en [0, 1) con 53 bits.
+double unit(std::uint64_t h) {
+    return static_cast<double>(h >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double random_weight(const GeneratorOptions &options, std::uint64_t i) {
+    if (options.max_weight == options.min_weight) {
+        return options.min_weight;
+    }
+    return options.min_weight +
+           (options.max_weight - options.min_weight) * unit(draw(options.seed, kWeightStream, i));
+}
+
+void check_weights(const GeneratorOptions &options) {
+    if (!(options.min_weight <= options.max_weight)) {
+        throw std::invalid_argument("Rango de pesos no válido");
+    }
+}
+
+int checked_size(std::int64_t n) {
+    if (n < 0 || n > INT_MAX) {
+        throw std::invalid_argument("Tamaño de grafo no válido");
+    }
+    return static_cast<int>(n);
+}
+
+BuildOptions undirected(unsigned threads) {
+    BuildOptions b;
+    b.symmetrize = true;
+    b.threads = threads;
+    return b;
+}
+
+struct Point {
+    double x, y;
+};
+
+double length(Point p, Point q) {
+    return std::hypot(p.x - q.x, p.y - q.y);
+}
+
+// Conjuntos disjuntos con compresión de caminos por división a la mitad.
+struct DisjointSets {
+    std::vector<int> parent;
+
+    explicit DisjointSets(int n) : parent(n) { std::iota(parent.begin(), parent.end(), 0); }
+
+    int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return false;
+        }
+        parent[std::max(a, b)] = std::min(a, b);
+        return true;
+    }
+};
+
+} // namespace
+
+Graph grid_2d(int width, int height, const GeneratorOptions &options) {
+    check_weights(options);
+    const int n = checked_size(std::int64_t(width) * height);
+    if (width < 0 || height < 0) {
+        throw std::invalid_argument("Tamaño de rejilla no válido");
+    }
+    // Un lote por fila: aristas a la derecha y hacia abajo.
+    std::vector<std::vector<EdgeRecord>> rows(height);
+    parallel::for_each_index(height, options.threads, 64, [&](unsigned, std::size_t y) {
+        auto &row = rows[y];
+        for (int x = 0; x < width; ++x) {
+            const int u = static_cast<int>(y) * width + x;
+            if (x + 1 < width) {
+                row.push_back({u, u + 1, random_weight(options, 2 * std::uint64_t(u))});
+            }
+            if (static_cast<int>(y) + 1 < height) {
+                row.push_back({u, u + width, random_weight(options, 2 * std::uint64_t(u) + 1)});
+            }
+        }
+    });
+    return build_csr(n, rows, undirected(options.threads));
+}
+
+Graph grid_3d(int nx, int ny, int nz, const GeneratorOptions &options) {
+    check_weights(options);
+    const int n = checked_size(std::int64_t(nx) * ny * nz);
+    if (nx < 0 || ny < 0 || nz < 0) {
+        throw std::invalid_argument("Tamaño de rejilla no válido");
+    }
+    std::vector<std::vector<EdgeRecord>> rows(static_cast<std::size_t>(ny) * nz);
+    parallel::for_each_index(rows.size(), options.threads, 64, [&](unsigned, std::size_t r) {
+        const int y = static_cast<int>(r % ny), z = static_cast<int>(r / ny);
+        auto &row = rows[r];
+        for (int x = 0; x < nx; ++x) {
+            const int u = (z * ny + y) * nx + x;
+            const std::uint64_t base = 3 * std::uint64_t(u);
+            if (x + 1 < nx) {
+                row.push_back({u, u + 1, random_weight(options, base)});
+            }
+            if (y + 1 < ny) {
+                row.push_back({u, u + nx, random_weight(options, base + 1)});
+            }
+            if (z + 1 < nz) {
+                row.push_back({u, u + nx * ny, random_weight(options, base + 2)});
+            }
+        }
+    });
+    return build_csr(n, rows, undirected(options.threads));
+}
+
+Graph rmat(int scale, std::size_t edges, const RmatOptions &rmat, const GeneratorOptions &options) {
+    check_weights(options);
+    if (scale < 0 || scale > 30) {
+        throw std::invalid_argument("Escala de R-MAT fuera de [0, 30]");
+    }
+    const double d = 1.0 - rmat.a - rmat.b - rmat.c;
+    if (rmat.a < 0 || rmat.b < 0 || rmat.c < 0 || d < -1e-12) {
+        throw std::invalid_argument("Probabilidades de R-MAT no válidas");
+    }
+    const int n = 1 << scale;
+
+    // Umbrales acumulados de los cuadrantes en cada nivel; con ruido cada
+    // probabilidad se multiplica por un factor en [0.95, 1.05) y se normaliza.
+    std::vector<double> t_ab(scale), t_a(scale), t_c(scale);
+    for (int l = 0; l < scale; ++l) {
+        double p[4] = {rmat.a, rmat.b, rmat.c, std::max(d, 0.0)};
+        if (rmat.noise) {
+            double sum = 0.0;
+            for (int q = 0; q < 4; ++q) {
+                p[q] *= 0.95 + 0.1 * unit(draw(options.seed, kNoiseStream, 4 * std::uint64_t(l) + q));
+                sum += p[q];
+            }
+            for (double &x : p) {
+                x /= sum;
+            }
+        }
+        // Fila superior con probabilidad a + b; dentro de ella, izquierda con a / (a + b).
+        t_ab[l] = p[0] + p[1];
+        t_a[l] = p[0] + p[1] > 0 ? p[0] / (p[0] + p[1]) : 0.0;
+        t_c[l] = p[2] + p[3] > 0 ? p[2] / (p[2] + p[3]) : 0.0;
+    }
+
+    std::vector<int> perm;
+    if (rmat.permute) {
+        perm.resize(n);
+        std::iota(perm.begin(), perm.end(), 0);
+        for (int i = n - 1; i > 0; --i) {
+            std::swap(perm[i], perm[draw(options.seed, kPermuteStream, i) % (std::uint64_t(i) + 1)]);
+        }
+    }
+
+    std::vector<std::vector<EdgeRecord>> blocks((edges + kEdgeBlock - 1) / kEdgeBlock);
+    parallel::for_each_index(blocks.size(), options.threads, 1, [&](unsigned, std::size_t b) {
+        const std::size_t begin = b * kEdgeBlock, end = std::min(edges, begin + kEdgeBlock);
+        auto &out = blocks[b];
+        out.reserve(end - begin);
+        for (std::size_t i = begin; i < end; ++i) {
+            int u = 0, v = 0;
+            for (int l = 0; l < scale; ++l) {
+                const std::uint64_t h = draw(options.seed, kRmatStream, i * scale + l);
+                // Dos reales de 32 bits por nivel: fila y columna.
+                const double r1 = static_cast<double>(h >> 32) * (1.0 / 4294967296.0);
+                const double r2 = static_cast<double>(h & 0xffffffffu) * (1.0 / 4294967296.0);
+                const bool down = r1 >= t_ab[l];
+                const bool right = r2 >= (down ? t_c[l] : t_a[l]);
+                u = (u << 1) | down;
+                v = (v << 1) | right;
+            }
+            if (rmat.permute) {
+                u = perm[u];
+                v = perm[v];
+            }
+            out.push_back({u, v, random_weight(options, i)});
+        }
+    });
+    BuildOptions b;
+    b.deduplicate = rmat.simple;
+    b.drop_self_loops = rmat.simple;
+    b.threads = options.threads;
+    return build_csr(n, blocks, b);
+}
+
+Graph random_geometric(int n, double radius, const GeneratorOptions &options) {
+    checked_size(n);
+    if (!(radius >= 0.0)) {
+        throw std::invalid_argument("Radio no válido");
+    }
+    std::vector<Point> points(n);
+    for (int i = 0; i < n; ++i) {
+        const std::uint64_t h = 2 * std::uint64_t(i);
+        points[i] = {unit(draw(options.seed, kPointStream, h)), unit(draw(options.seed, kPointStream, h + 1))};
+    }
+
+    // Celdas de lado >= radius: los vecinos de un punto están en las 3x3
+    // celdas que rodean la suya.  Se limita el número de celdas a ~n.
+    const double side_cells = radius > 0.0 ? std::floor(1.0 / radius) : 1.0;
+    const int cells = static_cast<int>(std::max(1.0, std::min(side_cells, std::ceil(std::sqrt(double(n))))));
+    auto cell_of = [&](double x) { return std::min(cells - 1, static_cast<int>(x * cells)); };
+    std::vector<std::size_t> start(static_cast<std::size_t>(cells) * cells + 1, 0);
+    std::vector<int> cell(n);
+    for (int i = 0; i < n; ++i) {
+        cell[i] = cell_of(points[i].y) * cells + cell_of(points[i].x);
+        ++start[cell[i] + 1];
+    }
+    std::partial_sum(start.begin(), start.end(), start.begin());
+    std::vector<int> members(n);
+    {
+        std::vector<std::size_t> next(start.begin(), start.end() - 1);
+        for (int i = 0; i < n; ++i) {
+            members[next[cell[i]]++] = i;
+        }
+    }
+
+    std::vector<std::vector<EdgeRecord>> blocks((n + kVertexBlock - 1) / kVertexBlock);
+    parallel::for_each_index(blocks.size(), options.threads, 1, [&](unsigned, std::size_t b) {
+        const int begin = static_cast<int>(b * kVertexBlock);
+        const int end = std::min(n, static_cast<int>(begin + kVertexBlock));
+        for (int i = begin; i < end; ++i) {
+            const int cx = cell[i] % cells, cy = cell[i] / cells;
+            for (int y = std::max(0, cy - 1); y <= std::min(cells - 1, cy + 1); ++y) {
+                for (int x = std::max(0, cx - 1); x <= std::min(cells - 1, cx + 1); ++x) {
+                    const int c = y * cells + x;
+                    for (std::size_t k = start[c]; k < start[c + 1]; ++k) {
+                        const int j = members[k];
+                        const double dist = length(points[i], points[j]);
+                        if (j > i && dist < radius) {
+                            blocks[b].push_back({i, j, dist});
+                        }
+                    }
+                }
+            }
+        }
+    });
+    return build_csr(n, blocks, undirected(options.threads));
+}
+
+Graph road_network(int width, int height, const RoadOptions &road, const GeneratorOptions &options) {
+    const int n = checked_size(std::int64_t(width) * height);
+    if (width < 0 || height < 0) {
+        throw std::invalid_argument("Tamaño de rejilla no válido");
+    }
+    std::vector<Point> points(n);
+    for (int u = 0; u < n; ++u) {
+        const std::uint64_t h = 2 * std::uint64_t(u);
+        points[u] = {u % width + road.jitter * (2.0 * unit(draw(options.seed, kPointStream, h)) - 1.0),
+                     u / width + road.jitter * (2.0 * unit(draw(options.seed, kPointStream, h + 1)) - 1.0)};
+    }
+
+    // Calles de la rejilla en orden aleatorio: Kruskal sobre ese orden da un
+    // árbol generador aleatorio (conexo); del resto se conserva una fracción.
+    struct Street {
+        std::uint64_t key;
+        int u, v;
+    };
+    std::vector<Street> streets;
+    for (int u = 0; u < n; ++u) {
+        if (u % width + 1 < width) {
+            streets.push_back({0, u, u + 1});
+        }
+        if (u + width < n) {
+            streets.push_back({0, u, u + width});
+        }
+    }
+    for (std::size_t e = 0; e < streets.size(); ++e) {
+        streets[e].key = draw(options.seed, kTreeStream, e);
+    }
+    std::vector<EdgeRecord> edges;
+    DisjointSets sets(n);
+    std::vector<std::size_t> order(streets.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&](std::size_t a, std::size_t b) { return streets[a].key < streets[b].key; });
+    for (std::size_t e : order) {
+        const Street &s = streets[e];
+        if (sets.unite(s.u, s.v) || unit(draw(options.seed, kKeepStream, e)) < road.keep) {
+            edges.push_back({s.u, s.v, length(points[s.u], points[s.v])});
+        }
+    }
+    for (int u = 0; u < n; ++u) {
+        if (u % width + 1 >= width || u + width >= n) {
+            continue;
+        }
+        const std::uint64_t h = draw(options.seed, kDiagonalStream, u);
+        if (unit(h) < road.diagonals) {
+            // El bit bajo elige la diagonal.
+            const int a = h & 1 ? u : u + 1;
+            const int b = h & 1 ? u + width + 1 : u + width;
+            edges.push_back({a, b, length(points[a], points[b])});
+        }
+    }
+    return build_csr(n, edges, undirected(options.threads));
+}
+
+} // namespace graphs
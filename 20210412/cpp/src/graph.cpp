@@ -0,0 +1,152 @@
+#include "graph.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+namespace graphs {
+
+namespace {
+
+// Almacenamiento propio de un grafo construido en memoria.
+template <class Vertex, class Weight>
+struct OwnedArrays {
+    std::vector<std::size_t> offsets;
+    std::vector<Vertex> targets;
+    std::vector<Weight> weights;
+};
+
+const std::size_t kEmptyOffsets[1] = {0};
+
+} // namespace
+
+template <class Vertex, class Weight>
+BasicGraph<Vertex, Weight>::BasicGraph() : offsets_(kEmptyOffsets) {}
+
+template <class Vertex, class Weight>
+BasicGraph<Vertex, Weight>::BasicGraph(const BasicAdjList<Vertex, Weight> &adj) {
+    const std::size_t n = adj.size();
+    auto store = std::make_shared<OwnedArrays<Vertex, Weight>>();
+    store->offsets.assign(n + 1, 0);
+    for (std::size_t u = 0; u < n; ++u) {
+        store->offsets[u + 1] = store->offsets[u] + adj[u].size();
+    }
+    store->targets.reserve(store->offsets[n]);
+    store->weights.reserve(store->offsets[n]);
+    for (const auto &edges : adj) {
+        for (const auto &edge : edges) {
+            store->targets.push_back(edge.first);
+            store->weights.push_back(edge.second);
+        }
+    }
+    attach({store->offsets.data(), store->offsets.size()},
+           {store->targets.data(), store->targets.size()},
+           {store->weights.data(), store->weights.size()}, store);
+    validate();
+}
+
+template <class Vertex, class Weight>
+BasicGraph<Vertex, Weight>::BasicGraph(std::vector<std::size_t> offsets, std::vector<Vertex> targets,
+                                       std::vector<Weight> weights) {
+    auto store = std::make_shared<OwnedArrays<Vertex, Weight>>();
+    store->offsets = std::move(offsets);
+    store->targets = std::move(targets);
+    store->weights = std::move(weights);
+    if (store->offsets.empty()) {
+        store->offsets.push_back(0);
+    }
+    attach({store->offsets.data(), store->offsets.size()},
+           {store->targets.data(), store->targets.size()},
+           {store->weights.data(), store->weights.size()}, store);
+    validate();
+}
+
+template <class Vertex, class Weight>
+BasicGraph<Vertex, Weight> BasicGraph<Vertex, Weight>::view(ArrayView<std::size_t> offsets,
+                                                            ArrayView<Vertex> targets,
+                                                            ArrayView<Weight> weights,
+                                                            std::shared_ptr<const void> owner) {
+    BasicGraph g;
+    g.attach(offsets, targets, weights, std::move(owner));
+    g.validate();
+    return g;
+}
+
+template <class Vertex, class Weight>
+BasicGraph<Vertex, Weight> BasicGraph<Vertex, Weight>::trusted_view(ArrayView<std::size_t> offsets,
+                                                                    ArrayView<Vertex> targets,
+                                                                    ArrayView<Weight> weights,
+                                                                    std::shared_ptr<const void> owner,
+                                                                    bool has_negative_weights) {
+    BasicGraph g;
+    g.attach(offsets, targets, weights, std::move(owner));
+    g.has_negative_weights_ = has_negative_weights;
+    return g;
+}
+
+template <class Vertex, class Weight>
+void BasicGraph<Vertex, Weight>::attach(ArrayView<std::size_t> offsets, ArrayView<Vertex> targets,
+                                        ArrayView<Weight> weights, std::shared_ptr<const void> owner) {
+    if (offsets.empty() || offsets[0] != 0 || offsets[offsets.size() - 1] != targets.size() ||
+        weights.size() != targets.size()) {
+        throw std::invalid_argument("Arrays CSR inconsistentes");
+    }
+    offsets_ = offsets.data();
+    targets_ = targets.data();
+    weights_ = weights.data();
+    n_ = static_cast<Vertex>(offsets.size() - 1);
+    m_ = targets.size();
+    owner_ = std::move(owner);
+}
+
+template <class Vertex, class Weight>
+void BasicGraph<Vertex, Weight>::validate() {
+    for (Vertex u = 0; u < n_; ++u) {
+        if (offsets_[u] > offsets_[u + 1]) {
+            throw std::invalid_argument("Desplazamientos CSR no monótonos");
+        }
+    }
+    for (std::size_t e = 0; e < m_; ++e) {
+        Vertex v = targets_[e];
+        if (v < 0 || v >= n_) {
+            throw std::invalid_argument("Destino de arista fuera de rango");
+        }
+    }
+    has_negative_weights_ = false;
+    for (std::size_t e = 0; e < m_; ++e) {
+        const Weight w = weights_[e];
+        if constexpr (std::is_floating_point_v<Weight>) {
+            if (std::isnan(w)) {
+                throw std::invalid_argument("Peso de arista no numérico (NaN)");
+            }
+        }
+        if (w < Weight(0)) {
+            has_negative_weights_ = true;
+        }
+    }
+}
+
+template <class Vertex, class Weight>
+std::vector<Vertex> extract_path(const BasicShortestPathTree<Vertex, Weight> &tree,
+                                 typename BasicShortestPathTree<Vertex, Weight>::vertex_type target) {
+    std::vector<Vertex> path;
+    if (target < 0 || target >= static_cast<Vertex>(tree.dist.size()) ||
+        WeightTraits<Weight>::is_infinite(tree.dist[target])) {
+        return path;
+    }
+    for (Vertex v = target; v != -1; v = tree.parent[v]) {
+        path.push_back(v);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+#define GRAPHS_GRAPH(V, W)                                                                     \
+    template class BasicGraph<V, W>;                                                           \
+    template std::vector<V> extract_path(const BasicShortestPathTree<V, W> &,                  \
+                                         typename BasicShortestPathTree<V, W>::vertex_type);
+GRAPHS_INSTANTIATE(GRAPHS_GRAPH)
+#undef GRAPHS_GRAPH
+
+} // namespace graphs
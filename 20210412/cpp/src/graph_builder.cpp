@@ -0,0 +1,268 @@
+#include "graph_builder.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "parallel.hpp"
+
+namespace graphs {
+
+namespace {
+
+// Tramo contiguo de aristas de entrada; las tareas paralelas trabajan por tramos.
+template <class Record>
+struct Slice {
+    const Record *data;
+    std::size_t size;
+};
+
+constexpr std::size_t kSliceEdges = 1 << 15;
+constexpr std::size_t kRowGrain = 1024;
+
+template <class Vertex, class Weight>
+struct BuiltArrays {
+    std::vector<std::size_t> offsets;
+    std::vector<Vertex> targets;
+    std::vector<Weight> weights;
+};
+
+template <class Record>
+void split(const std::vector<Record> &batch, std::vector<Slice<Record>> &slices) {
+    for (std::size_t begin = 0; begin < batch.size(); begin += kSliceEdges) {
+        slices.push_back({batch.data() + begin, std::min(kSliceEdges, batch.size() - begin)});
+    }
+}
+
+// Entrada formada por tramos de EdgeRecord.
+template <class Record>
+struct SliceSource {
+    using record_type = Record;
+
+    const std::vector<Slice<Record>> &slices;
+
+    std::size_t tasks() const { return slices.size(); }
+    template <class F>
+    void visit(std::size_t s, F &&f) const {
+        for (std::size_t i = 0; i < slices[s].size; ++i) {
+            f(slices[s].data[i]);
+        }
+    }
+};
+
+// Entrada formada por las aristas invertidas de un grafo, por bloques de filas.
+template <class Vertex, class Weight>
+struct ReversedSource {
+    using record_type = BasicEdgeRecord<Vertex, Weight>;
+
+    const BasicGraph<Vertex, Weight> &g;
+
+    std::size_t tasks() const {
+        return (static_cast<std::size_t>(g.num_vertices()) + kRowGrain - 1) / kRowGrain;
+    }
+    template <class F>
+    void visit(std::size_t t, F &&f) const {
+        const Vertex begin = static_cast<Vertex>(t * kRowGrain);
+        const Vertex end = std::min(g.num_vertices(), static_cast<Vertex>(begin + kRowGrain));
+        for (Vertex u = begin; u < end; ++u) {
+            for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+                f(record_type{g.target(e), u, g.weight(e)});
+            }
+        }
+    }
+};
+
+// Monta el CSR a partir de una fuente de aristas que puede recorrerse dos
+// veces por tareas independientes (conteo y reparto).
+template <class Vertex, class Weight, class Source>
+BasicGraph<Vertex, Weight> build_from(Vertex n, const Source &source, const BuildOptions &options) {
+    using Record = BasicEdgeRecord<Vertex, Weight>;
+    if (n < 0) {
+        throw std::invalid_argument("Número de vértices negativo");
+    }
+    const unsigned threads = parallel::effective_threads(source.tasks(), options.threads);
+    auto keep = [&](const Record &e) { return !(options.drop_self_loops && e.u == e.v); };
+    auto mirrored = [&](const Record &e) { return options.symmetrize && e.u != e.v; };
+
+    // 1. Grados de salida y validación de las aristas.
+    std::vector<std::atomic<std::size_t>> cursor(static_cast<std::size_t>(n) + 1);
+    std::vector<char> negative(threads, 0);
+    parallel::for_each_index(source.tasks(), threads, 1, [&](unsigned worker, std::size_t t) {
+        source.visit(t, [&](const Record &e) {
+            if (e.u < 0 || e.u >= n || e.v < 0 || e.v >= n) {
+                throw std::out_of_range("Extremo de arista fuera de rango");
+            }
+            if constexpr (std::is_floating_point_v<Weight>) {
+                if (std::isnan(e.w)) {
+                    throw std::invalid_argument("Peso de arista no numérico (NaN)");
+                }
+            }
+            if (!keep(e)) {
+                return;
+            }
+            if (e.w < Weight(0)) {
+                negative[worker] = 1;
+            }
+            cursor[e.u].fetch_add(1, std::memory_order_relaxed);
+            if (mirrored(e)) {
+                cursor[e.v].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    });
+
+    // 2. Desplazamientos por suma prefija; cursor[u] pasa a ser la siguiente
+    //    posición libre de la fila u.
+    auto store = std::make_shared<BuiltArrays<Vertex, Weight>>();
+    auto &offsets = store->offsets;
+    offsets.resize(static_cast<std::size_t>(n) + 1);
+    parallel::for_each_index(offsets.size(), options.threads, kRowGrain, [&](unsigned, std::size_t u) {
+        offsets[u] = cursor[u].load(std::memory_order_relaxed);
+    });
+    const std::size_t m = parallel::exclusive_scan(offsets, options.threads);
+    parallel::for_each_index(offsets.size(), options.threads, kRowGrain, [&](unsigned, std::size_t u) {
+        cursor[u].store(offsets[u], std::memory_order_relaxed);
+    });
+
+    // 3. Reparto de las aristas en su fila.
+    auto &targets = store->targets;
+    auto &weights = store->weights;
+    targets.resize(m);
+    weights.resize(m);
+    parallel::for_each_index(source.tasks(), threads, 1, [&](unsigned, std::size_t t) {
+        source.visit(t, [&](const Record &e) {
+            if (!keep(e)) {
+                return;
+            }
+            std::size_t pos = cursor[e.u].fetch_add(1, std::memory_order_relaxed);
+            targets[pos] = e.v;
+            weights[pos] = e.w;
+            if (mirrored(e)) {
+                pos = cursor[e.v].fetch_add(1, std::memory_order_relaxed);
+                targets[pos] = e.u;
+                weights[pos] = e.w;
+            }
+        });
+    });
+    cursor.clear();
+    cursor.shrink_to_fit();
+
+    // 4. Filas ordenadas por (destino, peso); con deduplicate se compacta
+    //    cada fila a su inicio y kept[u] guarda cuántas aristas quedan.
+    std::vector<std::size_t> kept;
+    if (options.deduplicate) {
+        kept.resize(static_cast<std::size_t>(n) + 1, 0);
+    }
+    const unsigned row_threads = parallel::effective_threads(n, options.threads, kRowGrain);
+    std::vector<std::vector<std::pair<Vertex, Weight>>> scratch(row_threads);
+    parallel::for_each_index(n, row_threads, kRowGrain, [&](unsigned worker, std::size_t u) {
+        const std::size_t begin = offsets[u], end = offsets[u + 1];
+        std::size_t count = end - begin;
+        if (count > 1) {
+            auto &row = scratch[worker];
+            row.clear();
+            for (std::size_t e = begin; e < end; ++e) {
+                row.emplace_back(targets[e], weights[e]);
+            }
+            std::sort(row.begin(), row.end());
+            if (options.deduplicate) {
+                row.erase(std::unique(row.begin(), row.end(),
+                                      [](const auto &a, const auto &b) { return a.first == b.first; }),
+                          row.end());
+            }
+            count = row.size();
+            for (std::size_t k = 0; k < count; ++k) {
+                targets[begin + k] = row[k].first;
+                weights[begin + k] = row[k].second;
+            }
+        }
+        if (options.deduplicate) {
+            kept[u] = count;
+        }
+    });
+
+    if (options.deduplicate) {
+        const std::size_t m_kept = parallel::exclusive_scan(kept, options.threads);
+        if (m_kept != m) {
+            auto compact = std::make_shared<BuiltArrays<Vertex, Weight>>();
+            compact->targets.resize(m_kept);
+            compact->weights.resize(m_kept);
+            parallel::for_each_index(n, options.threads, kRowGrain, [&](unsigned, std::size_t u) {
+                const std::size_t count = kept[u + 1] - kept[u];
+                std::copy_n(targets.begin() + offsets[u], count, compact->targets.begin() + kept[u]);
+                std::copy_n(weights.begin() + offsets[u], count, compact->weights.begin() + kept[u]);
+            });
+            compact->offsets = std::move(kept);
+            store = std::move(compact);
+        }
+    }
+
+    const bool has_negative = std::find(negative.begin(), negative.end(), 1) != negative.end();
+    const BuiltArrays<Vertex, Weight> &a = *store;
+    return BasicGraph<Vertex, Weight>::trusted_view({a.offsets.data(), a.offsets.size()},
+                               {a.targets.data(), a.targets.size()},
+                               {a.weights.data(), a.weights.size()}, store, has_negative);
+}
+
+} // namespace
+
+template <class Vertex, class Weight>
+BasicGraph<Vertex, Weight> build_csr(typename BasicEdgeRecord<Vertex, Weight>::vertex_type n,
+                                     const std::vector<std::vector<BasicEdgeRecord<Vertex, Weight>>> &batches,
+                                     const BuildOptions &options) {
+    using Record = BasicEdgeRecord<Vertex, Weight>;
+    std::vector<Slice<Record>> slices;
+    for (const auto &batch : batches) {
+        split(batch, slices);
+    }
+    return build_from<Vertex, Weight>(n, SliceSource<Record>{slices}, options);
+}
+
+template <class Vertex, class Weight>
+BasicGraph<Vertex, Weight> build_csr(typename BasicEdgeRecord<Vertex, Weight>::vertex_type n,
+                                     const std::vector<BasicEdgeRecord<Vertex, Weight>> &edges,
+                                     const BuildOptions &options) {
+    using Record = BasicEdgeRecord<Vertex, Weight>;
+    std::vector<Slice<Record>> slices;
+    split(edges, slices);
+    return build_from<Vertex, Weight>(n, SliceSource<Record>{slices}, options);
+}
+
+Graph build_csr(int n, const std::vector<std::vector<EdgeRecord>> &batches,
+                const BuildOptions &options) {
+    return build_csr<int, double>(n, batches, options);
+}
+
+Graph build_csr(int n, const std::vector<EdgeRecord> &edges, const BuildOptions &options) {
+    return build_csr<int, double>(n, edges, options);
+}
+
+template <class Vertex, class Weight>
+BasicGraph<Vertex, Weight> transpose(const BasicGraph<Vertex, Weight> &g, unsigned threads) {
+    BuildOptions options;
+    options.threads = threads;
+    return build_from<Vertex, Weight>(g.num_vertices(), ReversedSource<Vertex, Weight>{g}, options);
+}
+
+template <class Vertex, class Weight>
+void BasicGraphBuilder<Vertex, Weight>::add_edge(Vertex u, Vertex v, Weight w) {
+    if (u < 0 || v < 0) {
+        throw std::out_of_range("Extremo de arista fuera de rango");
+    }
+    edges_.push_back({u, v, w});
+    n_ = std::max(n_, static_cast<Vertex>(std::max(u, v) + 1));
+}
+
+#define GRAPHS_BUILDER(V, W)                                                                   \
+    template BasicGraph<V, W> build_csr<V, W>(V, const std::vector<std::vector<BasicEdgeRecord<V, W>>> &, \
+                                              const BuildOptions &);                           \
+    template BasicGraph<V, W> build_csr<V, W>(V, const std::vector<BasicEdgeRecord<V, W>> &,   \
+                                              const BuildOptions &);                           \
+    template BasicGraph<V, W> transpose<V, W>(const BasicGraph<V, W> &, unsigned);             \
+    template class BasicGraphBuilder<V, W>;
+GRAPHS_INSTANTIATE(GRAPHS_BUILDER)
+#undef GRAPHS_BUILDER
+
+} // namespace graphs
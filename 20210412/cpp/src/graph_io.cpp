@@ -0,0 +1,426 @@
+#include "graph_io.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include "parallel.hpp"
+
+namespace graphs {
+
+namespace {
+
+std::string read_all(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("No se puede abrir el archivo: " + path);
+    }
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    return buffer.str();
+}
+
+bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && is_blank(s.front())) s.remove_prefix(1);
+    while (!s.empty() && is_blank(s.back())) s.remove_suffix(1);
+    return s;
+}
+
+std::size_t line_of(std::string_view text, const char *at) {
+    return 1 + static_cast<std::size_t>(std::count(text.data(), at, '\n'));
+}
+
+// Asigna índices consecutivos a los nombres por orden de aparición.
+class Interner {
+public:
+    int vertex(std::string_view name) {
+        auto it = index_.find(name);
+        if (it != index_.end()) {
+            return it->second;
+        }
+        int id = static_cast<int>(names_.size());
+        names_.emplace_back(name);
+        // La clave apunta a la cadena propia, que no se mueve (deque).
+        index_.emplace(names_.back(), id);
+        return id;
+    }
+
+    int size() const { return static_cast<int>(names_.size()); }
+    std::vector<std::string> take_names() { return {names_.begin(), names_.end()}; }
+
+private:
+    std::unordered_map<std::string_view, int> index_;
+    std::deque<std::string> names_;
+};
+
+// Como Interner, pero los nombres son vistas del texto leído, que vive más
+// que el índice: sirve para numerar cada trozo del CSV sin copiar cadenas.
+struct ViewInterner {
+    int vertex(std::string_view name) {
+        auto [it, added] = index.emplace(name, static_cast<int>(names.size()));
+        if (added) {
+            names.push_back(name);
+        }
+        return it->second;
+    }
+
+    std::unordered_map<std::string_view, int> index;
+    std::vector<std::string_view> names;
+};
+
+// Una línea del CSV separada en campos (sin espacios alrededor).
+struct CsvLine {
+    std::string_view u, v, w;
+};
+
+// Recorre las líneas de [begin, end) e invoca on_line para las no vacías;
+// se detiene (y devuelve false) cuando on_line devuelve false.
+template <class F>
+bool for_each_csv_line(const char *begin, const char *end, F &&on_line) {
+    const char *p = begin;
+    while (p < end) {
+        const char *eol = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (!eol) {
+            eol = end;
+        }
+        std::string_view line(p, eol - p);
+        CsvLine fields;
+        std::string_view *slot[3] = {&fields.u, &fields.v, &fields.w};
+        for (int k = 0; k < 3; ++k) {
+            std::size_t comma = line.find(',');
+            *slot[k] = trim(line.substr(0, comma));
+            if (comma == std::string_view::npos) {
+                break;
+            }
+            line.remove_prefix(comma + 1);
+        }
+        if (!fields.u.empty() && !on_line(fields)) {
+            return false;
+        }
+        p = eol + 1;
+    }
+    return true;
+}
+
+// Trozos del texto que terminan en fin de línea, para leerlos en paralelo.
+std::vector<std::string_view> split_lines(std::string_view text, unsigned threads) {
+    const std::size_t min_chunk = 1 << 20;
+    const std::size_t pieces =
+        4 * static_cast<std::size_t>(parallel::effective_threads(text.size(), threads, min_chunk));
+    const std::size_t target = std::max(min_chunk, text.size() / pieces + 1);
+    std::vector<std::string_view> chunks;
+    std::size_t begin = 0;
+    while (begin < text.size()) {
+        std::size_t end = std::min(text.size(), begin + target);
+        if (end < text.size()) {
+            std::size_t eol = text.find('\n', end);
+            end = eol == std::string_view::npos ? text.size() : eol + 1;
+        }
+        chunks.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return chunks;
+}
+
+bool parse_id(std::string_view field, int &id) {
+    auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), id);
+    return ec == std::errc() && ptr == field.data() + field.size() && id >= 0;
+}
+
+double parse_weight(std::string_view text, std::string_view whole) {
+    if (text.empty()) {
+        return 1.0;
+    }
+    double w = 0.0;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), w);
+    if (ec != std::errc() || ptr != text.data() + text.size()) {
+        throw std::runtime_error("Peso no válido en la línea " +
+                                 std::to_string(line_of(whole, text.data())) + ": " +
+                                 std::string(text));
+    }
+    return w;
+}
+
+// Vía de BuildOptions::numeric_ids: todos los identificadores son enteros no
+// negativos y se usan directamente como índices.  Devuelve false si algún
+// trozo no lo cumple.
+bool read_numeric_csv(std::string_view text, const std::vector<std::string_view> &chunks,
+                      unsigned threads, std::vector<std::vector<EdgeRecord>> &batches, int &n) {
+    std::atomic<bool> numeric{true};
+    std::vector<int> max_id(chunks.size(), -1);
+    batches.assign(chunks.size(), {});
+    parallel::for_each_index(chunks.size(), threads, 1, [&](unsigned, std::size_t c) {
+        const char *begin = chunks[c].data();
+        auto &batch = batches[c];
+        batch.reserve(chunks[c].size() / 8);
+        bool ok = for_each_csv_line(begin, begin + chunks[c].size(), [&](const CsvLine &line) {
+            int u = 0, v = 0;
+            if (!numeric.load(std::memory_order_relaxed) || !parse_id(line.u, u) ||
+                (!line.v.empty() && !parse_id(line.v, v))) {
+                return false;
+            }
+            max_id[c] = std::max(max_id[c], u);
+            if (!line.v.empty()) {
+                max_id[c] = std::max(max_id[c], v);
+                batch.push_back({u, v, parse_weight(line.w, text)});
+            }
+            return true;
+        });
+        if (!ok) {
+            numeric.store(false, std::memory_order_relaxed);
+        }
+    });
+    if (!numeric.load()) {
+        return false;
+    }
+    const int top = *std::max_element(max_id.begin(), max_id.end());
+    if (top == std::numeric_limits<int>::max()) {
+        throw std::runtime_error("Identificador de vértice demasiado grande: " + std::to_string(top));
+    }
+    n = 1 + top;
+    return true;
+}
+
+// Analizador JSON mínimo para el formato de adyacencia.
+class JsonReader {
+public:
+    explicit JsonReader(const std::string &text) : s_(text) {}
+
+    void parse(Interner &names, std::vector<EdgeRecord> &edges) {
+        expect('{');
+        if (peek() == '}') {
+            ++pos_;
+            return;
+        }
+        for (;;) {
+            int u = names.vertex(string());
+            expect(':');
+            expect('[');
+            if (peek() == ']') {
+                ++pos_;
+            } else {
+                for (;;) {
+                    neighbor(names, edges, u);
+                    if (peek() == ',') {
+                        ++pos_;
+                        continue;
+                    }
+                    expect(']');
+                    break;
+                }
+            }
+            if (peek() == ',') {
+                ++pos_;
+                continue;
+            }
+            expect('}');
+            break;
+        }
+    }
+
+private:
+    void neighbor(Interner &names, std::vector<EdgeRecord> &edges, int u) {
+        char c = peek();
+        if (c == '[') {
+            ++pos_;
+            int v = names.vertex(scalar());
+            double w = 1.0;
+            if (peek() == ',') {
+                ++pos_;
+                w = number();
+            }
+            expect(']');
+            edges.push_back({u, v, w});
+        } else if (c == '{') {
+            ++pos_;
+            int v = -1;
+            double w = 1.0;
+            for (;;) {
+                std::string key = string();
+                expect(':');
+                if (key == "to") {
+                    v = names.vertex(scalar());
+                } else if (key == "weight") {
+                    w = number();
+                } else {
+                    scalar();
+                }
+                if (peek() == ',') {
+                    ++pos_;
+                    continue;
+                }
+                expect('}');
+                break;
+            }
+            if (v < 0) {
+                fail("falta el campo \"to\"");
+            }
+            edges.push_back({u, v, w});
+        } else {
+            edges.push_back({u, names.vertex(scalar()), 1.0});
+        }
+    }
+
+    // Cadena o número, devuelto como texto (identificador de nodo).
+    std::string scalar() {
+        if (peek() == '"') {
+            return string();
+        }
+        std::size_t start = pos_;
+        while (pos_ < s_.size() && (std::isalnum(static_cast<unsigned char>(s_[pos_])) ||
+                                    s_[pos_] == '-' || s_[pos_] == '+' || s_[pos_] == '.')) {
+            ++pos_;
+        }
+        if (start == pos_) {
+            fail("se esperaba un valor");
+        }
+        return s_.substr(start, pos_ - start);
+    }
+
+    double number() {
+        std::string text = scalar();
+        try {
+            return std::stod(text);
+        } catch (const std::exception &) {
+            fail("número no válido: " + text);
+        }
+        return 0.0;
+    }
+
+    std::string string() {
+        expect('"');
+        std::string out;
+        while (pos_ < s_.size() && s_[pos_] != '"') {
+            if (s_[pos_] == '\\' && pos_ + 1 < s_.size()) {
+                ++pos_;
+            }
+            out.push_back(s_[pos_++]);
+        }
+        expect('"');
+        return out;
+    }
+
+    char peek() {
+        while (pos_ < s_.size() && std::isspace(static_cast<unsigned char>(s_[pos_]))) {
+            ++pos_;
+        }
+        return pos_ < s_.size() ? s_[pos_] : '\0';
+    }
+
+    void expect(char c) {
+        if (peek() != c) {
+            fail(std::string("se esperaba '") + c + "'");
+        }
+        ++pos_;
+    }
+
+    [[noreturn]] void fail(const std::string &what) const {
+        std::size_t line = 1 + std::count(s_.begin(), s_.begin() + std::min(pos_, s_.size()), '\n');
+        throw std::runtime_error("JSON de adyacencia no válido (línea " + std::to_string(line) +
+                                 "): " + what);
+    }
+
+    const std::string &s_;
+    std::size_t pos_ = 0;
+};
+
+} // namespace
+
+int LabeledGraph::find(const std::string &name) const {
+    if (names.empty()) {
+        int id = -1;
+        return parse_id(name, id) && id < graph.num_vertices() ? id : -1;
+    }
+    auto it = std::find(names.begin(), names.end(), name);
+    return it == names.end() ? -1 : static_cast<int>(it - names.begin());
+}
+
+LabeledGraph read_edge_list_csv(const std::string &path, const BuildOptions &options) {
+    const std::string content = read_all(path);
+    const std::string_view text(content);
+    const auto chunks = split_lines(text, options.threads);
+    std::vector<std::vector<EdgeRecord>> batches;
+    LabeledGraph out;
+    int n = 0;
+    if (options.numeric_ids && read_numeric_csv(text, chunks, options.threads, batches, n)) {
+        out.graph = build_csr(n, batches, options);
+        return out;
+    }
+    // Identificadores con nombre: cada trozo numera sus nombres por orden de
+    // aparición y lee sus aristas en paralelo; al fusionar los trozos en
+    // orden, los índices locales se traducen a los globales, que conservan
+    // así el orden de aparición en todo el archivo.
+    std::vector<ViewInterner> local(chunks.size());
+    batches.assign(chunks.size(), {});
+    parallel::for_each_index(chunks.size(), options.threads, 1, [&](unsigned, std::size_t c) {
+        const char *begin = chunks[c].data();
+        auto &batch = batches[c];
+        batch.reserve(chunks[c].size() / 16);
+        for_each_csv_line(begin, begin + chunks[c].size(), [&](const CsvLine &line) {
+            const int u = local[c].vertex(line.u);
+            if (!line.v.empty()) {
+                const int v = local[c].vertex(line.v);
+                batch.push_back({u, v, parse_weight(line.w, text)});
+            }
+            return true;
+        });
+    });
+    ViewInterner global;
+    std::vector<std::vector<int>> remap(chunks.size());
+    for (std::size_t c = 0; c < chunks.size(); ++c) {
+        remap[c].reserve(local[c].names.size());
+        for (std::string_view name : local[c].names) {
+            remap[c].push_back(global.vertex(name));
+        }
+        local[c] = {};
+    }
+    parallel::for_each_index(chunks.size(), options.threads, 1, [&](unsigned, std::size_t c) {
+        for (EdgeRecord &e : batches[c]) {
+            e.u = remap[c][e.u];
+            e.v = remap[c][e.v];
+        }
+        std::vector<int>().swap(remap[c]);
+    });
+    global.index = {};
+    out.graph = build_csr(static_cast<int>(global.names.size()), batches, options);
+    out.names.assign(global.names.begin(), global.names.end());
+    return out;
+}
+
+LabeledGraph read_adjacency_json(const std::string &path, const BuildOptions &options) {
+    std::string text = read_all(path);
+    Interner names;
+    std::vector<EdgeRecord> edges;
+    JsonReader(text).parse(names, edges);
+    LabeledGraph out;
+    out.graph = build_csr(names.size(), edges, options);
+    out.names = names.take_names();
+    return out;
+}
+
+LabeledGraph read_graph_file(const std::string &path, const BuildOptions &options) {
+    auto dot = path.find_last_of('.');
+    std::string ext = dot == std::string::npos ? "" : path.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (ext == "csv") {
+        return read_edge_list_csv(path, options);
+    }
+    if (ext == "json") {
+        return read_adjacency_json(path, options);
+    }
+    throw std::runtime_error("Tipo de archivo no soportado: " + path);
+}
+
+} // namespace graphs
@@ -0,0 +1,100 @@
+#include "johnson.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+#include "bellman_ford.hpp"
+#include "dijkstra.hpp"
+#include "parallel.hpp"
+
+namespace graphs {
+
+TiledDistanceMatrix::TiledDistanceMatrix(int n, int tile) : n_(n), tile_(std::max(tile, 1)) {
+    if (n < 0) {
+        throw std::invalid_argument("Tamaño de matriz negativo");
+    }
+    tiles_per_row_ = (static_cast<std::size_t>(n_) + tile_ - 1) / tile_;
+    data_.assign(tiles_per_row_ * tiles_per_row_ * tile_ * tile_,
+                 std::numeric_limits<double>::infinity());
+}
+
+void TiledDistanceMatrix::set_row(int i, const std::vector<double> &row) {
+    for (int j = 0; j < n_; ++j) {
+        data_[index(i, j)] = row[j];
+    }
+}
+
+std::vector<double> TiledDistanceMatrix::row(int i) const {
+    std::vector<double> out(n_);
+    for (int j = 0; j < n_; ++j) {
+        out[j] = data_[index(i, j)];
+    }
+    return out;
+}
+
+namespace {
+
+// Ejecuta un Dijkstra por origen sobre el grafo reponderado y entrega cada
+// fila, ya con las distancias originales, a emit(source, row).
+template <class Emit>
+void johnson_rows(const Graph &g, unsigned threads, Emit &&emit) {
+    const int n = g.num_vertices();
+    std::vector<double> h(n, 0.0);
+    Graph reduced;
+    const Graph *work = &g;
+    if (g.has_negative_weights()) {
+        BellmanFordResult bf = bellman_ford_potentials(g);
+        if (bf.negative_cycle) {
+            throw std::runtime_error("El grafo contiene un ciclo negativo");
+        }
+        h = std::move(bf.tree.dist);
+        std::vector<double> w(g.num_edges());
+        for (int u = 0; u < n; ++u) {
+            for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+                // El redondeo puede dejar -1e-17 en aristas ajustadas: se satura a 0.
+                w[e] = std::max(0.0, g.weight(e) + h[u] - h[g.target(e)]);
+            }
+        }
+        reduced = Graph(g.offsets().to_vector(), g.targets().to_vector(), std::move(w));
+        work = &reduced;
+    }
+
+    threads = parallel::effective_threads(n, threads);
+    std::vector<DijkstraWorkspace> workspaces(threads);
+    std::vector<std::vector<double>> rows(threads);
+    const QueryLimits unlimited;
+    parallel::for_each_index(n, threads, 1, [&](unsigned worker, std::size_t s) {
+        const int source = static_cast<int>(s);
+        SparseDistances reached = dijkstra_limited(*work, source, unlimited, workspaces[worker]);
+        auto &row = rows[worker];
+        row.assign(n, std::numeric_limits<double>::infinity());
+        for (std::size_t k = 0; k < reached.size(); ++k) {
+            int v = reached.vertices[k];
+            row[v] = reached.dist[k] - h[source] + h[v];
+        }
+        emit(source, row);
+    });
+}
+
+} // namespace
+
+void johnson_apsp_rows(const Graph &g, const DistanceRowCallback &on_row, unsigned threads) {
+    std::mutex emit_mutex;
+    johnson_rows(g, threads, [&](int source, const std::vector<double> &row) {
+        std::lock_guard<std::mutex> lock(emit_mutex);
+        on_row(source, row);
+    });
+}
+
+TiledDistanceMatrix johnson_apsp(const Graph &g, unsigned threads, int tile) {
+    TiledDistanceMatrix out(g.num_vertices(), tile);
+    // Cada hilo escribe filas distintas: no hace falta sincronizar.
+    johnson_rows(g, threads, [&](int source, const std::vector<double> &row) {
+        out.set_row(source, row);
+    });
+    return out;
+}
+
+} // namespace graphs
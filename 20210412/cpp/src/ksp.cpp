@@ -0,0 +1,104 @@
+#include "ksp.hpp"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+
+namespace graphs {
+
+namespace {
+
+// Los caminos se identifican por su secuencia de aristas (admite multiaristas).
+struct CandidateLess {
+    bool operator()(const PathResult &a, const PathResult &b) const {
+        if (a.cost != b.cost) {
+            return a.cost < b.cost;
+        }
+        if (a.edges.size() != b.edges.size()) {
+            return a.edges.size() < b.edges.size();
+        }
+        return a.edges < b.edges;
+    }
+};
+
+bool same_root(const PathResult &p, const PathResult &q, std::size_t len) {
+    if (p.vertices.size() <= len || q.vertices.size() <= len) {
+        return false;
+    }
+    return std::equal(p.vertices.begin(), p.vertices.begin() + len + 1, q.vertices.begin());
+}
+
+} // namespace
+
+std::vector<PathResult> k_shortest_paths(const Graph &g, int source, int target, std::size_t k,
+                                         unsigned threads) {
+    SearchPool pool;
+    return k_shortest_paths(g, source, target, k, pool, threads);
+}
+
+std::vector<PathResult> k_shortest_paths(const Graph &g, int source, int target, std::size_t k,
+                                         SearchPool &pool, unsigned threads) {
+    std::vector<PathResult> accepted;
+    if (k == 0) {
+        return accepted;
+    }
+    {
+        auto scratch = pool.acquire();
+        PathResult first = dijkstra_path(g, source, target, scratch->workspace);
+        if (!first.found()) {
+            return accepted;
+        }
+        accepted.push_back(std::move(first));
+    }
+    std::set<PathResult, CandidateLess> candidates;
+    std::set<std::vector<std::size_t>> known;
+    known.insert(accepted.front().edges);
+
+    while (accepted.size() < k) {
+        const PathResult &prev = accepted.back();
+        const std::size_t spurs = prev.vertices.size() - 1;
+        // Coste acumulado del prefijo hasta cada vértice del camino anterior.
+        std::vector<double> root_cost(prev.vertices.size(), 0.0);
+        for (std::size_t i = 0; i < prev.edges.size(); ++i) {
+            root_cost[i + 1] = root_cost[i] + g.weight(prev.edges[i]);
+        }
+        std::vector<PathResult> found(spurs);
+        parallel::for_each_index(spurs, threads, 1, [&](unsigned, std::size_t i) {
+            auto scratch = pool.acquire();
+            SearchMask &mask = scratch->mask;
+            mask.prepare(g.num_vertices(), g.num_edges());
+            for (std::size_t j = 0; j < i; ++j) {
+                mask.ban_vertex(prev.vertices[j]);
+            }
+            for (const PathResult &p : accepted) {
+                if (same_root(p, prev, i)) {
+                    mask.ban_edge(p.edges[i]);
+                }
+            }
+            PathResult spur = dijkstra_path(g, prev.vertices[i], target, scratch->workspace, &mask);
+            if (!spur.found()) {
+                return;
+            }
+            PathResult total;
+            total.cost = root_cost[i] + spur.cost;
+            total.vertices.assign(prev.vertices.begin(), prev.vertices.begin() + i);
+            total.vertices.insert(total.vertices.end(), spur.vertices.begin(), spur.vertices.end());
+            total.edges.assign(prev.edges.begin(), prev.edges.begin() + i);
+            total.edges.insert(total.edges.end(), spur.edges.begin(), spur.edges.end());
+            found[i] = std::move(total);
+        });
+        for (auto &cand : found) {
+            if (cand.found() && known.insert(cand.edges).second) {
+                candidates.insert(std::move(cand));
+            }
+        }
+        if (candidates.empty()) {
+            break;
+        }
+        accepted.push_back(*candidates.begin());
+        candidates.erase(candidates.begin());
+    }
+    return accepted;
+}
+
+} // namespace graphs
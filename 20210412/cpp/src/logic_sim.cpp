@@ -0,0 +1,804 @@
+#include "logic_sim.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "parallel.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GRAPHS_SIM_X86 1
+#include <immintrin.h>
+#endif
+
+namespace graphs {
+
+namespace {
+
+// Vectores por bloque: 8 palabras de 64 bits por registro.
+constexpr unsigned kWords = 8;
+constexpr unsigned kBlockLanes = 64 * kWords;
+// Bloques por trozo del espacio de entradas en la comprobación de
+// equivalencia (unidad de reparto y de salida temprana).
+constexpr std::uint64_t kChunkBlocks = 64;
+constexpr unsigned kMaxEquivalenceInputs = 63;
+constexpr unsigned kMaxTableInputs = 32;
+
+bool is_gate(GateKind kind) { return kind != GateKind::Input; }
+
+bool binary(GateKind kind) { return kind >= GateKind::And; }
+
+bool apply(GateKind kind, bool a, bool b) {
+    switch (kind) {
+    case GateKind::Const0:
+        return false;
+    case GateKind::Const1:
+        return true;
+    case GateKind::Buf:
+        return a;
+    case GateKind::Not:
+        return !a;
+    case GateKind::And:
+        return a && b;
+    case GateKind::Or:
+        return a || b;
+    case GateKind::Xor:
+        return a != b;
+    case GateKind::Nand:
+        return !(a && b);
+    case GateKind::Nor:
+        return !(a || b);
+    case GateKind::Xnor:
+        return a == b;
+    case GateKind::Input:
+        break;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// Programa compilado
+
+struct Instr {
+    GateKind op;
+    std::uint32_t dst, a, b;
+};
+
+struct Program {
+    std::vector<Instr> code;
+    std::uint32_t registers = 0;
+    // Registro de la entrada i (las entradas ocupan los primeros).
+    std::vector<std::uint32_t> inputs;
+    std::vector<std::uint32_t> outputs;
+};
+
+// Asigna registros reutilizando los de los nodos que ya nadie va a leer.
+Program compile(const Circuit &c) {
+    const std::size_t n = c.size();
+    std::vector<std::size_t> last(n, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Circuit::Node &node = c.node(static_cast<std::uint32_t>(i));
+        if (node.kind == GateKind::Input || node.kind == GateKind::Const0 || node.kind == GateKind::Const1) {
+            continue;
+        }
+        last[node.a] = i;
+        if (binary(node.kind)) {
+            last[node.b] = i;
+        }
+    }
+    for (std::uint32_t o : c.outputs()) {
+        last[o] = std::numeric_limits<std::size_t>::max();
+    }
+    Program p;
+    std::vector<std::uint32_t> reg(n, 0), free;
+    for (unsigned i = 0; i < c.inputs(); ++i) {
+        reg[c.input(i)] = p.registers;
+        p.inputs.push_back(p.registers++);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        const Circuit::Node &node = c.node(static_cast<std::uint32_t>(i));
+        if (node.kind == GateKind::Input) {
+            continue;
+        }
+        Instr in{node.kind, 0, 0, 0};
+        const bool unary = node.kind == GateKind::Buf || node.kind == GateKind::Not;
+        if (unary || binary(node.kind)) {
+            in.a = reg[node.a];
+            in.b = binary(node.kind) ? reg[node.b] : in.a;
+            // Los operandos que mueren aquí liberan su registro antes de
+            // elegir el destino: la instrucción puede escribir sobre ellos.
+            for (std::uint32_t operand : {node.a, node.b}) {
+                if ((operand == node.a || binary(node.kind)) && last[operand] == i &&
+                    c.node(operand).kind != GateKind::Input) {
+                    free.push_back(reg[operand]);
+                    last[operand] = 0;
+                }
+            }
+        }
+        if (free.empty()) {
+            reg[i] = p.registers++;
+        } else {
+            reg[i] = free.back();
+            free.pop_back();
+        }
+        in.dst = reg[i];
+        p.code.push_back(in);
+        if (last[i] == 0) {
+            // Nadie lo lee: el registro vuelve a quedar libre.
+            free.push_back(reg[i]);
+        }
+    }
+    for (std::uint32_t o : c.outputs()) {
+        p.outputs.push_back(reg[o]);
+    }
+    return p;
+}
+
+// Patrones de las seis primeras entradas dentro de una palabra.
+constexpr std::uint64_t kLanePattern[6] = {0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+                                           0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull};
+
+// Entradas del bloque `block` (vectores 512·block ... 512·block + 511).
+void fill_inputs(const Program &p, std::uint64_t block, std::uint64_t *regs) {
+    const std::uint64_t base = block * kBlockLanes;
+    for (std::size_t i = 0; i < p.inputs.size(); ++i) {
+        std::uint64_t *r = regs + std::size_t(p.inputs[i]) * kWords;
+        for (unsigned w = 0; w < kWords; ++w) {
+            if (i < 6) {
+                r[w] = kLanePattern[i];
+            } else if (i < 9) {
+                r[w] = ((w >> (i - 6)) & 1) ? ~std::uint64_t(0) : 0;
+            } else {
+                r[w] = ((base >> i) & 1) ? ~std::uint64_t(0) : 0;
+            }
+        }
+    }
+}
+
+void run_scalar(const Program &p, std::uint64_t *regs) {
+    for (const Instr &in : p.code) {
+        std::uint64_t *d = regs + std::size_t(in.dst) * kWords;
+        const std::uint64_t *x = regs + std::size_t(in.a) * kWords;
+        const std::uint64_t *y = regs + std::size_t(in.b) * kWords;
+        std::uint64_t t[kWords];
+        for (unsigned w = 0; w < kWords; ++w) {
+            switch (in.op) {
+            case GateKind::Const0:
+                t[w] = 0;
+                break;
+            case GateKind::Const1:
+                t[w] = ~std::uint64_t(0);
+                break;
+            case GateKind::Buf:
+                t[w] = x[w];
+                break;
+            case GateKind::Not:
+                t[w] = ~x[w];
+                break;
+            case GateKind::And:
+                t[w] = x[w] & y[w];
+                break;
+            case GateKind::Or:
+                t[w] = x[w] | y[w];
+                break;
+            case GateKind::Xor:
+                t[w] = x[w] ^ y[w];
+                break;
+            case GateKind::Nand:
+                t[w] = ~(x[w] & y[w]);
+                break;
+            case GateKind::Nor:
+                t[w] = ~(x[w] | y[w]);
+                break;
+            case GateKind::Xnor:
+                t[w] = ~(x[w] ^ y[w]);
+                break;
+            case GateKind::Input:
+                t[w] = x[w];
+                break;
+            }
+        }
+        std::copy(t, t + kWords, d);
+    }
+}
+
+#ifdef GRAPHS_SIM_X86
+__attribute__((target("avx2"))) void run_avx2(const Program &p, std::uint64_t *regs) {
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    for (const Instr &in : p.code) {
+        auto *d = reinterpret_cast<__m256i *>(regs + std::size_t(in.dst) * kWords);
+        const auto *x = reinterpret_cast<const __m256i *>(regs + std::size_t(in.a) * kWords);
+        const auto *y = reinterpret_cast<const __m256i *>(regs + std::size_t(in.b) * kWords);
+        const __m256i x0 = _mm256_loadu_si256(x), x1 = _mm256_loadu_si256(x + 1);
+        const __m256i y0 = _mm256_loadu_si256(y), y1 = _mm256_loadu_si256(y + 1);
+        __m256i r0, r1;
+        switch (in.op) {
+        case GateKind::Const0:
+            r0 = r1 = _mm256_setzero_si256();
+            break;
+        case GateKind::Const1:
+            r0 = r1 = ones;
+            break;
+        case GateKind::Not:
+            r0 = _mm256_xor_si256(x0, ones);
+            r1 = _mm256_xor_si256(x1, ones);
+            break;
+        case GateKind::And:
+        case GateKind::Nand:
+            r0 = _mm256_and_si256(x0, y0);
+            r1 = _mm256_and_si256(x1, y1);
+            break;
+        case GateKind::Or:
+        case GateKind::Nor:
+            r0 = _mm256_or_si256(x0, y0);
+            r1 = _mm256_or_si256(x1, y1);
+            break;
+        case GateKind::Xor:
+        case GateKind::Xnor:
+            r0 = _mm256_xor_si256(x0, y0);
+            r1 = _mm256_xor_si256(x1, y1);
+            break;
+        default:
+            r0 = x0;
+            r1 = x1;
+            break;
+        }
+        if (in.op == GateKind::Nand || in.op == GateKind::Nor || in.op == GateKind::Xnor) {
+            r0 = _mm256_xor_si256(r0, ones);
+            r1 = _mm256_xor_si256(r1, ones);
+        }
+        _mm256_storeu_si256(d, r0);
+        _mm256_storeu_si256(d + 1, r1);
+    }
+}
+
+__attribute__((target("avx512f"))) void run_avx512(const Program &p, std::uint64_t *regs) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    for (const Instr &in : p.code) {
+        void *d = regs + std::size_t(in.dst) * kWords;
+        const __m512i x = _mm512_loadu_si512(regs + std::size_t(in.a) * kWords);
+        const __m512i y = _mm512_loadu_si512(regs + std::size_t(in.b) * kWords);
+        __m512i r;
+        switch (in.op) {
+        case GateKind::Const0:
+            r = _mm512_setzero_si512();
+            break;
+        case GateKind::Const1:
+            r = ones;
+            break;
+        case GateKind::Not:
+            r = _mm512_xor_si512(x, ones);
+            break;
+        case GateKind::And:
+            r = _mm512_and_si512(x, y);
+            break;
+        case GateKind::Or:
+            r = _mm512_or_si512(x, y);
+            break;
+        case GateKind::Xor:
+            r = _mm512_xor_si512(x, y);
+            break;
+        case GateKind::Nand:
+            r = _mm512_xor_si512(_mm512_and_si512(x, y), ones);
+            break;
+        case GateKind::Nor:
+            r = _mm512_xor_si512(_mm512_or_si512(x, y), ones);
+            break;
+        case GateKind::Xnor:
+            r = _mm512_xor_si512(_mm512_xor_si512(x, y), ones);
+            break;
+        default:
+            r = x;
+            break;
+        }
+        _mm512_storeu_si512(d, r);
+    }
+}
+
+bool has_avx2() {
+    static const bool ok = __builtin_cpu_supports("avx2");
+    return ok;
+}
+
+bool has_avx512() {
+    static const bool ok = __builtin_cpu_supports("avx512f");
+    return ok;
+}
+#endif
+
+using Kernel = void (*)(const Program &, std::uint64_t *);
+
+Kernel select_kernel(unsigned lanes) {
+#ifdef GRAPHS_SIM_X86
+    if ((lanes == 0 || lanes >= 512) && has_avx512()) {
+        return run_avx512;
+    }
+    if ((lanes == 0 || lanes >= 256) && has_avx2()) {
+        return run_avx2;
+    }
+#endif
+    (void)lanes;
+    return run_scalar;
+}
+
+// ---------------------------------------------------------------------------
+// Expresiones
+
+class ExpressionParser {
+public:
+    ExpressionParser(Circuit &c, const std::map<std::string, std::uint32_t> &vars, const std::string &text)
+        : c_(c), vars_(vars), text_(text) {}
+
+    std::uint32_t parse() {
+        const std::uint32_t r = parse_or();
+        skip();
+        if (pos_ != text_.size()) {
+            fail("símbolo inesperado");
+        }
+        return r;
+    }
+
+private:
+    [[noreturn]] void fail(const std::string &what) const {
+        throw std::invalid_argument("Expresión no válida (posición " + std::to_string(pos_) + "): " + what +
+                                    " en '" + text_ + "'");
+    }
+
+    void skip() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    bool accept(char ch) {
+        skip();
+        if (pos_ < text_.size() && text_[pos_] == ch) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    std::uint32_t parse_or() {
+        std::uint32_t r = parse_xor();
+        while (accept('|')) {
+            r = c_.add_gate(GateKind::Or, r, parse_xor());
+        }
+        return r;
+    }
+
+    std::uint32_t parse_xor() {
+        std::uint32_t r = parse_and();
+        while (accept('^')) {
+            r = c_.add_gate(GateKind::Xor, r, parse_and());
+        }
+        return r;
+    }
+
+    std::uint32_t parse_and() {
+        std::uint32_t r = parse_unary();
+        while (accept('&')) {
+            r = c_.add_gate(GateKind::And, r, parse_unary());
+        }
+        return r;
+    }
+
+    std::uint32_t parse_unary() {
+        if (accept('~') || accept('!')) {
+            return c_.add_gate(GateKind::Not, parse_unary());
+        }
+        if (accept('(')) {
+            const std::uint32_t r = parse_or();
+            if (!accept(')')) {
+                fail("falta ')'");
+            }
+            return r;
+        }
+        skip();
+        const std::size_t start = pos_;
+        while (pos_ < text_.size() && (std::isalnum(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_')) {
+            ++pos_;
+        }
+        const std::string word = text_.substr(start, pos_ - start);
+        if (word == "0" || word == "1") {
+            return c_.constant(word == "1");
+        }
+        const auto it = vars_.find(word);
+        if (it == vars_.end()) {
+            pos_ = start;
+            fail(word.empty() ? "falta un operando" : "variable desconocida " + word);
+        }
+        return it->second;
+    }
+
+    Circuit &c_;
+    const std::map<std::string, std::uint32_t> &vars_;
+    const std::string &text_;
+    std::size_t pos_ = 0;
+};
+
+// ---------------------------------------------------------------------------
+// .bench
+
+struct BenchDef {
+    std::string op;
+    std::vector<std::string> args;
+    std::size_t line;
+};
+
+[[noreturn]] void bench_error(std::size_t line, const std::string &what) {
+    throw std::runtime_error("Fichero .bench no válido (línea " + std::to_string(line) + "): " + what);
+}
+
+std::string trim(const std::string &s) {
+    const std::size_t b = s.find_first_not_of(" \t\r");
+    if (b == std::string::npos) {
+        return {};
+    }
+    return s.substr(b, s.find_last_not_of(" \t\r") - b + 1);
+}
+
+// "OP(a, b, ...)" -> OP y argumentos.
+bool split_call(const std::string &text, std::string &op, std::vector<std::string> &args) {
+    const std::size_t open = text.find('('), close = text.rfind(')');
+    if (open == std::string::npos || close == std::string::npos || close < open || trim(text.substr(close + 1)) != "") {
+        return false;
+    }
+    op = trim(text.substr(0, open));
+    std::transform(op.begin(), op.end(), op.begin(), [](unsigned char ch) { return std::toupper(ch); });
+    args.clear();
+    std::stringstream list(text.substr(open + 1, close - open - 1));
+    std::string arg;
+    while (std::getline(list, arg, ',')) {
+        args.push_back(trim(arg));
+        if (args.back().empty()) {
+            return false;
+        }
+    }
+    return !op.empty();
+}
+
+// Puerta de varias entradas como árbol equilibrado; la inversión va en la
+// última.
+std::uint32_t gate_tree(Circuit &c, GateKind base, bool inverted, std::vector<std::uint32_t> ids) {
+    while (ids.size() > 2) {
+        std::vector<std::uint32_t> next;
+        for (std::size_t i = 0; i + 1 < ids.size(); i += 2) {
+            next.push_back(c.add_gate(base, ids[i], ids[i + 1]));
+        }
+        if (ids.size() % 2) {
+            next.push_back(ids.back());
+        }
+        ids.swap(next);
+    }
+    if (ids.size() == 1) {
+        return c.add_gate(inverted ? GateKind::Not : GateKind::Buf, ids[0]);
+    }
+    GateKind kind = base;
+    if (inverted) {
+        kind = base == GateKind::And ? GateKind::Nand : base == GateKind::Or ? GateKind::Nor : GateKind::Xnor;
+    }
+    return c.add_gate(kind, ids[0], ids[1]);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Circuit
+
+Circuit::Circuit(unsigned inputs) {
+    for (unsigned i = 0; i < inputs; ++i) {
+        add_input();
+    }
+}
+
+std::uint32_t Circuit::add_input(const std::string &name) {
+    const auto id = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back({GateKind::Input, 0, 0});
+    input_names_.push_back(name.empty() ? "x" + std::to_string(input_nodes_.size()) : name);
+    input_nodes_.push_back(id);
+    return id;
+}
+
+std::uint32_t Circuit::input(unsigned i) const {
+    if (i >= input_nodes_.size()) {
+        throw std::out_of_range("Entrada fuera de rango: " + std::to_string(i));
+    }
+    return input_nodes_[i];
+}
+
+std::uint32_t Circuit::constant(bool value) {
+    const auto id = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back({value ? GateKind::Const1 : GateKind::Const0, 0, 0});
+    return id;
+}
+
+std::uint32_t Circuit::add_gate(GateKind kind, std::uint32_t a, std::uint32_t b) {
+    if (!is_gate(kind) || kind == GateKind::Const0 || kind == GateKind::Const1) {
+        throw std::invalid_argument("Tipo de puerta no válido");
+    }
+    if (a >= nodes_.size() || (binary(kind) && b >= nodes_.size())) {
+        throw std::invalid_argument("Operando de puerta inexistente");
+    }
+    const auto id = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back({kind, a, binary(kind) ? b : a});
+    return id;
+}
+
+void Circuit::add_output(std::uint32_t node, const std::string &name) {
+    if (node >= nodes_.size()) {
+        throw std::invalid_argument("Salida inexistente");
+    }
+    outputs_.push_back(node);
+    output_names_.push_back(name.empty() ? "y" + std::to_string(outputs_.size() - 1) : name);
+}
+
+Circuit parse_expressions(const std::vector<std::string> &outputs, const std::vector<std::string> &inputs) {
+    Circuit c;
+    std::map<std::string, std::uint32_t> vars;
+    for (const std::string &name : inputs) {
+        if (!vars.emplace(name, c.add_input(name)).second) {
+            throw std::invalid_argument("Variable repetida: " + name);
+        }
+    }
+    for (const std::string &text : outputs) {
+        c.add_output(ExpressionParser(c, vars, text).parse());
+    }
+    return c;
+}
+
+Circuit parse_bench(std::istream &in) {
+    std::vector<std::pair<std::string, std::size_t>> input_names, output_names;
+    std::map<std::string, BenchDef> defs;
+    std::string raw;
+    std::size_t line = 0;
+    while (std::getline(in, raw)) {
+        ++line;
+        const std::string text = trim(raw.substr(0, raw.find('#')));
+        if (text.empty()) {
+            continue;
+        }
+        std::string op;
+        std::vector<std::string> args;
+        const std::size_t eq = text.find('=');
+        if (eq == std::string::npos) {
+            if (!split_call(text, op, args) || args.size() != 1 || (op != "INPUT" && op != "OUTPUT")) {
+                bench_error(line, text);
+            }
+            (op == "INPUT" ? input_names : output_names).push_back({args[0], line});
+            if (op == "INPUT" && !defs.emplace(args[0], BenchDef{"INPUT", {}, line}).second) {
+                bench_error(line, "señal definida dos veces: " + args[0]);
+            }
+            continue;
+        }
+        const std::string name = trim(text.substr(0, eq));
+        if (name.empty() || !split_call(text.substr(eq + 1), op, args)) {
+            bench_error(line, text);
+        }
+        static const char *const kOps[] = {"AND", "OR", "NAND", "NOR", "XOR", "XNOR", "NOT", "BUF", "BUFF"};
+        if (std::find(std::begin(kOps), std::end(kOps), op) == std::end(kOps)) {
+            bench_error(line, "puerta no soportada: " + op);
+        }
+        if (args.empty() || ((op == "NOT" || op == "BUF" || op == "BUFF") && args.size() != 1)) {
+            bench_error(line, op + " con " + std::to_string(args.size()) + " entradas");
+        }
+        if (!defs.emplace(name, BenchDef{op, args, line}).second) {
+            bench_error(line, "señal definida dos veces: " + name);
+        }
+    }
+
+    Circuit c;
+    std::map<std::string, std::uint32_t> ids;
+    for (const auto &entry : input_names) {
+        ids[entry.first] = c.add_input(entry.first);
+    }
+    // Recorrido en profundidad iterativo: las definiciones pueden estar en
+    // cualquier orden y los circuitos pueden ser muy profundos.
+    std::map<std::string, bool> open;
+    auto build = [&](const std::string &root, std::size_t ref_line) {
+        std::vector<std::pair<std::string, std::size_t>> stack{{root, ref_line}};
+        while (!stack.empty()) {
+            const std::string name = stack.back().first;
+            if (ids.count(name)) {
+                stack.pop_back();
+                continue;
+            }
+            const auto def = defs.find(name);
+            if (def == defs.end()) {
+                bench_error(stack.back().second, "señal sin definir: " + name);
+            }
+            if (!open[name]) {
+                open[name] = true;
+                for (const std::string &arg : def->second.args) {
+                    if (!ids.count(arg)) {
+                        if (open[arg]) {
+                            bench_error(def->second.line, "ciclo combinacional en " + arg);
+                        }
+                        stack.push_back({arg, def->second.line});
+                    }
+                }
+                continue;
+            }
+            std::vector<std::uint32_t> args;
+            for (const std::string &arg : def->second.args) {
+                if (!ids.count(arg)) {
+                    bench_error(def->second.line, "ciclo combinacional en " + arg);
+                }
+                args.push_back(ids[arg]);
+            }
+            const std::string &op = def->second.op;
+            const bool inverted = op == "NAND" || op == "NOR" || op == "XNOR" || op == "NOT";
+            const GateKind base = (op == "AND" || op == "NAND") ? GateKind::And
+                                  : (op == "OR" || op == "NOR") ? GateKind::Or
+                                                                : GateKind::Xor;
+            ids[name] = gate_tree(c, base, inverted, args);
+            stack.pop_back();
+        }
+    };
+    for (const auto &entry : output_names) {
+        build(entry.first, entry.second);
+        c.add_output(ids[entry.first], entry.first);
+    }
+    return c;
+}
+
+Circuit load_bench(const std::string &path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("No se puede abrir el archivo: " + path);
+    }
+    return parse_bench(in);
+}
+
+Circuit build_miter(const Circuit &a, const Circuit &b) {
+    if (a.inputs() != b.inputs() || a.outputs().size() != b.outputs().size()) {
+        throw std::invalid_argument("Los circuitos del miter deben tener las mismas entradas y salidas");
+    }
+    Circuit m;
+    for (unsigned i = 0; i < a.inputs(); ++i) {
+        m.add_input(a.input_names()[i]);
+    }
+    auto copy = [&m](const Circuit &c) {
+        std::vector<std::uint32_t> map(c.size());
+        unsigned next_input = 0;
+        for (std::uint32_t i = 0; i < c.size(); ++i) {
+            const Circuit::Node &node = c.node(i);
+            if (node.kind == GateKind::Input) {
+                map[i] = m.input(next_input++);
+            } else if (node.kind == GateKind::Const0 || node.kind == GateKind::Const1) {
+                map[i] = m.constant(node.kind == GateKind::Const1);
+            } else {
+                map[i] = m.add_gate(node.kind, map[node.a], map[node.b]);
+            }
+        }
+        return map;
+    };
+    const std::vector<std::uint32_t> ma = copy(a), mb = copy(b);
+    for (std::size_t o = 0; o < a.outputs().size(); ++o) {
+        m.add_output(m.add_gate(GateKind::Xor, ma[a.outputs()[o]], mb[b.outputs()[o]]), a.output_names()[o]);
+    }
+    return m;
+}
+
+std::vector<bool> evaluate(const Circuit &circuit, std::uint64_t assignment) {
+    std::vector<char> value(circuit.size(), 0);
+    unsigned next_input = 0;
+    for (std::uint32_t i = 0; i < circuit.size(); ++i) {
+        const Circuit::Node &node = circuit.node(i);
+        value[i] = node.kind == GateKind::Input ? static_cast<char>((assignment >> next_input++) & 1)
+                                                : apply(node.kind, value[node.a] != 0, value[node.b] != 0);
+    }
+    std::vector<bool> out;
+    for (std::uint32_t o : circuit.outputs()) {
+        out.push_back(value[o] != 0);
+    }
+    return out;
+}
+
+std::vector<std::vector<std::uint64_t>> truth_table(const Circuit &circuit, const SimOptions &options) {
+    const unsigned n = circuit.inputs();
+    if (n > kMaxTableInputs) {
+        throw std::invalid_argument("Demasiadas entradas para la tabla de verdad: " + std::to_string(n));
+    }
+    const Program p = compile(circuit);
+    const std::uint64_t vectors = std::uint64_t(1) << n;
+    const std::size_t words = static_cast<std::size_t>(std::max<std::uint64_t>(1, vectors / 64));
+    const std::uint64_t blocks = (vectors + kBlockLanes - 1) / kBlockLanes;
+    std::vector<std::vector<std::uint64_t>> table(p.outputs.size(), std::vector<std::uint64_t>(words, 0));
+    const Kernel run = select_kernel(options.lanes);
+    const unsigned threads = parallel::effective_threads(blocks, options.threads, kChunkBlocks);
+    std::vector<std::vector<std::uint64_t>> regs(threads, std::vector<std::uint64_t>(std::size_t(p.registers) * kWords));
+    parallel::for_each_index(blocks, threads, kChunkBlocks, [&](unsigned worker, std::size_t block) {
+        std::uint64_t *r = regs[worker].data();
+        fill_inputs(p, block, r);
+        run(p, r);
+        const std::size_t first = block * kWords, count = std::min<std::size_t>(kWords, words - first);
+        for (std::size_t o = 0; o < p.outputs.size(); ++o) {
+            std::copy(r + std::size_t(p.outputs[o]) * kWords, r + std::size_t(p.outputs[o]) * kWords + count,
+                      table[o].begin() + static_cast<long>(first));
+        }
+    });
+    if (vectors < 64) {
+        for (auto &row : table) {
+            row[0] &= (std::uint64_t(1) << vectors) - 1;
+        }
+    }
+    return table;
+}
+
+EquivalenceResult check_equivalence(const Circuit &a, const Circuit &b, const SimOptions &options) {
+    const Circuit miter = build_miter(a, b);
+    const unsigned n = miter.inputs();
+    if (n > kMaxEquivalenceInputs) {
+        throw std::invalid_argument("Demasiadas entradas para la comprobación exhaustiva: " + std::to_string(n));
+    }
+    EquivalenceResult result;
+    if (miter.outputs().empty()) {
+        return result;
+    }
+    const Program p = compile(miter);
+    const std::uint64_t vectors = std::uint64_t(1) << n;
+    const std::uint64_t blocks = (vectors + kBlockLanes - 1) / kBlockLanes;
+    const std::uint64_t chunks = (blocks + kChunkBlocks - 1) / kChunkBlocks;
+    const Kernel run = select_kernel(options.lanes);
+    const unsigned threads = parallel::effective_threads(chunks, options.threads);
+    std::vector<std::vector<std::uint64_t>> regs(threads, std::vector<std::uint64_t>(std::size_t(p.registers) * kWords));
+    std::atomic<std::uint64_t> best{std::numeric_limits<std::uint64_t>::max()};
+    std::atomic<std::uint64_t> evaluated{0};
+    parallel::for_each_index(chunks, threads, 1, [&](unsigned worker, std::size_t chunk) {
+        std::uint64_t *r = regs[worker].data();
+        const std::uint64_t end = std::min(blocks, (chunk + 1) * kChunkBlocks);
+        for (std::uint64_t block = chunk * kChunkBlocks; block < end; ++block) {
+            // Un trozo anterior ya encontró una diferencia de menor índice.
+            if (block * kBlockLanes >= best.load(std::memory_order_relaxed)) {
+                return;
+            }
+            fill_inputs(p, block, r);
+            run(p, r);
+            evaluated.fetch_add(std::min<std::uint64_t>(kBlockLanes, vectors), std::memory_order_relaxed);
+            for (unsigned w = 0; w < kWords; ++w) {
+                std::uint64_t diff = 0;
+                for (std::uint32_t o : p.outputs) {
+                    diff |= r[std::size_t(o) * kWords + w];
+                }
+                if (diff) {
+                    const std::uint64_t lane = block * kBlockLanes + 64 * w + static_cast<unsigned>(__builtin_ctzll(diff));
+                    std::uint64_t seen = best.load(std::memory_order_relaxed);
+                    while (lane < seen && !best.compare_exchange_weak(seen, lane, std::memory_order_relaxed)) {
+                    }
+                    return;
+                }
+            }
+        }
+    });
+    result.evaluated = std::min(vectors, evaluated.load());
+    if (best.load() != std::numeric_limits<std::uint64_t>::max()) {
+        result.equivalent = false;
+        // Con menos de 9 entradas los vectores de un bloque se repiten; el
+        // primero que difiere está en la primera copia.
+        result.counterexample = best.load() & (vectors - 1);
+        const std::vector<bool> diff = evaluate(miter, result.counterexample);
+        result.output = static_cast<unsigned>(std::find(diff.begin(), diff.end(), true) - diff.begin());
+    }
+    return result;
+}
+
+unsigned simd_lanes() {
+#ifdef GRAPHS_SIM_X86
+    if (has_avx512()) {
+        return 512;
+    }
+    if (has_avx2()) {
+        return 256;
+    }
+#endif
+    return 64;
+}
+
+} // namespace graphs
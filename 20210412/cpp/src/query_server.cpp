@@ -0,0 +1,105 @@
+#include "query_server.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace graphs {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_seconds(Clock::time_point since) {
+    return std::chrono::duration<double>(Clock::now() - since).count();
+}
+
+// Percentil q (en [0, 1]) por rango más cercano; `sorted` no está vacío.
+double nearest_rank(const std::vector<double> &sorted, double q) {
+    const std::size_t rank = static_cast<std::size_t>(std::ceil(q * sorted.size()));
+    return sorted[std::max<std::size_t>(rank, 1) - 1];
+}
+
+} // namespace
+
+SharedGraph::SharedGraph() : graph_(std::make_shared<const Graph>()) {}
+
+SharedGraph::SharedGraph(Graph g) : graph_(std::make_shared<const Graph>(std::move(g))) {}
+
+SharedGraph::SharedGraph(const AdjList &adj) : graph_(std::make_shared<const Graph>(adj)) {}
+
+QueryServer::QueryServer(SharedGraph graph) : graph_(std::move(graph)) {
+    if (graph_->has_negative_weights()) {
+        throw std::runtime_error("Dijkstra no admite pesos negativos");
+    }
+}
+
+double QueryServer::distance(int source, int target) const {
+    return path(source, target).cost;
+}
+
+PathResult QueryServer::path(int source, int target) const {
+    auto ws = pool_.acquire();
+    return dijkstra_path(*graph_, source, target, *ws);
+}
+
+BatchResult QueryServer::run(const std::vector<QueryRequest> &requests,
+                             const BatchOptions &options) const {
+    const int n = graph_.num_vertices();
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        const QueryRequest &q = requests[i];
+        if (q.source < 0 || q.source >= n || q.target < 0 || q.target >= n) {
+            throw std::out_of_range("Consulta " + std::to_string(i) + " con vértice fuera de rango");
+        }
+    }
+
+    BatchResult out;
+    out.cost.resize(requests.size());
+    if (options.paths) {
+        out.paths.resize(requests.size());
+    }
+    std::vector<double> latency(requests.size());
+
+    // Un workspace por hilo trabajador durante todo el lote.
+    const unsigned threads = parallel::effective_threads(requests.size(), options.threads);
+    std::vector<parallel::ResourcePool<DijkstraWorkspace>::Lease> leases;
+    leases.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        leases.push_back(pool_.acquire());
+    }
+
+    const Clock::time_point start = Clock::now();
+    parallel::for_each_index(requests.size(), threads, 1, [&](unsigned worker, std::size_t i) {
+        const Clock::time_point begin = Clock::now();
+        PathResult r = dijkstra_path(*graph_, requests[i].source, requests[i].target, *leases[worker]);
+        out.cost[i] = r.cost;
+        if (options.paths) {
+            out.paths[i] = std::move(r.vertices);
+        }
+        latency[i] = 1e6 * elapsed_seconds(begin);
+    });
+    out.stats = summarize_latencies(latency, elapsed_seconds(start));
+    return out;
+}
+
+LatencyStats summarize_latencies(std::vector<double> &latencies, double seconds) {
+    LatencyStats s;
+    s.queries = latencies.size();
+    s.seconds = seconds;
+    if (latencies.empty()) {
+        return s;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    s.throughput = seconds > 0.0 ? s.queries / seconds : 0.0;
+    s.mean = std::accumulate(latencies.begin(), latencies.end(), 0.0) / s.queries;
+    s.p50 = nearest_rank(latencies, 0.50);
+    s.p90 = nearest_rank(latencies, 0.90);
+    s.p99 = nearest_rank(latencies, 0.99);
+    s.max = latencies.back();
+    return s;
+}
+
+} // namespace graphs
@@ -0,0 +1,248 @@
+#include "quine_mccluskey.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <memory>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "parallel.hpp"
+
+namespace graphs {
+
+namespace {
+
+constexpr std::size_t kGrain = 1024;
+// Por encima de este número de variables los mintérminos se buscan en una
+// tabla hash en vez de en un mapa de bits de 2^n bits.
+constexpr unsigned kMaxBitmapVars = 26;
+
+std::uint64_t mix(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// Índice de sólo lectura de los cubos de un nivel (direccionamiento
+// abierto); devuelve la posición del cubo o kMissing.
+class CubeIndex {
+public:
+    static constexpr std::size_t kMissing = ~std::size_t(0);
+
+    explicit CubeIndex(const std::vector<Cube> &cubes) : cubes_(cubes) {
+        std::size_t size = 16;
+        while (size < cubes.size() * 2) {
+            size <<= 1;
+        }
+        slots_.assign(size, kMissing);
+        for (std::size_t k = 0; k < cubes.size(); ++k) {
+            std::size_t i = slot(cubes[k]);
+            while (slots_[i] != kMissing) {
+                i = (i + 1) & (slots_.size() - 1);
+            }
+            slots_[i] = k;
+        }
+    }
+
+    std::size_t find(const Cube &c) const {
+        for (std::size_t i = slot(c);; i = (i + 1) & (slots_.size() - 1)) {
+            const std::size_t k = slots_[i];
+            if (k == kMissing || cubes_[k] == c) {
+                return k;
+            }
+        }
+    }
+
+private:
+    std::size_t slot(const Cube &c) const {
+        return static_cast<std::size_t>(mix(c.value ^ mix(c.mask))) & (slots_.size() - 1);
+    }
+
+    const std::vector<Cube> &cubes_;
+    std::vector<std::size_t> slots_;
+};
+
+// Orden de los patrones como cadenas: '-' < '0' < '1' en el primer
+// carácter (bit más significativo) en que difieren.
+bool pattern_less(const Cube &a, const Cube &b) {
+    const std::uint64_t diff = (a.mask ^ b.mask) | (a.value ^ b.value);
+    if (diff == 0) {
+        return false;
+    }
+    std::uint64_t top = diff;
+    for (unsigned shift = 1; shift < 64; shift <<= 1) {
+        top |= top >> shift;
+    }
+    top ^= top >> 1;
+    auto rank = [top](const Cube &c) { return c.mask & top ? (c.value & top ? 2 : 1) : 0; };
+    return rank(a) < rank(b);
+}
+
+std::uint64_t full_mask(unsigned num_vars) {
+    return num_vars == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << num_vars) - 1;
+}
+
+void check_terms(const std::vector<std::uint64_t> &terms, unsigned num_vars) {
+    const std::uint64_t mask = full_mask(num_vars);
+    for (std::uint64_t t : terms) {
+        if (t & ~mask) {
+            throw std::invalid_argument("Término fuera de rango para " + std::to_string(num_vars) + " variables");
+        }
+    }
+}
+
+// Filtro final de Python: descarta los primos que sólo cubren indiferencias.
+class MintermIndex {
+public:
+    MintermIndex(const std::vector<std::uint64_t> &minterms, unsigned num_vars) : minterms_(minterms) {
+        if (num_vars <= kMaxBitmapVars) {
+            bitmap_.assign((std::size_t(1) << num_vars) / 64 + 1, 0);
+            for (std::uint64_t m : minterms) {
+                bitmap_[m / 64] |= std::uint64_t(1) << (m % 64);
+            }
+        } else {
+            hashed_.insert(minterms.begin(), minterms.end());
+        }
+    }
+
+    bool covers_any(const Cube &c, std::uint64_t full) const {
+        const std::uint64_t free = full & ~c.mask;
+        const unsigned dashes = static_cast<unsigned>(std::bitset<64>(free).count());
+        if (dashes >= 63 || (std::uint64_t(1) << dashes) > minterms_.size()) {
+            return std::any_of(minterms_.begin(), minterms_.end(), [&](std::uint64_t m) { return c.covers(m); });
+        }
+        // Recorre los 2^dashes puntos del cubo (subconjuntos de `free`).
+        std::uint64_t sub = 0;
+        do {
+            if (contains(c.value | sub)) {
+                return true;
+            }
+            sub = (sub - free) & free;
+        } while (sub != 0);
+        return false;
+    }
+
+private:
+    bool contains(std::uint64_t m) const {
+        return bitmap_.empty() ? hashed_.count(m) > 0 : (bitmap_[m / 64] >> (m % 64)) & 1;
+    }
+
+    const std::vector<std::uint64_t> &minterms_;
+    std::vector<std::uint64_t> bitmap_;
+    std::unordered_set<std::uint64_t> hashed_;
+};
+
+} // namespace
+
+std::string cube_to_pattern(const Cube &cube, unsigned num_vars) {
+    std::string s(num_vars, '-');
+    for (unsigned i = 0; i < num_vars; ++i) {
+        const std::uint64_t bit = std::uint64_t(1) << (num_vars - 1 - i);
+        if (cube.mask & bit) {
+            s[i] = cube.value & bit ? '1' : '0';
+        }
+    }
+    return s;
+}
+
+Cube pattern_to_cube(const std::string &pattern) {
+    if (pattern.size() > 64) {
+        throw std::invalid_argument("Patrón de más de 64 variables");
+    }
+    Cube c;
+    for (char ch : pattern) {
+        c.value <<= 1;
+        c.mask <<= 1;
+        if (ch == '0' || ch == '1') {
+            c.mask |= 1;
+            c.value |= ch == '1';
+        } else if (ch != '-') {
+            throw std::invalid_argument(std::string("Carácter no válido en el patrón: ") + ch);
+        }
+    }
+    return c;
+}
+
+std::vector<Cube> prime_implicants(const std::vector<std::uint64_t> &minterms,
+                                   const std::vector<std::uint64_t> &dont_cares, unsigned num_vars,
+                                   const QmOptions &options) {
+    if (num_vars == 0 || num_vars > 64) {
+        throw std::invalid_argument("El número de variables debe estar entre 1 y 64");
+    }
+    check_terms(minterms, num_vars);
+    check_terms(dont_cares, num_vars);
+    const std::uint64_t full = full_mask(num_vars);
+
+    std::vector<Cube> level;
+    level.reserve(minterms.size() + dont_cares.size());
+    for (const auto *terms : {&minterms, &dont_cares}) {
+        for (std::uint64_t t : *terms) {
+            level.push_back({t, full});
+        }
+    }
+    auto by_key = [](const Cube &a, const Cube &b) { return a.mask != b.mask ? a.mask < b.mask : a.value < b.value; };
+    std::sort(level.begin(), level.end(), by_key);
+    level.erase(std::unique(level.begin(), level.end()), level.end());
+
+    const unsigned threads = parallel::effective_threads(level.size(), options.threads, kGrain);
+    std::vector<Cube> primes;
+    std::vector<std::vector<Cube>> produced(threads);
+    while (!level.empty()) {
+        const CubeIndex index(level);
+        // Cada par se busca desde el cubo con el bit a 0, que marca también a
+        // su pareja (de ahí las marcas atómicas).
+        std::unique_ptr<std::atomic<std::uint8_t>[]> used(new std::atomic<std::uint8_t>[level.size()]());
+        parallel::for_each_index(level.size(), threads, kGrain, [&](unsigned w, std::size_t i) {
+            const Cube c = level[i];
+            for (std::uint64_t rest = c.mask & ~c.value; rest; rest &= rest - 1) {
+                const std::uint64_t bit = rest & (~rest + 1);
+                const std::size_t k = index.find({c.value | bit, c.mask});
+                if (k != CubeIndex::kMissing) {
+                    used[i].store(1, std::memory_order_relaxed);
+                    used[k].store(1, std::memory_order_relaxed);
+                    produced[w].push_back({c.value, c.mask & ~bit});
+                }
+            }
+        });
+        for (std::size_t i = 0; i < level.size(); ++i) {
+            if (!used[i].load(std::memory_order_relaxed)) {
+                primes.push_back(level[i]);
+            }
+        }
+        level.clear();
+        for (auto &part : produced) {
+            level.insert(level.end(), part.begin(), part.end());
+            part.clear();
+        }
+        std::sort(level.begin(), level.end(), by_key);
+        level.erase(std::unique(level.begin(), level.end()), level.end());
+    }
+
+    const MintermIndex index(minterms, num_vars);
+    std::vector<std::uint8_t> keep(primes.size(), 0);
+    parallel::for_each_index(primes.size(), options.threads, 64,
+                             [&](unsigned, std::size_t i) { keep[i] = index.covers_any(primes[i], full); });
+
+    std::vector<Cube> out;
+    for (std::size_t i = 0; i < primes.size(); ++i) {
+        if (keep[i]) {
+            out.push_back(primes[i]);
+        }
+    }
+    std::sort(out.begin(), out.end(), pattern_less);
+    return out;
+}
+
+std::vector<std::string> quine_mccluskey(const std::vector<std::uint64_t> &minterms,
+                                         const std::vector<std::uint64_t> &dont_cares, unsigned num_vars,
+                                         const QmOptions &options) {
+    std::vector<std::string> out;
+    for (const Cube &c : prime_implicants(minterms, dont_cares, num_vars, options)) {
+        out.push_back(cube_to_pattern(c, num_vars));
+    }
+    return out;
+}
+
+} // namespace graphs
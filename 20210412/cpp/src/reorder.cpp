@@ -0,0 +1,313 @@
+#include "reorder.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace graphs {
+
+namespace {
+
+// Estructura no dirigida subyacente en CSR (vecinos salientes y entrantes,
+// sin bucles).  Puede contener vecinos repetidos, que no afectan a los recorridos.
+struct Undirected {
+    std::vector<std::size_t> offsets;
+    std::vector<int> adj;
+
+    explicit Undirected(const Graph &g) {
+        const int n = g.num_vertices();
+        offsets.assign(n + 1, 0);
+        for (int u = 0; u < n; ++u) {
+            for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+                int v = g.target(e);
+                if (v != u) {
+                    ++offsets[u + 1];
+                    ++offsets[v + 1];
+                }
+            }
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        adj.resize(offsets[n]);
+        std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (int u = 0; u < n; ++u) {
+            for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+                int v = g.target(e);
+                if (v != u) {
+                    adj[fill[u]++] = v;
+                    adj[fill[v]++] = u;
+                }
+            }
+        }
+    }
+
+    int num_vertices() const { return static_cast<int>(offsets.size()) - 1; }
+    int degree(int u) const { return static_cast<int>(offsets[u + 1] - offsets[u]); }
+};
+
+// Restricción opcional de un recorrido a los vértices con part[v] == tag.
+struct Region {
+    const std::vector<int> *part = nullptr;
+    int tag = 0;
+
+    bool contains(int v) const { return !part || (*part)[v] == tag; }
+};
+
+struct LevelInfo {
+    std::size_t levels = 0;
+    std::size_t last_level_start = 0;
+};
+
+// BFS desde root sobre los vértices de `region` no visitados.  Añade los
+// vértices a `order` y marca `visited`.  Con by_degree los vecinos de cada
+// vértice se visitan por grado creciente (Cuthill–McKee).
+LevelInfo bfs_levels(const Undirected &u, int root, const Region &region,
+                     std::vector<char> &visited, std::vector<int> &order, bool by_degree) {
+    LevelInfo info;
+    std::size_t head = order.size();
+    std::size_t level_end = head;
+    order.push_back(root);
+    visited[root] = 1;
+    std::vector<int> nbrs;
+    while (head < order.size()) {
+        if (head == level_end) {
+            info.last_level_start = head;
+            level_end = order.size();
+            ++info.levels;
+        }
+        int x = order[head++];
+        nbrs.clear();
+        for (std::size_t k = u.offsets[x]; k < u.offsets[x + 1]; ++k) {
+            int y = u.adj[k];
+            if (!visited[y] && region.contains(y)) {
+                visited[y] = 1;
+                nbrs.push_back(y);
+            }
+        }
+        if (by_degree) {
+            std::sort(nbrs.begin(), nbrs.end(), [&](int a, int b) {
+                return u.degree(a) != u.degree(b) ? u.degree(a) < u.degree(b) : a < b;
+            });
+        }
+        order.insert(order.end(), nbrs.begin(), nbrs.end());
+    }
+    return info;
+}
+
+// Vértice pseudo-periférico (George–Liu): se repite el BFS desde el vértice
+// de menor grado del último nivel mientras aumente el número de niveles.
+// Deja `visited` como estaba.
+int pseudo_peripheral(const Undirected &u, int start, const Region &region,
+                      std::vector<char> &visited) {
+    int root = start;
+    std::size_t best_levels = 0;
+    std::vector<int> order;
+    for (;;) {
+        order.clear();
+        LevelInfo info = bfs_levels(u, root, region, visited, order, false);
+        for (int v : order) {
+            visited[v] = 0;
+        }
+        if (info.levels <= best_levels) {
+            return root;
+        }
+        best_levels = info.levels;
+        int candidate = order[info.last_level_start];
+        for (std::size_t i = info.last_level_start; i < order.size(); ++i) {
+            if (u.degree(order[i]) < u.degree(candidate)) {
+                candidate = order[i];
+            }
+        }
+        if (candidate == root) {
+            return root;
+        }
+        root = candidate;
+    }
+}
+
+// Recorre todas las componentes: primero la de `root` (si se da) y después
+// las restantes por índice creciente.  visit(start, order) añade una componente.
+template <class Visit>
+std::vector<int> for_each_component(int n, int root, std::vector<char> &visited, Visit &&visit) {
+    std::vector<int> order;
+    order.reserve(n);
+    if (root >= 0) {
+        if (root >= n) {
+            throw std::out_of_range("Vértice raíz fuera de rango");
+        }
+        visit(root, order);
+    }
+    for (int v = 0; v < n; ++v) {
+        if (!visited[v]) {
+            visit(v, order);
+        }
+    }
+    return order;
+}
+
+} // namespace
+
+Permutation Permutation::from_order(std::vector<int> old_of_new) {
+    Permutation p;
+    const int n = static_cast<int>(old_of_new.size());
+    p.new_of_old.assign(n, -1);
+    for (int i = 0; i < n; ++i) {
+        int v = old_of_new[i];
+        if (v < 0 || v >= n || p.new_of_old[v] != -1) {
+            throw std::invalid_argument("El orden no es una permutación válida");
+        }
+        p.new_of_old[v] = i;
+    }
+    p.old_of_new = std::move(old_of_new);
+    return p;
+}
+
+Permutation rcm_order(const Graph &g) {
+    Undirected u(g);
+    const int n = u.num_vertices();
+    std::vector<char> visited(n, 0);
+    const Region all;
+    // Se empieza cada componente por su vértice de menor grado.
+    std::vector<int> by_degree(n);
+    std::iota(by_degree.begin(), by_degree.end(), 0);
+    std::stable_sort(by_degree.begin(), by_degree.end(),
+                     [&](int a, int b) { return u.degree(a) < u.degree(b); });
+    std::vector<int> order;
+    order.reserve(n);
+    for (int start : by_degree) {
+        if (visited[start]) {
+            continue;
+        }
+        int root = pseudo_peripheral(u, start, all, visited);
+        bfs_levels(u, root, all, visited, order, true);
+    }
+    std::reverse(order.begin(), order.end());
+    return Permutation::from_order(std::move(order));
+}
+
+Permutation bfs_order(const Graph &g, int root) {
+    Undirected u(g);
+    const Region all;
+    std::vector<char> visited(u.num_vertices(), 0);
+    return Permutation::from_order(for_each_component(
+        u.num_vertices(), root, visited,
+        [&](int start, std::vector<int> &order) { bfs_levels(u, start, all, visited, order, false); }));
+}
+
+Permutation dfs_order(const Graph &g, int root) {
+    Undirected u(g);
+    std::vector<char> visited(u.num_vertices(), 0);
+    // Pila explícita de (vértice, siguiente vecino): sin recursión.
+    std::vector<std::pair<int, std::size_t>> stack;
+    return Permutation::from_order(for_each_component(
+        u.num_vertices(), root, visited, [&](int start, std::vector<int> &order) {
+            visited[start] = 1;
+            order.push_back(start);
+            stack.emplace_back(start, u.offsets[start]);
+            while (!stack.empty()) {
+                auto &[x, next] = stack.back();
+                if (next == u.offsets[x + 1]) {
+                    stack.pop_back();
+                    continue;
+                }
+                int y = u.adj[next++];
+                if (!visited[y]) {
+                    visited[y] = 1;
+                    order.push_back(y);
+                    stack.emplace_back(y, u.offsets[y]);
+                }
+            }
+        }));
+}
+
+Permutation partition_order(const Graph &g, int block_size) {
+    if (block_size < 1) {
+        throw std::invalid_argument("El tamaño de bloque debe ser positivo");
+    }
+    Undirected u(g);
+    const int n = u.num_vertices();
+    // order[begin, end) es una parte; part[v] identifica la parte de v.  Se
+    // parte en orden BFS para que cada mitad sea una región conexa compacta.
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<int> part(n, 0);
+    std::vector<char> visited(n, 0);
+    std::vector<std::pair<std::size_t, std::size_t>> pending{{0, order.size()}};
+    std::vector<int> local;
+    int next_tag = 1;
+    while (!pending.empty()) {
+        auto [begin, end] = pending.back();
+        pending.pop_back();
+        const Region region{&part, part[order[begin]]};
+        // Orden BFS de la parte (componente a componente).
+        local.clear();
+        for (std::size_t i = begin; i < end; ++i) {
+            int start = order[i];
+            if (visited[start]) {
+                continue;
+            }
+            int root = pseudo_peripheral(u, start, region, visited);
+            bfs_levels(u, root, region, visited, local, false);
+        }
+        for (int v : local) {
+            visited[v] = 0;
+        }
+        std::copy(local.begin(), local.end(), order.begin() + begin);
+        if (end - begin <= static_cast<std::size_t>(block_size)) {
+            continue;
+        }
+        const std::size_t mid = begin + (end - begin) / 2;
+        const int left = next_tag++;
+        const int right = next_tag++;
+        for (std::size_t i = begin; i < mid; ++i) {
+            part[order[i]] = left;
+        }
+        for (std::size_t i = mid; i < end; ++i) {
+            part[order[i]] = right;
+        }
+        pending.emplace_back(mid, end);
+        pending.emplace_back(begin, mid);
+    }
+    return Permutation::from_order(std::move(order));
+}
+
+Graph permute(const Graph &g, const Permutation &perm) {
+    const int n = g.num_vertices();
+    if (perm.size() != n) {
+        throw std::invalid_argument("La permutación no coincide con el número de vértices");
+    }
+    std::vector<std::size_t> offsets(n + 1, 0);
+    for (int i = 0; i < n; ++i) {
+        offsets[i + 1] = offsets[i] + g.degree(perm.to_old(i));
+    }
+    std::vector<int> targets(g.num_edges());
+    std::vector<double> weights(g.num_edges());
+    std::vector<std::pair<int, double>> row;
+    for (int i = 0; i < n; ++i) {
+        int old_u = perm.to_old(i);
+        row.clear();
+        for (std::size_t e = g.edge_begin(old_u); e < g.edge_end(old_u); ++e) {
+            row.emplace_back(perm.to_new(g.target(e)), g.weight(e));
+        }
+        std::stable_sort(row.begin(), row.end(),
+                         [](const auto &a, const auto &b) { return a.first < b.first; });
+        for (std::size_t k = 0; k < row.size(); ++k) {
+            targets[offsets[i] + k] = row[k].first;
+            weights[offsets[i] + k] = row[k].second;
+        }
+    }
+    return Graph(std::move(offsets), std::move(targets), std::move(weights));
+}
+
+int bandwidth(const Graph &g) {
+    int bw = 0;
+    for (int u = 0; u < g.num_vertices(); ++u) {
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            bw = std::max(bw, std::abs(u - g.target(e)));
+        }
+    }
+    return bw;
+}
+
+} // namespace graphs
@@ -0,0 +1,645 @@
+#include "sat.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace graphs {
+
+namespace {
+
+constexpr std::uint8_t kFalse = 0;
+constexpr std::uint8_t kTrue = 1;
+constexpr std::uint8_t kUndef = 2;
+constexpr std::uint32_t kNoLit = ~std::uint32_t(0);
+
+// Conflictos del primer tramo entre reinicios; el tramo i es kRestartBase
+// por el término i de la secuencia de Luby (1 1 2 1 1 2 4 ...).
+constexpr double kRestartBase = 100;
+constexpr double kVarDecay = 0.95;
+constexpr double kClauseDecay = 0.999;
+
+double luby(double y, std::uint64_t x) {
+    std::uint64_t size = 1;
+    int seq = 0;
+    while (size < x + 1) {
+        ++seq;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != x) {
+        size = (size - 1) >> 1;
+        --seq;
+        x = x % size;
+    }
+    return std::pow(y, seq);
+}
+
+int decode(std::uint32_t l) {
+    const int v = static_cast<int>(l >> 1) + 1;
+    return (l & 1) ? -v : v;
+}
+
+} // namespace
+
+SatSolver::SatSolver(unsigned vars) { grow(vars); }
+
+int SatSolver::new_var() {
+    grow(vars() + 1);
+    return static_cast<int>(vars());
+}
+
+void SatSolver::grow(std::uint32_t vars) {
+    const std::uint32_t old = this->vars();
+    if (vars <= old) {
+        return;
+    }
+    assigns_.resize(vars, kUndef);
+    polarity_.resize(vars, kFalse);
+    level_.resize(vars, 0);
+    reason_.resize(vars, kNoReason);
+    activity_.resize(vars, 0);
+    seen_.resize(vars, 0);
+    heap_pos_.resize(vars, -1);
+    watches_.resize(2 * static_cast<std::size_t>(vars));
+    for (std::uint32_t v = old; v < vars; ++v) {
+        heap_insert(v);
+    }
+}
+
+SatSolver::Lit SatSolver::encode(int literal) {
+    if (literal == 0) {
+        throw std::invalid_argument("Literal 0 no válido");
+    }
+    const std::uint32_t v = static_cast<std::uint32_t>(std::abs(static_cast<long long>(literal)));
+    grow(v);
+    return 2 * (v - 1) + (literal < 0 ? 1 : 0);
+}
+
+std::uint8_t SatSolver::lit_value(Lit l) const {
+    const std::uint8_t a = assigns_[l >> 1];
+    return a == kUndef ? kUndef : static_cast<std::uint8_t>(a ^ (l & 1));
+}
+
+bool SatSolver::add_clause(const std::vector<int> &literals) {
+    std::vector<Lit> lits;
+    lits.reserve(literals.size());
+    for (int literal : literals) {
+        lits.push_back(encode(literal));
+    }
+    if (!ok_) {
+        return false;
+    }
+    backtrack(0);
+    std::sort(lits.begin(), lits.end());
+    lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < lits.size(); ++i) {
+        // x y ¬x quedan contiguos tras ordenar.
+        if (i + 1 < lits.size() && (lits[i] ^ 1) == lits[i + 1]) {
+            return true;
+        }
+        const std::uint8_t value = lit_value(lits[i]);
+        if (value == kTrue) {
+            return true;
+        }
+        if (value == kUndef) {
+            lits[out++] = lits[i];
+        }
+    }
+    lits.resize(out);
+    if (lits.empty()) {
+        ok_ = false;
+        return false;
+    }
+    if (lits.size() == 1) {
+        assign(lits[0], kNoReason);
+        ok_ = propagate() == kNoReason;
+        return ok_;
+    }
+    attach(std::move(lits), false);
+    ++problem_clauses_;
+    return true;
+}
+
+std::uint32_t SatSolver::attach(std::vector<Lit> lits, bool learned) {
+    const auto id = static_cast<std::uint32_t>(clauses_.size());
+    watches_[lits[0]].push_back({id, lits[1]});
+    watches_[lits[1]].push_back({id, lits[0]});
+    Clause c;
+    c.lits = std::move(lits);
+    c.learned = learned;
+    clauses_.push_back(std::move(c));
+    if (learned) {
+        ++learned_count_;
+        ++stats_.learned;
+        bump_clause(clauses_.back());
+    }
+    return id;
+}
+
+void SatSolver::assign(Lit l, std::uint32_t reason) {
+    const std::uint32_t v = l >> 1;
+    assigns_[v] = (l & 1) ? kFalse : kTrue;
+    level_[v] = decision_level();
+    reason_[v] = reason;
+    trail_.push_back(l);
+}
+
+// Cada lista watches_[l] guarda las cláusulas que vigilan el literal l; se
+// recorre cuando l pasa a ser falso.  El literal implicado por una cláusula
+// razón es siempre lits[0].
+std::uint32_t SatSolver::propagate() {
+    std::uint32_t conflict = kNoReason;
+    while (qhead_ < trail_.size()) {
+        const Lit false_lit = trail_[qhead_++] ^ 1;
+        ++stats_.propagations;
+        std::vector<Watch> &ws = watches_[false_lit];
+        std::size_t i = 0, j = 0;
+        while (i < ws.size()) {
+            const Watch w = ws[i++];
+            if (lit_value(w.blocker) == kTrue) {
+                ws[j++] = w;
+                continue;
+            }
+            Clause &c = clauses_[w.clause];
+            if (c.lits[0] == false_lit) {
+                std::swap(c.lits[0], c.lits[1]);
+            }
+            const Lit first = c.lits[0];
+            const Watch keep{w.clause, first};
+            if (first != w.blocker && lit_value(first) == kTrue) {
+                ws[j++] = keep;
+                continue;
+            }
+            bool moved = false;
+            for (std::size_t k = 2; k < c.lits.size(); ++k) {
+                if (lit_value(c.lits[k]) != kFalse) {
+                    std::swap(c.lits[1], c.lits[k]);
+                    watches_[c.lits[1]].push_back(keep);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) {
+                continue;
+            }
+            ws[j++] = keep;
+            if (lit_value(first) == kFalse) {
+                conflict = w.clause;
+                qhead_ = trail_.size();
+                while (i < ws.size()) {
+                    ws[j++] = ws[i++];
+                }
+            } else {
+                assign(first, w.clause);
+            }
+        }
+        ws.resize(j);
+        if (conflict != kNoReason) {
+            break;
+        }
+    }
+    return conflict;
+}
+
+void SatSolver::analyze(std::uint32_t conflict, std::vector<Lit> &learnt, unsigned &back_level) {
+    learnt.assign(1, kNoLit);
+    int pending = 0;
+    Lit p = kNoLit;
+    std::size_t index = trail_.size();
+    do {
+        Clause &c = clauses_[conflict];
+        if (c.learned) {
+            bump_clause(c);
+        }
+        for (std::size_t k = (p == kNoLit ? 0 : 1); k < c.lits.size(); ++k) {
+            const Lit q = c.lits[k];
+            const std::uint32_t v = q >> 1;
+            if (!seen_[v] && level(v) > 0) {
+                bump_var(v);
+                seen_[v] = 1;
+                if (level(v) >= decision_level()) {
+                    ++pending;
+                } else {
+                    learnt.push_back(q);
+                }
+            }
+        }
+        do {
+            --index;
+        } while (!seen_[trail_[index] >> 1]);
+        p = trail_[index];
+        conflict = reason_[p >> 1];
+        seen_[p >> 1] = 0;
+        --pending;
+    } while (pending > 0);
+    learnt[0] = p ^ 1;
+
+    // Minimización local: sobra un literal cuya razón sólo contiene
+    // literales ya presentes (o de nivel 0).
+    const std::vector<Lit> marked(learnt.begin() + 1, learnt.end());
+    std::size_t out = 1;
+    for (std::size_t i = 1; i < learnt.size(); ++i) {
+        const std::uint32_t reason = reason_[learnt[i] >> 1];
+        bool redundant = reason != kNoReason;
+        if (redundant) {
+            const Clause &r = clauses_[reason];
+            for (std::size_t k = 1; k < r.lits.size() && redundant; ++k) {
+                const std::uint32_t v = r.lits[k] >> 1;
+                redundant = seen_[v] || level(v) == 0;
+            }
+        }
+        if (!redundant) {
+            learnt[out++] = learnt[i];
+        }
+    }
+    learnt.resize(out);
+    for (Lit l : marked) {
+        seen_[l >> 1] = 0;
+    }
+
+    back_level = 0;
+    if (learnt.size() > 1) {
+        std::size_t best = 1;
+        for (std::size_t i = 2; i < learnt.size(); ++i) {
+            if (level(learnt[i] >> 1) > level(learnt[best] >> 1)) {
+                best = i;
+            }
+        }
+        std::swap(learnt[1], learnt[best]);
+        back_level = level(learnt[1] >> 1);
+    }
+}
+
+// `p` es una suposición que ha resultado falsa: recorre el rastro hacia
+// atrás desde ¬p y se queda con las decisiones (todas suposiciones) de las
+// que depende.
+void SatSolver::analyze_final(Lit p) {
+    failed_.assign(1, decode(p));
+    if (decision_level() == 0) {
+        return;
+    }
+    seen_[p >> 1] = 1;
+    for (std::size_t i = trail_.size(); i-- > trail_lim_[0];) {
+        const std::uint32_t v = trail_[i] >> 1;
+        if (!seen_[v]) {
+            continue;
+        }
+        if (reason_[v] == kNoReason) {
+            failed_.push_back(decode(trail_[i]));
+        } else {
+            const Clause &c = clauses_[reason_[v]];
+            for (std::size_t k = 1; k < c.lits.size(); ++k) {
+                if (level(c.lits[k] >> 1) > 0) {
+                    seen_[c.lits[k] >> 1] = 1;
+                }
+            }
+        }
+        seen_[v] = 0;
+    }
+    seen_[p >> 1] = 0;
+}
+
+void SatSolver::backtrack(unsigned target) {
+    if (decision_level() <= target) {
+        return;
+    }
+    for (std::size_t i = trail_.size(); i-- > trail_lim_[target];) {
+        const std::uint32_t v = trail_[i] >> 1;
+        polarity_[v] = assigns_[v];
+        assigns_[v] = kUndef;
+        reason_[v] = kNoReason;
+        heap_insert(v);
+    }
+    trail_.resize(trail_lim_[target]);
+    trail_lim_.resize(target);
+    qhead_ = trail_.size();
+}
+
+bool SatSolver::locked(std::uint32_t c) const {
+    const Lit first = clauses_[c].lits[0];
+    return reason_[first >> 1] == c && lit_value(first) == kTrue;
+}
+
+void SatSolver::reduce_learned() {
+    std::vector<std::uint32_t> candidates;
+    for (std::uint32_t c = 0; c < clauses_.size(); ++c) {
+        const Clause &cl = clauses_[c];
+        if (cl.learned && !cl.deleted && cl.lbd > 2 && cl.lits.size() > 2 && !locked(c)) {
+            candidates.push_back(c);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [&](std::uint32_t x, std::uint32_t y) {
+        return clauses_[x].activity < clauses_[y].activity;
+    });
+    const std::size_t remove = std::min(candidates.size(), learned_count_ / 2);
+    for (std::size_t i = 0; i < remove; ++i) {
+        Clause &c = clauses_[candidates[i]];
+        c.deleted = true;
+        std::vector<Lit>().swap(c.lits);
+        --learned_count_;
+        ++stats_.deleted;
+        ++deleted_slots_;
+    }
+    if (deleted_slots_ * 2 > clauses_.size()) {
+        collect_garbage();
+    } else {
+        for (auto &ws : watches_) {
+            ws.erase(std::remove_if(ws.begin(), ws.end(), [&](const Watch &w) { return clauses_[w.clause].deleted; }),
+                     ws.end());
+        }
+    }
+}
+
+// Compacta clauses_ y renumera las listas de vigilancia y las razones.
+void SatSolver::collect_garbage() {
+    std::vector<std::uint32_t> remap(clauses_.size(), kNoReason);
+    std::size_t out = 0;
+    for (std::size_t c = 0; c < clauses_.size(); ++c) {
+        if (!clauses_[c].deleted) {
+            remap[c] = static_cast<std::uint32_t>(out);
+            if (out != c) {
+                clauses_[out] = std::move(clauses_[c]);
+            }
+            ++out;
+        }
+    }
+    clauses_.resize(out);
+    deleted_slots_ = 0;
+    for (auto &ws : watches_) {
+        std::size_t j = 0;
+        for (const Watch &w : ws) {
+            if (remap[w.clause] != kNoReason) {
+                ws[j++] = {remap[w.clause], w.blocker};
+            }
+        }
+        ws.resize(j);
+    }
+    for (Lit l : trail_) {
+        std::uint32_t &r = reason_[l >> 1];
+        if (r != kNoReason) {
+            r = remap[r];
+        }
+    }
+}
+
+SatResult SatSolver::solve(const std::vector<int> &assumptions, std::uint64_t conflict_limit) {
+    failed_.clear();
+    model_.clear();
+    std::vector<Lit> assume;
+    assume.reserve(assumptions.size());
+    for (int a : assumptions) {
+        assume.push_back(encode(a));
+    }
+    if (!ok_) {
+        return SatResult::Unsat;
+    }
+    backtrack(0);
+    if (max_learned_ == 0) {
+        max_learned_ = std::max(2000.0, static_cast<double>(problem_clauses_) / 3);
+    }
+    const std::uint64_t start = stats_.conflicts;
+    std::vector<Lit> learnt;
+    for (std::uint64_t round = 0;; ++round) {
+        const auto budget = static_cast<std::uint64_t>(luby(2, round) * kRestartBase);
+        std::uint64_t conflicts = 0;
+        for (;;) {
+            const std::uint32_t conflict = propagate();
+            if (conflict != kNoReason) {
+                ++stats_.conflicts;
+                ++conflicts;
+                if (decision_level() == 0) {
+                    ok_ = false;
+                    return SatResult::Unsat;
+                }
+                unsigned back = 0;
+                analyze(conflict, learnt, back);
+                backtrack(back);
+                if (learnt.size() == 1) {
+                    assign(learnt[0], kNoReason);
+                } else {
+                    std::vector<unsigned> levels;
+                    for (Lit l : learnt) {
+                        levels.push_back(level(l >> 1));
+                    }
+                    std::sort(levels.begin(), levels.end());
+                    const auto id = attach(learnt, true);
+                    clauses_[id].lbd =
+                        static_cast<unsigned>(std::unique(levels.begin(), levels.end()) - levels.begin());
+                    assign(learnt[0], id);
+                }
+                var_inc_ /= kVarDecay;
+                clause_inc_ /= kClauseDecay;
+                if (conflict_limit > 0 && stats_.conflicts - start >= conflict_limit) {
+                    backtrack(0);
+                    return SatResult::Unknown;
+                }
+                continue;
+            }
+            if (conflicts >= budget) {
+                backtrack(0);
+                ++stats_.restarts;
+                break;
+            }
+            if (static_cast<double>(learned_count_) >= max_learned_) {
+                reduce_learned();
+                max_learned_ *= 1.1;
+            }
+
+            Lit next = kNoLit;
+            while (decision_level() < assume.size()) {
+                const Lit p = assume[decision_level()];
+                const std::uint8_t value = lit_value(p);
+                if (value == kTrue) {
+                    // Nivel vacío para que el nivel k siga siendo la
+                    // suposición k.
+                    trail_lim_.push_back(trail_.size());
+                } else if (value == kFalse) {
+                    analyze_final(p);
+                    backtrack(0);
+                    return SatResult::Unsat;
+                } else {
+                    next = p;
+                    break;
+                }
+            }
+            if (next == kNoLit) {
+                std::uint32_t v;
+                do {
+                    if (heap_.empty()) {
+                        model_ = assigns_;
+                        backtrack(0);
+                        return SatResult::Sat;
+                    }
+                    v = heap_pop();
+                } while (assigns_[v] != kUndef);
+                next = 2 * v + (polarity_[v] == kTrue ? 0 : 1);
+                ++stats_.decisions;
+            }
+            trail_lim_.push_back(trail_.size());
+            assign(next, kNoReason);
+        }
+    }
+}
+
+bool SatSolver::value(int literal) const {
+    const std::uint32_t v = static_cast<std::uint32_t>(std::abs(static_cast<long long>(literal)));
+    if (literal == 0 || v > model_.size()) {
+        throw std::out_of_range("No hay valor en el modelo para el literal " + std::to_string(literal));
+    }
+    return (model_[v - 1] == kTrue) != (literal < 0);
+}
+
+void SatSolver::bump_var(std::uint32_t v) {
+    if ((activity_[v] += var_inc_) > 1e100) {
+        for (double &a : activity_) {
+            a *= 1e-100;
+        }
+        var_inc_ *= 1e-100;
+    }
+    if (heap_pos_[v] >= 0) {
+        heap_up(static_cast<std::size_t>(heap_pos_[v]));
+    }
+}
+
+void SatSolver::bump_clause(Clause &c) {
+    if ((c.activity += clause_inc_) > 1e20) {
+        for (Clause &other : clauses_) {
+            if (other.learned) {
+                other.activity *= 1e-20;
+            }
+        }
+        clause_inc_ *= 1e-20;
+    }
+}
+
+void SatSolver::heap_insert(std::uint32_t v) {
+    if (heap_pos_[v] >= 0) {
+        return;
+    }
+    heap_pos_[v] = static_cast<std::int64_t>(heap_.size());
+    heap_.push_back(v);
+    heap_up(heap_.size() - 1);
+}
+
+std::uint32_t SatSolver::heap_pop() {
+    const std::uint32_t top = heap_[0];
+    heap_[0] = heap_.back();
+    heap_pos_[heap_[0]] = 0;
+    heap_.pop_back();
+    heap_pos_[top] = -1;
+    if (!heap_.empty()) {
+        heap_down(0);
+    }
+    return top;
+}
+
+void SatSolver::heap_up(std::size_t i) {
+    const std::uint32_t v = heap_[i];
+    while (i > 0) {
+        const std::size_t parent = (i - 1) / 2;
+        if (activity_[heap_[parent]] >= activity_[v]) {
+            break;
+        }
+        heap_[i] = heap_[parent];
+        heap_pos_[heap_[i]] = static_cast<std::int64_t>(i);
+        i = parent;
+    }
+    heap_[i] = v;
+    heap_pos_[v] = static_cast<std::int64_t>(i);
+}
+
+void SatSolver::heap_down(std::size_t i) {
+    const std::uint32_t v = heap_[i];
+    for (;;) {
+        std::size_t child = 2 * i + 1;
+        if (child >= heap_.size()) {
+            break;
+        }
+        if (child + 1 < heap_.size() && activity_[heap_[child + 1]] > activity_[heap_[child]]) {
+            ++child;
+        }
+        if (activity_[heap_[child]] <= activity_[v]) {
+            break;
+        }
+        heap_[i] = heap_[child];
+        heap_pos_[heap_[i]] = static_cast<std::int64_t>(i);
+        i = child;
+    }
+    heap_[i] = v;
+    heap_pos_[v] = static_cast<std::int64_t>(i);
+}
+
+SatSolver parse_dimacs(std::istream &in) {
+    SatSolver solver;
+    bool header = false;
+    unsigned declared = 0;
+    std::vector<int> clause;
+    std::string line;
+    std::size_t number = 0;
+    auto fail = [&](const std::string &what) {
+        throw std::runtime_error("Fichero DIMACS no válido (línea " + std::to_string(number) + "): " + what);
+    };
+    while (std::getline(in, line)) {
+        ++number;
+        std::istringstream tokens(line);
+        std::string first;
+        if (!(tokens >> first) || first == "c") {
+            continue;
+        }
+        if (first == "%") {
+            break;
+        }
+        if (first == "p") {
+            std::string format;
+            long long vars = -1, clauses = -1;
+            if (header || !(tokens >> format >> vars >> clauses) || format != "cnf" || vars < 0 || clauses < 0) {
+                fail("cabecera 'p cnf' no válida");
+            }
+            header = true;
+            declared = static_cast<unsigned>(vars);
+            solver = SatSolver(declared);
+            continue;
+        }
+        if (!header) {
+            fail("falta la cabecera 'p cnf'");
+        }
+        tokens.clear();
+        tokens.seekg(0);
+        std::string token;
+        while (tokens >> token) {
+            char *end = nullptr;
+            const long long literal = std::strtoll(token.c_str(), &end, 10);
+            if (*end != '\0' || std::llabs(literal) > declared) {
+                fail("literal no válido '" + token + "'");
+            }
+            if (literal == 0) {
+                solver.add_clause(clause);
+                clause.clear();
+            } else {
+                clause.push_back(static_cast<int>(literal));
+            }
+        }
+    }
+    if (!header) {
+        fail("falta la cabecera 'p cnf'");
+    }
+    if (!clause.empty()) {
+        fail("cláusula sin terminar");
+    }
+    return solver;
+}
+
+SatSolver load_dimacs(const std::string &path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("No se puede abrir el archivo: " + path);
+    }
+    return parse_dimacs(in);
+}
+
+} // namespace graphs
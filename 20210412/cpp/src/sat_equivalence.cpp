@@ -0,0 +1,203 @@
+#include "sat_equivalence.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace graphs {
+
+namespace {
+
+// Codificador con plegado de constantes y tabla de puertas ya codificadas:
+// dos puertas iguales sobre los mismos literales (en cualquier orden)
+// comparten variable, así que las partes comunes de los dos circuitos
+// acaban en los mismos literales.
+class TseitinEncoder {
+public:
+    explicit TseitinEncoder(SatSolver &solver) : solver_(solver) {}
+
+    int constant(bool value) {
+        if (true_ == 0) {
+            true_ = solver_.new_var();
+            solver_.add_clause({true_});
+        }
+        return value ? true_ : -true_;
+    }
+
+    int and_gate(int a, int b) {
+        if (a > b) {
+            std::swap(a, b);
+        }
+        if (a == b) {
+            return a;
+        }
+        if (a == -b || is_false(a) || is_false(b)) {
+            return constant(false);
+        }
+        if (is_true(a)) {
+            return b;
+        }
+        if (is_true(b)) {
+            return a;
+        }
+        int &out = table_[std::make_tuple(0, a, b)];
+        if (out == 0) {
+            out = solver_.new_var();
+            solver_.add_clause({-out, a});
+            solver_.add_clause({-out, b});
+            solver_.add_clause({out, -a, -b});
+        }
+        return out;
+    }
+
+    int xor_gate(int a, int b) {
+        // xor(¬a, b) = ¬xor(a, b): se codifica sobre variables positivas.
+        const bool negate = (a < 0) != (b < 0);
+        a = std::abs(a);
+        b = std::abs(b);
+        if (a > b) {
+            std::swap(a, b);
+        }
+        int out;
+        if (a == b) {
+            out = constant(false);
+        } else if (a == true_) {
+            out = -b;
+        } else if (b == true_) {
+            out = -a;
+        } else {
+            int &slot = table_[std::make_tuple(1, a, b)];
+            if (slot == 0) {
+                slot = solver_.new_var();
+                solver_.add_clause({-slot, a, b});
+                solver_.add_clause({-slot, -a, -b});
+                solver_.add_clause({slot, -a, b});
+                solver_.add_clause({slot, a, -b});
+            }
+            out = slot;
+        }
+        return negate ? -out : out;
+    }
+
+    std::vector<int> encode(const Circuit &c, const std::vector<int> &inputs) {
+        if (!inputs.empty() && inputs.size() != c.inputs()) {
+            throw std::invalid_argument("Se esperaban " + std::to_string(c.inputs()) + " literales de entrada");
+        }
+        std::vector<int> lit(c.size());
+        unsigned next_input = 0;
+        for (std::uint32_t i = 0; i < c.size(); ++i) {
+            const Circuit::Node &n = c.node(i);
+            switch (n.kind) {
+            case GateKind::Input:
+                lit[i] = inputs.empty() ? solver_.new_var() : inputs[next_input];
+                ++next_input;
+                break;
+            case GateKind::Const0:
+            case GateKind::Const1:
+                lit[i] = constant(n.kind == GateKind::Const1);
+                break;
+            case GateKind::Buf:
+                lit[i] = lit[n.a];
+                break;
+            case GateKind::Not:
+                lit[i] = -lit[n.a];
+                break;
+            case GateKind::And:
+            case GateKind::Nand:
+                lit[i] = and_gate(lit[n.a], lit[n.b]);
+                break;
+            case GateKind::Or:
+            case GateKind::Nor:
+                lit[i] = -and_gate(-lit[n.a], -lit[n.b]);
+                break;
+            case GateKind::Xor:
+            case GateKind::Xnor:
+                lit[i] = xor_gate(lit[n.a], lit[n.b]);
+                break;
+            }
+            if (n.kind == GateKind::Nand || n.kind == GateKind::Nor || n.kind == GateKind::Xnor) {
+                lit[i] = -lit[i];
+            }
+        }
+        return lit;
+    }
+
+private:
+    bool is_true(int l) const { return true_ != 0 && l == true_; }
+    bool is_false(int l) const { return true_ != 0 && l == -true_; }
+
+    SatSolver &solver_;
+    int true_ = 0;
+    std::map<std::tuple<int, int, int>, int> table_;
+};
+
+} // namespace
+
+std::vector<int> encode_tseitin(const Circuit &circuit, SatSolver &solver, const std::vector<int> &input_literals) {
+    TseitinEncoder encoder(solver);
+    return encoder.encode(circuit, input_literals);
+}
+
+SatEquivalenceResult check_equivalence_sat(const Circuit &a, const Circuit &b, const SatEquivalenceOptions &options) {
+    if (a.inputs() != b.inputs() || a.outputs().size() != b.outputs().size()) {
+        throw std::invalid_argument("Los circuitos del miter deben tener las mismas entradas y salidas");
+    }
+    SatSolver solver;
+    TseitinEncoder encoder(solver);
+    const std::vector<int> la = encoder.encode(a, {});
+    std::vector<int> inputs;
+    for (std::uint32_t i = 0; i < a.size(); ++i) {
+        if (a.node(i).kind == GateKind::Input) {
+            inputs.push_back(la[i]);
+        }
+    }
+    const std::vector<int> lb = encoder.encode(b, inputs);
+
+    SatEquivalenceResult result;
+    result.outputs.assign(a.outputs().size(), SatResult::Unknown);
+    bool found = false;
+    for (std::size_t o = 0; o < a.outputs().size(); ++o) {
+        const int x = la[a.outputs()[o]], y = lb[b.outputs()[o]];
+        if (x == y) {
+            result.outputs[o] = SatResult::Unsat;
+            continue;
+        }
+        if (x == -y) {
+            // Siempre distintas: cualquier entrada vale.
+            result.outputs[o] = SatResult::Sat;
+        } else {
+            // d -> (x XOR y); basta esta dirección para buscar diferencias.
+            const int d = solver.new_var();
+            solver.add_clause({-d, x, y});
+            solver.add_clause({-d, -x, -y});
+            result.outputs[o] = solver.solve({d}, options.conflict_limit);
+            if (result.outputs[o] == SatResult::Unsat) {
+                solver.add_clause({-d});
+                solver.add_clause({-x, y});
+                solver.add_clause({x, -y});
+            }
+        }
+        if (result.outputs[o] != SatResult::Unsat) {
+            result.equivalent = false;
+        }
+        if (result.outputs[o] == SatResult::Sat && !found) {
+            found = true;
+            result.output = static_cast<unsigned>(o);
+            result.counterexample.resize(inputs.size());
+            for (std::size_t i = 0; i < inputs.size(); ++i) {
+                // Con x == ¬y no hay modelo: vale la entrada todo ceros.
+                result.counterexample[i] = x != -y && solver.value(inputs[i]);
+            }
+            if (options.stop_at_first) {
+                break;
+            }
+        }
+    }
+    result.stats = solver.stats();
+    return result;
+}
+
+} // namespace graphs
@@ -0,0 +1,465 @@
+#include "scc.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+#include "dag.hpp"
+#include "graph_builder.hpp"
+#include "parallel.hpp"
+
+namespace graphs {
+
+namespace {
+
+constexpr std::size_t kFrontierGrain = 256;
+constexpr std::size_t kTrimGrain = 1024;
+// Subproblemas con menos vértices se resuelven con Tarjan secuencial.
+constexpr std::size_t kSmallTask = 1 << 14;
+
+// Tarjan iterativo sobre el subgrafo inducido por k vértices: vertex(i) es
+// el i-ésimo y local(v) su posición (o -1 si v no pertenece).  emit(members)
+// recibe cada componente, en orden topológico inverso.
+template <class Vertex, class Local, class Emit>
+void tarjan(const Graph &g, int k, Vertex vertex, Local local, Emit emit) {
+    std::vector<int> index(k, -1), low(k, 0);
+    std::vector<char> on_stack(k, 0);
+    std::vector<int> stack, members;
+    std::vector<std::pair<int, std::size_t>> frames;
+    int counter = 0;
+    auto open = [&](int x) {
+        index[x] = low[x] = counter++;
+        on_stack[x] = 1;
+        stack.push_back(x);
+        frames.emplace_back(x, g.edge_begin(vertex(x)));
+    };
+    for (int root = 0; root < k; ++root) {
+        if (index[root] != -1) {
+            continue;
+        }
+        open(root);
+        while (!frames.empty()) {
+            auto &[x, next] = frames.back();
+            if (next < g.edge_end(vertex(x))) {
+                const int w = local(g.target(next++));
+                if (w < 0) {
+                    continue;
+                }
+                if (index[w] == -1) {
+                    open(w);  // invalida x y next
+                } else if (on_stack[w]) {
+                    low[x] = std::min(low[x], index[w]);
+                }
+                continue;
+            }
+            const int done = x;
+            frames.pop_back();
+            if (!frames.empty()) {
+                int &parent_low = low[frames.back().first];
+                parent_low = std::min(parent_low, low[done]);
+            }
+            if (low[done] == index[done]) {
+                members.clear();
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    on_stack[w] = 0;
+                    members.push_back(vertex(w));
+                } while (w != done);
+                emit(members);
+            }
+        }
+    }
+}
+
+SccResult tarjan_scc(const Graph &g) {
+    const int n = g.num_vertices();
+    SccResult out;
+    out.component.assign(n, -1);
+    tarjan(
+        g, n, [](int v) { return v; }, [](int v) { return v; },
+        [&](const std::vector<int> &members) {
+            for (int v : members) {
+                out.component[v] = out.count;
+            }
+            ++out.count;
+        });
+    // Tarjan cierra primero las componentes sumidero: se invierte la numeración.
+    for (int &c : out.component) {
+        c = out.count - 1 - c;
+    }
+    return out;
+}
+
+SccResult kosaraju_scc(const Graph &g, unsigned threads) {
+    const int n = g.num_vertices();
+    std::vector<int> post;
+    post.reserve(n);
+    std::vector<char> seen(n, 0);
+    std::vector<std::pair<int, std::size_t>> frames;
+    for (int root = 0; root < n; ++root) {
+        if (seen[root]) {
+            continue;
+        }
+        seen[root] = 1;
+        frames.emplace_back(root, g.edge_begin(root));
+        while (!frames.empty()) {
+            auto &[u, next] = frames.back();
+            if (next == g.edge_end(u)) {
+                post.push_back(u);
+                frames.pop_back();
+                continue;
+            }
+            const int v = g.target(next++);
+            if (!seen[v]) {
+                seen[v] = 1;
+                frames.emplace_back(v, g.edge_begin(v));
+            }
+        }
+    }
+    // En el traspuesto, por postorden decreciente: cada recorrido es una
+    // componente y salen en orden topológico.
+    const Graph rev = transpose(g, threads);
+    SccResult out;
+    out.component.assign(n, -1);
+    std::vector<int> stack;
+    for (auto it = post.rbegin(); it != post.rend(); ++it) {
+        if (out.component[*it] != -1) {
+            continue;
+        }
+        const int c = out.count++;
+        out.component[*it] = c;
+        stack.push_back(*it);
+        while (!stack.empty()) {
+            const int u = stack.back();
+            stack.pop_back();
+            for (std::size_t e = rev.edge_begin(u); e < rev.edge_end(u); ++e) {
+                const int v = rev.target(e);
+                if (out.component[v] == -1) {
+                    out.component[v] = c;
+                    stack.push_back(v);
+                }
+            }
+        }
+    }
+    return out;
+}
+
+// Estado compartido del algoritmo forward-backward.  color[v] identifica el
+// subproblema de v (-1 si ya tiene componente); cada subproblema tiene un
+// color distinto, lo que permite resolverlos en paralelo sin interferencias.
+class ForwardBackward {
+public:
+    ForwardBackward(const Graph &g, unsigned threads)
+        : g_(g), rev_(transpose(g, threads)), threads_(threads), n_(g.num_vertices()),
+          color_(n_, 0), component_(n_, -1), forward_(n_), backward_(n_), local_(n_, -1) {}
+
+    SccResult run() {
+        std::vector<int> rest = trim();
+        std::vector<std::vector<int>> big, small;
+        if (!rest.empty()) {
+            (rest.size() < kSmallTask ? small : big).push_back(std::move(rest));
+        }
+        int next_color = 1;
+        unsigned stamp = 0;
+        while (!big.empty()) {
+            std::vector<int> task = std::move(big.back());
+            big.pop_back();
+            const int c = color_[task.front()];
+            ++stamp;
+            reach(g_, task.front(), c, forward_, stamp);
+            reach(rev_, task.front(), c, backward_, stamp);
+            // Intersección: componente del pivote.  El resto, en tres partes.
+            std::vector<int> parts[3];
+            const int id = next_id_++;
+            for (int v : task) {
+                const bool f = forward_[v].load(std::memory_order_relaxed) == stamp;
+                const bool b = backward_[v].load(std::memory_order_relaxed) == stamp;
+                if (f && b) {
+                    component_[v] = id;
+                    color_[v] = -1;
+                } else {
+                    parts[f ? 0 : b ? 1 : 2].push_back(v);
+                }
+            }
+            for (auto &part : parts) {
+                if (part.empty()) {
+                    continue;
+                }
+                const int pc = next_color++;
+                for (int v : part) {
+                    color_[v] = pc;
+                }
+                (part.size() < kSmallTask ? small : big).push_back(std::move(part));
+            }
+        }
+        solve_small(small);
+
+        SccResult out;
+        out.count = next_id_;
+        out.component = std::move(component_);
+        return out;
+    }
+
+private:
+    // Recorte paralelo de vértices sin entradas o sin salidas dentro del
+    // grafo restante: cada uno es una componente trivial.  Devuelve los
+    // vértices que quedan.  Las listas de trabajo cortas (cadenas largas) se
+    // procesan en secuencial, sin sincronizar por rondas.
+    std::vector<int> trim() {
+        std::vector<std::atomic<int>> in(n_), out(n_);
+        std::vector<std::atomic<char>> removed(n_);
+        std::atomic<int> ids{next_id_};
+        auto finish = [&](int v) {
+            component_[v] = ids.fetch_add(1, std::memory_order_relaxed);
+            color_[v] = -1;
+        };
+        std::vector<int> work;
+        for (int v = 0; v < n_; ++v) {
+            in[v].store(static_cast<int>(rev_.degree(v)), std::memory_order_relaxed);
+            out[v].store(static_cast<int>(g_.degree(v)), std::memory_order_relaxed);
+            removed[v].store(0, std::memory_order_relaxed);
+            if (rev_.degree(v) == 0 || g_.degree(v) == 0) {
+                removed[v].store(1, std::memory_order_relaxed);
+                finish(v);
+                work.push_back(v);
+            }
+        }
+        // Quita u del grafo restante; push(v) recibe los vértices que se quedan
+        // sin entradas o sin salidas.
+        auto remove = [&](int u, auto &&push) {
+            auto take = [&](std::vector<std::atomic<int>> &degree, int v) {
+                if (degree[v].fetch_sub(1, std::memory_order_relaxed) == 1 &&
+                    !removed[v].exchange(1, std::memory_order_relaxed)) {
+                    finish(v);
+                    push(v);
+                }
+            };
+            for (std::size_t e = g_.edge_begin(u); e < g_.edge_end(u); ++e) {
+                take(in, g_.target(e));
+            }
+            for (std::size_t e = rev_.edge_begin(u); e < rev_.edge_end(u); ++e) {
+                take(out, rev_.target(e));
+            }
+        };
+        std::vector<std::vector<int>> local;
+        while (!work.empty()) {
+            if (work.size() < kTrimGrain) {
+                while (!work.empty() && work.size() < kTrimGrain) {
+                    const int u = work.back();
+                    work.pop_back();
+                    remove(u, [&](int v) { work.push_back(v); });
+                }
+                continue;
+            }
+            const unsigned workers = parallel::effective_threads(work.size(), threads_, kTrimGrain);
+            local.assign(workers, {});
+            auto round = [&](unsigned worker, std::size_t i) {
+                remove(work[i], [&](int v) { local[worker].push_back(v); });
+            };
+            parallel::for_each_index(work.size(), workers, kTrimGrain, round);
+            work.clear();
+            for (const auto &l : local) {
+                work.insert(work.end(), l.begin(), l.end());
+            }
+        }
+        next_id_ = ids.load();
+        std::vector<int> rest;
+        for (int v = 0; v < n_; ++v) {
+            if (color_[v] == 0) {
+                rest.push_back(v);
+            }
+        }
+        return rest;
+    }
+
+    // BFS desde pivot dentro del color c; marca con `stamp`.  Los niveles
+    // anchos se expanden en paralelo y los estrechos en secuencial.
+    void reach(const Graph &g, int pivot, int c, std::vector<std::atomic<unsigned>> &mark,
+               unsigned stamp) {
+        auto visit = [&](int v) {
+            return color_[v] == c && mark[v].load(std::memory_order_relaxed) != stamp &&
+                   mark[v].exchange(stamp, std::memory_order_relaxed) != stamp;
+        };
+        std::vector<int> frontier{pivot}, next;
+        std::vector<std::vector<int>> local;
+        mark[pivot].store(stamp, std::memory_order_relaxed);
+        while (!frontier.empty()) {
+            if (frontier.size() < kFrontierGrain) {
+                std::size_t head = 0;
+                while (head < frontier.size() && frontier.size() - head < kFrontierGrain) {
+                    const int u = frontier[head++];
+                    for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+                        if (visit(g.target(e))) {
+                            frontier.push_back(g.target(e));
+                        }
+                    }
+                }
+                frontier.erase(frontier.begin(), frontier.begin() + head);
+                continue;
+            }
+            const unsigned workers =
+                parallel::effective_threads(frontier.size(), threads_, kFrontierGrain);
+            local.assign(workers, {});
+            auto expand = [&](unsigned worker, std::size_t i) {
+                const int u = frontier[i];
+                for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+                    if (visit(g.target(e))) {
+                        local[worker].push_back(g.target(e));
+                    }
+                }
+            };
+            parallel::for_each_index(frontier.size(), workers, kFrontierGrain, expand);
+            next.clear();
+            for (const auto &l : local) {
+                next.insert(next.end(), l.begin(), l.end());
+            }
+            std::swap(frontier, next);
+        }
+    }
+
+    // Subproblemas pequeños en paralelo, cada uno con Tarjan restringido a su
+    // color.  Sólo se leen color_ y local_ de vértices del propio color.
+    void solve_small(const std::vector<std::vector<int>> &tasks) {
+        std::atomic<int> next_id{next_id_};
+        parallel::for_each_index(tasks.size(), threads_, 1, [&](unsigned, std::size_t t) {
+            const auto &task = tasks[t];
+            const int c = color_[task.front()];
+            for (std::size_t i = 0; i < task.size(); ++i) {
+                local_[task[i]] = static_cast<int>(i);
+            }
+            tarjan(
+                g_, static_cast<int>(task.size()), [&](int i) { return task[i]; },
+                [&](int v) { return color_[v] == c ? local_[v] : -1; },
+                [&](const std::vector<int> &members) {
+                    const int id = next_id.fetch_add(1, std::memory_order_relaxed);
+                    for (int v : members) {
+                        component_[v] = id;
+                    }
+                });
+        });
+        next_id_ = next_id.load();
+    }
+
+    const Graph &g_;
+    Graph rev_;
+    unsigned threads_;
+    int n_;
+    std::vector<int> color_;
+    std::vector<int> component_;
+    std::vector<std::atomic<unsigned>> forward_, backward_;
+    std::vector<int> local_;
+    int next_id_ = 0;
+};
+
+// Renumera las componentes en orden topológico de la condensación.
+void relabel_topological(const Graph &g, SccResult &scc, unsigned threads) {
+    const std::vector<int> order = topological_sort(condensation(g, scc, threads)).order;
+    std::vector<int> rank(scc.count);
+    for (int i = 0; i < scc.count; ++i) {
+        rank[order[i]] = i;
+    }
+    for (int &c : scc.component) {
+        c = rank[c];
+    }
+}
+
+} // namespace
+
+std::vector<int> SccResult::sizes() const {
+    std::vector<int> out(count, 0);
+    for (int c : component) {
+        ++out[c];
+    }
+    return out;
+}
+
+SccResult strongly_connected_components(const Graph &g, SccMethod method, unsigned threads) {
+    switch (method) {
+    case SccMethod::Tarjan:
+        return tarjan_scc(g);
+    case SccMethod::Kosaraju:
+        return kosaraju_scc(g, threads);
+    case SccMethod::ForwardBackward: {
+        SccResult out = ForwardBackward(g, threads).run();
+        relabel_topological(g, out, threads);
+        return out;
+    }
+    }
+    throw std::invalid_argument("Método de componentes desconocido");
+}
+
+Graph condensation(const Graph &g, const SccResult &scc, unsigned threads) {
+    const int n = g.num_vertices();
+    if (scc.component.size() != static_cast<std::size_t>(n)) {
+        throw std::invalid_argument("Las componentes no corresponden al grafo");
+    }
+    const std::size_t block = 4096;
+    std::vector<std::vector<EdgeRecord>> batches((n + block - 1) / block);
+    parallel::for_each_index(batches.size(), threads, 1, [&](unsigned, std::size_t b) {
+        const int end = static_cast<int>(std::min<std::size_t>(n, (b + 1) * block));
+        for (int u = static_cast<int>(b * block); u < end; ++u) {
+            for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+                const int cu = scc.component[u], cv = scc.component[g.target(e)];
+                if (cu != cv) {
+                    batches[b].push_back({cu, cv, g.weight(e)});
+                }
+            }
+        }
+    });
+    BuildOptions options;
+    options.deduplicate = true;
+    options.threads = threads;
+    return build_csr(scc.count, batches, options);
+}
+
+std::vector<int> find_cycle(const Graph &g, int source) {
+    const int n = g.num_vertices();
+    if (source >= n) {
+        throw std::out_of_range("Nodo origen fuera de rango");
+    }
+    // DFS tricolor iterativo: una arista hacia un vértice en la pila (gris)
+    // cierra un ciclo formado por el tramo de la pila desde ese vértice.
+    std::vector<char> color(n, 0);
+    std::vector<std::pair<int, std::size_t>> frames;
+    const int first = source >= 0 ? source : 0;
+    const int last = source >= 0 ? source + 1 : n;
+    for (int root = first; root < last; ++root) {
+        if (color[root]) {
+            continue;
+        }
+        color[root] = 1;
+        frames.emplace_back(root, g.edge_begin(root));
+        while (!frames.empty()) {
+            auto &[u, next] = frames.back();
+            if (next == g.edge_end(u)) {
+                color[u] = 2;
+                frames.pop_back();
+                continue;
+            }
+            const int v = g.target(next++);
+            if (color[v] == 1) {
+                std::vector<int> cycle;
+                std::size_t k = frames.size();
+                while (frames[k - 1].first != v) {
+                    --k;
+                }
+                for (; k <= frames.size(); ++k) {
+                    cycle.push_back(frames[k - 1].first);
+                }
+                return cycle;
+            }
+            if (color[v] == 0) {
+                color[v] = 1;
+                frames.emplace_back(v, g.edge_begin(v));
+            }
+        }
+    }
+    return {};
+}
+
+bool has_cycle(const Graph &g, int source) { return !find_cycle(g, source).empty(); }
+
+} // namespace graphs
@@ -0,0 +1,612 @@
+#include "sequence_search.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "parallel.hpp"
+
+namespace graphs {
+
+struct Condition::Node {
+    enum Kind { Const, From, To, Event, Not, And, Or } kind;
+    int value = 0;
+    std::shared_ptr<const Node> a, b;
+};
+
+namespace {
+
+using Node = Condition::Node;
+
+std::uint64_t saturating_add(std::uint64_t a, std::uint64_t b, bool &overflow) {
+    if (a > std::numeric_limits<std::uint64_t>::max() - b) {
+        overflow = true;
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    return a + b;
+}
+
+bool eval(const Node &n, int from, int event, int to) {
+    switch (n.kind) {
+    case Node::Const:
+        return n.value != 0;
+    case Node::From:
+        return from == n.value;
+    case Node::To:
+        return to == n.value;
+    case Node::Event:
+        return event == n.value;
+    case Node::Not:
+        return !eval(*n.a, from, event, to);
+    case Node::And:
+        return eval(*n.a, from, event, to) && eval(*n.b, from, event, to);
+    case Node::Or:
+        return eval(*n.a, from, event, to) || eval(*n.b, from, event, to);
+    }
+    return false;
+}
+
+// Analizador descendente recursivo del lenguaje de condiciones:
+//   expr    := or ('->' expr)?
+//   or      := and ('||' and)*
+//   and     := unary ('&&' unary)*
+//   unary   := '!' unary | '(' expr ')' | 'true' | 'false' | atom
+//   atom    := ('from' | 'to' | 'event') ('==' | '!=') nombre
+class Parser {
+public:
+    Parser(const std::string &text, const TransitionTable &table) : text_(text), table_(table) {}
+
+    Condition parse() {
+        Condition c = expr();
+        skip();
+        if (pos_ != text_.size()) {
+            fail("se esperaba el final");
+        }
+        return c;
+    }
+
+private:
+    [[noreturn]] void fail(const std::string &what) const {
+        throw std::invalid_argument("Condición no válida en la posición " + std::to_string(pos_) + ": " + what);
+    }
+
+    void skip() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    bool accept(const char *token) {
+        skip();
+        const std::size_t len = std::char_traits<char>::length(token);
+        if (text_.compare(pos_, len, token) == 0) {
+            pos_ += len;
+            return true;
+        }
+        return false;
+    }
+
+    static bool name_char(char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.' || c == '-';
+    }
+
+    // Nombre simple o entre comillas simples.
+    std::string name() {
+        skip();
+        if (pos_ < text_.size() && text_[pos_] == '\'') {
+            const std::size_t end = text_.find('\'', pos_ + 1);
+            if (end == std::string::npos) {
+                fail("comilla sin cerrar");
+            }
+            std::string s = text_.substr(pos_ + 1, end - pos_ - 1);
+            pos_ = end + 1;
+            return s;
+        }
+        const std::size_t begin = pos_;
+        // '-' sólo dentro del nombre, para no comerse la flecha.
+        while (pos_ < text_.size() && name_char(text_[pos_]) &&
+               !(text_[pos_] == '-' && pos_ + 1 < text_.size() && text_[pos_ + 1] == '>')) {
+            ++pos_;
+        }
+        if (pos_ == begin) {
+            fail("se esperaba un nombre");
+        }
+        return text_.substr(begin, pos_ - begin);
+    }
+
+    static bool numeric(const std::string &s) {
+        return !s.empty() && std::all_of(s.begin(), s.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); });
+    }
+
+    int resolve(const std::string &s, bool state) const {
+        if (numeric(s)) {
+            const int i = std::stoi(s);
+            if (i >= (state ? table_.num_states() : table_.num_events())) {
+                throw std::invalid_argument("Índice fuera de rango en la condición: " + s);
+            }
+            return i;
+        }
+        return state ? table_.state_index(s) : table_.event_index(s);
+    }
+
+    Condition expr() {
+        Condition a = disjunction();
+        if (accept("->")) {
+            return implies(a, expr());
+        }
+        return a;
+    }
+
+    Condition disjunction() {
+        Condition a = conjunction();
+        while (accept("||")) {
+            a = a || conjunction();
+        }
+        return a;
+    }
+
+    Condition conjunction() {
+        Condition a = unary();
+        while (accept("&&")) {
+            a = a && unary();
+        }
+        return a;
+    }
+
+    Condition unary() {
+        if (accept("!")) {
+            return !unary();
+        }
+        if (accept("(")) {
+            Condition c = expr();
+            if (!accept(")")) {
+                fail("se esperaba ')'");
+            }
+            return c;
+        }
+        const std::string word = name();
+        if (word == "true" || word == "false") {
+            return Condition::constant(word == "true");
+        }
+        if (word != "from" && word != "to" && word != "event") {
+            fail("se esperaba from, to, event, true o false");
+        }
+        bool equal;
+        if (accept("==")) {
+            equal = true;
+        } else if (accept("!=")) {
+            equal = false;
+        } else {
+            fail("se esperaba == o !=");
+        }
+        const int value = resolve(name(), word != "event");
+        Condition c = word == "from" ? Condition::from(value)
+                      : word == "to" ? Condition::to(value)
+                                     : Condition::event(value);
+        return equal ? c : !c;
+    }
+
+    const std::string &text_;
+    const TransitionTable &table_;
+    std::size_t pos_ = 0;
+};
+
+// Búsqueda en profundidad con robo de trabajo.
+class Search {
+public:
+    Search(const SequenceGenerator &gen, const std::vector<int> &allowed, const std::vector<std::uint64_t> *alive,
+           const std::vector<PathPredicate> &path, int start, int length, const SequenceOptions &options, bool collect)
+        : table_(gen.table()), allowed_(allowed), alive_(alive), path_(path), start_(start), length_(length),
+          options_(options), collect_(collect) {}
+
+    SequenceResult run(std::uint64_t &count, bool &overflow) {
+        const unsigned threads = options_.threads ? options_.threads : parallel::default_threads();
+        workers_ = std::vector<Worker>(threads);
+        workers_[0].queue.push_back({});
+        pending_ = 1;
+        parallel::for_each_index(threads, threads, 1, [&](unsigned, std::size_t w) { work(static_cast<unsigned>(w)); });
+
+        SequenceResult result;
+        count = 0;
+        overflow = false;
+        for (Worker &w : workers_) {
+            result.nodes += w.nodes;
+            result.pruned += w.pruned;
+            result.steals += w.steals;
+            count = saturating_add(count, w.count, overflow);
+            for (auto &s : w.found) {
+                result.sequences.push_back(std::move(s));
+            }
+        }
+        // Cada tarea entrega sus secuencias en orden; el orden DFS global
+        // es el lexicográfico de los índices de evento.
+        std::sort(result.sequences.begin(), result.sequences.end());
+        if (options_.limit && result.sequences.size() > options_.limit) {
+            result.sequences.resize(options_.limit);
+        }
+        return result;
+    }
+
+private:
+    // Prefijo de eventos pendiente de explorar (su último paso aún no se ha
+    // comprobado con los invariantes de camino).
+    using Task = std::vector<int>;
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> queue;
+        std::atomic<std::size_t> queued{0};
+        std::vector<std::vector<int>> found;
+        std::uint64_t count = 0;
+        std::size_t nodes = 0;
+        std::size_t pruned = 0;
+        std::size_t steals = 0;
+    };
+
+    bool alive(int depth, int state) const {
+        return !alive_ || (*alive_)[static_cast<std::size_t>(depth) * table_.num_states() + state] > 0;
+    }
+
+    int step(int from, int event) const {
+        return allowed_[static_cast<std::size_t>(from) * table_.num_events() + event];
+    }
+
+    bool path_ok(const std::vector<int> &states, const std::vector<int> &events, int depth) const {
+        const SequencePath p{states.data(), events.data(), depth};
+        return std::all_of(path_.begin(), path_.end(), [&](const PathPredicate &f) { return f(p); });
+    }
+
+    void push(unsigned w, Task task) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(workers_[w].mutex);
+        workers_[w].queue.push_front(std::move(task));
+        workers_[w].queued.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool take(unsigned w, Task &task) {
+        // Primero la propia cola por detrás (la tarea más reciente)...
+        {
+            Worker &me = workers_[w];
+            std::lock_guard<std::mutex> lock(me.mutex);
+            if (!me.queue.empty()) {
+                task = std::move(me.queue.back());
+                me.queue.pop_back();
+                me.queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        // ... y si no, robo por delante (la más antigua) de las demás.
+        for (unsigned k = 1; k < workers_.size(); ++k) {
+            Worker &victim = workers_[(w + k) % workers_.size()];
+            if (victim.queued.load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.queue.empty()) {
+                task = std::move(victim.queue.front());
+                victim.queue.pop_front();
+                victim.queued.fetch_sub(1, std::memory_order_relaxed);
+                ++workers_[w].steals;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(unsigned w) {
+        Task task;
+        bool hungry = false;
+        while (pending_.load(std::memory_order_acquire) > 0 && !failed_.load(std::memory_order_relaxed)) {
+            if (take(w, task)) {
+                if (hungry) {
+                    idle_.fetch_sub(1, std::memory_order_relaxed);
+                    hungry = false;
+                }
+                try {
+                    explore(w, task);
+                } catch (...) {
+                    // Un invariante de camino lanzó: los demás hilos paran y
+                    // for_each_index propaga la excepción.
+                    failed_ = true;
+                    throw;
+                }
+                pending_.fetch_sub(1, std::memory_order_acq_rel);
+            } else {
+                if (!hungry) {
+                    idle_.fetch_add(1, std::memory_order_relaxed);
+                    hungry = true;
+                }
+                std::this_thread::yield();
+            }
+        }
+        if (hungry) {
+            idle_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void record(Worker &me, const std::vector<int> &events) {
+        ++me.count;
+        if (collect_) {
+            me.found.emplace_back(events.begin(), events.begin() + length_);
+        }
+    }
+
+    void explore(unsigned w, const Task &task) {
+        Worker &me = workers_[w];
+        const int base = static_cast<int>(task.size());
+        const int events = table_.num_events();
+        std::vector<int> states(length_ + 1), path(length_ + 1, 0), next(length_ + 1, 0);
+        states[0] = start_;
+        for (int d = 0; d < base; ++d) {
+            path[d] = task[d];
+            states[d + 1] = step(states[d], task[d]);
+        }
+        if (base > 0) {
+            // Último paso de una tarea cedida: aún sin comprobar.
+            ++me.nodes;
+            if (!path_ok(states, path, base)) {
+                return;
+            }
+        } else if (length_ == 0 && !path_ok(states, path, 0)) {
+            return;
+        }
+        if (base == length_) {
+            record(me, path);
+            return;
+        }
+        std::size_t found = 0;
+        next[base] = 0;
+        int d = base;
+        while (d >= base) {
+            if (options_.limit && found >= options_.limit) {
+                break;
+            }
+            if (next[d] == events) {
+                --d;
+                continue;
+            }
+            const int e = next[d]++;
+            const int s = step(states[d], e);
+            if (s < 0) {
+                continue;
+            }
+            ++me.nodes;
+            if (!alive(d + 1, s)) {
+                ++me.pruned;
+                continue;
+            }
+            path[d] = e;
+            states[d + 1] = s;
+            if (!path_ok(states, path, d + 1)) {
+                continue;
+            }
+            if (d + 1 == length_) {
+                record(me, path);
+                ++found;
+                continue;
+            }
+            ++d;
+            next[d] = 0;
+            if (idle_.load(std::memory_order_relaxed) > 0 && me.queued.load(std::memory_order_relaxed) == 0) {
+                donate(w, path, states, next, base, d);
+            }
+        }
+    }
+
+    // Cede los hermanos pendientes del nivel más superficial con alguno.
+    void donate(unsigned w, const std::vector<int> &path, const std::vector<int> &states, std::vector<int> &next,
+                int base, int d) {
+        const int events = table_.num_events();
+        for (int k = base; k < d; ++k) {
+            bool gave = false;
+            for (int e = next[k]; e < events; ++e) {
+                const int s = step(states[k], e);
+                if (s < 0) {
+                    continue;
+                }
+                if (!alive(k + 1, s)) {
+                    ++workers_[w].nodes;
+                    ++workers_[w].pruned;
+                    continue;
+                }
+                Task t(path.begin(), path.begin() + k);
+                t.push_back(e);
+                push(w, std::move(t));
+                gave = true;
+            }
+            next[k] = events;
+            if (gave) {
+                return;
+            }
+        }
+    }
+
+    const TransitionTable &table_;
+    const std::vector<int> &allowed_;
+    const std::vector<std::uint64_t> *alive_;
+    const std::vector<PathPredicate> &path_;
+    int start_;
+    int length_;
+    SequenceOptions options_;
+    bool collect_;
+    std::vector<Worker> workers_;
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<unsigned> idle_{0};
+    std::atomic<bool> failed_{false};
+};
+
+} // namespace
+
+TransitionTable::TransitionTable(int states, int events) : states_(states), events_(events) {
+    if (states < 0 || events < 0) {
+        throw std::invalid_argument("Tamaño de tabla de transiciones negativo");
+    }
+    next_.assign(static_cast<std::size_t>(states) * events, kNone);
+}
+
+TransitionTable::TransitionTable(std::vector<std::string> states, std::vector<std::string> events)
+    : TransitionTable(static_cast<int>(states.size()), static_cast<int>(events.size())) {
+    state_names_ = std::move(states);
+    event_names_ = std::move(events);
+}
+
+void TransitionTable::set(int from, int event, int to) {
+    if (from < 0 || from >= states_ || to < kNone || to >= states_ || event < 0 || event >= events_) {
+        throw std::out_of_range("Transición fuera de rango");
+    }
+    next_[static_cast<std::size_t>(from) * events_ + event] = to;
+}
+
+void TransitionTable::set(const std::string &from, const std::string &event, const std::string &to) {
+    set(state_index(from), event_index(event), state_index(to));
+}
+
+int TransitionTable::state_index(const std::string &name) const {
+    const auto it = std::find(state_names_.begin(), state_names_.end(), name);
+    if (it == state_names_.end()) {
+        throw std::invalid_argument("Estado desconocido: " + name);
+    }
+    return static_cast<int>(it - state_names_.begin());
+}
+
+int TransitionTable::event_index(const std::string &name) const {
+    const auto it = std::find(event_names_.begin(), event_names_.end(), name);
+    if (it == event_names_.end()) {
+        throw std::invalid_argument("Evento desconocido: " + name);
+    }
+    return static_cast<int>(it - event_names_.begin());
+}
+
+Condition::Condition() : Condition(constant(true)) {}
+
+Condition Condition::constant(bool value) {
+    return Condition(std::make_shared<const Node>(Node{Node::Const, value ? 1 : 0, nullptr, nullptr}));
+}
+
+Condition Condition::from(int state) {
+    return Condition(std::make_shared<const Node>(Node{Node::From, state, nullptr, nullptr}));
+}
+
+Condition Condition::to(int state) {
+    return Condition(std::make_shared<const Node>(Node{Node::To, state, nullptr, nullptr}));
+}
+
+Condition Condition::event(int event) {
+    return Condition(std::make_shared<const Node>(Node{Node::Event, event, nullptr, nullptr}));
+}
+
+Condition operator!(const Condition &a) {
+    return Condition(std::make_shared<const Node>(Node{Node::Not, 0, a.node_, nullptr}));
+}
+
+Condition operator&&(const Condition &a, const Condition &b) {
+    return Condition(std::make_shared<const Node>(Node{Node::And, 0, a.node_, b.node_}));
+}
+
+Condition operator||(const Condition &a, const Condition &b) {
+    return Condition(std::make_shared<const Node>(Node{Node::Or, 0, a.node_, b.node_}));
+}
+
+Condition implies(const Condition &a, const Condition &b) {
+    return !a || b;
+}
+
+bool Condition::operator()(int from, int event, int to) const {
+    return eval(*node_, from, event, to);
+}
+
+Condition parse_condition(const std::string &text, const TransitionTable &table) {
+    return Parser(text, table).parse();
+}
+
+SequenceGenerator::SequenceGenerator(TransitionTable table, int start) : table_(std::move(table)), start_(start) {
+    if (start < 0 || start >= table_.num_states()) {
+        throw std::out_of_range("Estado inicial fuera de rango");
+    }
+    allowed_.resize(static_cast<std::size_t>(table_.num_states()) * table_.num_events());
+    for (int s = 0; s < table_.num_states(); ++s) {
+        for (int e = 0; e < table_.num_events(); ++e) {
+            allowed_[static_cast<std::size_t>(s) * table_.num_events() + e] = table_.next(s, e);
+        }
+    }
+}
+
+void SequenceGenerator::require(const Condition &step) {
+    // Compilación: la condición se evalúa una vez por transición.
+    for (int s = 0; s < table_.num_states(); ++s) {
+        for (int e = 0; e < table_.num_events(); ++e) {
+            int &to = allowed_[static_cast<std::size_t>(s) * table_.num_events() + e];
+            if (to != TransitionTable::kNone && !step(s, e, to)) {
+                to = TransitionTable::kNone;
+            }
+        }
+    }
+}
+
+void SequenceGenerator::require(const std::string &step) {
+    require(parse_condition(step, table_));
+}
+
+void SequenceGenerator::require_path(PathPredicate path) {
+    path_.push_back(std::move(path));
+}
+
+std::vector<std::uint64_t> SequenceGenerator::completions(int length, bool &overflow) const {
+    const int n = table_.num_states(), events = table_.num_events();
+    std::vector<std::uint64_t> table(static_cast<std::size_t>(length + 1) * n, 0);
+    std::fill(table.begin() + static_cast<std::size_t>(length) * n, table.end(), 1);
+    for (int d = length - 1; d >= 0; --d) {
+        const std::uint64_t *below = table.data() + static_cast<std::size_t>(d + 1) * n;
+        std::uint64_t *row = table.data() + static_cast<std::size_t>(d) * n;
+        for (int s = 0; s < n; ++s) {
+            for (int e = 0; e < events; ++e) {
+                const int t = step(s, e);
+                if (t >= 0) {
+                    row[s] = saturating_add(row[s], below[t], overflow);
+                }
+            }
+        }
+    }
+    return table;
+}
+
+SequenceResult SequenceGenerator::generate(int length, const SequenceOptions &options) const {
+    if (length < 0) {
+        throw std::invalid_argument("Longitud de secuencia negativa");
+    }
+    bool overflow = false;
+    std::vector<std::uint64_t> alive;
+    if (options.memoize) {
+        alive = completions(length, overflow);
+    }
+    std::uint64_t count;
+    Search search(*this, allowed_, options.memoize ? &alive : nullptr, path_, start_, length, options, true);
+    return search.run(count, overflow);
+}
+
+std::uint64_t SequenceGenerator::count(int length, bool *overflow, unsigned threads) const {
+    if (length < 0) {
+        throw std::invalid_argument("Longitud de secuencia negativa");
+    }
+    bool over = false;
+    const std::vector<std::uint64_t> table = completions(length, over);
+    std::uint64_t total = table[start_];
+    if (!path_.empty()) {
+        SequenceOptions options;
+        options.threads = threads;
+        Search search(*this, allowed_, &table, path_, start_, length, options, false);
+        over = false;
+        search.run(total, over);
+    }
+    if (overflow) {
+        *overflow = over;
+    }
+    return total;
+}
+
+} // namespace graphs
@@ -0,0 +1,407 @@
+#include "snapshot.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace graphs {
+
+namespace {
+
+constexpr char kMagic[8] = {'G', 'L', 'A', 'S', 'S', 'C', 'S', 'R'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kByteOrderMark = 0x01020304u;
+constexpr std::uint64_t kAlignment = 64;
+
+constexpr std::uint32_t kFlagNegativeWeights = 1u << 0;
+constexpr std::uint32_t kFlagChecksums = 1u << 1;
+constexpr std::uint32_t kFlagNames = 1u << 2;
+
+struct Section {
+    std::uint64_t pos;
+    std::uint64_t bytes;
+    std::uint32_t crc;
+    std::uint32_t reserved;
+};
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t flags;
+    std::uint32_t offset_encoding;
+    std::uint64_t num_vertices;
+    std::uint64_t num_edges;
+    Section offsets;
+    Section targets;
+    Section weights;
+    Section names;
+    std::uint32_t header_crc;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(Header) % 8 == 0, "La cabecera debe tener tamaño múltiplo de 8");
+
+std::uint64_t align_up(std::uint64_t x) {
+    return (x + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+std::uint32_t header_checksum(Header h) {
+    h.header_crc = 0;
+    return crc32(&h, sizeof(h));
+}
+
+// Escritura secuencial con relleno hasta la alineación de cada sección.
+class SectionWriter {
+public:
+    explicit SectionWriter(const std::string &path) : out_(path, std::ios::binary | std::ios::trunc) {
+        if (!out_) {
+            throw std::runtime_error("No se puede crear el archivo: " + path);
+        }
+        Header blank{};
+        write_raw(&blank, sizeof(blank));
+    }
+
+    Section write(const void *data, std::size_t bytes, bool checksum) {
+        static const char zeros[kAlignment] = {};
+        write_raw(zeros, align_up(pos_) - pos_);
+        Section s{};
+        s.pos = pos_;
+        s.bytes = bytes;
+        s.crc = checksum ? crc32(data, bytes) : 0;
+        write_raw(data, bytes);
+        return s;
+    }
+
+    void finish(const Header &h) {
+        out_.seekp(0);
+        out_.write(reinterpret_cast<const char *>(&h), sizeof(h));
+        out_.flush();
+        if (!out_) {
+            throw std::runtime_error("Error al escribir la instantánea");
+        }
+    }
+
+private:
+    void write_raw(const void *data, std::size_t bytes) {
+        out_.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+        pos_ += bytes;
+    }
+
+    std::ofstream out_;
+    std::uint64_t pos_ = 0;
+};
+
+// Archivo mapeado en memoria de sólo lectura.  En plataformas sin mmap se
+// lee completo a memoria (misma interfaz, sin carga diferida).
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &path) {
+#if defined(_WIN32)
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("No se puede abrir el archivo: " + path);
+        }
+        buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data_ = reinterpret_cast<const unsigned char *>(buffer_.data());
+        size_ = buffer_.size();
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("No se puede abrir el archivo: " + path);
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("No se puede consultar el archivo: " + path);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ > 0) {
+            void *p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("No se puede mapear el archivo: " + path);
+            }
+            data_ = static_cast<const unsigned char *>(p);
+        }
+        ::close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#if !defined(_WIN32)
+        if (data_) {
+            ::munmap(const_cast<unsigned char *>(data_), size_);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const unsigned char *data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const unsigned char *data_ = nullptr;
+    std::size_t size_ = 0;
+#if defined(_WIN32)
+    std::vector<char> buffer_;
+#endif
+};
+
+// Memoria que mantiene vivo un grafo cargado: el mapeo y, si hizo falta
+// decodificarlos, los desplazamientos.
+struct LoadedStorage {
+    std::unique_ptr<MappedFile> file;
+    std::vector<std::size_t> decoded_offsets;
+};
+
+void put_varint(std::vector<unsigned char> &out, std::uint64_t x) {
+    while (x >= 0x80) {
+        out.push_back(static_cast<unsigned char>(x | 0x80));
+        x >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(x));
+}
+
+[[noreturn]] void corrupt(const std::string &what) {
+    throw std::runtime_error("Instantánea no válida: " + what);
+}
+
+} // namespace
+
+std::uint32_t crc32(const void *data, std::size_t size, std::uint32_t crc) {
+    static const auto table = [] {
+        std::array<std::uint32_t, 256> t{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    const auto *p = static_cast<const unsigned char *>(data);
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ p[i]) & 0xFFu] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void write_snapshot(const std::string &path, const Graph &g, const SnapshotOptions &options,
+                    const std::vector<std::string> *names) {
+    const std::size_t n = static_cast<std::size_t>(g.num_vertices());
+    if (names && names->size() != n) {
+        throw std::invalid_argument("El número de nombres no coincide con el de vértices");
+    }
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.byte_order = kByteOrderMark;
+    h.offset_encoding = static_cast<std::uint32_t>(options.offsets);
+    h.num_vertices = n;
+    h.num_edges = g.num_edges();
+    h.flags = (g.has_negative_weights() ? kFlagNegativeWeights : 0u) |
+              (options.checksums ? kFlagChecksums : 0u) | (names ? kFlagNames : 0u);
+
+    SectionWriter out(path);
+    auto offsets = g.offsets();
+    switch (options.offsets) {
+    case OffsetEncoding::Raw64: {
+        std::vector<std::uint64_t> raw(offsets.begin(), offsets.end());
+        h.offsets = out.write(raw.data(), raw.size() * sizeof(std::uint64_t), options.checksums);
+        break;
+    }
+    case OffsetEncoding::Raw32: {
+        if (g.num_edges() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::invalid_argument("Demasiadas aristas para desplazamientos de 32 bits");
+        }
+        std::vector<std::uint32_t> raw(offsets.begin(), offsets.end());
+        h.offsets = out.write(raw.data(), raw.size() * sizeof(std::uint32_t), options.checksums);
+        break;
+    }
+    case OffsetEncoding::VarintDegrees: {
+        std::vector<unsigned char> bytes;
+        bytes.reserve(n);
+        for (std::size_t u = 0; u < n; ++u) {
+            put_varint(bytes, offsets[u + 1] - offsets[u]);
+        }
+        h.offsets = out.write(bytes.data(), bytes.size(), options.checksums);
+        break;
+    }
+    default:
+        throw std::invalid_argument("Codificación de desplazamientos desconocida");
+    }
+    static_assert(sizeof(int) == 4, "Los destinos se guardan como int32");
+    h.targets = out.write(g.targets().data(), g.num_edges() * sizeof(int), options.checksums);
+    h.weights = out.write(g.weights().data(), g.num_edges() * sizeof(double), options.checksums);
+    if (names) {
+        std::string blob;
+        for (const auto &name : *names) {
+            blob += name;
+            blob.push_back('\0');
+        }
+        h.names = out.write(blob.data(), blob.size(), options.checksums);
+    }
+    h.header_crc = header_checksum(h);
+    out.finish(h);
+}
+
+Snapshot load_snapshot(const std::string &path, const SnapshotLoadOptions &options) {
+    auto storage = std::make_shared<LoadedStorage>();
+    storage->file = std::make_unique<MappedFile>(path);
+    const unsigned char *base = storage->file->data();
+    const std::size_t size = storage->file->size();
+    if (size < sizeof(Header)) {
+        corrupt("archivo demasiado corto");
+    }
+    Header h;
+    std::memcpy(&h, base, sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) {
+        corrupt("identificador de formato incorrecto");
+    }
+    if (h.version != kVersion) {
+        corrupt("versión no soportada " + std::to_string(h.version));
+    }
+    if (h.byte_order != kByteOrderMark) {
+        corrupt("orden de bytes distinto al de esta máquina");
+    }
+    if (h.header_crc != header_checksum(h)) {
+        corrupt("cabecera dañada");
+    }
+    if (h.num_vertices > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+        corrupt("demasiados vértices");
+    }
+    const bool has_names = (h.flags & kFlagNames) != 0;
+    for (const Section *s : {&h.offsets, &h.targets, &h.weights, &h.names}) {
+        if (s->pos % kAlignment != 0 || s->pos > size || s->bytes > size - s->pos) {
+            corrupt("sección fuera del archivo");
+        }
+    }
+    // Cotas previas a cualquier producto: cada vértice ocupa al menos un
+    // byte de desplazamientos y cada arista un double, así que los tamaños
+    // calculados abajo no desbordan.
+    if (h.num_vertices > h.offsets.bytes) {
+        corrupt("demasiados vértices para la sección de desplazamientos");
+    }
+    if (h.num_edges > size / sizeof(double)) {
+        corrupt("demasiadas aristas para el tamaño del archivo");
+    }
+    const std::size_t n = static_cast<std::size_t>(h.num_vertices);
+    const std::size_t m = static_cast<std::size_t>(h.num_edges);
+    if (h.targets.bytes != m * sizeof(int) || h.weights.bytes != m * sizeof(double)) {
+        corrupt("tamaño de sección incoherente");
+    }
+    if (options.verify_checksums && (h.flags & kFlagChecksums)) {
+        for (const Section *s : {&h.offsets, &h.targets, &h.weights, &h.names}) {
+            if (s->bytes > 0 && crc32(base + s->pos, s->bytes) != s->crc) {
+                corrupt("suma de comprobación incorrecta");
+            }
+        }
+    }
+
+    Snapshot out;
+    ArrayView<std::size_t> offsets;
+    const unsigned char *off = base + h.offsets.pos;
+    switch (static_cast<OffsetEncoding>(h.offset_encoding)) {
+    case OffsetEncoding::Raw64:
+        if (h.offsets.bytes != (n + 1) * sizeof(std::uint64_t)) {
+            corrupt("tamaño de desplazamientos incoherente");
+        }
+        if (sizeof(std::size_t) == sizeof(std::uint64_t)) {
+            offsets = {reinterpret_cast<const std::size_t *>(off), n + 1};
+            out.zero_copy_offsets = true;
+        } else {
+            storage->decoded_offsets.resize(n + 1);
+            for (std::size_t i = 0; i <= n; ++i) {
+                std::uint64_t x;
+                std::memcpy(&x, off + i * sizeof(x), sizeof(x));
+                storage->decoded_offsets[i] = static_cast<std::size_t>(x);
+            }
+        }
+        break;
+    case OffsetEncoding::Raw32: {
+        if (h.offsets.bytes != (n + 1) * sizeof(std::uint32_t)) {
+            corrupt("tamaño de desplazamientos incoherente");
+        }
+        const auto *raw = reinterpret_cast<const std::uint32_t *>(off);
+        storage->decoded_offsets.assign(raw, raw + n + 1);
+        break;
+    }
+    case OffsetEncoding::VarintDegrees: {
+        storage->decoded_offsets.resize(n + 1);
+        storage->decoded_offsets[0] = 0;
+        std::size_t p = 0;
+        for (std::size_t u = 0; u < n; ++u) {
+            std::uint64_t deg = 0;
+            for (int shift = 0;; shift += 7) {
+                if (p >= h.offsets.bytes || shift > 63) {
+                    corrupt("grados varint truncados");
+                }
+                unsigned char byte = off[p++];
+                deg |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+                    break;
+                }
+            }
+            storage->decoded_offsets[u + 1] = storage->decoded_offsets[u] + deg;
+        }
+        break;
+    }
+    default:
+        corrupt("codificación de desplazamientos desconocida");
+    }
+    if (!out.zero_copy_offsets) {
+        offsets = {storage->decoded_offsets.data(), storage->decoded_offsets.size()};
+    }
+    if (offsets[0] != 0 || offsets[n] != m) {
+        corrupt("los desplazamientos no cubren todas las aristas");
+    }
+
+    ArrayView<int> targets(reinterpret_cast<const int *>(base + h.targets.pos), m);
+    ArrayView<double> weights(reinterpret_cast<const double *>(base + h.weights.pos), m);
+    if (options.load_names && has_names) {
+        const char *p = reinterpret_cast<const char *>(base + h.names.pos);
+        const char *end = p + h.names.bytes;
+        out.names.reserve(n);
+        while (p < end) {
+            const char *z = static_cast<const char *>(std::memchr(p, '\0', end - p));
+            if (!z) {
+                corrupt("tabla de nombres truncada");
+            }
+            out.names.emplace_back(p, z);
+            p = z + 1;
+        }
+        if (out.names.size() != n) {
+            corrupt("número de nombres incoherente");
+        }
+    }
+    if (options.validate) {
+        try {
+            out.graph = Graph::view(offsets, targets, weights, storage);
+        } catch (const std::invalid_argument &e) {
+            corrupt(e.what());
+        }
+    } else {
+        out.graph = Graph::trusted_view(offsets, targets, weights, storage,
+                                        (h.flags & kFlagNegativeWeights) != 0);
+    }
+    return out;
+}
+
+} // namespace graphs
@@ -0,0 +1,568 @@
+#include "spectral.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include "graph_builder.hpp"
+#include "parallel.hpp"
+
+namespace graphs {
+
+namespace {
+
+// Bloque fijo de filas: unidad de reparto entre hilos.
+constexpr std::size_t kBlock = 4096;
+
+using Column = std::vector<double>;
+using Block = std::vector<Column>;
+// Matriz densa pequeña r x c por filas.
+using Dense = std::vector<double>;
+
+// Ejecuta body(worker, begin, end) por bloques de filas con `workers` hilos
+// (véase block_workers).
+template <class Body>
+void for_each_block(int n, unsigned workers, Body &&body) {
+    const std::size_t blocks = (static_cast<std::size_t>(n) + kBlock - 1) / kBlock;
+    parallel::for_each_index(blocks, workers, 1, [&](unsigned worker, std::size_t b) {
+        const int begin = static_cast<int>(b * kBlock);
+        const int end = static_cast<int>(std::min<std::size_t>(n, (b + 1) * kBlock));
+        body(worker, begin, end);
+    });
+}
+
+unsigned block_workers(int n, unsigned threads) {
+    return parallel::effective_threads((static_cast<std::size_t>(n) + kBlock - 1) / kBlock, threads);
+}
+
+// G = A^T B (a.size() x b.size()) en una sola pasada sobre las filas.
+Dense gram(const Block &a, const Block &b, int n, unsigned threads) {
+    const std::size_t ra = a.size(), rb = b.size();
+    const unsigned workers = block_workers(n, threads);
+    std::vector<Dense> partial(workers, Dense(ra * rb, 0.0));
+    for_each_block(n, workers, [&](unsigned worker, int begin, int end) {
+        Dense &g = partial[worker];
+        for (std::size_t i = 0; i < ra; ++i) {
+            for (std::size_t j = 0; j < rb; ++j) {
+                double acc = 0.0;
+                for (int r = begin; r < end; ++r) {
+                    acc += a[i][r] * b[j][r];
+                }
+                g[i * rb + j] += acc;
+            }
+        }
+    });
+    Dense g(ra * rb, 0.0);
+    for (const Dense &p : partial) {
+        for (std::size_t i = 0; i < g.size(); ++i) {
+            g[i] += p[i];
+        }
+    }
+    return g;
+}
+
+// A * C con C de a.size() x cols (por filas), en una pasada.
+Block combine(const Block &a, const Dense &c, std::size_t cols, int n, unsigned threads) {
+    Block out(cols, Column(n, 0.0));
+    for_each_block(n, block_workers(n, threads), [&](unsigned, int begin, int end) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                const double coef = c[i * cols + j];
+                if (coef == 0.0) {
+                    continue;
+                }
+                for (int r = begin; r < end; ++r) {
+                    out[j][r] += coef * a[i][r];
+                }
+            }
+        }
+    });
+    return out;
+}
+
+// Quita la componente sobre el vector unitario y de cada columna.
+void project_out(const Column &y, Block &cols, int n, unsigned threads) {
+    const Dense dots = gram(Block{y}, cols, n, threads);
+    for_each_block(n, block_workers(n, threads), [&](unsigned, int begin, int end) {
+        for (std::size_t j = 0; j < cols.size(); ++j) {
+            for (int r = begin; r < end; ++r) {
+                cols[j][r] -= dots[j] * y[r];
+            }
+        }
+    });
+}
+
+// Gram–Schmidt en el espacio de coeficientes: devuelve T (k x r, por filas)
+// tal que S T tiene columnas ortonormales, descartando las columnas
+// (casi) dependientes de las anteriores.  g = S^T S.
+Dense orthonormal_coefficients(const Dense &g, std::size_t k, std::size_t &rank) {
+    std::vector<Column> t; // columnas de T
+    for (std::size_t j = 0; j < k; ++j) {
+        Column u(k, 0.0);
+        u[j] = 1.0;
+        // c_i = q_i^T s_j = t_i^T G e_j
+        for (const Column &ti : t) {
+            double c = 0.0;
+            for (std::size_t l = 0; l < k; ++l) {
+                c += ti[l] * g[l * k + j];
+            }
+            for (std::size_t l = 0; l < k; ++l) {
+                u[l] -= c * ti[l];
+            }
+        }
+        double norm2 = 0.0;
+        for (std::size_t a = 0; a < k; ++a) {
+            for (std::size_t b = 0; b < k; ++b) {
+                norm2 += u[a] * g[a * k + b] * u[b];
+            }
+        }
+        if (!(norm2 > 1e-14 * g[j * k + j]) || !(norm2 > 0.0)) {
+            continue;
+        }
+        const double inv = 1.0 / std::sqrt(norm2);
+        for (double &x : u) {
+            x *= inv;
+        }
+        t.push_back(std::move(u));
+    }
+    rank = t.size();
+    Dense out(k * rank);
+    for (std::size_t i = 0; i < k; ++i) {
+        for (std::size_t j = 0; j < rank; ++j) {
+            out[i * rank + j] = t[j][i];
+        }
+    }
+    return out;
+}
+
+// Ortonormaliza S (dos pasadas) y aplica la misma transformación a AS.
+void orthonormalize(Block &s, Block &as, int n, unsigned threads) {
+    for (int pass = 0; pass < 2 && !s.empty(); ++pass) {
+        std::size_t rank = 0;
+        const Dense t = orthonormal_coefficients(gram(s, s, n, threads), s.size(), rank);
+        s = combine(s, t, rank, n, threads);
+        if (!as.empty()) {
+            as = combine(as, t, rank, n, threads);
+        }
+    }
+}
+
+// Autovalores (ascendentes) y vectores propios (columnas de v, por filas) de
+// una matriz simétrica pequeña por el método cíclico de Jacobi.
+void symmetric_eigen(Dense a, std::size_t k, std::vector<double> &values, Dense &vectors) {
+    Dense v(k * k, 0.0);
+    for (std::size_t i = 0; i < k; ++i) {
+        v[i * k + i] = 1.0;
+    }
+    for (int sweep = 0; sweep < 100; ++sweep) {
+        double off = 0.0, diag = 0.0;
+        for (std::size_t i = 0; i < k; ++i) {
+            diag += a[i * k + i] * a[i * k + i];
+            for (std::size_t j = i + 1; j < k; ++j) {
+                off += a[i * k + j] * a[i * k + j];
+            }
+        }
+        if (off <= 1e-30 * diag || off == 0.0) {
+            break;
+        }
+        for (std::size_t p = 0; p < k; ++p) {
+            for (std::size_t q = p + 1; q < k; ++q) {
+                const double apq = a[p * k + q];
+                if (apq == 0.0) {
+                    continue;
+                }
+                const double theta = (a[q * k + q] - a[p * k + p]) / (2.0 * apq);
+                const double t = (theta >= 0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0), s = t * c;
+                for (std::size_t r = 0; r < k; ++r) {
+                    const double arp = a[r * k + p], arq = a[r * k + q];
+                    a[r * k + p] = c * arp - s * arq;
+                    a[r * k + q] = s * arp + c * arq;
+                }
+                for (std::size_t r = 0; r < k; ++r) {
+                    const double apr = a[p * k + r], aqr = a[q * k + r];
+                    a[p * k + r] = c * apr - s * aqr;
+                    a[q * k + r] = s * apr + c * aqr;
+                }
+                for (std::size_t r = 0; r < k; ++r) {
+                    const double vrp = v[r * k + p], vrq = v[r * k + q];
+                    v[r * k + p] = c * vrp - s * vrq;
+                    v[r * k + q] = s * vrp + c * vrq;
+                }
+            }
+        }
+    }
+    std::vector<std::size_t> order(k);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&](std::size_t x, std::size_t y) { return a[x * k + x] < a[y * k + y]; });
+    values.resize(k);
+    vectors.assign(k * k, 0.0);
+    for (std::size_t j = 0; j < k; ++j) {
+        values[j] = a[order[j] * k + order[j]];
+        for (std::size_t i = 0; i < k; ++i) {
+            vectors[i * k + j] = v[i * k + order[j]];
+        }
+    }
+}
+
+// Rayleigh–Ritz sobre S ortonormal: devuelve las m primeras columnas de los
+// vectores de Ritz como coeficientes (k x m) y sus valores.
+Dense rayleigh_ritz(const Block &s, const Block &as, std::size_t m, int n, unsigned threads,
+                    std::vector<double> &theta) {
+    const std::size_t k = s.size();
+    Dense g = gram(s, as, n, threads);
+    for (std::size_t i = 0; i < k; ++i) {
+        for (std::size_t j = i + 1; j < k; ++j) {
+            g[i * k + j] = g[j * k + i] = 0.5 * (g[i * k + j] + g[j * k + i]);
+        }
+    }
+    std::vector<double> values;
+    Dense vectors;
+    symmetric_eigen(std::move(g), k, values, vectors);
+    m = std::min(m, k);
+    Dense c(k * m);
+    for (std::size_t i = 0; i < k; ++i) {
+        for (std::size_t j = 0; j < m; ++j) {
+            c[i * m + j] = vectors[i * k + j];
+        }
+    }
+    theta.assign(values.begin(), values.begin() + m);
+    return c;
+}
+
+Block apply_all(const LaplacianOperator &L, const Block &x) {
+    Block out(x.size());
+    for (std::size_t j = 0; j < x.size(); ++j) {
+        L.apply(x[j], out[j]);
+    }
+    return out;
+}
+
+// Subgrafo de w inducido por los vértices `keep` (ordenados).
+Graph induced(const Graph &w, const std::vector<int> &keep, std::vector<int> &local) {
+    for (std::size_t i = 0; i < keep.size(); ++i) {
+        local[keep[i]] = static_cast<int>(i);
+    }
+    std::vector<std::size_t> offsets(keep.size() + 1, 0);
+    std::vector<int> targets;
+    std::vector<double> weights;
+    for (std::size_t i = 0; i < keep.size(); ++i) {
+        const int u = keep[i];
+        for (std::size_t e = w.edge_begin(u); e < w.edge_end(u); ++e) {
+            const int v = local[w.target(e)];
+            if (v >= 0) {
+                targets.push_back(v);
+                weights.push_back(w.weight(e));
+            }
+        }
+        offsets[i + 1] = targets.size();
+    }
+    for (int u : keep) {
+        local[u] = -1;
+    }
+    return Graph(std::move(offsets), std::move(targets), std::move(weights));
+}
+
+struct Bisection {
+    LaplacianKind kind;
+    const FiedlerOptions &options;
+    std::vector<int> &part;
+    std::vector<int> local;
+
+    // w es el subgrafo de los vértices globales `vertices`; reparte las
+    // partes [first, first + k).
+    void split(const Graph &w, const std::vector<int> &vertices, int first, int k) {
+        const int size = static_cast<int>(vertices.size());
+        if (k == 1) {
+            for (int v : vertices) {
+                part[v] = first;
+            }
+            return;
+        }
+        const int k1 = k / 2, k2 = k - k1;
+        const int left = std::clamp(static_cast<int>(std::lround(double(size) * k1 / k)), k1, size - k2);
+        const FiedlerResult f = fiedler_vector(LaplacianOperator::from_symmetric(w, kind, options.threads), options);
+        std::vector<int> order(size);
+        std::iota(order.begin(), order.end(), 0);
+        std::nth_element(order.begin(), order.begin() + left, order.end(), [&](int a, int b) {
+            return f.vector[a] < f.vector[b] || (f.vector[a] == f.vector[b] && a < b);
+        });
+        std::vector<int> lo(order.begin(), order.begin() + left), hi(order.begin() + left, order.end());
+        std::sort(lo.begin(), lo.end());
+        std::sort(hi.begin(), hi.end());
+        local.assign(size, -1);
+        const Graph wl = induced(w, lo, local);
+        const Graph wh = induced(w, hi, local);
+        std::vector<int> vl(lo.size()), vh(hi.size());
+        for (std::size_t i = 0; i < lo.size(); ++i) {
+            vl[i] = vertices[lo[i]];
+        }
+        for (std::size_t i = 0; i < hi.size(); ++i) {
+            vh[i] = vertices[hi[i]];
+        }
+        split(wl, vl, first, k1);
+        split(wh, vh, first + k1, k2);
+    }
+};
+
+} // namespace
+
+LaplacianOperator::LaplacianOperator(const Graph &g, LaplacianKind kind, unsigned threads) {
+    if (g.has_negative_weights()) {
+        throw std::invalid_argument("La Laplaciana no admite pesos negativos");
+    }
+    BuildOptions opts;
+    opts.symmetrize = true;
+    opts.drop_self_loops = true;
+    opts.threads = threads;
+    const int n = g.num_vertices();
+    std::vector<EdgeRecord> edges;
+    edges.reserve(g.num_edges());
+    for (int u = 0; u < n; ++u) {
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            edges.push_back({u, g.target(e), g.weight(e)});
+        }
+    }
+    // Filas ordenadas por destino: se suman las repeticiones (A + A^T).
+    const Graph sym = build_csr(n, edges, opts);
+    std::vector<std::size_t> offsets(static_cast<std::size_t>(n) + 1, 0);
+    std::vector<int> targets;
+    std::vector<double> weights;
+    targets.reserve(sym.num_edges());
+    weights.reserve(sym.num_edges());
+    for (int u = 0; u < n; ++u) {
+        for (std::size_t e = sym.edge_begin(u); e < sym.edge_end(u); ++e) {
+            if (targets.size() > offsets[u] && targets.back() == sym.target(e)) {
+                weights.back() += sym.weight(e);
+            } else {
+                targets.push_back(sym.target(e));
+                weights.push_back(sym.weight(e));
+            }
+        }
+        offsets[u + 1] = targets.size();
+    }
+    init(Graph(std::move(offsets), std::move(targets), std::move(weights)), kind, threads);
+}
+
+LaplacianOperator LaplacianOperator::from_symmetric(Graph w, LaplacianKind kind, unsigned threads) {
+    if (w.has_negative_weights()) {
+        throw std::invalid_argument("La Laplaciana no admite pesos negativos");
+    }
+    LaplacianOperator L;
+    L.init(std::move(w), kind, threads);
+    return L;
+}
+
+void LaplacianOperator::init(Graph w, LaplacianKind kind, unsigned threads) {
+    w_ = std::move(w);
+    kind_ = kind;
+    threads_ = threads;
+    const int n = w_.num_vertices();
+    degree_.assign(n, 0.0);
+    inv_sqrt_degree_.assign(n, 0.0);
+    for_each_block(n, block_workers(n, threads_), [&](unsigned, int begin, int end) {
+        for (int u = begin; u < end; ++u) {
+            double d = 0.0;
+            for (std::size_t e = w_.edge_begin(u); e < w_.edge_end(u); ++e) {
+                d += w_.weight(e);
+            }
+            degree_[u] = d;
+            inv_sqrt_degree_[u] = d > 0.0 ? 1.0 / std::sqrt(d) : 0.0;
+        }
+    });
+}
+
+void LaplacianOperator::apply(const std::vector<double> &x, std::vector<double> &y) const {
+    const int n = size();
+    if (x.size() != static_cast<std::size_t>(n)) {
+        throw std::invalid_argument("Dimensión del vector incorrecta");
+    }
+    y.resize(n);
+    const bool normalized = kind_ == LaplacianKind::Normalized;
+    for_each_block(n, block_workers(n, threads_), [&](unsigned, int begin, int end) {
+        for (int u = begin; u < end; ++u) {
+            double acc = 0.0;
+            if (normalized) {
+                for (std::size_t e = w_.edge_begin(u); e < w_.edge_end(u); ++e) {
+                    const int v = w_.target(e);
+                    acc += w_.weight(e) * inv_sqrt_degree_[v] * x[v];
+                }
+                y[u] = degree_[u] > 0.0 ? x[u] - inv_sqrt_degree_[u] * acc : 0.0;
+            } else {
+                for (std::size_t e = w_.edge_begin(u); e < w_.edge_end(u); ++e) {
+                    acc += w_.weight(e) * x[w_.target(e)];
+                }
+                y[u] = degree_[u] * x[u] - acc;
+            }
+        }
+    });
+}
+
+double LaplacianOperator::diagonal(int u) const {
+    if (kind_ == LaplacianKind::Normalized) {
+        return degree_[u] > 0.0 ? 1.0 : 0.0;
+    }
+    return degree_[u];
+}
+
+double LaplacianOperator::norm_bound() const {
+    if (kind_ == LaplacianKind::Normalized) {
+        return 2.0;
+    }
+    const double dmax = degree_.empty() ? 0.0 : *std::max_element(degree_.begin(), degree_.end());
+    return dmax > 0.0 ? 2.0 * dmax : 1.0;
+}
+
+std::vector<double> LaplacianOperator::null_vector() const {
+    const int n = size();
+    std::vector<double> y(n, n ? 1.0 / std::sqrt(double(n)) : 0.0);
+    if (kind_ == LaplacianKind::Normalized) {
+        const double total = std::accumulate(degree_.begin(), degree_.end(), 0.0);
+        if (total > 0.0) {
+            for (int u = 0; u < n; ++u) {
+                y[u] = std::sqrt(degree_[u] / total);
+            }
+        }
+    }
+    return y;
+}
+
+FiedlerResult fiedler_vector(const LaplacianOperator &L, const FiedlerOptions &o) {
+    if (!(o.tolerance > 0.0) || o.max_iter < 1 || o.block_size < 1) {
+        throw std::invalid_argument("Tolerancia, iteraciones y bloque deben ser positivos");
+    }
+    const int n = L.size();
+    FiedlerResult out;
+    if (n <= 1) {
+        out.converged = true;
+        return out;
+    }
+    const unsigned threads = block_workers(n, o.threads);
+    const std::size_t m = static_cast<std::size_t>(std::min(o.block_size, n - 1));
+    const double scale = L.norm_bound();
+    const Column y = L.null_vector();
+
+    std::mt19937 rng(o.seed);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    Block x(m, Column(n));
+    for (Column &c : x) {
+        for (double &v : c) {
+            v = uniform(rng);
+        }
+    }
+    project_out(y, x, n, threads);
+    Block none;
+    orthonormalize(x, none, n, threads);
+    Block ax = apply_all(L, x);
+    std::vector<double> theta;
+    {
+        const Dense c = rayleigh_ritz(x, ax, x.size(), n, threads, theta);
+        x = combine(x, c, theta.size(), n, threads);
+        ax = combine(ax, c, theta.size(), n, threads);
+    }
+    Block p, ap;
+
+    for (int it = 0;; ++it) {
+        // Residuos R = AX - X diag(theta) precondicionados con la diagonal.
+        Block w(x.size(), Column(n));
+        std::vector<Dense> norms(block_workers(n, threads), Dense(x.size(), 0.0));
+        for_each_block(n, block_workers(n, threads), [&](unsigned worker, int begin, int end) {
+            for (std::size_t j = 0; j < x.size(); ++j) {
+                for (int r = begin; r < end; ++r) {
+                    const double res = ax[j][r] - theta[j] * x[j][r];
+                    norms[worker][j] += res * res;
+                    const double d = L.diagonal(r);
+                    w[j][r] = d > 0.0 ? res / d : res;
+                }
+            }
+        });
+        double r0 = 0.0;
+        for (const Dense &part : norms) {
+            r0 += part[0];
+        }
+        out.iterations = it;
+        out.residual = std::sqrt(r0) / scale;
+        if (out.residual < o.tolerance) {
+            out.converged = true;
+            break;
+        }
+        if (it == o.max_iter) {
+            break;
+        }
+        project_out(y, w, n, threads);
+        // L y = 0, de modo que AW se calcula tras la proyección.
+        Block aw = apply_all(L, w);
+        Block s(x), as(ax);
+        for (std::size_t j = 0; j < w.size(); ++j) {
+            s.push_back(std::move(w[j]));
+            as.push_back(std::move(aw[j]));
+        }
+        for (std::size_t j = 0; j < p.size(); ++j) {
+            s.push_back(std::move(p[j]));
+            as.push_back(std::move(ap[j]));
+        }
+        orthonormalize(s, as, n, threads);
+        const Dense c = rayleigh_ritz(s, as, m, n, threads, theta);
+        const std::size_t cols = theta.size();
+        x = combine(s, c, cols, n, threads);
+        ax = combine(as, c, cols, n, threads);
+        // Dirección implícita: la parte de los vectores de Ritz fuera de X.
+        Dense cp(c);
+        std::fill(cp.begin(), cp.begin() + std::min(m, s.size()) * cols, 0.0);
+        p = combine(s, cp, cols, n, threads);
+        ap = combine(as, cp, cols, n, threads);
+    }
+
+    out.value = std::max(0.0, theta[0]);
+    out.vector = std::move(x[0]);
+    // Signo canónico: la componente de mayor módulo es positiva.
+    const auto big = std::max_element(out.vector.begin(), out.vector.end(),
+                                      [](double a, double b) { return std::fabs(a) < std::fabs(b); });
+    if (*big < 0.0) {
+        for (double &v : out.vector) {
+            v = -v;
+        }
+    }
+    return out;
+}
+
+double fiedler_value(const Graph &g, const FiedlerOptions &options) {
+    if (g.num_vertices() <= 1) {
+        return 0.0;
+    }
+    return fiedler_vector(LaplacianOperator(g, LaplacianKind::Combinatorial, options.threads), options).value;
+}
+
+SpectralPartition spectral_partition(const Graph &g, int parts, LaplacianKind kind,
+                                     const FiedlerOptions &options) {
+    const int n = g.num_vertices();
+    if (parts < 1 || (n > 0 && parts > n)) {
+        throw std::invalid_argument("Número de partes fuera de rango");
+    }
+    SpectralPartition out;
+    out.part.assign(n, 0);
+    out.parts = n > 0 ? parts : 0;
+    if (n == 0) {
+        return out;
+    }
+    const LaplacianOperator L(g, kind, options.threads);
+    const Graph &w = L.adjacency();
+    std::vector<int> all(n);
+    std::iota(all.begin(), all.end(), 0);
+    Bisection{kind, options, out.part, {}}.split(w, all, 0, parts);
+    double cut = 0.0;
+    for (int u = 0; u < n; ++u) {
+        for (std::size_t e = w.edge_begin(u); e < w.edge_end(u); ++e) {
+            if (out.part[u] != out.part[w.target(e)]) {
+                cut += w.weight(e);
+            }
+        }
+    }
+    out.cut_weight = cut / 2.0;
+    return out;
+}
+
+} // namespace graphs
@@ -0,0 +1,508 @@
+#include "state_space.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include "parallel.hpp"
+
+namespace graphs {
+
+namespace {
+
+constexpr unsigned kShardBits = 8;
+constexpr std::size_t kShards = std::size_t(1) << kShardBits;
+constexpr std::size_t kFrontierGrain = 64;
+constexpr std::uint64_t kFingerprintSeed = 0x6a09e667f3bcc909ull;
+
+std::uint64_t mix(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+std::size_t shard_of(std::uint64_t h) {
+    return static_cast<std::size_t>(h >> (64 - kShardBits));
+}
+
+// Conjunto exacto: estados completos y predecesor en cada partición.  El
+// identificador global de un estado es local * kShards + partición.
+class ExactStore {
+public:
+    static constexpr std::uint64_t kNoParent = std::numeric_limits<std::uint64_t>::max();
+
+    explicit ExactStore(std::size_t words) : words_(words), shards_(kShards) {}
+
+    // Inserta el estado; devuelve falso si ya estaba.  `id` recibe su identificador.
+    bool insert(const StateWord *s, std::uint64_t parent, std::uint64_t &id) {
+        const std::uint64_t h = hash_state(s, words_);
+        const std::size_t k = shard_of(h);
+        Shard &shard = shards_[k];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if ((shard.count + 1) * 2 > shard.slots.size()) {
+            grow(shard);
+        }
+        const std::uint64_t tag = (h >> 24) & 0xffffffffu;
+        const std::size_t mask = shard.slots.size() - 1;
+        for (std::size_t i = h & mask;; i = (i + 1) & mask) {
+            const std::uint64_t slot = shard.slots[i];
+            if (slot == 0) {
+                if (shard.count >= 0xffffffffu - 1) {
+                    throw std::runtime_error("Demasiados estados en una partición del conjunto de visitados");
+                }
+                const std::uint64_t local = shard.count++;
+                shard.slots[i] = (tag << 32) | (local + 1);
+                shard.states.insert(shard.states.end(), s, s + words_);
+                shard.parents.push_back(parent);
+                id = local * kShards + k;
+                return true;
+            }
+            const std::uint64_t local = (slot & 0xffffffffu) - 1;
+            if ((slot >> 32) == tag && std::equal(s, s + words_, shard.states.data() + local * words_)) {
+                id = local * kShards + k;
+                return false;
+            }
+        }
+    }
+
+    const StateWord *state(std::uint64_t id) const {
+        return shards_[id % kShards].states.data() + (id / kShards) * words_;
+    }
+    std::uint64_t parent(std::uint64_t id) const { return shards_[id % kShards].parents[id / kShards]; }
+
+    std::size_t memory_bytes() const {
+        std::size_t bytes = 0;
+        for (const Shard &s : shards_) {
+            bytes += 8 * (s.slots.capacity() + s.states.capacity() + s.parents.capacity());
+        }
+        return bytes;
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        // 0 = libre; si no, (etiqueta de 32 bits << 32) | (índice local + 1).
+        std::vector<std::uint64_t> slots;
+        std::vector<StateWord> states;
+        std::vector<std::uint64_t> parents;
+        std::size_t count = 0;
+    };
+
+    void grow(Shard &shard) {
+        std::vector<std::uint64_t> slots(std::max<std::size_t>(64, 2 * shard.slots.size()), 0);
+        const std::size_t mask = slots.size() - 1;
+        for (std::size_t local = 0; local < shard.count; ++local) {
+            const std::uint64_t h = hash_state(shard.states.data() + local * words_, words_);
+            std::size_t i = h & mask;
+            while (slots[i] != 0) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = (((h >> 24) & 0xffffffffu) << 32) | (local + 1);
+        }
+        shard.slots.swap(slots);
+    }
+
+    std::size_t words_;
+    std::vector<Shard> shards_;
+};
+
+// Compactación de hash: huella de 64 bits (nunca 0) y la del predecesor.
+class CompactStore {
+public:
+    static constexpr std::uint64_t kNoParent = 0;
+
+    explicit CompactStore(std::size_t words) : words_(words), shards_(kShards) {}
+
+    std::uint64_t fingerprint(const StateWord *s) const {
+        const std::uint64_t h = hash_state(s, words_, kFingerprintSeed);
+        return h == 0 ? 1 : h;
+    }
+
+    bool insert(const StateWord *s, std::uint64_t parent, std::uint64_t &id) {
+        id = fingerprint(s);
+        Shard &shard = shards_[shard_of(id)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if ((shard.count + 1) * 2 > shard.keys.size()) {
+            grow(shard);
+        }
+        const std::size_t i = find(shard, id);
+        if (shard.keys[i] == id) {
+            return false;
+        }
+        shard.keys[i] = id;
+        shard.parents[i] = parent;
+        ++shard.count;
+        return true;
+    }
+
+    // Huella del predecesor de la huella fp (ya insertada).
+    std::uint64_t parent(std::uint64_t fp) const {
+        const Shard &shard = shards_[shard_of(fp)];
+        return shard.parents[find(shard, fp)];
+    }
+
+    std::size_t memory_bytes() const {
+        std::size_t bytes = 0;
+        for (const Shard &s : shards_) {
+            bytes += 8 * (s.keys.capacity() + s.parents.capacity());
+        }
+        return bytes;
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::vector<std::uint64_t> keys;
+        std::vector<std::uint64_t> parents;
+        std::size_t count = 0;
+    };
+
+    // Posición de fp o del hueco libre donde iría.
+    static std::size_t find(const Shard &shard, std::uint64_t fp) {
+        const std::size_t mask = shard.keys.size() - 1;
+        std::size_t i = fp & mask;
+        while (shard.keys[i] != 0 && shard.keys[i] != fp) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    static void grow(Shard &shard) {
+        Shard bigger;
+        bigger.keys.assign(std::max<std::size_t>(64, 2 * shard.keys.size()), 0);
+        bigger.parents.assign(bigger.keys.size(), 0);
+        for (std::size_t i = 0; i < shard.keys.size(); ++i) {
+            if (shard.keys[i] != 0) {
+                const std::size_t j = find(bigger, shard.keys[i]);
+                bigger.keys[j] = shard.keys[i];
+                bigger.parents[j] = shard.parents[i];
+            }
+        }
+        shard.keys.swap(bigger.keys);
+        shard.parents.swap(bigger.parents);
+    }
+
+    std::size_t words_;
+    std::vector<Shard> shards_;
+};
+
+// Supertraza: un estado es nuevo si alguno de sus k bits estaba a cero.
+class BitStore {
+public:
+    static constexpr std::uint64_t kNoParent = 0;
+
+    BitStore(std::size_t words, unsigned log2_bits, unsigned hashes)
+        : words_(words), hashes_(std::max(1u, hashes)), mask_((std::uint64_t(1) << checked(log2_bits)) - 1),
+          bits_(std::size_t(1) << (log2_bits - 6)) {}
+
+    bool insert(const StateWord *s, std::uint64_t, std::uint64_t &id) {
+        const std::uint64_t h1 = hash_state(s, words_);
+        const std::uint64_t h2 = mix(h1) | 1;
+        bool fresh = false;
+        std::size_t set = 0;
+        for (unsigned i = 0; i < hashes_; ++i) {
+            const std::uint64_t bit = (h1 + i * h2) & mask_;
+            const std::uint64_t m = std::uint64_t(1) << (bit % 64);
+            if (!(bits_[bit / 64].fetch_or(m, std::memory_order_relaxed) & m)) {
+                fresh = true;
+                ++set;
+            }
+        }
+        set_bits_.fetch_add(set, std::memory_order_relaxed);
+        id = 0;
+        return fresh;
+    }
+
+    // Probabilidad de que un estado nuevo encuentre ya puestos sus k bits.
+    double omission_estimate() const {
+        const double fill = double(set_bits_.load()) / double(mask_ + 1);
+        return std::pow(fill, hashes_);
+    }
+
+    std::size_t memory_bytes() const { return 8 * bits_.size(); }
+
+private:
+    static unsigned checked(unsigned log2_bits) {
+        if (log2_bits < 6 || log2_bits > 40) {
+            throw std::invalid_argument("bitstate_log2 fuera de [6, 40]");
+        }
+        return log2_bits;
+    }
+
+    std::size_t words_;
+    unsigned hashes_;
+    std::uint64_t mask_;
+    std::vector<std::atomic<std::uint64_t>> bits_;
+    std::atomic<std::size_t> set_bits_{0};
+};
+
+// Busca entre los sucesores de `from` (o los iniciales si from es nulo) el
+// primero que cumple match(s); devuelve su índice en el sumidero o -1.
+template <class Match>
+long find_successor(const TransitionSystem &system, const StateWord *from, SuccessorSink &sink, Match match) {
+    sink.clear();
+    if (from) {
+        system.successors(from, sink);
+    } else {
+        system.initial_states(sink);
+    }
+    for (std::size_t j = 0; j < sink.size(); ++j) {
+        if (match(sink.state(j))) {
+            return static_cast<long>(j);
+        }
+    }
+    return -1;
+}
+
+// Completa las acciones de una traza de estados conocidos.
+void label_actions(const TransitionSystem &system, Trace &trace) {
+    const std::size_t words = system.state_words();
+    SuccessorSink sink(words);
+    trace.actions.clear();
+    for (std::size_t i = 0; i + 1 < trace.states.size(); ++i) {
+        const StateWord *next = trace.states[i + 1].data();
+        const long j = find_successor(system, trace.states[i].data(), sink,
+                                      [&](const StateWord *s) { return std::equal(s, s + words, next); });
+        trace.actions.push_back(j < 0 ? -1 : sink.action(j));
+    }
+}
+
+Trace exact_trace(const TransitionSystem &system, const ExactStore &store, std::uint64_t id) {
+    const std::size_t words = system.state_words();
+    Trace trace;
+    for (; id != ExactStore::kNoParent; id = store.parent(id)) {
+        const StateWord *s = store.state(id);
+        trace.states.emplace_back(s, s + words);
+    }
+    std::reverse(trace.states.begin(), trace.states.end());
+    label_actions(system, trace);
+    return trace;
+}
+
+// Reproduce la cadena de huellas desde los estados iniciales.
+Trace compact_trace(const TransitionSystem &system, const CompactStore &store, std::uint64_t fp) {
+    std::vector<std::uint64_t> chain;
+    for (; fp != CompactStore::kNoParent; fp = store.parent(fp)) {
+        chain.push_back(fp);
+    }
+    std::reverse(chain.begin(), chain.end());
+    const std::size_t words = system.state_words();
+    SuccessorSink sink(words);
+    Trace trace;
+    const StateWord *from = nullptr;
+    for (std::uint64_t want : chain) {
+        const long j = find_successor(system, from, sink,
+                                      [&](const StateWord *s) { return store.fingerprint(s) == want; });
+        if (j < 0) {
+            throw std::runtime_error("No se pudo reproducir la traza (sucesores no deterministas)");
+        }
+        if (from) {
+            trace.actions.push_back(sink.action(j));
+        }
+        trace.states.emplace_back(sink.state(j), sink.state(j) + words);
+        from = trace.states.back().data();
+    }
+    return trace;
+}
+
+struct Frontier {
+    std::vector<StateWord> states;
+    std::vector<std::uint64_t> ids;
+
+    void clear() {
+        states.clear();
+        ids.clear();
+    }
+};
+
+// BFS por niveles común a los tres conjuntos.  Devuelve el identificador del
+// estado que viola el invariante en `bad` (si violated).
+template <class Store>
+ExploreResult run(const TransitionSystem &system, const StatePredicate &invariant,
+                  const ExploreOptions &options, Store &store, std::uint64_t &bad) {
+    const std::size_t words = system.state_words();
+    ExploreResult result;
+    std::atomic<std::size_t> stored{0};
+    std::atomic<bool> stop{false};
+    std::atomic<bool> limited{false};
+    std::mutex bad_mutex;
+    bool found = false;
+
+    auto record_violation = [&](std::uint64_t id) {
+        std::lock_guard<std::mutex> lock(bad_mutex);
+        if (!found) {
+            found = true;
+            bad = id;
+        }
+        stop.store(true, std::memory_order_relaxed);
+    };
+    // Inserta un sucesor; lo añade a `next` si es nuevo y correcto.
+    auto admit = [&](const StateWord *s, std::uint64_t parent, Frontier &next) {
+        std::uint64_t id;
+        if (!store.insert(s, parent, id)) {
+            return;
+        }
+        const std::size_t count = stored.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (invariant && !invariant(s)) {
+            record_violation(id);
+            return;
+        }
+        if (options.max_states && count >= options.max_states) {
+            limited.store(true, std::memory_order_relaxed);
+            stop.store(true, std::memory_order_relaxed);
+        }
+        next.states.insert(next.states.end(), s, s + words);
+        next.ids.push_back(id);
+    };
+
+    Frontier frontier;
+    {
+        SuccessorSink init(words);
+        system.initial_states(init);
+        for (std::size_t j = 0; j < init.size() && !stop; ++j) {
+            admit(init.state(j), Store::kNoParent, frontier);
+        }
+    }
+
+    std::vector<std::size_t> transitions;
+    while (!stop && !frontier.ids.empty()) {
+        if (options.max_depth >= 0 && result.depth >= options.max_depth) {
+            limited = true;
+            break;
+        }
+        const std::size_t count = frontier.ids.size();
+        const unsigned threads = parallel::effective_threads(count, options.threads, kFrontierGrain);
+        std::vector<Frontier> next(threads);
+        std::vector<SuccessorSink> sinks(threads, SuccessorSink(words));
+        transitions.assign(threads, 0);
+        parallel::for_each_index(count, threads, kFrontierGrain, [&](unsigned worker, std::size_t i) {
+            if (stop.load(std::memory_order_relaxed)) {
+                return;
+            }
+            SuccessorSink &sink = sinks[worker];
+            sink.clear();
+            system.successors(frontier.states.data() + i * words, sink);
+            transitions[worker] += sink.size();
+            for (std::size_t j = 0; j < sink.size(); ++j) {
+                admit(sink.state(j), frontier.ids[i], next[worker]);
+            }
+        });
+        ++result.depth;
+        for (std::size_t t : transitions) {
+            result.transitions += t;
+        }
+        frontier.clear();
+        for (const Frontier &f : next) {
+            frontier.states.insert(frontier.states.end(), f.states.begin(), f.states.end());
+            frontier.ids.insert(frontier.ids.end(), f.ids.begin(), f.ids.end());
+        }
+    }
+
+    result.states = stored.load();
+    result.violated = found;
+    result.violation_depth = found ? result.depth : -1;
+    result.complete = !found && !limited && frontier.ids.empty();
+    result.memory_bytes = store.memory_bytes();
+    return result;
+}
+
+} // namespace
+
+BitField BitLayout::add(unsigned width) {
+    if (width == 0 || width > 64) {
+        throw std::invalid_argument("Ancho de campo fuera de [1, 64]");
+    }
+    BitField f{bits_, width};
+    bits_ += width;
+    return f;
+}
+
+StateWord *SuccessorSink::push(int action) {
+    actions_.push_back(action);
+    data_.resize(data_.size() + words_, 0);
+    return data_.data() + data_.size() - words_;
+}
+
+StateWord *SuccessorSink::push_copy(const StateWord *from, int action) {
+    StateWord *s = push(action);
+    std::copy(from, from + words_, s);
+    return s;
+}
+
+void GraphSystem::initial_states(SuccessorSink &out) const {
+    for (int v : initial_) {
+        if (v < 0 || v >= g_.num_vertices()) {
+            throw std::out_of_range("Estado inicial fuera de rango");
+        }
+        *out.push() = static_cast<StateWord>(v);
+    }
+}
+
+void GraphSystem::successors(const StateWord *state, SuccessorSink &out) const {
+    const int u = static_cast<int>(*state);
+    for (std::size_t e = g_.edge_begin(u); e < g_.edge_end(u); ++e) {
+        *out.push(static_cast<int>(e)) = static_cast<StateWord>(g_.target(e));
+    }
+}
+
+std::uint64_t hash_state(const StateWord *state, std::size_t words, std::uint64_t seed) {
+    std::uint64_t h = mix(seed ^ words);
+    for (std::size_t i = 0; i < words; ++i) {
+        h = mix(h ^ state[i]);
+    }
+    return h;
+}
+
+ExploreResult explore(const TransitionSystem &system, const StatePredicate &invariant,
+                      const ExploreOptions &options) {
+    const std::size_t words = system.state_words();
+    if (words == 0) {
+        throw std::invalid_argument("Estados de cero palabras");
+    }
+    std::uint64_t bad = 0;
+    switch (options.mode) {
+    case VisitedMode::Exact: {
+        ExactStore store(words);
+        ExploreResult r = run(system, invariant, options, store, bad);
+        if (r.violated && options.trace) {
+            r.counterexample = exact_trace(system, store, bad);
+        }
+        return r;
+    }
+    case VisitedMode::HashCompaction: {
+        CompactStore store(words);
+        ExploreResult r = run(system, invariant, options, store, bad);
+        const double n = static_cast<double>(r.states);
+        r.omission_estimate = std::min(1.0, n * n / 36893488147419103232.0);  // n^2 / 2^65
+        if (r.violated && options.trace) {
+            r.counterexample = compact_trace(system, store, bad);
+        }
+        return r;
+    }
+    case VisitedMode::Bitstate: {
+        ExploreResult r;
+        {
+            BitStore store(words, options.bitstate_log2, options.bitstate_hashes);
+            r = run(system, invariant, options, store, bad);
+            r.omission_estimate = store.omission_estimate();
+        }
+        if (r.violated && options.trace) {
+            // Segunda pasada con huellas hasta la profundidad del error.
+            ExploreOptions again = options;
+            again.mode = VisitedMode::HashCompaction;
+            again.max_depth = r.violation_depth;
+            again.max_states = 0;
+            r.counterexample = explore(system, invariant, again).counterexample;
+        }
+        return r;
+    }
+    }
+    throw std::invalid_argument("Modo de visitados desconocido");
+}
+
+} // namespace graphs
@@ -0,0 +1,200 @@
+#include "symbolic_fsm.hpp"
+
+#include <stdexcept>
+
+namespace graphs {
+
+SymbolicFsm::SymbolicFsm(BddManager &manager, unsigned state_bits, unsigned input_bits) : manager_(&manager) {
+    for (unsigned i = 0; i < state_bits; ++i) {
+        current_.push_back(manager.new_var());
+        next_.push_back(manager.new_var());
+    }
+    for (unsigned j = 0; j < input_bits; ++j) {
+        inputs_.push_back(manager.new_var());
+    }
+}
+
+Bdd SymbolicFsm::current(unsigned i) const {
+    return manager_->var(current_.at(i));
+}
+
+Bdd SymbolicFsm::next(unsigned i) const {
+    return manager_->var(next_.at(i));
+}
+
+Bdd SymbolicFsm::input(unsigned j) const {
+    return manager_->var(inputs_.at(j));
+}
+
+void SymbolicFsm::set_next(unsigned i, const Bdd &f) {
+    add_constraint(~(next(i) ^ f));
+}
+
+void SymbolicFsm::add_constraint(const Bdd &relation) {
+    if (relation.manager() != manager_) {
+        throw std::invalid_argument("La relación pertenece a otro gestor BDD");
+    }
+    parts_.push_back(relation);
+    scheduled_ = false;
+}
+
+std::vector<unsigned> SymbolicFsm::swap_map() const {
+    std::vector<unsigned> map(manager_->num_vars());
+    for (unsigned v = 0; v < map.size(); ++v) {
+        map[v] = v;
+    }
+    for (std::size_t i = 0; i < current_.size(); ++i) {
+        map[current_[i]] = next_[i];
+        map[next_[i]] = current_[i];
+    }
+    return map;
+}
+
+// Cuantificación temprana: cada variable de `quantified` se elimina tras la
+// última partición que la menciona (o antes de todas si ninguna lo hace).
+const SymbolicFsm::Schedule &SymbolicFsm::schedule(bool forward) {
+    if (!scheduled_) {
+        for (int direction = 0; direction < 2; ++direction) {
+            std::vector<unsigned> quantified = inputs_;
+            const std::vector<unsigned> &own = direction == 0 ? current_ : next_;
+            quantified.insert(quantified.end(), own.begin(), own.end());
+            std::vector<int> last(manager_->num_vars(), -1);
+            for (std::size_t k = 0; k < parts_.size(); ++k) {
+                for (unsigned v : manager_->support(parts_[k])) {
+                    last[v] = static_cast<int>(k);
+                }
+            }
+            std::vector<std::vector<unsigned>> after(parts_.size());
+            std::vector<unsigned> before;
+            for (unsigned v : quantified) {
+                (last[v] < 0 ? before : after[last[v]]).push_back(v);
+            }
+            Schedule &s = direction == 0 ? forward_ : backward_;
+            s.before = manager_->cube(before);
+            s.after.clear();
+            for (const auto &vars : after) {
+                s.after.push_back(manager_->cube(vars));
+            }
+        }
+        scheduled_ = true;
+    }
+    return forward ? forward_ : backward_;
+}
+
+Bdd SymbolicFsm::apply(const Bdd &states, const Schedule &schedule) {
+    Bdd r = manager_->exists(states, schedule.before);
+    for (std::size_t k = 0; k < parts_.size() && !r.is_zero(); ++k) {
+        r = manager_->and_exists(r, parts_[k], schedule.after[k]);
+    }
+    return r;
+}
+
+Bdd SymbolicFsm::image(const Bdd &states) {
+    // ∃x, e. S(x) ∧ T(x, e, x') y después x' -> x.
+    return manager_->rename(apply(states, schedule(true)), swap_map());
+}
+
+Bdd SymbolicFsm::preimage(const Bdd &states) {
+    // ∃x', e. S(x') ∧ T(x, e, x').
+    return apply(manager_->rename(states, swap_map()), schedule(false));
+}
+
+Bdd SymbolicFsm::state(const std::vector<bool> &bits) {
+    if (bits.size() != current_.size()) {
+        throw std::invalid_argument("El estado debe tener un valor por bit");
+    }
+    Bdd r = manager_->one();
+    for (std::size_t i = bits.size(); i-- > 0;) {
+        r &= bits[i] ? manager_->var(current_[i]) : manager_->nvar(current_[i]);
+    }
+    return r;
+}
+
+double SymbolicFsm::count(const Bdd &states) const {
+    return manager_->sat_count(states, state_bits());
+}
+
+std::vector<bool> SymbolicFsm::pick_state(const Bdd &states) const {
+    const std::vector<int> a = manager_->pick_one(states);
+    if (a.empty()) {
+        throw std::invalid_argument("Conjunto de estados vacío");
+    }
+    std::vector<bool> bits(current_.size());
+    for (std::size_t i = 0; i < bits.size(); ++i) {
+        bits[i] = a[current_[i]] == 1;
+    }
+    return bits;
+}
+
+std::vector<bool> SymbolicFsm::inputs_between(const std::vector<bool> &from, const std::vector<bool> &to) {
+    Bdd r = state(from) & manager_->rename(state(to), swap_map());
+    for (const Bdd &part : parts_) {
+        r &= part;
+    }
+    const std::vector<int> a = manager_->pick_one(r);
+    if (a.empty()) {
+        return {};
+    }
+    std::vector<bool> bits(inputs_.size());
+    for (std::size_t j = 0; j < bits.size(); ++j) {
+        bits[j] = a[inputs_[j]] == 1;
+    }
+    return bits;
+}
+
+namespace {
+
+ReachResult run(SymbolicFsm &fsm, const Bdd &initial, const Bdd *bad, const ReachOptions &options) {
+    BddManager &m = fsm.manager();
+    ReachResult result;
+    std::vector<Bdd> rings{initial};
+    Bdd reached = initial, frontier = initial;
+    result.frontier_nodes.push_back(m.node_count(frontier));
+    bool hit = bad && !(frontier & *bad).is_zero();
+    while (!hit && !frontier.is_zero() && (options.max_depth < 0 || result.depth < options.max_depth)) {
+        frontier = fsm.image(frontier) & ~reached;
+        if (frontier.is_zero()) {
+            break;
+        }
+        ++result.depth;
+        reached |= frontier;
+        rings.push_back(frontier);
+        result.frontier_nodes.push_back(m.node_count(frontier));
+        hit = bad && !(frontier & *bad).is_zero();
+    }
+    result.complete = !hit && frontier.is_zero();
+    result.reached = reached;
+    result.states = fsm.count(reached);
+    if (!hit) {
+        return result;
+    }
+    result.violated = true;
+    result.violation_depth = result.depth;
+    if (options.trace) {
+        // Hacia atrás por los anillos: cada estado tiene un predecesor en el
+        // anillo anterior porque el recorrido es en anchura.
+        const int d = result.depth;
+        SymbolicTrace &t = result.counterexample;
+        t.states.resize(d + 1);
+        t.states[d] = fsm.pick_state(rings[d] & *bad);
+        for (int k = d - 1; k >= 0; --k) {
+            t.states[k] = fsm.pick_state(fsm.preimage(fsm.state(t.states[k + 1])) & rings[k]);
+        }
+        for (int k = 0; k < d; ++k) {
+            t.inputs.push_back(fsm.inputs_between(t.states[k], t.states[k + 1]));
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+ReachResult reachable(SymbolicFsm &fsm, const Bdd &initial, const ReachOptions &options) {
+    return run(fsm, initial, nullptr, options);
+}
+
+ReachResult check_invariant(SymbolicFsm &fsm, const Bdd &initial, const Bdd &bad, const ReachOptions &options) {
+    return run(fsm, initial, &bad, options);
+}
+
+} // namespace graphs
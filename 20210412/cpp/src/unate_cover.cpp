@@ -0,0 +1,594 @@
+#include "unate_cover.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+#include "parallel.hpp"
+
+namespace graphs {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Bits = std::vector<std::uint64_t>;
+
+constexpr std::uint64_t kInfinity = std::numeric_limits<std::uint64_t>::max();
+
+std::size_t words_for(std::size_t bits) { return (bits + 63) / 64; }
+
+bool test(const std::uint64_t *b, std::size_t i) { return (b[i / 64] >> (i % 64)) & 1; }
+void set_bit(std::uint64_t *b, std::size_t i) { b[i / 64] |= std::uint64_t(1) << (i % 64); }
+void reset_bit(std::uint64_t *b, std::size_t i) { b[i / 64] &= ~(std::uint64_t(1) << (i % 64)); }
+
+std::size_t popcount(std::uint64_t w) { return std::bitset<64>(w).count(); }
+
+std::size_t and_count(const std::uint64_t *a, const std::uint64_t *b, std::size_t words) {
+    std::size_t n = 0;
+    for (std::size_t w = 0; w < words; ++w) {
+        n += popcount(a[w] & b[w]);
+    }
+    return n;
+}
+
+bool is_subset(const std::uint64_t *a, const std::uint64_t *b, std::size_t words) {
+    for (std::size_t w = 0; w < words; ++w) {
+        if (a[w] & ~b[w]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename F> void for_each_bit(const std::uint64_t *b, std::size_t words, F &&f) {
+    for (std::size_t w = 0; w < words; ++w) {
+        for (std::uint64_t rest = b[w]; rest; rest &= rest - 1) {
+            f(w * 64 + static_cast<std::size_t>(__builtin_ctzll(rest)));
+        }
+    }
+}
+
+// Subproblema de la ramificación: filas por cubrir, columnas disponibles y
+// columnas ya elegidas.
+struct Node {
+    Bits rows;
+    Bits cols;
+    std::vector<std::size_t> chosen;
+    std::uint64_t cost = 0;
+};
+
+class Solver {
+public:
+    Solver(const CoverMatrix &matrix, const std::vector<unsigned> &costs, double budget)
+        : costs_(costs), nrows_(matrix.rows()), ncols_(matrix.columns()),
+          row_words_(words_for(nrows_)), col_words_(words_for(ncols_)),
+          deadline_(Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                      std::chrono::duration<double>(std::max(budget, 0.0)))) {
+        // set() admite celdas repetidas: aquí cada lista queda sin duplicados.
+        col_lists_.resize(ncols_);
+        row_lists_.resize(nrows_);
+        for (std::size_t c = 0; c < ncols_; ++c) {
+            auto &list = col_lists_[c];
+            list = matrix.column(c);
+            std::sort(list.begin(), list.end());
+            list.erase(std::unique(list.begin(), list.end()), list.end());
+            for (std::uint32_t r : list) {
+                row_lists_[r].push_back(c);
+            }
+        }
+    }
+
+    std::size_t essentials() const {
+        std::vector<std::size_t> found;
+        for (const auto &list : row_lists_) {
+            if (list.size() == 1) {
+                found.push_back(list[0]);
+            }
+        }
+        std::sort(found.begin(), found.end());
+        return static_cast<std::size_t>(std::unique(found.begin(), found.end()) - found.begin());
+    }
+
+    // Solución voraz que completa `chosen` sin usar columnas fuera de
+    // `allowed`, seguida de la eliminación de columnas redundantes.  Las
+    // filas de `ignored` (dominadas) no hace falta cubrirlas.
+    std::vector<std::size_t> greedy(std::vector<std::size_t> chosen, const std::vector<char> &allowed,
+                                    const std::vector<char> &ignored) const {
+        std::vector<char> covered = ignored;
+        for (std::size_t c : chosen) {
+            for (std::uint32_t r : col_lists_[c]) {
+                covered[r] = 1;
+            }
+        }
+        auto gain = [&](std::size_t c) {
+            std::size_t n = 0;
+            for (std::uint32_t r : col_lists_[c]) {
+                n += !covered[r];
+            }
+            return n;
+        };
+        // Las ganancias sólo bajan: se recalculan al sacar la columna del
+        // montículo y se reinsertan si ya no son la mejor.
+        using Entry = std::pair<double, std::size_t>;
+        std::priority_queue<Entry> heap;
+        for (std::size_t c = 0; c < ncols_; ++c) {
+            if (allowed[c]) {
+                const std::size_t g = gain(c);
+                if (g > 0) {
+                    heap.push({static_cast<double>(g) / cost(c), c});
+                }
+            }
+        }
+        while (!heap.empty()) {
+            const Entry top = heap.top();
+            heap.pop();
+            const std::size_t g = gain(top.second);
+            if (g == 0) {
+                continue;
+            }
+            const double score = static_cast<double>(g) / cost(top.second);
+            if (!heap.empty() && score < heap.top().first) {
+                heap.push({score, top.second});
+                continue;
+            }
+            chosen.push_back(top.second);
+            for (std::uint32_t r : col_lists_[top.second]) {
+                covered[r] = 1;
+            }
+        }
+
+        std::vector<std::size_t> times(nrows_, 0);
+        for (std::size_t c : chosen) {
+            for (std::uint32_t r : col_lists_[c]) {
+                ++times[r];
+            }
+        }
+        std::vector<std::size_t> order = chosen;
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return cost(a) != cost(b) ? cost(a) > cost(b) : a > b;
+        });
+        std::vector<std::size_t> kept;
+        for (std::size_t c : order) {
+            const auto &rows = col_lists_[c];
+            if (std::all_of(rows.begin(), rows.end(), [&](std::uint32_t r) { return ignored[r] || times[r] > 1; })) {
+                for (std::uint32_t r : rows) {
+                    --times[r];
+                }
+            } else {
+                kept.push_back(c);
+            }
+        }
+        std::sort(kept.begin(), kept.end());
+        kept.erase(std::unique(kept.begin(), kept.end()), kept.end());
+        return kept;
+    }
+
+    // Búsqueda exacta sobre la representación densa.  Devuelve false si se
+    // agotó el tiempo (best_ conserva la mejor solución encontrada).
+    bool solve(std::vector<std::size_t> &best, std::uint64_t &best_cost, std::size_t &nodes,
+               std::uint64_t &lower_bound) {
+        row_bits_.assign(nrows_ * col_words_, 0);
+        col_bits_.assign(ncols_ * row_words_, 0);
+        for (std::size_t c = 0; c < ncols_; ++c) {
+            for (std::uint32_t r : col_lists_[c]) {
+                set_bit(&row_bits_[r * col_words_], c);
+                set_bit(&col_bits_[c * row_words_], r);
+            }
+        }
+        live_.assign(std::max(nrows_ * col_words_, ncols_ * row_words_), 0);
+
+        Node root;
+        root.rows.assign(row_words_, 0);
+        root.cols.assign(col_words_, 0);
+        for (std::size_t r = 0; r < nrows_; ++r) {
+            set_bit(root.rows.data(), r);
+        }
+        for (std::size_t c = 0; c < ncols_; ++c) {
+            set_bit(root.cols.data(), c);
+        }
+        best_ = best;
+        best_cost_ = best_cost;
+        if (reduce(root) && !expired_) {
+            if (none(root.rows)) {
+                lower_bound = root.cost;
+                offer(root);
+            } else {
+                lower_bound = root.cost + bound(root);
+                // La voraz sobre la matriz reducida suele mejorar la inicial.
+                std::vector<char> allowed(ncols_, 0), ignored(nrows_, 1);
+                for_each_bit(root.cols.data(), col_words_, [&](std::size_t c) { allowed[c] = 1; });
+                for_each_bit(root.rows.data(), row_words_, [&](std::size_t r) { ignored[r] = 0; });
+                for (std::size_t c : root.chosen) {
+                    for (std::uint32_t r : col_lists_[c]) {
+                        ignored[r] = 0;
+                    }
+                }
+                Node guess;
+                guess.chosen = greedy(root.chosen, allowed, ignored);
+                guess.cost = total(guess.chosen);
+                offer(guess);
+                branch(std::move(root));
+            }
+        }
+        best = best_;
+        best_cost = best_cost_;
+        nodes = nodes_;
+        return !expired_;
+    }
+
+    std::uint64_t cost(std::size_t c) const { return costs_.empty() ? 1 : costs_[c]; }
+
+    std::uint64_t total(const std::vector<std::size_t> &cols) const {
+        std::uint64_t sum = 0;
+        for (std::size_t c : cols) {
+            sum += cost(c);
+        }
+        return sum;
+    }
+
+private:
+    bool expired() {
+        if (!expired_ && Clock::now() >= deadline_) {
+            expired_ = true;
+        }
+        return expired_;
+    }
+
+    static bool none(const Bits &b) {
+        return std::all_of(b.begin(), b.end(), [](std::uint64_t w) { return w == 0; });
+    }
+
+    const std::uint64_t *row(std::size_t r) const { return &row_bits_[r * col_words_]; }
+    const std::uint64_t *col(std::size_t c) const { return &col_bits_[c * row_words_]; }
+
+    void select(Node &node, std::size_t c) const {
+        node.chosen.push_back(c);
+        node.cost += cost(c);
+        reset_bit(node.cols.data(), c);
+        const std::uint64_t *rows = col(c);
+        for (std::size_t w = 0; w < row_words_; ++w) {
+            node.rows[w] &= ~rows[w];
+        }
+    }
+
+    void offer(const Node &node) {
+        if (node.cost < best_cost_) {
+            best_cost_ = node.cost;
+            best_ = node.chosen;
+            std::sort(best_.begin(), best_.end());
+        }
+    }
+
+    // Columnas esenciales y dominancias hasta el punto fijo.  Devuelve false
+    // si alguna fila se queda sin columnas o se agota el tiempo.
+    bool reduce(Node &node) {
+        for (;;) {
+            if (expired()) {
+                return false;
+            }
+            bool changed = false;
+            for (std::size_t r = 0; r < nrows_; ++r) {
+                if (!test(node.rows.data(), r)) {
+                    continue;
+                }
+                const std::size_t n = and_count(row(r), node.cols.data(), col_words_);
+                if (n == 0) {
+                    return false;
+                }
+                if (n == 1) {
+                    std::size_t only = 0;
+                    for (std::size_t w = 0; w < col_words_; ++w) {
+                        const std::uint64_t live = row(r)[w] & node.cols[w];
+                        if (live) {
+                            only = w * 64 + static_cast<std::size_t>(__builtin_ctzll(live));
+                        }
+                    }
+                    select(node, only);
+                    changed = true;
+                }
+            }
+            if (changed) {
+                continue;
+            }
+            if (none(node.rows)) {
+                return true;
+            }
+
+            // Dominancia de filas: si las columnas de a están en b, cubrir a
+            // cubre b y b sobra.
+            std::vector<std::pair<std::size_t, std::size_t>> order;
+            for_each_bit(node.rows.data(), row_words_, [&](std::size_t r) {
+                std::uint64_t *live = &live_[order.size() * col_words_];
+                std::size_t n = 0;
+                for (std::size_t w = 0; w < col_words_; ++w) {
+                    live[w] = row(r)[w] & node.cols[w];
+                    n += popcount(live[w]);
+                }
+                order.push_back({n, r});
+            });
+            std::vector<std::size_t> slot(order.size());
+            for (std::size_t k = 0; k < order.size(); ++k) {
+                slot[k] = k;
+            }
+            std::sort(slot.begin(), slot.end(), [&](std::size_t a, std::size_t b) { return order[a] < order[b]; });
+            for (std::size_t i = 0; i < slot.size(); ++i) {
+                if (expired()) {
+                    return false;
+                }
+                const std::size_t a = slot[i];
+                if (!test(node.rows.data(), order[a].second)) {
+                    continue;
+                }
+                for (std::size_t j = i + 1; j < slot.size(); ++j) {
+                    const std::size_t b = slot[j];
+                    if (test(node.rows.data(), order[b].second) &&
+                        is_subset(&live_[a * col_words_], &live_[b * col_words_], col_words_)) {
+                        reset_bit(node.rows.data(), order[b].second);
+                        changed = true;
+                    }
+                }
+            }
+
+            // Dominancia de columnas: si las filas de a están en las de b y b
+            // no cuesta más, a sobra.  Las columnas sin filas se descartan.
+            order.clear();
+            for_each_bit(node.cols.data(), col_words_, [&](std::size_t c) {
+                std::uint64_t *live = &live_[order.size() * row_words_];
+                std::size_t n = 0;
+                for (std::size_t w = 0; w < row_words_; ++w) {
+                    live[w] = col(c)[w] & node.rows[w];
+                    n += popcount(live[w]);
+                }
+                if (n == 0) {
+                    reset_bit(node.cols.data(), c);
+                    changed = true;
+                    return;
+                }
+                order.push_back({n, c});
+            });
+            slot.resize(order.size());
+            for (std::size_t k = 0; k < order.size(); ++k) {
+                slot[k] = k;
+            }
+            std::sort(slot.begin(), slot.end(), [&](std::size_t a, std::size_t b) {
+                return order[a].first != order[b].first ? order[a].first > order[b].first
+                                                        : cost(order[a].second) < cost(order[b].second);
+            });
+            for (std::size_t i = 0; i < slot.size(); ++i) {
+                if (expired()) {
+                    return false;
+                }
+                const std::size_t a = slot[i];
+                const std::size_t ca = order[a].second;
+                for (std::size_t j = 0; j < i; ++j) {
+                    const std::size_t b = slot[j];
+                    const std::size_t cb = order[b].second;
+                    if (test(node.cols.data(), cb) && cost(cb) <= cost(ca) &&
+                        is_subset(&live_[a * row_words_], &live_[b * row_words_], row_words_)) {
+                        reset_bit(node.cols.data(), ca);
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+            if (!changed) {
+                return true;
+            }
+        }
+    }
+
+    // Filas independientes (sin columnas comunes), de las más cortas a las
+    // más largas: cada una exige al menos su columna más barata.
+    std::uint64_t bound(const Node &node) const {
+        std::vector<std::pair<std::size_t, std::size_t>> order;
+        for_each_bit(node.rows.data(), row_words_, [&](std::size_t r) {
+            order.push_back({and_count(row(r), node.cols.data(), col_words_), r});
+        });
+        std::sort(order.begin(), order.end());
+        Bits used(col_words_, 0);
+        std::uint64_t lb = 0;
+        for (const auto &entry : order) {
+            const std::uint64_t *bits = row(entry.second);
+            bool disjoint = true;
+            for (std::size_t w = 0; w < col_words_ && disjoint; ++w) {
+                disjoint = (bits[w] & node.cols[w] & used[w]) == 0;
+            }
+            if (!disjoint) {
+                continue;
+            }
+            std::uint64_t cheapest = kInfinity;
+            for (std::size_t w = 0; w < col_words_; ++w) {
+                const std::uint64_t live = bits[w] & node.cols[w];
+                used[w] |= live;
+                for (std::uint64_t rest = live; rest; rest &= rest - 1) {
+                    cheapest = std::min(cheapest, cost(w * 64 + static_cast<std::size_t>(__builtin_ctzll(rest))));
+                }
+            }
+            lb += cheapest;
+        }
+        return lb;
+    }
+
+    // Ramifica sobre la fila con menos columnas: la rama i elige su i-ésima
+    // columna y descarta las anteriores.  Cada rama restringe la matriz ya
+    // reducida, cuyo óptimo es el del nodo.
+    void branch(Node node) {
+        ++nodes_;
+        if (!reduce(node)) {
+            return;
+        }
+        if (none(node.rows)) {
+            offer(node);
+            return;
+        }
+        if (node.cost + bound(node) >= best_cost_) {
+            return;
+        }
+        std::size_t pick = 0, fewest = std::numeric_limits<std::size_t>::max();
+        for_each_bit(node.rows.data(), row_words_, [&](std::size_t r) {
+            const std::size_t n = and_count(row(r), node.cols.data(), col_words_);
+            if (n < fewest) {
+                fewest = n;
+                pick = r;
+            }
+        });
+        std::vector<std::size_t> candidates;
+        for (std::size_t w = 0; w < col_words_; ++w) {
+            for (std::uint64_t rest = row(pick)[w] & node.cols[w]; rest; rest &= rest - 1) {
+                candidates.push_back(w * 64 + static_cast<std::size_t>(__builtin_ctzll(rest)));
+            }
+        }
+        std::vector<std::size_t> gain(ncols_, 0);
+        for (std::size_t c : candidates) {
+            gain[c] = and_count(col(c), node.rows.data(), row_words_);
+        }
+        std::sort(candidates.begin(), candidates.end(), [&](std::size_t a, std::size_t b) {
+            return cost(a) != cost(b) ? cost(a) < cost(b) : gain[a] > gain[b];
+        });
+        for (std::size_t c : candidates) {
+            Node child = node;
+            select(child, c);
+            branch(std::move(child));
+            if (expired_) {
+                return;
+            }
+            reset_bit(node.cols.data(), c);
+        }
+    }
+
+    const std::vector<unsigned> &costs_;
+    const std::size_t nrows_, ncols_, row_words_, col_words_;
+    const Clock::time_point deadline_;
+    std::vector<std::vector<std::uint32_t>> col_lists_;
+    std::vector<std::vector<std::size_t>> row_lists_;
+    Bits row_bits_, col_bits_, live_;
+    std::vector<std::size_t> best_;
+    std::uint64_t best_cost_ = kInfinity;
+    std::size_t nodes_ = 0;
+    bool expired_ = false;
+};
+
+} // namespace
+
+CoverMatrix::CoverMatrix(std::size_t rows, std::size_t columns) : rows_(rows), columns_(columns) {
+    if (rows > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("Demasiadas filas en la matriz de cobertura");
+    }
+}
+
+void CoverMatrix::set(std::size_t row, std::size_t column) {
+    if (row >= rows_ || column >= columns_.size()) {
+        throw std::out_of_range("Celda fuera de la matriz de cobertura");
+    }
+    columns_[column].push_back(static_cast<std::uint32_t>(row));
+}
+
+CoverResult solve_cover(const CoverMatrix &matrix, const CoverOptions &options) {
+    if (!options.costs.empty() && options.costs.size() != matrix.columns()) {
+        throw std::invalid_argument("Se esperaba un coste por columna");
+    }
+    std::vector<char> reached(matrix.rows(), 0);
+    for (std::size_t c = 0; c < matrix.columns(); ++c) {
+        for (std::uint32_t r : matrix.column(c)) {
+            reached[r] = 1;
+        }
+    }
+    if (std::find(reached.begin(), reached.end(), 0) != reached.end()) {
+        throw std::invalid_argument("Hay filas que ninguna columna cubre");
+    }
+
+    Solver solver(matrix, options.costs, options.time_budget);
+    CoverResult result;
+    result.essentials = solver.essentials();
+    result.columns =
+        solver.greedy({}, std::vector<char>(matrix.columns(), 1), std::vector<char>(matrix.rows(), 0));
+    result.cost = solver.total(result.columns);
+
+    const std::size_t cells = matrix.rows() * matrix.columns();
+    const bool dense = matrix.columns() == 0 || cells / matrix.columns() == matrix.rows();
+    if (options.time_budget > 0 && dense && cells <= options.max_dense_bits) {
+        result.optimal =
+            solver.solve(result.columns, result.cost, result.nodes, result.lower_bound);
+    }
+    if (result.optimal) {
+        result.lower_bound = result.cost;
+    }
+    return result;
+}
+
+MinimizeResult minimize_cover(const std::vector<std::uint64_t> &minterms,
+                              const std::vector<std::uint64_t> &dont_cares, unsigned num_vars,
+                              const MinimizeOptions &options) {
+    QmOptions qm;
+    qm.threads = options.threads;
+    const std::vector<Cube> primes = prime_implicants(minterms, dont_cares, num_vars, qm);
+
+    std::vector<std::uint64_t> on = minterms;
+    std::sort(on.begin(), on.end());
+    on.erase(std::unique(on.begin(), on.end()), on.end());
+    const std::uint64_t full = num_vars == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << num_vars) - 1;
+
+    // Filas de cada primo: sus puntos buscados entre los mintérminos, o los
+    // mintérminos recorridos si el cubo es más grande que la lista.
+    std::vector<std::vector<std::uint32_t>> covered(primes.size());
+    parallel::for_each_index(primes.size(), options.threads, 64, [&](unsigned, std::size_t i) {
+        const Cube &c = primes[i];
+        const std::uint64_t free = full & ~c.mask;
+        const unsigned dashes = static_cast<unsigned>(std::bitset<64>(free).count());
+        if (dashes >= 63 || (std::uint64_t(1) << dashes) > on.size()) {
+            for (std::size_t r = 0; r < on.size(); ++r) {
+                if (c.covers(on[r])) {
+                    covered[i].push_back(static_cast<std::uint32_t>(r));
+                }
+            }
+            return;
+        }
+        std::uint64_t sub = 0;
+        do {
+            const auto it = std::lower_bound(on.begin(), on.end(), c.value | sub);
+            if (it != on.end() && *it == (c.value | sub)) {
+                covered[i].push_back(static_cast<std::uint32_t>(it - on.begin()));
+            }
+            sub = (sub - free) & free;
+        } while (sub != 0);
+    });
+
+    // Un término pesa más que los literales de cualquier cobertura: una
+    // cobertura óptima es irredundante, así que tiene como mucho
+    // min(|ON|, primos) términos de num_vars literales como máximo.
+    const std::uint64_t term = static_cast<std::uint64_t>(num_vars) * std::min(on.size(), primes.size()) + 1;
+    if (term > std::numeric_limits<unsigned>::max() - num_vars) {
+        throw std::invalid_argument("Demasiados mintérminos para ponderar términos y literales");
+    }
+    CoverMatrix matrix(on.size(), primes.size());
+    CoverOptions cover;
+    cover.time_budget = options.time_budget;
+    for (std::size_t i = 0; i < primes.size(); ++i) {
+        for (std::uint32_t r : covered[i]) {
+            matrix.set(r, i);
+        }
+        cover.costs.push_back(static_cast<unsigned>(term + std::bitset<64>(primes[i].mask).count()));
+    }
+    const CoverResult solved = solve_cover(matrix, cover);
+
+    MinimizeResult result;
+    result.primes = primes.size();
+    result.optimal = solved.optimal;
+    for (std::size_t c : solved.columns) {
+        result.cover.push_back(primes[c]);
+        result.patterns.push_back(cube_to_pattern(primes[c], num_vars));
+    }
+    return result;
+}
+
+std::vector<std::string> minimize_function(const std::vector<std::uint64_t> &minterms, unsigned num_vars,
+                                           const std::vector<std::uint64_t> &dont_cares,
+                                           const MinimizeOptions &options) {
+    return minimize_cover(minterms, dont_cares, num_vars, options).patterns;
+}
+
+} // namespace graphs
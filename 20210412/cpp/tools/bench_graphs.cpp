@@ -0,0 +1,354 @@
+// Banco de rendimiento de los algoritmos de grafos sobre grafos sintéticos.
+//
+// Uso:
+//   bench_graphs [--sizes=1000,10000,100000] [--families=grid2d,grid3d,rmat,geometric,road]
+//                [--algorithms=<subcadena>[,...]] [--threads=N] [--repeat=R] [--seed=S]
+//                [--max-bellman-ford=N] [--out=archivo.json]
+//
+// Para cada familia y tamaño (número aproximado de vértices) genera el grafo
+// con generators.hpp y ejecuta cada variante de caminos mínimos, BFS y
+// centralidad.  Escribe un documento JSON con una entrada por ejecución:
+// el mejor tiempo de `repeat` repeticiones, aristas recorridas por segundo
+// (m por recorrido; m por iteración en las de centralidad; en las búsquedas
+// acotadas, las aristas de los vértices asentados), vértices
+// asentados o alcanzados y el pico de memoria residente del proceso durante
+// la variante (en Linux se reinicia antes de cada una; en otros sistemas es
+// el pico acumulado).  baseline_rss_bytes es la memoria residente al empezar
+// la variante (grafo y copias ya construidos), de modo que la diferencia con
+// el pico es la memoria de trabajo del algoritmo.  Los tiempos sólo son
+// representativos compilando en Release (-DCMAKE_BUILD_TYPE=Release).
+
+#include "bellman_ford.hpp"
+#include "bfs.hpp"
+#include "centrality.hpp"
+#include "compressed_graph.hpp"
+#include "dijkstra.hpp"
+#include "generators.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+const double kPi = std::acos(-1.0);
+
+struct Settings {
+    std::vector<int> sizes = {1000, 10000, 100000};
+    std::vector<std::string> families = {"grid2d", "grid3d", "rmat", "geometric", "road"};
+    std::vector<std::string> algorithms;
+    unsigned threads = 0;
+    int repeat = 3;
+    std::uint64_t seed = 1;
+    int max_bellman_ford = 100000;
+    std::string out;
+};
+
+// Resultado de una ejecución: vértices asentados/alcanzados, iteraciones
+// (1 en los recorridos únicos) y aristas recorridas por iteración.
+struct Run {
+    static constexpr std::size_t kAllEdges = ~std::size_t(0);
+    std::size_t settled = 0;
+    int iterations = 1;
+    std::size_t edges = kAllEdges;
+};
+
+struct Variant {
+    std::string name;
+    std::string category;
+    std::function<Run()> run;
+};
+
+std::vector<std::string> split(const std::string &s) {
+    std::vector<std::string> parts;
+    std::stringstream in(s);
+    for (std::string item; std::getline(in, item, ',');) {
+        if (!item.empty()) {
+            parts.push_back(item);
+        }
+    }
+    return parts;
+}
+
+// Campo de /proc/self/status en bytes (Linux); -1 si no existe.
+long long proc_status(const std::string &key) {
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line);) {
+        if (line.rfind(key + ":", 0) == 0) {
+            return std::stoll(line.substr(key.size() + 1)) * 1024;
+        }
+    }
+#endif
+    (void)key;
+    return -1;
+}
+
+// Pico de memoria residente en bytes (0 si no se puede medir).
+std::size_t peak_memory() {
+    const long long hwm = proc_status("VmHWM");
+    if (hwm >= 0) {
+        return static_cast<std::size_t>(hwm);
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+        return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+    return 0;
+}
+
+// Memoria residente actual en bytes (0 si no se puede medir).
+std::size_t current_memory() {
+    return static_cast<std::size_t>(std::max(0LL, proc_status("VmRSS")));
+}
+
+// Reinicia el pico de memoria residente (Linux >= 4.0); sin efecto en otros sistemas.
+void reset_peak_memory() {
+#if defined(__linux__)
+    std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+
+graphs::Graph make_graph(const std::string &family, int n, const Settings &s) {
+    graphs::GeneratorOptions opts;
+    opts.seed = s.seed;
+    opts.threads = s.threads;
+    opts.min_weight = 1.0;
+    opts.max_weight = 10.0;
+    if (family == "grid2d") {
+        const int side = std::max(1, static_cast<int>(std::lround(std::sqrt(double(n)))));
+        return graphs::grid_2d(side, side, opts);
+    }
+    if (family == "grid3d") {
+        const int side = std::max(1, static_cast<int>(std::lround(std::cbrt(double(n)))));
+        return graphs::grid_3d(side, side, side, opts);
+    }
+    if (family == "rmat") {
+        const int scale = std::max(1, static_cast<int>(std::lround(std::log2(double(n)))));
+        return graphs::rmat(scale, std::size_t(8) << scale, {}, opts);
+    }
+    if (family == "geometric") {
+        return graphs::random_geometric(n, std::sqrt(8.0 / (kPi * n)), opts);
+    }
+    if (family == "road") {
+        const int side = std::max(1, static_cast<int>(std::lround(std::sqrt(double(n)))));
+        return graphs::road_network(side, side, {}, opts);
+    }
+    throw std::invalid_argument("Familia de grafos desconocida: " + family);
+}
+
+// Vértice de mayor grado: origen con región alcanzable no trivial en todas las familias.
+int pick_source(const graphs::Graph &g) {
+    int best = 0;
+    for (int u = 1; u < g.num_vertices(); ++u) {
+        if (g.degree(u) > g.degree(best)) {
+            best = u;
+        }
+    }
+    return best;
+}
+
+template <class D>
+std::size_t count_finite(const std::vector<D> &dist) {
+    return std::count_if(dist.begin(), dist.end(), [](D d) { return !std::isinf(double(d)); });
+}
+
+std::vector<Variant> variants(const graphs::Graph &g, const Settings &s) {
+    const int n = g.num_vertices();
+    const int source = pick_source(g);
+    auto adj = std::make_shared<graphs::AdjList>(n);
+    for (int u = 0; u < n; ++u) {
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            (*adj)[u].push_back({g.target(e), g.weight(e)});
+        }
+    }
+    std::vector<float> narrow(g.weights().begin(), g.weights().end());
+    const graphs::BasicGraph<int, float> gf(g.offsets().to_vector(), g.targets().to_vector(), narrow);
+    graphs::CompressOptions copts;
+    copts.threads = s.threads;
+    auto compressed = std::make_shared<const graphs::CompressedGraph>(g, copts);
+
+    graphs::BfsOptions bfs;
+    bfs.threads = s.threads;
+    bfs.symmetric = false;
+    graphs::BfsOptions top_down = bfs;
+    top_down.alpha = 1e-9;
+    auto engine = std::make_shared<graphs::BfsEngine>(g, bfs);
+    auto engine_top_down = std::make_shared<graphs::BfsEngine>(g, top_down);
+    auto engine_compressed = std::make_shared<graphs::BfsEngine>(*compressed, bfs);
+
+    graphs::RankOptions rank;
+    rank.threads = s.threads;
+    rank.max_iter = 200;
+    auto with = [rank](graphs::RankAcceleration a) {
+        graphs::RankOptions r = rank;
+        r.acceleration = a;
+        return r;
+    };
+    const std::vector<double> personal = graphs::seed_personalization(n, {source});
+    auto ranked = [n](const auto &r) { return Run{static_cast<std::size_t>(n), r.iterations}; };
+
+    std::vector<Variant> out = {
+        {"dijkstra_adjlist", "sssp", [=] { return Run{count_finite(graphs::dijkstra(n, *adj, source))}; }},
+        {"dijkstra_csr", "sssp", [=] { return Run{count_finite(graphs::dijkstra(g, source))}; }},
+        {"dijkstra_csr_f32", "sssp", [=] { return Run{count_finite(graphs::dijkstra(gf, source))}; }},
+        {"dijkstra_compressed", "sssp",
+         [=] { return Run{count_finite(graphs::dijkstra(*compressed, source))}; }},
+        {"dijkstra_tree", "sssp", [=] { return Run{count_finite(graphs::dijkstra_tree(g, source).dist)}; }},
+        {"dijkstra_nearest_1000", "sssp",
+         [=] {
+             graphs::DijkstraWorkspace ws;
+             const graphs::SparseDistances near = graphs::dijkstra_nearest(g, source, 1000, ws);
+             std::size_t edges = 0;
+             for (int v : near.vertices) {
+                 edges += g.degree(v);
+             }
+             return Run{near.size(), 1, edges};
+         }},
+        {"shortest_paths", "sssp", [=] { return Run{count_finite(graphs::shortest_paths(g, source).dist)}; }},
+        {"bfs_direction_optimizing", "bfs", [=] { return Run{engine->hops(source).visited}; }},
+        {"bfs_top_down", "bfs", [=] { return Run{engine_top_down->hops(source).visited}; }},
+        {"bfs_compressed", "bfs", [=] { return Run{engine_compressed->hops(source).visited}; }},
+        {"pagerank", "centrality", [=] { return ranked(graphs::pagerank(g, rank)); }},
+        {"pagerank_gauss_seidel", "centrality",
+         [=] { return ranked(graphs::pagerank(g, with(graphs::RankAcceleration::GaussSeidel))); }},
+        {"pagerank_aitken", "centrality",
+         [=] { return ranked(graphs::pagerank(g, with(graphs::RankAcceleration::Aitken))); }},
+        {"pagerank_f32", "centrality", [=] { return ranked(graphs::pagerank<float>(g, rank)); }},
+        {"pagerank_compressed", "centrality",
+         [=] { return ranked(graphs::pagerank(*compressed, rank)); }},
+        {"personalized_pagerank", "centrality",
+         [=] { return ranked(graphs::personalized_pagerank(g, personal, rank)); }},
+        {"eigenvector_centrality", "centrality", [=] { return ranked(graphs::eigenvector_centrality(g, rank)); }},
+    };
+    // Bellman–Ford cuesta O(V E) en el peor caso: sólo hasta un tamaño.
+    if (n <= s.max_bellman_ford) {
+        out.push_back({"bellman_ford", "sssp",
+                       [=] { return Run{count_finite(graphs::bellman_ford(g, source).tree.dist)}; }});
+    }
+    return out;
+}
+
+bool selected(const std::string &name, const Settings &s) {
+    if (s.algorithms.empty()) {
+        return true;
+    }
+    return std::any_of(s.algorithms.begin(), s.algorithms.end(),
+                       [&](const std::string &a) { return name.find(a) != std::string::npos; });
+}
+
+int usage() {
+    std::cerr << "Uso: bench_graphs [--sizes=1000,10000,100000]"
+                 " [--families=grid2d,grid3d,rmat,geometric,road]\n"
+                 "                  [--algorithms=<subcadena>[,...]] [--threads=N] [--repeat=R]"
+                 " [--seed=S]\n"
+                 "                  [--max-bellman-ford=N] [--out=archivo.json]\n";
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Settings s;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const std::size_t eq = arg.find('=');
+            const std::string key = arg.substr(0, eq);
+            const std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+            if (key == "--sizes") {
+                s.sizes.clear();
+                for (const auto &x : split(value)) {
+                    s.sizes.push_back(std::stoi(x));
+                }
+            } else if (key == "--families") {
+                s.families = split(value);
+            } else if (key == "--algorithms") {
+                s.algorithms = split(value);
+            } else if (key == "--threads") {
+                s.threads = static_cast<unsigned>(std::stoul(value));
+            } else if (key == "--repeat") {
+                s.repeat = std::max(1, std::stoi(value));
+            } else if (key == "--seed") {
+                s.seed = std::stoull(value);
+            } else if (key == "--max-bellman-ford") {
+                s.max_bellman_ford = std::stoi(value);
+            } else if (key == "--out") {
+                s.out = value;
+            } else {
+                return usage();
+            }
+        }
+    } catch (const std::exception &) {
+        return usage();
+    }
+
+    try {
+        std::ostringstream json;
+        json.precision(6);
+        json << "{\n  \"threads\": " << s.threads << ",\n  \"repeat\": " << s.repeat
+             << ",\n  \"seed\": " << s.seed << ",\n  \"results\": [";
+        bool first = true;
+        for (const std::string &family : s.families) {
+            for (int size : s.sizes) {
+                const auto start = std::chrono::steady_clock::now();
+                const graphs::Graph g = make_graph(family, size, s);
+                const double gen = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::cerr << family << " n=" << g.num_vertices() << " m=" << g.num_edges() << " ("
+                          << gen << " s)\n";
+                for (const Variant &v : variants(g, s)) {
+                    if (!selected(v.name, s)) {
+                        continue;
+                    }
+                    reset_peak_memory();
+                    const std::size_t baseline = current_memory();
+                    double best = INFINITY;
+                    Run r;
+                    for (int k = 0; k < s.repeat; ++k) {
+                        const auto t0 = std::chrono::steady_clock::now();
+                        r = v.run();
+                        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+                    }
+                    const double traversed = double(r.edges == Run::kAllEdges ? g.num_edges() : r.edges) * r.iterations;
+                    json << (first ? "\n" : ",\n") << "    {\"family\": \"" << family << "\", \"algorithm\": \""
+                         << v.name << "\", \"category\": \"" << v.category << "\", \"vertices\": "
+                         << g.num_vertices() << ", \"edges\": " << g.num_edges() << ", \"seconds\": " << best
+                         << ", \"edges_per_second\": " << (best > 0 ? traversed / best : 0.0)
+                         << ", \"settled\": " << r.settled << ", \"iterations\": " << r.iterations
+                         << ", \"baseline_rss_bytes\": " << baseline
+                         << ", \"peak_rss_bytes\": " << peak_memory() << "}";
+                    first = false;
+                    std::cerr << "  " << v.name << ": " << best << " s\n";
+                }
+            }
+        }
+        json << "\n  ]\n}\n";
+        if (s.out.empty()) {
+            std::cout << json.str();
+        } else {
+            std::ofstream(s.out) << json.str();
+        }
+        return 0;
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
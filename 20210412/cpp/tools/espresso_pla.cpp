@@ -0,0 +1,61 @@
+// Minimizador de PLA con Espresso (espresso.hpp) para la línea de órdenes.
+//
+// Uso:
+//   espresso_pla [entrada.pla|-] [--threads=N] [--max-iterations=N]
+//
+// Lee el PLA del archivo o de la entrada estándar y escribe por la salida
+// estándar el PLA minimizado (tipo f).  lib/boolean_logic.py lo invoca para
+// minimize_function(method="espresso") y minimize_pla.
+
+#include "espresso.hpp"
+
+#include <iostream>
+#include <string>
+
+namespace {
+
+int usage() {
+    std::cerr << "Uso: espresso_pla [entrada.pla|-] [--threads=N] [--max-iterations=N]\n";
+    return 2;
+}
+
+bool parse_unsigned(const std::string &text, unsigned &out) {
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos || text.size() > 9) {
+        return false;
+    }
+    out = static_cast<unsigned>(std::stoul(text));
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    try {
+        graphs::EspressoOptions options;
+        std::string path = "-";
+        bool have_path = false;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg.rfind("--threads=", 0) == 0) {
+                if (!parse_unsigned(arg.substr(10), options.threads)) {
+                    return usage();
+                }
+            } else if (arg.rfind("--max-iterations=", 0) == 0) {
+                if (!parse_unsigned(arg.substr(17), options.max_iterations)) {
+                    return usage();
+                }
+            } else if (!have_path && (arg == "-" || arg.rfind("--", 0) != 0)) {
+                path = arg;
+                have_path = true;
+            } else {
+                return usage();
+            }
+        }
+        const graphs::Pla pla = path == "-" ? graphs::parse_pla(std::cin) : graphs::load_pla(path);
+        graphs::write_pla(std::cout, graphs::espresso(pla, options));
+        return 0;
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -8,12 +8,19 @@ consenso para eliminar *hazards* estáticos y evaluación de márgenes temporale
 
 Las funciones están diseñadas para su uso en un contexto didáctico. No se
 pretende competir con bibliotecas especializadas y su rendimiento se orienta a
-casos de pocos variables.
+casos de pocos variables.  Para funciones grandes, ``minimize_function`` admite
+``method="espresso"`` y ``minimize_pla`` minimiza ficheros PLA; ambos llaman
+al minimizador nativo de ``cpp/include/espresso.hpp`` a través del ejecutable
+``espresso_pla``.
 """
 
 from __future__ import annotations
 
 import itertools
+import os
+import shutil
+import subprocess
+from pathlib import Path
 from typing import Iterable, List, Set, Tuple, Dict, Optional, Callable
 
 
@@ -78,12 +85,15 @@ def _quine_mccluskey(minterms: Iterable[int], dont_cares: Iterable[int], num_var
             for t in group_terms:
                 if t not in used:
                     prime_implicants.add(t)
-        # normalizar y eliminar duplicados en next_groups
+        # normalizar y eliminar duplicados en next_groups (ya son patrones,
+        # se reagrupan por el número de unos sin volver a convertirlos)
         dedup: Dict[str, None] = {}
         for terms_list in next_groups.values():
             for t in terms_list:
                 dedup[t] = None
-        groups = _group_terms([k for k in dedup.keys()], num_vars) if dedup else {}
+        groups = {}
+        for t in dedup:
+            groups.setdefault(t.count('1'), []).append(t)
     # eliminar implicantes que cubren únicamente don't cares
     filtered = set()
     for implicant in prime_implicants:
@@ -120,17 +130,83 @@ def minimize_function(
         minterms: Iterable de índices donde la función vale 1.
         num_vars: número de variables.
         dont_cares: índices que pueden ser ignorados.
-        method: actualmente solo se implementa `quine_mccluskey`.
+        method: `quine_mccluskey` (todos los implicantes primos) o `espresso`
+            (cobertura prima e irredundante, heurística, para muchas variables;
+            requiere el ejecutable espresso_pla).
 
     Returns:
         Lista de patrones simplificados (p.ej. '1-0-') que representan cada
         implicante primo esencial.
     """
-    if method.lower() != "quine_mccluskey":
+    method = method.lower()
+    if method == "espresso":
+        minterms = sorted(set(minterms))
+        if not minterms:
+            return []
+        dont_cares = sorted(set(dont_cares) - set(minterms))
+        rows = [f"{m:0{num_vars}b} 1" for m in minterms] + [f"{d:0{num_vars}b} -" for d in dont_cares]
+        text = f".i {num_vars}\n.o 1\n.type fd\n" + "\n".join(rows) + "\n.e\n"
+        return _run_espresso(text)[0][1]
+    if method != "quine_mccluskey":
         raise ValueError("Método de minimización no soportado")
     return sorted(_quine_mccluskey(minterms, dont_cares, num_vars))
 
 
+# --- Espresso ---------------------------------------------------------------
+#
+# La minimización la hace el ejecutable nativo espresso_pla (cpp/tools), que
+# recibe y devuelve PLA de Berkeley.
+
+
+def _espresso_command() -> str:
+    """Ruta de espresso_pla: $GLASS_ESPRESSO_PLA, el PATH o un directorio de
+    compilación dentro de cpp/ (p.ej. ``cmake -S cpp -B cpp/build``)."""
+    path = os.environ.get("GLASS_ESPRESSO_PLA") or shutil.which("espresso_pla")
+    if path:
+        return path
+    for candidate in sorted((Path(__file__).resolve().parents[1] / "cpp").glob("*/espresso_pla")):
+        return str(candidate)
+    raise RuntimeError("No se encuentra espresso_pla: compila el objetivo espresso_pla de cpp/ "
+                       "o indica su ruta en GLASS_ESPRESSO_PLA")
+
+
+def _run_espresso(text: str) -> List[Tuple[str, List[str]]]:
+    """Minimiza un PLA con espresso_pla; devuelve (etiqueta, patrones) por salida.
+
+    Lanza ValueError con el mensaje del minimizador si el PLA no es válido.
+    """
+    done = subprocess.run([_espresso_command(), "-"], input=text, capture_output=True,
+                          text=True, check=False)
+    if done.returncode != 0:
+        raise ValueError(done.stderr.strip() or f"espresso_pla terminó con código {done.returncode}")
+    labels: List[str] = []
+    covers: List[List[str]] = []
+    for line in done.stdout.splitlines():
+        fields = line.split()
+        if not fields:
+            continue
+        if fields[0] == ".o":
+            covers = [[] for _ in range(int(fields[1]))]
+        elif fields[0] == ".ob":
+            labels = fields[1:]
+        elif not fields[0].startswith("."):
+            for o, bit in enumerate(fields[1]):
+                if bit == "1":
+                    covers[o].append(fields[0])
+    labels = labels or [f"y{o}" for o in range(len(covers))]
+    return [(label, sorted(cover)) for label, cover in zip(labels, covers)]
+
+
+def minimize_pla(text: str) -> Dict[str, List[str]]:
+    """Minimiza con Espresso cada salida de un PLA de Berkeley.
+
+    Admite .i, .o, .ilb, .ob, .p, .type (f, fd, fr, fdr) y .e.  Devuelve, por
+    etiqueta de salida (y0, y1... si no hay .ob), los patrones de la cobertura
+    ordenados.  Lanza ValueError con el número de línea si el PLA no es válido.
+    """
+    return dict(_run_espresso(text))
+
+
 def pattern_to_expression(pattern: str, variables: List[str]) -> str:
     """Convierte un patrón de bits/guiones en una expresión booleana en suma de productos.
 
@@ -12,8 +12,9 @@ circuito miter.
 from __future__ import annotations
 
 import itertools
+import re
 from collections import deque
-from typing import Dict, Iterable, List, Tuple, Callable
+from typing import Dict, Iterable, List, Optional, Tuple, Callable
 
 
 def bfs_reachability(adj: Dict[str, List[str]], start: str, target: str) -> Tuple[bool, int]:
@@ -91,6 +92,91 @@ def check_equivalence(func1: Callable[..., int], func2: Callable[..., int], num_
     return True
 
 
+_EXPR_TOKEN = re.compile(r"\s*(?:([A-Za-z_][A-Za-z0-9_]*)|([01])|([~!&|^()]))")
+
+
+def _compile_expression(expr: str, variables: List[str]):
+    """Traduce una expresión de pattern_to_expression a código Python sobre enteros.
+
+    Cada variable pasa a ser ``v[i]``; ``~`` sobre enteros de Python es el
+    complemento a dos infinito, así que basta enmascarar el resultado final.
+    """
+    index = {name: i for i, name in enumerate(variables)}
+    parts = []
+    pos = 0
+    expr = expr.rstrip()
+    while pos < len(expr):
+        m = _EXPR_TOKEN.match(expr, pos)
+        if not m:
+            raise ValueError(f"Expresión no válida (posición {pos}): {expr!r}")
+        name, const, op = m.groups()
+        if name is not None:
+            if name not in index:
+                raise ValueError(f"Variable desconocida '{name}' en {expr!r}")
+            parts.append(f"v[{index[name]}]")
+        elif const is not None:
+            parts.append("0" if const == "0" else "(-1)")
+        else:
+            parts.append("~" if op == "!" else op)
+        pos = m.end()
+    try:
+        if not parts:
+            raise SyntaxError
+        return compile(" ".join(parts), "<expresión>", "eval")
+    except SyntaxError:
+        raise ValueError(f"Expresión no válida: {expr!r}") from None
+
+
+def check_expression_equivalence(expr1: str, expr2: str, variables: List[str],
+                                 chunk_bits: int = 16) -> Tuple[bool, Optional[Tuple[int, ...]]]:
+    """Comprueba la equivalencia de dos expresiones por rodajas de bits.
+
+    En lugar de llamar a una función por combinación, cada variable se
+    representa con un entero de ``2**chunk_bits`` bits en el que el bit ``l``
+    es su valor en la combinación ``l`` del trozo; una sola evaluación de la
+    expresión cubre así el trozo entero.  Los trozos se recorren en orden y
+    la búsqueda se detiene en el primero con diferencias.
+
+    Devuelve ``(True, None)`` o ``(False, contraejemplo)``, donde el
+    contraejemplo es la primera combinación distinta en el orden de
+    ``itertools.product`` (la primera variable es el bit más significativo),
+    como en :func:`check_equivalence`.  Las expresiones usan la sintaxis de
+    ``boolean_logic.pattern_to_expression`` (``~``, ``&``, ``^``, ``|``,
+    paréntesis, 0 y 1).  Para circuitos grandes está el motor en C++
+    (``cpp/include/logic_sim.hpp``).
+    """
+    code1 = _compile_expression(expr1, variables)
+    code2 = _compile_expression(expr2, variables)
+    n = len(variables)
+    k = min(n, max(0, chunk_bits))
+    lanes = 1 << k
+    full = (1 << lanes) - 1
+    # Patrones dentro del trozo: la posición p alterna en bloques de 2**p.
+    patterns = []
+    for p in range(k):
+        block = ((1 << (1 << p)) - 1) << (1 << p)
+        pattern = block
+        width = 2 << p
+        while width < lanes:
+            pattern |= pattern << width
+            width <<= 1
+        patterns.append(pattern)
+    for chunk in range(1 << (n - k)):
+        values = []
+        for i in range(n):
+            p = n - 1 - i
+            if p < k:
+                values.append(patterns[p])
+            else:
+                values.append(full if (chunk >> (p - k)) & 1 else 0)
+        env = {"__builtins__": {}, "v": values}
+        diff = (eval(code1, env) ^ eval(code2, env)) & full
+        if diff:
+            index = (chunk << k) | ((diff & -diff).bit_length() - 1)
+            return False, tuple((index >> (n - 1 - i)) & 1 for i in range(n))
+    return True, None
+
+
 def estimated_bfs_complexity(num_states: int, branching_factor: int) -> str:
     """Devuelve una cadena con la complejidad temporal O(b^d) de un BFS.
 
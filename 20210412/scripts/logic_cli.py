@@ -2,10 +2,11 @@
 """
 CLI para las utilidades de lógica y máquinas de estados.
 
-Proporciona comandos para minimizar funciones, obtener formas normales, calcular
-derivadas booleanas, añadir términos de consenso, evaluar márgenes temporales,
-verificar FSM y comparar implementaciones con un miter. Todas las operaciones
-son de sólo lectura salvo que se indique `--confirm`.
+Proporciona comandos para minimizar funciones (también ficheros PLA con
+Espresso), obtener formas normales, calcular derivadas booleanas, añadir
+términos de consenso, evaluar márgenes temporales, verificar FSM y comparar
+implementaciones con un miter. Todas las operaciones son de sólo lectura salvo
+que se indique `--confirm`.
 """
 
 import argparse
@@ -34,6 +35,21 @@ def cmd_minimize(args) -> None:
     print("Forma simplificada:", ' | '.join(f"({e})" for e in expressions))
 
 
+def cmd_pla(args) -> None:
+    text = Path(args.file).read_text(encoding='utf-8')
+    result = bl.minimize_pla(text)
+    header = {}
+    for line in text.splitlines():
+        fields = line.split('#', 1)[0].split()
+        if fields and fields[0] in ('.i', '.ilb'):
+            header[fields[0]] = fields[1:]
+    vars_list = header.get('.ilb') or [f'x{i}' for i in range(int(header['.i'][0]))]
+    for label, patterns in result.items():
+        expressions = [bl.pattern_to_expression(p, vars_list) for p in patterns]
+        print(f"{label}:", patterns)
+        print(f"{label} =", ' | '.join(f"({e})" for e in expressions) if expressions else '0')
+
+
 def cmd_sop(args) -> None:
     minterms = [int(x) for x in args.minterms.split(',')] if args.minterms else []
     vars_list = args.variables.split(',') if args.variables else [f'x{i}' for i in range(args.num_vars)]
@@ -98,6 +114,14 @@ def cmd_miter(args) -> None:
     print("Equivalencia funcional:", equivalent)
 
 
+def cmd_equiv(args) -> None:
+    variables = args.variables.split(',')
+    equivalent, counterexample = fu.check_expression_equivalence(args.expr1, args.expr2, variables)
+    print("Equivalencia funcional:", equivalent)
+    if counterexample is not None:
+        print("Contraejemplo:", ', '.join(f"{v}={b}" for v, b in zip(variables, counterexample)))
+
+
 def cmd_parity(args) -> None:
     bits = [int(b) for b in args.bits.split(',')]
     p = fu.parity_bit(bits)
@@ -122,9 +146,15 @@ def main() -> None:
     p_min.add_argument('--dont-cares', default='', help='Lista de estados no influyentes')
     p_min.add_argument('--num-vars', type=int, required=True, help='Número de variables')
     p_min.add_argument('--variables', default='', help='Nombres de variables separados por coma')
-    p_min.add_argument('--method', default='quine_mccluskey', help='Método de minimización')
+    p_min.add_argument('--method', default='quine_mccluskey',
+                       help='Método de minimización (quine_mccluskey o espresso)')
     p_min.set_defaults(func=cmd_minimize)
 
+    # pla
+    p_pla = subparsers.add_parser('pla', help='Minimiza con Espresso cada salida de un fichero PLA')
+    p_pla.add_argument('file', help='Fichero PLA (.i, .o, .ilb, .ob, .type)')
+    p_pla.set_defaults(func=cmd_pla)
+
     # sum of products
     p_sop = subparsers.add_parser('sop', help='Calcula la forma suma de productos')
     p_sop.add_argument('--minterms', required=True, help='Lista de minterminos separados por coma')
@@ -173,6 +203,13 @@ def main() -> None:
     p_mit.add_argument('--num-vars', type=int, required=True, help='Número de variables')
     p_mit.set_defaults(func=cmd_miter)
 
+    # equivalence of expressions (bit-sliced)
+    p_eq = subparsers.add_parser('equiv', help='Comprueba equivalencia entre dos expresiones por rodajas de bits')
+    p_eq.add_argument('--expr1', required=True, help="Primera expresión (p. ej. 'A & ~B')")
+    p_eq.add_argument('--expr2', required=True, help='Segunda expresión')
+    p_eq.add_argument('--variables', required=True, help='Variables separadas por coma (la primera es el bit más significativo)')
+    p_eq.set_defaults(func=cmd_equiv)
+
     # parity
     p_par = subparsers.add_parser('parity', help='Calcula bit de paridad')
     p_par.add_argument('--bits', required=True, help='Bits separados por coma')
@@ -0,0 +1,233 @@
+#include "bdd.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using graphs::Bdd;
+using graphs::BddManager;
+
+// Expresión aleatoria sobre `vars` variables: el BDD y su evaluación directa.
+struct Expr {
+    Bdd bdd;
+    std::function<bool(const std::vector<bool> &)> eval;
+};
+
+static Expr random_expr(BddManager &m, std::mt19937 &rng, unsigned vars, int depth) {
+    std::uniform_int_distribution<int> pick(0, depth > 0 ? 4 : 0);
+    const int op = pick(rng);
+    if (op == 0) {
+        const unsigned v = std::uniform_int_distribution<unsigned>(0, vars - 1)(rng);
+        return {m.var(v), [v](const std::vector<bool> &a) { return a[v]; }};
+    }
+    Expr a = random_expr(m, rng, vars, depth - 1);
+    if (op == 1) {
+        auto fa = a.eval;
+        return {~a.bdd, [fa](const std::vector<bool> &x) { return !fa(x); }};
+    }
+    Expr b = random_expr(m, rng, vars, depth - 1);
+    auto fa = a.eval, fb = b.eval;
+    if (op == 2) {
+        return {a.bdd & b.bdd, [fa, fb](const std::vector<bool> &x) { return fa(x) && fb(x); }};
+    }
+    if (op == 3) {
+        return {a.bdd | b.bdd, [fa, fb](const std::vector<bool> &x) { return fa(x) || fb(x); }};
+    }
+    return {a.bdd ^ b.bdd, [fa, fb](const std::vector<bool> &x) { return fa(x) != fb(x); }};
+}
+
+static std::vector<bool> bits_of(unsigned mask, unsigned n) {
+    std::vector<bool> a(n);
+    for (unsigned i = 0; i < n; ++i) {
+        a[i] = (mask >> i) & 1;
+    }
+    return a;
+}
+
+int main() {
+    // Identidades y canonicidad.
+    {
+        BddManager m(3);
+        const Bdd x = m.var(0), y = m.var(1), z = m.var(2);
+        assert((x & ~x).is_zero() && (x | ~x).is_one());
+        assert(~(x & y) == (~x | ~y));
+        assert(((x & y) | z) == ((z | y) & (z | x)));
+        assert((x ^ y ^ x) == y);
+        assert(m.ite(x, y, z) == ((x & y) | (~x & z)));
+        assert(m.sat_count(x | y, 3) == 6.0 && m.sat_count(x & y & z, 3) == 1.0);
+        assert(m.node_count(x ^ y ^ z) == 5);
+        assert(m.support((x & z) | (y & ~y)) == (std::vector<unsigned>{0, 2}));
+        const std::vector<int> one = m.pick_one(x & ~y);
+        assert(one[0] == 1 && one[1] == 0 && one[2] == -1);
+        assert(m.pick_one(m.zero()).empty());
+        assert(m.restrict(m.ite(x, y, z), 0, false) == z);
+    }
+
+    // Expresiones aleatorias frente a la tabla de verdad; cuantificadores,
+    // producto relacional y renombrado.
+    {
+        const unsigned n = 8;
+        BddManager m(n);
+        std::mt19937 rng(70);
+        for (int round = 0; round < 40; ++round) {
+            const Expr f = random_expr(m, rng, n, 6);
+            const Expr g = random_expr(m, rng, n, 6);
+            double count = 0;
+            for (unsigned mask = 0; mask < (1u << n); ++mask) {
+                const std::vector<bool> a = bits_of(mask, n);
+                assert(m.eval(f.bdd, a) == f.eval(a));
+                count += f.eval(a);
+            }
+            assert(m.sat_count(f.bdd, n) == count);
+
+            const Bdd c = m.cube({1, 4, 6});
+            assert(m.and_exists(f.bdd, g.bdd, c) == m.exists(f.bdd & g.bdd, c));
+            assert(m.forall(f.bdd, c) == ~m.exists(~f.bdd, c));
+            const Bdd ex = m.exists(f.bdd, c);
+            for (unsigned mask = 0; mask < (1u << n); ++mask) {
+                std::vector<bool> a = bits_of(mask, n);
+                bool any = false;
+                for (unsigned q = 0; q < 8; ++q) {
+                    a[1] = q & 1;
+                    a[4] = q & 2;
+                    a[6] = q & 4;
+                    any = any || f.eval(a);
+                }
+                assert(m.eval(ex, a) == any);
+            }
+
+            // Permutación inversa del orden: f(x) -> f(x_{n-1-i}).
+            std::vector<unsigned> rev(n);
+            for (unsigned i = 0; i < n; ++i) {
+                rev[i] = n - 1 - i;
+            }
+            const Bdd r = m.rename(f.bdd, rev);
+            for (unsigned mask = 0; mask < (1u << n); mask += 7) {
+                std::vector<bool> a = bits_of(mask, n), b(n);
+                for (unsigned i = 0; i < n; ++i) {
+                    b[i] = a[n - 1 - i];
+                }
+                assert(m.eval(r, b) == f.eval(a));
+            }
+            assert(m.rename(r, rev) == f.bdd);
+        }
+    }
+
+    // Sifting: (a0 ∧ b0) ∨ ... con todas las a antes que las b es
+    // exponencial; con los pares juntos es lineal.
+    {
+        const unsigned pairs = 10;
+        BddManager m(2 * pairs);
+        Bdd f = m.zero();
+        for (unsigned i = 0; i < pairs; ++i) {
+            f |= m.var(i) & m.var(pairs + i);
+        }
+        const std::size_t before = m.node_count(f);
+        assert(before == (std::size_t(2) << pairs) - 2);
+        const double count = m.sat_count(f, 2 * pairs);
+        std::mt19937 rng(7);
+        std::vector<std::vector<bool>> samples;
+        std::vector<bool> values;
+        for (int i = 0; i < 200; ++i) {
+            samples.push_back(bits_of(static_cast<unsigned>(rng()), 2 * pairs));
+            values.push_back(m.eval(f, samples.back()));
+        }
+
+        m.reorder();
+        assert(m.node_count(f) == 2 * pairs);
+        assert(m.stats().reorderings == 1);
+        assert(m.sat_count(f, 2 * pairs) == count);
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            assert(m.eval(f, samples[i]) == values[i]);
+        }
+        // Tras reordenar, las operaciones siguen dando diagramas canónicos.
+        Bdd g = m.zero();
+        for (unsigned i = pairs; i-- > 0;) {
+            g |= m.var(pairs + i) & m.var(i);
+        }
+        assert(g == f);
+
+        std::vector<unsigned> original(2 * pairs);
+        for (unsigned v = 0; v < 2 * pairs; ++v) {
+            original[v] = v;
+        }
+        m.set_order(original);
+        assert(m.order() == original && m.node_count(f) == before);
+        assert(m.sat_count(f, 2 * pairs) == count);
+    }
+
+    // Recolección de basura: los temporales se liberan, los manejadores vivos
+    // no; también la automática con un umbral pequeño.
+    {
+        graphs::BddOptions opts;
+        opts.gc_threshold = 256;
+        BddManager m(16, opts);
+        Bdd keep = m.one();
+        for (unsigned i = 0; i < 16; i += 2) {
+            keep &= m.var(i) | m.var(i + 1);
+        }
+        const double count = m.sat_count(keep, 16);
+        std::mt19937 rng(1);
+        for (int round = 0; round < 50; ++round) {
+            random_expr(m, rng, 16, 8);
+        }
+        assert(m.stats().gc_runs > 0);
+        m.collect_garbage();
+        assert(m.stats().live_nodes == m.node_count(keep));
+        assert(m.sat_count(keep, 16) == count);
+    }
+
+    // Reordenación automática.
+    {
+        graphs::BddOptions opts;
+        opts.auto_reorder = true;
+        opts.reorder_threshold = 200;
+        opts.gc_threshold = 200;
+        const unsigned pairs = 12;
+        BddManager m(2 * pairs, opts);
+        Bdd f = m.zero();
+        for (unsigned i = 0; i < pairs; ++i) {
+            f |= m.var(i) & m.var(pairs + i);
+        }
+        assert(m.stats().reorderings > 0);
+        assert(m.node_count(f) < 200);
+        assert(m.sat_count(f, 2 * pairs) == std::ldexp(1.0, 2 * pairs) - std::pow(3.0, pairs));
+    }
+
+    bool threw = false;
+    try {
+        graphs::BddOptions opts;
+        opts.max_nodes = 64;
+        BddManager m(12, opts);
+        Bdd f = m.zero();
+        for (unsigned i = 0; i < 6; ++i) {
+            f |= m.var(i) & m.var(6 + i);
+        }
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        BddManager a(1), b(1);
+        a.ite(a.var(0), b.var(0), a.zero());
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        BddManager m(2);
+        m.set_order({0, 0});
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "BDD: todas las pruebas superadas" << std::endl;
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "bellman_ford.hpp"
+#include "dijkstra.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+int main() {
+    // Grafo con una arista negativa pero sin ciclos negativos
+    // 0 -> 1 (4), 0 -> 2 (5), 1 -> 3 (3), 2 -> 1 (-3), 3 -> 4 (1)
+    graphs::AdjList adj(5);
+    adj[0] = {{1, 4.0}, {2, 5.0}};
+    adj[1] = {{3, 3.0}};
+    adj[2] = {{1, -3.0}};
+    adj[3] = {{4, 1.0}};
+    graphs::Graph g(adj);
+    assert(g.num_vertices() == 5 && g.num_edges() == 5);
+    assert(g.has_negative_weights());
+
+    // Dijkstra rechaza el grafo antes de explorar nada
+    bool thrown = false;
+    try {
+        graphs::dijkstra(g, 0);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    auto bf = graphs::bellman_ford(g, 0);
+    assert(!bf.negative_cycle);
+    assert(std::fabs(bf.tree.dist[1] - 2.0) < 1e-9);
+    assert(std::fabs(bf.tree.dist[4] - 6.0) < 1e-9);
+    auto path = graphs::extract_path(bf.tree, 4);
+    assert((path == std::vector<int>{0, 2, 1, 3, 4}));
+
+    // El despacho automático coincide con Bellman–Ford
+    auto sp = graphs::shortest_paths(g, 0);
+    assert(std::fabs(sp.dist[3] - 5.0) < 1e-9);
+
+    // Sin pesos negativos se usa Dijkstra y los resultados coinciden
+    adj[2] = {{1, 3.0}};
+    graphs::Graph pos(adj);
+    assert(!pos.has_negative_weights());
+    auto sp_pos = graphs::shortest_paths(pos, 0);
+    auto bf_pos = graphs::bellman_ford(pos, 0);
+    for (int v = 0; v < 5; ++v) {
+        assert(std::fabs(sp_pos.dist[v] - bf_pos.tree.dist[v]) < 1e-9);
+    }
+
+    // Ciclo negativo 1 -> 3 -> 1 alcanzable desde 0
+    adj[2] = {{1, -3.0}};
+    adj[3].push_back({1, -4.0});
+    graphs::Graph neg(adj);
+    auto bf_neg = graphs::bellman_ford(neg, 0);
+    assert(bf_neg.negative_cycle);
+    assert(bf_neg.cycle.size() == 2);
+    double cycle_weight = 0.0;
+    for (std::size_t i = 0; i < bf_neg.cycle.size(); ++i) {
+        int u = bf_neg.cycle[i];
+        int v = bf_neg.cycle[(i + 1) % bf_neg.cycle.size()];
+        for (std::size_t e = neg.edge_begin(u); e < neg.edge_end(u); ++e) {
+            if (neg.target(e) == v) {
+                cycle_weight += neg.weight(e);
+            }
+        }
+    }
+    assert(cycle_weight < 0.0);
+    thrown = false;
+    try {
+        graphs::shortest_paths(neg, 0);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Potenciales de Johnson en un grafo grande con aristas negativas: pesos
+    // no negativos desplazados por un potencial aleatorio (sin ciclos
+    // negativos).  Con la comprobación de ciclos en cada mejora de un origen
+    // esto era cuadrático (segundos para 10^4 vértices).
+    {
+        const int n = 20000;
+        std::mt19937 rng(53);
+        std::uniform_real_distribution<double> weight(0.0, 10.0), shift(0.0, 50.0);
+        std::vector<double> p(n);
+        for (double &x : p) {
+            x = shift(rng);
+        }
+        graphs::AdjList big(n);
+        for (int u = 0; u < n; ++u) {
+            for (int k = 0; k < 8; ++k) {
+                const int v = static_cast<int>(rng() % n);
+                big[u].push_back({v, weight(rng) + p[u] - p[v]});
+            }
+        }
+        graphs::Graph gb(big);
+        assert(gb.has_negative_weights());
+        const auto start = std::chrono::steady_clock::now();
+        auto pot = graphs::bellman_ford_potentials(gb);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        assert(!pot.negative_cycle);
+        for (int u = 0; u < n; ++u) {
+            assert(pot.tree.dist[u] <= 0.0);
+            for (std::size_t e = gb.edge_begin(u); e < gb.edge_end(u); ++e) {
+                assert(gb.weight(e) + pot.tree.dist[u] - pot.tree.dist[gb.target(e)] >= -1e-9);
+            }
+        }
+        std::cout << "Potenciales con " << n << " vértices: " << seconds << " s\n";
+        assert(seconds < 1.0);
+
+        // Un ciclo negativo en el grafo grande se sigue detectando.
+        big[0].push_back({1, -1000.0});
+        big[1].push_back({0, -1000.0});
+        auto cyc = graphs::bellman_ford_potentials(graphs::Graph(big));
+        assert(cyc.negative_cycle && !cyc.cycle.empty());
+    }
+
+    // Pesos NaN se rechazan al construir el grafo
+    thrown = false;
+    try {
+        graphs::Graph bad({0, 1, 1}, {1}, {std::nan("")});
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Todas las pruebas de Bellman-Ford se han superado.\n";
+    return 0;
+}
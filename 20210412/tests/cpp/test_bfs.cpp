@@ -0,0 +1,84 @@
+#include "bfs.hpp"
+#include "graph_builder.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <stdexcept>
+
+// BFS de referencia, secuencial y sólo descendente.
+static std::vector<int> reference_hops(const graphs::Graph &g, int source) {
+    std::vector<int> hops(g.num_vertices(), -1);
+    std::queue<int> q;
+    hops[source] = 0;
+    q.push(source);
+    while (!q.empty()) {
+        int u = q.front();
+        q.pop();
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            int v = g.target(e);
+            if (hops[v] < 0) {
+                hops[v] = hops[u] + 1;
+                q.push(v);
+            }
+        }
+    }
+    return hops;
+}
+
+static graphs::Graph random_graph(int n, int m, unsigned seed, bool symmetric) {
+    std::mt19937 rng(seed);
+    std::vector<graphs::EdgeRecord> edges;
+    for (int i = 0; i < m; ++i) {
+        edges.push_back({static_cast<int>(rng() % n), static_cast<int>(rng() % n), 1.0});
+    }
+    graphs::BuildOptions opts;
+    opts.symmetrize = symmetric;
+    return graphs::build_csr(n, edges, opts);
+}
+
+int main() {
+    // Cadena con un vértice aislado
+    graphs::Graph chain(graphs::AdjList{{{1, 1.0}}, {{2, 1.0}}, {}, {}});
+    graphs::BfsEngine small(chain);
+    auto r = small.hops(0);
+    assert((r.hops == std::vector<int>{0, 1, 2, -1}) && r.visited == 3);
+    assert(small.distance(0, 2) == 2 && small.distance(2, 0) == -1 && small.distance(1, 1) == 0);
+    assert(!small.reachable(0, 3));
+    bool threw = false;
+    try {
+        small.hops(4);
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Grafos aleatorios: disperso (descendente) y denso (pasa a ascendente)
+    for (int density : {2, 16}) {
+        for (bool symmetric : {false, true}) {
+            const int n = 20000;
+            graphs::Graph g = random_graph(n, density * n, 60 + density, symmetric);
+            auto ref = reference_hops(g, 0);
+            for (unsigned threads : {1u, 4u}) {
+                graphs::BfsOptions opts;
+                opts.threads = threads;
+                opts.symmetric = symmetric;
+                graphs::BfsEngine engine(g, opts);
+                auto got = engine.hops(0);
+                assert(got.hops == ref);
+                if (density == 16) {
+                    assert(got.bottom_up_levels > 0);
+                }
+                for (int t : {1, 77, 1234, n - 1}) {
+                    assert(engine.distance(0, t) == ref[t]);
+                }
+                // El motor es reutilizable entre consultas
+                assert(engine.hops(5).hops == reference_hops(g, 5));
+            }
+        }
+    }
+
+    std::cout << "BFS: todas las pruebas superadas" << std::endl;
+    return 0;
+}
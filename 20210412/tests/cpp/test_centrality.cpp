@@ -0,0 +1,142 @@
+#include "centrality.hpp"
+#include "graph_builder.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+template <class A, class B>
+static double max_diff(const std::vector<A> &a, const std::vector<B> &b) {
+    double m = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        m = std::max(m, std::fabs(double(a[i]) - double(b[i])));
+    }
+    return m;
+}
+
+// PageRank de referencia: iteración densa directa de la definición.
+static std::vector<double> reference_pagerank(const graphs::Graph &g, double d,
+                                              const std::vector<double> &p) {
+    const int n = g.num_vertices();
+    std::vector<double> x(p), next(n);
+    for (int it = 0; it < 500; ++it) {
+        double dangling = 0.0;
+        for (int u = 0; u < n; ++u) {
+            if (g.degree(u) == 0) {
+                dangling += x[u];
+            }
+        }
+        for (int v = 0; v < n; ++v) {
+            next[v] = (1.0 - d + d * dangling) * p[v];
+        }
+        for (int u = 0; u < n; ++u) {
+            double w = 0.0;
+            for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+                w += g.weight(e);
+            }
+            for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+                next[g.target(e)] += d * x[u] * g.weight(e) / w;
+            }
+        }
+        std::swap(x, next);
+    }
+    return x;
+}
+
+int main() {
+    // Centralidad por vector propio en un grafo no dirigido pequeño (estrella + arista)
+    graphs::Graph star(graphs::AdjList{{{1, 1.0}, {2, 1.0}, {3, 1.0}},
+                                       {{0, 1.0}, {2, 1.0}},
+                                       {{0, 1.0}, {1, 1.0}},
+                                       {{0, 1.0}}});
+    graphs::RankOptions tight;
+    tight.tolerance = 1e-12;
+    tight.max_iter = 1000;
+    auto ev = graphs::eigenvector_centrality(star, tight);
+    assert(ev.converged);
+    assert(std::fabs(std::accumulate(ev.scores.begin(), ev.scores.end(), 0.0) - 1.0) < 1e-12);
+    assert(ev.scores[0] > ev.scores[1] && std::fabs(ev.scores[1] - ev.scores[2]) < 1e-9);
+    assert(ev.scores[3] < ev.scores[1]);
+    // A·x = lambda·x
+    double lambda = 0.0;
+    for (std::size_t e = star.edge_begin(0); e < star.edge_end(0); ++e) {
+        lambda += ev.scores[star.target(e)];
+    }
+    lambda /= ev.scores[0];
+    for (int u = 0; u < 4; ++u) {
+        double ax = 0.0;
+        for (std::size_t e = star.edge_begin(u); e < star.edge_end(u); ++e) {
+            ax += ev.scores[star.target(e)];
+        }
+        assert(std::fabs(ax - lambda * ev.scores[u]) < 1e-9);
+    }
+
+    // Grafo bipartito (periódico): converge gracias al desplazamiento
+    graphs::Graph cycle4(graphs::AdjList{{{1, 1.0}, {3, 1.0}},
+                                         {{0, 1.0}, {2, 1.0}},
+                                         {{1, 1.0}, {3, 1.0}},
+                                         {{0, 1.0}, {2, 1.0}}});
+    auto ev4 = graphs::eigenvector_centrality(cycle4, tight);
+    assert(ev4.converged && max_diff(ev4.scores, std::vector<double>(4, 0.25)) < 1e-9);
+
+    // PageRank sobre un grafo aleatorio con pesos y vértices sin salidas
+    std::mt19937 rng(62);
+    const int n = 3000;
+    std::vector<graphs::EdgeRecord> edges;
+    for (int i = 0; i < 8 * n; ++i) {
+        int u = static_cast<int>(rng() % n);
+        if (u % 17 != 0) {
+            edges.push_back({u, static_cast<int>(rng() % n), 1.0 + rng() % 5});
+        }
+    }
+    graphs::Graph g = graphs::build_csr(n, edges);
+    auto ref = reference_pagerank(g, 0.85, std::vector<double>(n, 1.0 / n));
+
+    graphs::RankOptions opts;
+    opts.tolerance = 1e-10;
+    opts.max_iter = 500;
+    auto jacobi = graphs::pagerank(g, opts);
+    assert(jacobi.converged && max_diff(jacobi.scores, ref) < 1e-9);
+    assert(std::fabs(std::accumulate(jacobi.scores.begin(), jacobi.scores.end(), 0.0) - 1.0) < 1e-9);
+
+    opts.acceleration = graphs::RankAcceleration::GaussSeidel;
+    auto gs = graphs::pagerank(g, opts);
+    assert(gs.converged && max_diff(gs.scores, ref) < 1e-8 && gs.iterations < jacobi.iterations);
+    opts.threads = 4;
+    auto gs4 = graphs::pagerank(g, opts);
+    assert(gs4.scores == gs.scores);
+
+    opts.acceleration = graphs::RankAcceleration::Aitken;
+    opts.norm = graphs::RankNorm::LInf;
+    auto ait = graphs::pagerank(g, opts);
+    assert(ait.converged && max_diff(ait.scores, ref) < 1e-8);
+
+    // Puntuaciones en float
+    graphs::RankOptions loose;
+    loose.tolerance = 1e-6;
+    auto f32 = graphs::pagerank<float>(g, loose);
+    assert(f32.converged && max_diff(f32.scores, ref) < 1e-5);
+
+    // PageRank personalizado: toda la masa de teletransporte en las semillas
+    auto p = graphs::seed_personalization(n, {1, 2});
+    std::vector<double> uniform_seeds(n, 0.0);
+    uniform_seeds[1] = uniform_seeds[2] = 0.5;
+    auto ppr = graphs::personalized_pagerank(g, p, opts);
+    assert(ppr.converged && max_diff(ppr.scores, reference_pagerank(g, 0.85, uniform_seeds)) < 1e-8);
+
+    bool threw = false;
+    try {
+        graphs::RankOptions bad;
+        bad.acceleration = graphs::RankAcceleration::GaussSeidel;
+        graphs::eigenvector_centrality(star, bad);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Centralidad: todas las pruebas superadas" << std::endl;
+    return 0;
+}
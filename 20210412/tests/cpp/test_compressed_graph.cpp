@@ -0,0 +1,220 @@
+#include "bfs.hpp"
+#include "centrality.hpp"
+#include "compressed_graph.hpp"
+#include "dijkstra.hpp"
+#include "graph_builder.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+// Grafo aleatorio con filas desordenadas, aristas repetidas, bucles y un
+// vértice de grado alto (no múltiplo de 4 ni del bloque de decodificación).
+static graphs::Graph random_graph(int n, int m, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::uniform_real_distribution<double> weight(1.0, 10.0);
+    graphs::AdjList adj(n);
+    for (int i = 0; i < m; ++i) {
+        const int u = vertex(rng);
+        // Mezcla de vecinos cercanos y lejanos.
+        const int v = i % 3 ? std::clamp(u + vertex(rng) % 16 - 8, 0, n - 1) : vertex(rng);
+        adj[u].push_back({v, weight(rng)});
+    }
+    for (int i = 0; i < 203; ++i) {
+        adj[7].push_back({vertex(rng), weight(rng)});
+    }
+    adj[9].push_back({9, 2.5});
+    adj[9].push_back({9, 2.5});
+    return graphs::Graph(adj);
+}
+
+// Filas (destino, peso) ordenadas del CSR.
+static std::vector<std::pair<int, double>> sorted_row(const graphs::Graph &g, int u) {
+    std::vector<std::pair<int, double>> row;
+    for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+        row.push_back({g.target(e), g.weight(e)});
+    }
+    std::sort(row.begin(), row.end());
+    return row;
+}
+
+static void check_same(const graphs::Graph &g, const graphs::CompressedGraph &c) {
+    assert(c.num_vertices() == g.num_vertices() && c.num_edges() == g.num_edges());
+    const graphs::Graph d = c.decompress();
+    for (int u = 0; u < g.num_vertices(); ++u) {
+        const auto row = sorted_row(g, u);
+        assert(c.degree(u) == row.size() && d.degree(u) == row.size());
+        std::size_t i = 0;
+        for (const graphs::Neighbor &nb : c.neighbors(u)) {
+            assert(nb.target == row[i].first);
+            assert(std::fabs(nb.weight - row[i].second) <= c.weight_error() + 1e-12);
+            assert(d.target(d.edge_begin(u) + i) == nb.target && d.weight(d.edge_begin(u) + i) == nb.weight);
+            ++i;
+        }
+        assert(i == row.size());
+    }
+}
+
+int main() {
+    const graphs::Graph g = random_graph(5000, 60000, 64);
+    for (auto nc : {graphs::NeighborCodec::Varint, graphs::NeighborCodec::StreamVByte}) {
+        for (auto wc : {graphs::WeightCodec::Exact, graphs::WeightCodec::Float32,
+                        graphs::WeightCodec::Quantized16, graphs::WeightCodec::Quantized8}) {
+            graphs::CompressOptions opts;
+            opts.neighbors = nc;
+            opts.weights = wc;
+            opts.threads = 4;
+            const graphs::CompressedGraph c(g, opts);
+            check_same(g, c);
+            check_same(graphs::transpose(g), graphs::transpose(c, 3));
+            assert(c.memory_bytes() < 8 * (g.num_vertices() + 1) + 12 * g.num_edges());
+        }
+    }
+    std::cout << "Decodificación SIMD: " << (graphs::CompressedGraph::simd_decode() ? "sí" : "no")
+              << std::endl;
+
+    // Saltos de tres bytes y primer vecino por debajo de u.
+    {
+        const int n = 1 << 22;
+        std::vector<graphs::EdgeRecord> edges = {{n - 1, 0, 1.0}, {n - 1, 3, 1.0}, {0, n - 1, 1.0},
+                                                 {0, 1, 1.0},     {5, n / 2, 1.0}, {n / 2, 5, 1.0}};
+        const graphs::Graph big = graphs::build_csr(n, edges);
+        const graphs::CompressedGraph c(big);
+        assert(c.weight_error() == 0.0);
+        std::vector<int> row;
+        for (const auto &nb : c.neighbors(n - 1)) {
+            row.push_back(nb.target);
+            assert(nb.weight == 1.0);
+        }
+        assert((row == std::vector<int>{0, 3}));
+        assert(graphs::bfs_hops(c, 5).hops[n / 2] == 1);
+        assert(graphs::dijkstra(c, n - 1)[1] == 2.0);
+    }
+
+    // Dijkstra: exacto con pesos double, acotado con pesos cuantizados.
+    {
+        // Por defecto los pesos se guardan exactos; cuantizar es opcional.
+        const graphs::CompressedGraph ce(g);
+        assert(ce.weight_codec() == graphs::WeightCodec::Exact && ce.weight_error() == 0.0);
+        graphs::CompressOptions quantized;
+        quantized.weights = graphs::WeightCodec::Quantized16;
+        const graphs::CompressedGraph cq(g, quantized);
+        const auto ref = graphs::dijkstra_tree(g, 0);
+        const auto de = graphs::dijkstra_tree(ce, 0);
+        const auto dq = graphs::dijkstra(cq, 0);
+        for (int v = 0; v < g.num_vertices(); ++v) {
+            assert(de.dist[v] == ref.dist[v]);
+            if (std::isinf(ref.dist[v])) {
+                assert(std::isinf(dq[v]));
+            } else {
+                assert(std::fabs(dq[v] - ref.dist[v]) <= ref.dist[v] * 1e-3);
+            }
+        }
+        graphs::DijkstraWorkspace ws;
+        graphs::QueryLimits limits;
+        limits.max_settled = 50;
+        const auto near = graphs::dijkstra_limited(ce, 0, limits, ws);
+        const auto near_ref = graphs::dijkstra_nearest(g, 0, 50, ws);
+        assert(near.size() == 50 && near.dist == near_ref.dist);
+    }
+
+    // BFS: mismos saltos que sobre el CSR, también con fases ascendentes.
+    {
+        graphs::CompressOptions opts;
+        opts.neighbors = graphs::NeighborCodec::Varint;
+        const graphs::CompressedGraph c(g, opts);
+        graphs::BfsOptions bfs;
+        bfs.threads = 4;
+        bfs.alpha = 1e9;
+        graphs::BfsEngine engine(c, bfs);
+        const auto ref = graphs::bfs_hops(g, 3);
+        const auto got = engine.hops(3);
+        assert(got.hops == ref.hops && got.visited == ref.visited && got.bottom_up_levels > 0);
+        for (int t : {0, 100, 4999}) {
+            assert(engine.distance(3, t) == ref.hops[t]);
+        }
+    }
+
+    // PageRank sobre el comprimido.
+    {
+        graphs::CompressOptions exact;
+        exact.weights = graphs::WeightCodec::Exact;
+        const graphs::CompressedGraph c(g, exact);
+        graphs::RankOptions opts;
+        opts.tolerance = 1e-12;
+        opts.threads = 4;
+        const auto ref = graphs::pagerank(g, opts);
+        const auto got = graphs::pagerank(c, opts);
+        assert(got.converged);
+        for (int v = 0; v < g.num_vertices(); ++v) {
+            assert(std::fabs(got.scores[v] - ref.scores[v]) < 1e-12);
+        }
+        const auto p = graphs::seed_personalization(g.num_vertices(), {1, 2});
+        const auto pref = graphs::personalized_pagerank<float>(g, p, opts);
+        const auto pgot = graphs::personalized_pagerank<float>(c, p, opts);
+        for (int v = 0; v < g.num_vertices(); ++v) {
+            assert(std::fabs(pgot.scores[v] - pref.scores[v]) < 1e-5);
+        }
+    }
+
+    // Rejilla sin pesos: sin bytes de peso y más de 3 veces menos memoria.
+    {
+        const int w = 300;
+        std::vector<graphs::EdgeRecord> edges;
+        for (int y = 0; y < w; ++y) {
+            for (int x = 0; x < w; ++x) {
+                if (x + 1 < w) {
+                    edges.push_back({y * w + x, y * w + x + 1, 1.0});
+                }
+                if (y + 1 < w) {
+                    edges.push_back({y * w + x, (y + 1) * w + x, 1.0});
+                }
+            }
+        }
+        graphs::BuildOptions sym;
+        sym.symmetrize = true;
+        const graphs::Graph grid = graphs::build_csr(w * w, edges, sym);
+        const graphs::CompressedGraph c(grid);
+        const std::size_t csr = 8 * (grid.num_vertices() + 1) + 12 * grid.num_edges();
+        assert(c.memory_bytes() * 3 < csr);
+        graphs::BfsOptions bfs;
+        bfs.symmetric = true;
+        assert(graphs::bfs_hops(c, 0, bfs).hops[w * w - 1] == 2 * (w - 1));
+
+        // Las copias comparten los registros y sobreviven al original.
+        graphs::CompressedGraph copy;
+        {
+            const graphs::CompressedGraph tmp(grid);
+            copy = tmp;
+        }
+        assert(copy.memory_bytes() == c.memory_bytes() && copy.degree(w + 1) == 4);
+        assert(graphs::bfs_hops(copy, 0, bfs).hops[w * w - 1] == 2 * (w - 1));
+    }
+
+    bool threw = false;
+    try {
+        const double inf = std::numeric_limits<double>::infinity();
+        graphs::CompressOptions quantized;
+        quantized.weights = graphs::WeightCodec::Quantized8;
+        graphs::CompressedGraph(graphs::build_csr(3, std::vector<graphs::EdgeRecord>{{0, 1, 1.0}, {1, 2, inf}}),
+                                quantized);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        graphs::dijkstra(graphs::CompressedGraph(graphs::build_csr(2, std::vector<graphs::EdgeRecord>{{0, 1, -1.0}})), 0);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Grafo comprimido: todas las pruebas superadas" << std::endl;
+    return 0;
+}
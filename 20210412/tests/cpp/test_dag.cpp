@@ -0,0 +1,104 @@
+#include "dag.hpp"
+#include "bellman_ford.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+static bool is_topological(const graphs::Graph &g, const std::vector<int> &order) {
+    std::vector<int> pos(g.num_vertices(), -1);
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        pos[order[i]] = static_cast<int>(i);
+    }
+    for (int u = 0; u < g.num_vertices(); ++u) {
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            if (pos[u] < 0 || pos[u] >= pos[g.target(e)]) {
+                return false;
+            }
+        }
+    }
+    return order.size() == static_cast<std::size_t>(g.num_vertices());
+}
+
+static bool is_cycle(const graphs::Graph &g, const std::vector<int> &cycle) {
+    auto has_edge = [&](int u, int v) {
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            if (g.target(e) == v) {
+                return true;
+            }
+        }
+        return false;
+    };
+    for (std::size_t i = 0; i < cycle.size(); ++i) {
+        if (!has_edge(cycle[i], cycle[(i + 1) % cycle.size()])) {
+            return false;
+        }
+    }
+    return !cycle.empty();
+}
+
+int main() {
+    // DAG de ejemplo (data/samples/dag_adj.json) con pesos, uno negativo
+    graphs::AdjList adj = {{{1, 2.0}, {2, 1.0}}, {{3, -1.0}}, {{3, 4.0}}, {}};
+    graphs::Graph g(adj);
+    for (auto method : {graphs::TopoMethod::Kahn, graphs::TopoMethod::Dfs}) {
+        auto topo = graphs::topological_sort(g, method);
+        assert(topo.is_dag() && is_topological(g, topo.order));
+    }
+    assert((graphs::topological_sort(g).order == std::vector<int>{0, 1, 2, 3}));
+
+    auto sp = graphs::dag_shortest_paths(g, 0);
+    assert(sp.dist[3] == 1.0 && sp.parent[3] == 1);
+    auto lp = graphs::dag_longest_paths(g, 0);
+    assert(lp.dist[3] == 5.0 && lp.parent[3] == 2);
+    auto from1 = graphs::dag_longest_paths(g, 1);
+    assert(std::isinf(from1.dist[0]) && from1.dist[0] < 0 && graphs::extract_path(from1, 0).empty());
+
+    // Ciclo: se informa con un testigo y los caminos lo rechazan
+    graphs::Graph cyc(graphs::AdjList{{{1, 1.0}}, {{2, 1.0}}, {{3, 1.0}}, {{1, 1.0}}, {{0, 1.0}}});
+    for (auto method : {graphs::TopoMethod::Kahn, graphs::TopoMethod::Dfs}) {
+        auto topo = graphs::topological_sort(cyc, method);
+        assert(!topo.is_dag() && topo.order.empty() && is_cycle(cyc, topo.cycle));
+        assert(topo.cycle.size() == 3);
+    }
+    bool threw = false;
+    try {
+        graphs::dag_shortest_paths(cyc, 0);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    assert(threw);
+
+    // DAG aleatorio grande: coincide con Bellman–Ford
+    std::mt19937 rng(59);
+    const int n = 2000;
+    graphs::AdjList big(n);
+    for (int i = 0; i < 10 * n; ++i) {
+        int a = static_cast<int>(rng() % n), b = static_cast<int>(rng() % n);
+        if (a != b) {
+            big[std::min(a, b)].push_back({std::max(a, b), static_cast<double>(rng() % 21) - 5.0});
+        }
+    }
+    graphs::Graph dag(big);
+    auto order = graphs::topological_sort(dag, graphs::TopoMethod::Dfs).order;
+    auto fast = graphs::dag_shortest_paths(dag, 0, order);
+    auto ref = graphs::bellman_ford(dag, 0);
+    assert(!ref.negative_cycle);
+    for (int v = 0; v < n; ++v) {
+        assert(fast.dist[v] == ref.tree.dist[v] || std::fabs(fast.dist[v] - ref.tree.dist[v]) < 1e-9);
+    }
+
+    // Camino crítico: a(3) -> b(2) -> d(4); a -> c(1) -> d con retardo 2
+    graphs::Graph tasks(graphs::AdjList{{{1, 0.0}, {2, 0.0}}, {{3, 0.0}}, {{3, 2.0}}, {}});
+    auto cp = graphs::critical_path(tasks, {3.0, 2.0, 1.0, 4.0});
+    assert(cp.length == 10.0 && cp.earliest_start[3] == 6.0);
+    assert((cp.path == std::vector<int>{0, 2, 3}));
+    assert(cp.slack(0) == 0.0 && cp.slack(2) == 0.0 && cp.slack(1) == 1.0);
+    auto cp2 = graphs::critical_path(tasks, {3.0, 4.0, 1.0, 4.0});
+    assert(cp2.length == 11.0 && (cp2.path == std::vector<int>{0, 1, 3}) && cp2.slack(2) == 1.0);
+
+    std::cout << "DAG: todas las pruebas superadas" << std::endl;
+    return 0;
+}
@@ -1,7 +1,10 @@
 #include "dijkstra.hpp"
+#include "graph_builder.hpp"
 
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <type_traits>
 
 int main() {
     // Construcción de un grafo dirigido ponderado
@@ -20,5 +23,56 @@ int main() {
     assert(std::fabs(dist[2] - 3.0) < 1e-9);
     // La distancia a 1 es 1
     assert(std::fabs(dist[1] - 1.0) < 1e-9);
+
+    // Consultas acotadas reutilizando el mismo workspace
+    graphs::DijkstraWorkspace ws;
+    // Isócrona de radio 3: se asientan 0, 1 y 2 pero no 3
+    auto within = graphs::dijkstra_within(adj, 0, 3.0, ws);
+    assert(within.size() == 3);
+    assert(within.vertices[2] == 2 && std::fabs(within.dist[2] - 3.0) < 1e-9);
+    assert(within.parent[2] == 1);
+    // Los 2 más cercanos: el origen y el nodo 1
+    auto nearest = graphs::dijkstra_nearest(adj, 0, 2, ws);
+    assert(nearest.size() == 2);
+    assert(nearest.vertices[0] == 0 && nearest.vertices[1] == 1);
+    // Los dos nodos impares más cercanos
+    auto odd = graphs::dijkstra_nearest_if(adj, 0, 2, [](int v) { return v % 2 == 1; }, ws);
+    assert(odd.size() == 2);
+    assert(odd.vertices[1] == 3 && std::fabs(odd.dist[1] - 4.0) < 1e-9);
+    // Una consulta nueva no ve etiquetas de la anterior
+    auto from2 = graphs::dijkstra_within(adj, 2, 10.0, ws);
+    assert(from2.size() == 2);
+
+    // Las mismas consultas sobre el grafo CSR
+    graphs::Graph g(adj);
+    auto dist_csr = graphs::dijkstra(g, 0);
+    for (int v = 0; v < 4; ++v) {
+        assert(std::fabs(dist_csr[v] - dist[v]) < 1e-9);
+    }
+    auto tree = graphs::dijkstra_tree(g, 0);
+    assert((graphs::extract_path(tree, 3) == std::vector<int>{0, 1, 2, 3}));
+    auto within_csr = graphs::dijkstra_within(g, 0, 3.0, ws);
+    assert(within_csr.vertices == within.vertices);
+
+    // Otras instancias: identificadores de 64 bits y pesos float o enteros
+    using Wide = graphs::BasicGraph<std::int64_t, float>;
+    Wide wide(graphs::BasicAdjList<std::int64_t, float>{{{1, 1.0f}, {2, 4.0f}}, {{2, 2.0f}, {3, 5.0f}}, {{3, 1.0f}}, {}});
+    auto dist_wide = graphs::dijkstra(wide, 0);
+    static_assert(std::is_same_v<decltype(dist_wide)::value_type, float>);
+    assert(dist_wide[3] == 4.0f);
+    auto tree_wide = graphs::dijkstra_tree(graphs::transpose(wide), 3);
+    assert((graphs::extract_path(tree_wide, 0) == std::vector<std::int64_t>{3, 2, 1, 0}));
+
+    graphs::BasicGraphBuilder<int, std::int32_t> builder;
+    builder.add_edge(0, 1, 1);
+    builder.add_edge(0, 2, 4);
+    builder.add_edge(1, 2, 2);
+    builder.add_edge(2, 3, 1);
+    builder.add_vertices(5);
+    auto integral = graphs::dijkstra_tree(builder.build(), 0);
+    static_assert(std::is_same_v<decltype(integral.dist)::value_type, std::int64_t>);
+    assert(integral.dist[3] == 4 && integral.parent[3] == 2);
+    assert(integral.dist[4] == graphs::WeightTraits<std::int32_t>::infinity());
+    assert(graphs::extract_path(integral, 4).empty());
     return 0;
 }
\ No newline at end of file
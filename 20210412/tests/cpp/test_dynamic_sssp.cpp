@@ -0,0 +1,65 @@
+#include "dijkstra.hpp"
+#include "dynamic_sssp.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+static bool same(double a, double b) {
+    return (std::isinf(a) && std::isinf(b)) || std::fabs(a - b) < 1e-9;
+}
+
+int main() {
+    // Camino 0 -> 1 -> 2 -> 3 con atajo 0 -> 3
+    graphs::AdjList adj(4);
+    adj[0] = {{1, 1.0}, {3, 10.0}};
+    adj[1] = {{2, 1.0}};
+    adj[2] = {{3, 1.0}};
+    graphs::Graph g(adj);
+    graphs::DynamicShortestPaths dyn(g, {0});
+    assert(same(dyn.dist(0, 3), 3.0));
+    assert((dyn.path(0, 3) == std::vector<int>{0, 1, 2, 3}));
+
+    // Subir una arista fuera del árbol no toca nada
+    assert(dyn.update(0, 3, 20.0) == 0);
+    // Subir una arista del árbol repara sólo el subárbol {2, 3}
+    assert(dyn.update(1, 2, 50.0) == 2);
+    assert(same(dyn.dist(0, 2), 51.0));
+    assert(same(dyn.dist(0, 3), 20.0));
+    assert(dyn.parent(0, 3) == 0);
+    // Bajar el atajo mejora sólo el vértice 3
+    assert(dyn.update(0, 3, 2.0) == 1);
+    assert(same(dyn.dist(0, 3), 2.0));
+
+    // Prueba aleatoria contra Dijkstra desde cero, con dos orígenes y dos hilos
+    const int n = 60;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::uniform_real_distribution<double> weight(0.0, 10.0);
+    graphs::AdjList radj(n);
+    for (int i = 0; i < 300; ++i) {
+        int u = pick(rng), v = pick(rng);
+        radj[u].push_back({v, weight(rng)});
+    }
+    graphs::Graph rg(radj);
+    graphs::DynamicShortestPaths rdyn(rg, {0, 7}, 2);
+    std::vector<double> w = rg.weights().to_vector();
+    std::uniform_int_distribution<std::size_t> pick_edge(0, rg.num_edges() - 1);
+    for (int step = 0; step < 200; ++step) {
+        std::size_t e = pick_edge(rng);
+        w[e] = step % 3 == 0 ? 0.0 : weight(rng);
+        rdyn.set_weight(e, w[e]);
+        if (step % 20 == 0) {
+            graphs::Graph fresh(rg.offsets().to_vector(), rg.targets().to_vector(), w);
+            for (std::size_t t = 0; t < rdyn.num_sources(); ++t) {
+                auto ref = graphs::dijkstra(fresh, rdyn.source(t));
+                for (int v = 0; v < n; ++v) {
+                    assert(same(rdyn.dist(t, v), ref[v]));
+                }
+            }
+        }
+    }
+    std::cout << "Todas las pruebas de caminos mínimos dinámicos se han superado.\n";
+    return 0;
+}
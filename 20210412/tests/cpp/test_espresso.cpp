@@ -0,0 +1,226 @@
+#include "espresso.hpp"
+#include "unate_cover.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using graphs::Cube;
+
+static bool covered(const std::vector<Cube> &cover, std::uint64_t m) {
+    return std::any_of(cover.begin(), cover.end(), [m](const Cube &c) { return c.covers(m); });
+}
+
+// Tabla de verdad: 1 ON, 2 DC, 0 OFF.
+static std::vector<int> random_table(std::mt19937 &rng, unsigned n, std::vector<std::uint64_t> &on,
+                                     std::vector<std::uint64_t> &dc) {
+    std::vector<int> table(std::size_t(1) << n, 0);
+    on.clear();
+    dc.clear();
+    for (std::uint64_t t = 0; t < table.size(); ++t) {
+        const unsigned x = rng() % 10;
+        if (x < 4) {
+            table[t] = 1;
+            on.push_back(t);
+        } else if (x < 5) {
+            table[t] = 2;
+            dc.push_back(t);
+        }
+    }
+    return table;
+}
+
+// La cobertura implementa la tabla, cada cubo es primo y ninguno sobra.
+static void check_result(const std::vector<Cube> &cover, const std::vector<int> &table, unsigned n) {
+    auto implicant = [&](const Cube &c) {
+        for (std::uint64_t t = 0; t < table.size(); ++t) {
+            if (c.covers(t) && table[t] == 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+    for (std::uint64_t t = 0; t < table.size(); ++t) {
+        if (table[t] == 1) {
+            assert(covered(cover, t));
+        }
+    }
+    for (std::size_t i = 0; i < cover.size(); ++i) {
+        const Cube &c = cover[i];
+        assert(implicant(c));
+        for (std::uint64_t rest = c.mask; rest; rest &= rest - 1) {
+            const std::uint64_t bit = rest & (~rest + 1);
+            assert(!implicant({c.value & ~bit, c.mask & ~bit}));
+        }
+        std::vector<Cube> others = cover;
+        others.erase(others.begin() + static_cast<long>(i));
+        bool needed = false;
+        for (std::uint64_t t = 0; t < table.size() && !needed; ++t) {
+            needed = table[t] == 1 && c.covers(t) && !covered(others, t);
+        }
+        assert(needed);
+    }
+    (void)n;
+}
+
+int main() {
+    // Tautología y complemento frente a la tabla de verdad.
+    std::mt19937 rng(73);
+    for (int round = 0; round < 40; ++round) {
+        const unsigned n = 2 + round % 7;
+        const std::uint64_t full = (std::uint64_t(1) << n) - 1;
+        std::vector<Cube> f;
+        for (unsigned k = 0; k < 1 + rng() % 12; ++k) {
+            const std::uint64_t mask = rng() & full & (rng() | rng());
+            f.push_back({rng() & mask, mask});
+        }
+        const std::vector<Cube> comp = graphs::complement(f, n);
+        bool all = true;
+        for (std::uint64_t t = 0; t <= full; ++t) {
+            assert(covered(f, t) != covered(comp, t));
+            all = all && covered(f, t);
+        }
+        assert(graphs::tautology(f, n) == all);
+    }
+    assert(graphs::tautology({graphs::pattern_to_cube("1-"), graphs::pattern_to_cube("0-")}, 2));
+    assert(!graphs::tautology({graphs::pattern_to_cube("1-"), graphs::pattern_to_cube("01")}, 2));
+    assert(graphs::complement({}, 3) == std::vector<Cube>{Cube{}});
+
+    // Casos conocidos: mayoría (tres primos esenciales) y la función
+    // cíclica de seis primos, que admite tres.
+    assert(graphs::espresso_minimize({3, 5, 6, 7}, 3) == (std::vector<std::string>{"-11", "1-1", "11-"}));
+    assert(graphs::espresso_minimize({0, 1, 2, 5, 6, 7}, 3).size() == 3);
+    assert(graphs::espresso_minimize({0, 1, 2, 3}, 2) == std::vector<std::string>{"--"});
+    assert(graphs::espresso_minimize({}, 4).empty());
+
+    // Funciones aleatorias: resultado primo e irredundante, nunca con menos
+    // cubos que la cobertura mínima exacta.
+    for (int round = 0; round < 30; ++round) {
+        const unsigned n = 3 + round % 6;
+        std::vector<std::uint64_t> on, dc;
+        const std::vector<int> table = random_table(rng, n, on, dc);
+        std::vector<Cube> cover;
+        for (const std::string &p : graphs::espresso_minimize(on, n, dc)) {
+            cover.push_back(graphs::pattern_to_cube(p));
+        }
+        check_result(cover, table, n);
+        const auto exact = graphs::minimize_cover(on, dc, n);
+        assert(cover.size() >= exact.cover.size());
+
+        // El mismo resultado dando el conjunto OFF explícito.
+        std::vector<Cube> on_cubes, dc_cubes, off_cubes;
+        for (std::uint64_t t = 0; t < table.size(); ++t) {
+            const Cube c{t, (std::uint64_t(1) << n) - 1};
+            (table[t] == 1 ? on_cubes : table[t] == 2 ? dc_cubes : off_cubes).push_back(c);
+        }
+        if (!off_cubes.empty()) {
+            check_result(graphs::espresso(on_cubes, dc_cubes, off_cubes, n), table, n);
+        }
+    }
+
+    // PLA de dos salidas (tipo fd) y vuelta a escribir.
+    {
+        std::istringstream in("# sumador de un bit\n"
+                              ".i 3\n.o 2\n.ilb a b cin\n.ob s cout\n.p 8\n"
+                              "001 10\n010 10\n100 10\n111 11\n"
+                              "011 01\n101 01\n110 01\n"
+                              "000 0-\n.e\n");
+        const graphs::Pla pla = graphs::parse_pla(in);
+        assert(pla.inputs == 3 && pla.outputs == 2 && pla.type == "fd");
+        assert(pla.on[0].size() == 4 && pla.on[1].size() == 4 && pla.dc[1].size() == 1);
+        const graphs::Pla min = graphs::espresso(pla);
+        assert(min.on[0].size() == 4);
+        // El acarreo es la mayoría; el DC en 000 no ayuda.
+        assert(min.on[1].size() == 3);
+        std::ostringstream out;
+        graphs::write_pla(out, min);
+        std::istringstream again(out.str());
+        const graphs::Pla back = graphs::parse_pla(again);
+        assert(back.type == "f" && back.input_labels == pla.input_labels && back.output_labels == pla.output_labels);
+        for (unsigned o = 0; o < 2; ++o) {
+            std::vector<Cube> a = min.on[o], b = back.on[o];
+            auto key = [](const Cube &x, const Cube &y) { return x.mask != y.mask ? x.mask < y.mask : x.value < y.value; };
+            std::sort(a.begin(), a.end(), key);
+            std::sort(b.begin(), b.end(), key);
+            assert(a == b);
+        }
+    }
+
+    // Tipo fr: lo que no aparece es indiferente.
+    {
+        std::istringstream in(".i 3\n.o 1\n.type fr\n110 1\n111 1\n000 0\n001 0\n");
+        const graphs::Pla min = graphs::espresso(graphs::parse_pla(in));
+        assert(min.on[0].size() == 1);
+        const std::string p = graphs::cube_to_pattern(min.on[0][0], 3);
+        assert(p == "1--" || p == "-1-");
+    }
+
+    // 50 entradas: 100 cubos de 8 literales partidos cada uno en 8 trozos
+    // por 3 variables más (800 cubos).  La cobertura resultante es
+    // equivalente (comprobado por tautología) y vuelve a tener como mucho 100.
+    {
+        const unsigned n = 50;
+        std::vector<Cube> on;
+        for (int k = 0; k < 100; ++k) {
+            std::vector<unsigned> vars(n);
+            for (unsigned v = 0; v < n; ++v) {
+                vars[v] = v;
+            }
+            std::shuffle(vars.begin(), vars.end(), rng);
+            Cube base;
+            for (unsigned v = 0; v < 8; ++v) {
+                base.mask |= std::uint64_t(1) << vars[v];
+                base.value |= std::uint64_t(rng() & 1) << vars[v];
+            }
+            for (unsigned piece = 0; piece < 8; ++piece) {
+                Cube c = base;
+                for (unsigned v = 0; v < 3; ++v) {
+                    c.mask |= std::uint64_t(1) << vars[8 + v];
+                    c.value |= std::uint64_t((piece >> v) & 1) << vars[8 + v];
+                }
+                on.push_back(c);
+            }
+        }
+        std::shuffle(on.begin(), on.end(), rng);
+        const auto start = std::chrono::steady_clock::now();
+        const std::vector<Cube> min = graphs::espresso(on, {}, n);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        assert(min.size() <= 100);
+        for (const Cube &c : min) {
+            assert(graphs::cover_contains(on, c));
+        }
+        for (const Cube &c : on) {
+            assert(graphs::cover_contains(min, c));
+        }
+        std::cout << "50 entradas: " << on.size() << " -> " << min.size() << " cubos en " << seconds << " s"
+                  << std::endl;
+    }
+
+    // Errores.
+    bool threw = false;
+    try {
+        graphs::espresso({graphs::pattern_to_cube("1-")}, {}, {graphs::pattern_to_cube("11")}, 2);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    for (const char *bad : {".i 2\n.o 1\n1x 1\n", "10 1\n", ".i 2\n.o 1\n101 1\n", ".i 2\n.o 1\n.kiss\n"}) {
+        threw = false;
+        try {
+            std::istringstream in(bad);
+            graphs::parse_pla(in);
+        } catch (const std::runtime_error &) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    std::cout << "Espresso: todas las pruebas superadas" << std::endl;
+    return 0;
+}
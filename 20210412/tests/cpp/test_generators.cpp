@@ -0,0 +1,149 @@
+#include "bfs.hpp"
+#include "generators.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+static bool same(const graphs::Graph &a, const graphs::Graph &b) {
+    return a.offsets().to_vector() == b.offsets().to_vector() &&
+           a.targets().to_vector() == b.targets().to_vector() &&
+           a.weights().to_vector() == b.weights().to_vector();
+}
+
+// Cada arista u->v tiene su inversa v->u con el mismo peso.
+static bool symmetric(const graphs::Graph &g) {
+    for (int u = 0; u < g.num_vertices(); ++u) {
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            const int v = g.target(e);
+            bool found = false;
+            for (std::size_t f = g.edge_begin(v); f < g.edge_end(v); ++f) {
+                found |= g.target(f) == u && g.weight(f) == g.weight(e);
+            }
+            if (!found) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main() {
+    graphs::GeneratorOptions opts;
+    opts.seed = 67;
+    opts.min_weight = 1.0;
+    opts.max_weight = 5.0;
+    opts.threads = 4;
+    graphs::GeneratorOptions serial = opts;
+    serial.threads = 1;
+
+    // Rejillas: tamaño exacto, simetría, diámetro y reproducibilidad.
+    {
+        const graphs::Graph g = graphs::grid_2d(4, 3, opts);
+        assert(g.num_vertices() == 12 && g.num_edges() == 2 * (3 * 3 + 4 * 2));
+        assert(symmetric(g));
+        for (double w : g.weights()) {
+            assert(w >= 1.0 && w <= 5.0);
+        }
+        assert(graphs::bfs_hops(g, 0).hops[11] == 5);
+        assert(same(g, graphs::grid_2d(4, 3, serial)));
+        graphs::GeneratorOptions other = opts;
+        other.seed = 68;
+        assert(!same(g, graphs::grid_2d(4, 3, other)));
+        assert(graphs::grid_2d(0, 5).num_vertices() == 0);
+
+        const graphs::Graph c = graphs::grid_3d(3, 4, 5, opts);
+        assert(c.num_vertices() == 60 && c.num_edges() == 2 * (2 * 20 + 3 * 15 + 4 * 12));
+        assert(symmetric(c) && graphs::bfs_hops(c, 0).hops[59] == 2 + 3 + 4);
+        assert(same(c, graphs::grid_3d(3, 4, 5, serial)));
+        for (int u = 0; u < 60; ++u) {
+            assert(c.degree(u) >= 3 && c.degree(u) <= 6);
+        }
+    }
+
+    // R-MAT: grafo simple, grados sesgados e independiente de los hilos.
+    {
+        const graphs::Graph g = graphs::rmat(12, 8 << 12, {}, opts);
+        assert(g.num_vertices() == 4096);
+        assert(g.num_edges() > (8u << 12) / 2 && g.num_edges() <= (8u << 12));
+        std::size_t max_degree = 0;
+        for (int u = 0; u < g.num_vertices(); ++u) {
+            max_degree = std::max(max_degree, g.degree(u));
+            for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+                assert(g.target(e) != u);
+                assert(e + 1 == g.edge_end(u) || g.target(e) < g.target(e + 1));
+            }
+        }
+        assert(max_degree > 10 * g.num_edges() / g.num_vertices());
+        assert(same(g, graphs::rmat(12, 8 << 12, {}, serial)));
+
+        // Iniciador degenerado: todas las aristas caen en el cuadrante (0, 0).
+        graphs::RmatOptions corner;
+        corner.a = 1.0;
+        corner.b = corner.c = 0.0;
+        corner.noise = corner.permute = corner.simple = false;
+        const graphs::Graph z = graphs::rmat(5, 100, corner, opts);
+        assert(z.num_edges() == 100 && z.degree(0) == 100 && z.target(0) == 0);
+    }
+
+    // Geométrico: simétrico y con pesos (distancias) menores que r.
+    {
+        const int n = 400;
+        const double r = 0.08;
+        const graphs::Graph g = graphs::random_geometric(n, r, opts);
+        assert(symmetric(g));
+        for (double w : g.weights()) {
+            assert(w > 0.0 && w < r);
+        }
+        // Con radio mayor que la diagonal todos los pares están unidos.
+        const graphs::Graph all = graphs::random_geometric(30, 2.0, opts);
+        assert(all.num_edges() == 30 * 29);
+        assert(g.num_edges() < graphs::random_geometric(n, 2 * r, opts).num_edges());
+        // El grado medio sigue a n pi r^2.
+        const graphs::Graph big = graphs::random_geometric(20000, std::sqrt(8.0 / (std::acos(-1.0) * 20000)), opts);
+        const double avg = double(big.num_edges()) / big.num_vertices();
+        assert(avg > 6.5 && avg < 8.5);
+        assert(same(big, graphs::random_geometric(20000, std::sqrt(8.0 / (std::acos(-1.0) * 20000)), serial)));
+    }
+
+    // Carreteras: conexa, grado medio bajo y distancias euclídeas.
+    {
+        const graphs::Graph g = graphs::road_network(40, 30, {}, opts);
+        assert(g.num_vertices() == 1200 && symmetric(g));
+        assert(graphs::bfs_hops(g, 0).visited == 1200);
+        const double avg = double(g.num_edges()) / g.num_vertices();
+        assert(avg > 2.2 && avg < 3.5);
+        for (double w : g.weights()) {
+            assert(w > 0.0 && w < 2.0 * std::sqrt(2.0) + 1.0);
+        }
+        assert(same(g, graphs::road_network(40, 30, {}, serial)));
+        graphs::RoadOptions tree;
+        tree.keep = 0.0;
+        tree.diagonals = 0.0;
+        assert(graphs::road_network(40, 30, tree, opts).num_edges() == 2 * (1200 - 1));
+    }
+
+    auto throws = [](auto &&f) {
+        try {
+            f();
+        } catch (const std::invalid_argument &) {
+            return true;
+        }
+        return false;
+    };
+    assert(throws([] { graphs::grid_2d(-1, 3); }));
+    assert(throws([] { graphs::grid_3d(5000, 5000, 5000); }));
+    assert(throws([] { graphs::rmat(31, 10); }));
+    graphs::RmatOptions bad;
+    bad.a = 0.9;
+    assert(throws([&] { graphs::rmat(4, 10, bad); }));
+    assert(throws([] { graphs::random_geometric(10, -1.0); }));
+    graphs::GeneratorOptions reversed;
+    reversed.min_weight = 2.0;
+    assert(throws([&] { graphs::grid_2d(2, 2, reversed); }));
+
+    std::cout << "Generadores: todas las pruebas superadas" << std::endl;
+    return 0;
+}
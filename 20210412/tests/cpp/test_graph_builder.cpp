@@ -0,0 +1,170 @@
+#include "graph_builder.hpp"
+#include "graph_io.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#ifndef GLASS_SAMPLES_DIR
+#define GLASS_SAMPLES_DIR "../../data/samples"
+#endif
+
+static bool same_graph(const graphs::Graph &a, const graphs::Graph &b) {
+    return a.offsets().to_vector() == b.offsets().to_vector() &&
+           a.targets().to_vector() == b.targets().to_vector() &&
+           a.weights().to_vector() == b.weights().to_vector();
+}
+
+static void write_file(const std::string &path, const std::string &text) {
+    std::ofstream out(path, std::ios::binary);
+    out << text;
+}
+
+int main() {
+    // Filas ordenadas por destino, deduplicación y simetrización
+    graphs::GraphBuilder builder;
+    builder.add_edge(0, 2, 5.0);
+    builder.add_edge(0, 1, 1.0);
+    builder.add_edge(0, 2, 3.0);
+    builder.add_edge(2, 2, 1.0);
+    builder.add_vertices(4);
+    graphs::Graph g = builder.build();
+    assert(g.num_vertices() == 4 && g.num_edges() == 4);
+    assert(g.target(0) == 1 && g.target(1) == 2 && g.weight(1) == 3.0 && g.weight(2) == 5.0);
+
+    graphs::BuildOptions opts;
+    opts.deduplicate = true;
+    opts.symmetrize = true;
+    opts.drop_self_loops = true;
+    graphs::Graph sym = graphs::build_csr(4, {{0, 2, 5.0}, {0, 1, 1.0}, {0, 2, 3.0}, {2, 2, 1.0}}, opts);
+    assert(sym.num_edges() == 4 && !sym.has_negative_weights());
+    assert(sym.degree(0) == 2 && sym.weight(sym.edge_begin(0) + 1) == 3.0);
+    assert(sym.degree(1) == 1 && sym.target(sym.edge_begin(1)) == 0);
+    assert(sym.degree(2) == 1 && sym.weight(sym.edge_begin(2)) == 3.0);
+    assert(sym.degree(3) == 0);
+
+    graphs::Graph rev = graphs::transpose(g);
+    assert(rev.num_edges() == 4 && rev.degree(0) == 0 && rev.degree(2) == 3);
+    assert(rev.target(rev.edge_begin(2)) == 0 && rev.weight(rev.edge_begin(2)) == 3.0);
+    assert(same_graph(graphs::transpose(rev), g));
+
+    assert(graphs::build_csr(2, {{0, 1, -1.0}}).has_negative_weights());
+    bool threw = false;
+    try {
+        graphs::build_csr(2, {{0, 2, 1.0}});
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    assert(threw);
+
+    // El resultado no depende del número de hilos ni del reparto en lotes
+    std::mt19937 rng(58);
+    const int n = 5000;
+    std::vector<std::vector<graphs::EdgeRecord>> batches(7);
+    std::vector<graphs::EdgeRecord> all;
+    for (int i = 0; i < 200000; ++i) {
+        graphs::EdgeRecord e{static_cast<int>(rng() % n), static_cast<int>(rng() % n),
+                             static_cast<double>(rng() % 10)};
+        batches[i % batches.size()].push_back(e);
+        all.push_back(e);
+    }
+    for (bool dedupe : {false, true}) {
+        graphs::BuildOptions serial, threaded;
+        serial.threads = 1;
+        threaded.threads = 4;
+        serial.deduplicate = threaded.deduplicate = dedupe;
+        serial.symmetrize = threaded.symmetrize = dedupe;
+        graphs::Graph a = graphs::build_csr(n, all, serial);
+        graphs::Graph b = graphs::build_csr(n, batches, threaded);
+        assert(same_graph(a, b));
+        for (int u = 0; u < n; ++u) {
+            for (std::size_t e = a.edge_begin(u) + 1; e < a.edge_end(u); ++e) {
+                assert(a.target(e - 1) < a.target(e) || (!dedupe && a.target(e - 1) == a.target(e)));
+            }
+        }
+    }
+
+    // CSV numérico grande (varios trozos) frente a lectura con un hilo
+    const std::string csv_path = "test_graph_builder_edges.csv";
+    {
+        std::string text;
+        for (const auto &e : all) {
+            text += std::to_string(e.u) + ", " + std::to_string(e.v) + "," + std::to_string(e.w) + "\r\n";
+        }
+        text += "4999\n";
+        write_file(csv_path, text);
+        graphs::BuildOptions one, many;
+        one.threads = 1;
+        many.threads = 4;
+        one.numeric_ids = many.numeric_ids = true;
+        graphs::LabeledGraph a = graphs::read_edge_list_csv(csv_path, one);
+        graphs::LabeledGraph b = graphs::read_edge_list_csv(csv_path, many);
+        assert(a.names.empty() && a.graph.num_vertices() == n);
+        assert(same_graph(a.graph, b.graph));
+        assert(same_graph(a.graph, graphs::build_csr(n, all)));
+        assert(a.find("17") == 17 && a.find("5000") == -1 && a.find("x") == -1);
+
+        // El mismo archivo con nombres: cada trozo numera los suyos y al
+        // fusionarlos se conserva el orden de aparición en todo el archivo.
+        one.numeric_ids = many.numeric_ids = false;
+        graphs::LabeledGraph c = graphs::read_edge_list_csv(csv_path, one);
+        graphs::LabeledGraph d = graphs::read_edge_list_csv(csv_path, many);
+        std::vector<int> index(n, -1);
+        std::vector<std::string> order;
+        auto seen = [&](int v) {
+            if (index[v] < 0) {
+                index[v] = static_cast<int>(order.size());
+                order.push_back(std::to_string(v));
+            }
+            return index[v];
+        };
+        std::vector<graphs::EdgeRecord> renamed;
+        for (const auto &e : all) {
+            const int u = seen(e.u);
+            renamed.push_back({u, seen(e.v), e.w});
+        }
+        seen(4999);
+        assert(c.names == order && d.names == order);
+        assert(same_graph(c.graph, d.graph));
+        assert(same_graph(c.graph, graphs::build_csr(n, renamed)));
+    }
+
+    // Por defecto los números también son nombres: índices por orden de
+    // aparición, sin reservar vértices para identificadores dispersos
+    write_file(csv_path, "1000000000,1\n1,7\n");
+    graphs::LabeledGraph sparse = graphs::read_edge_list_csv(csv_path);
+    assert((sparse.names == std::vector<std::string>{"1000000000", "1", "7"}));
+    assert(sparse.graph.num_vertices() == 3 && sparse.find("7") == 2 && sparse.find("2") == -1);
+
+    // CSV con nombres: índices por orden de aparición
+    write_file(csv_path, "a,b,2\nb,c\n\nd\nc,a,0.5\n");
+    graphs::LabeledGraph named = graphs::read_edge_list_csv(csv_path);
+    assert((named.names == std::vector<std::string>{"a", "b", "c", "d"}));
+    assert(named.graph.num_edges() == 3 && named.graph.weight(0) == 2.0);
+
+    write_file(csv_path, "0,1\n1,2,abc\n");
+    threw = false;
+    try {
+        graphs::read_edge_list_csv(csv_path);
+    } catch (const std::runtime_error &e) {
+        threw = std::string(e.what()).find("línea 2") != std::string::npos;
+    }
+    assert(threw);
+    std::remove(csv_path.c_str());
+
+    // Ejemplos del repositorio
+    const std::string samples = GLASS_SAMPLES_DIR;
+    graphs::LabeledGraph csv = graphs::read_graph_file(samples + "/graph_edges.csv");
+    assert(csv.graph.num_vertices() == 5 && csv.find("4") == 4);
+    graphs::BuildOptions undirected;
+    undirected.symmetrize = true;
+    graphs::LabeledGraph json = graphs::read_graph_file(samples + "/dijkstra_adj.json", undirected);
+    assert(json.graph.num_vertices() == 5 && json.graph.num_edges() == 14);
+
+    std::cout << "Constructor de grafos: todas las pruebas superadas" << std::endl;
+    return 0;
+}
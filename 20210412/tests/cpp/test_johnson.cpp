@@ -0,0 +1,63 @@
+#include "bellman_ford.hpp"
+#include "johnson.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+static bool same(double a, double b) {
+    return (std::isinf(a) && std::isinf(b)) || std::fabs(a - b) < 1e-9;
+}
+
+int main() {
+    // Grafo aleatorio con aristas negativas "hacia delante" y positivas
+    // "hacia atrás" suficientemente grandes para que no haya ciclos negativos.
+    const int n = 40;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::uniform_real_distribution<double> weight(0.0, 5.0);
+    graphs::AdjList adj(n);
+    for (int i = 0; i < 160; ++i) {
+        int u = pick(rng), v = pick(rng);
+        if (u == v) continue;
+        double w = u < v ? weight(rng) - 2.0 : weight(rng) + 100.0;
+        adj[u].push_back({v, w});
+    }
+    graphs::Graph g(adj);
+    assert(g.has_negative_weights());
+
+    // Matriz por bloques (bloques de 16 para que haya bloques incompletos)
+    graphs::TiledDistanceMatrix D = graphs::johnson_apsp(g, 4, 16);
+    assert(D.size() == n);
+    for (int s = 0; s < n; ++s) {
+        auto bf = graphs::bellman_ford(g, s);
+        assert(!bf.negative_cycle);
+        for (int v = 0; v < n; ++v) {
+            assert(same(D.at(s, v), bf.tree.dist[v]));
+        }
+    }
+
+    // Volcado por filas: cada origen se entrega exactamente una vez
+    std::vector<int> seen(n, 0);
+    graphs::johnson_apsp_rows(g, [&](int s, const std::vector<double> &row) {
+        ++seen[s];
+        assert(row == D.row(s));
+    }, 3);
+    for (int c : seen) assert(c == 1);
+
+    // Un ciclo negativo hace fallar el algoritmo
+    adj[1].push_back({0, -50.0});
+    adj[0].push_back({1, 1.0});
+    graphs::Graph neg(adj);
+    bool thrown = false;
+    try {
+        graphs::johnson_apsp(neg);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Todas las pruebas de Johnson se han superado.\n";
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "ksp.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+
+// Enumera por fuerza bruta los costes de todos los caminos simples s -> t.
+static void all_simple_costs(const graphs::Graph &g, int u, int t, double cost,
+                             std::vector<bool> &on_path, std::vector<double> &out) {
+    if (u == t) {
+        out.push_back(cost);
+        return;
+    }
+    on_path[u] = true;
+    for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+        int v = g.target(e);
+        if (!on_path[v]) {
+            all_simple_costs(g, v, t, cost + g.weight(e), on_path, out);
+        }
+    }
+    on_path[u] = false;
+}
+
+int main() {
+    // Ejemplo clásico de Yen: C=0, D=1, E=2, F=3, G=4, H=5
+    graphs::AdjList adj(6);
+    adj[0] = {{1, 3.0}, {2, 2.0}};
+    adj[1] = {{3, 4.0}};
+    adj[2] = {{1, 1.0}, {3, 2.0}, {4, 3.0}};
+    adj[3] = {{4, 2.0}, {5, 1.0}};
+    adj[4] = {{5, 2.0}};
+    graphs::Graph g(adj);
+    auto paths = graphs::k_shortest_paths(g, 0, 5, 3, 2);
+    assert(paths.size() == 3);
+    assert((paths[0].vertices == std::vector<int>{0, 2, 3, 5}) && paths[0].cost == 5.0);
+    assert((paths[1].vertices == std::vector<int>{0, 2, 4, 5}) && paths[1].cost == 7.0);
+    assert((paths[2].vertices == std::vector<int>{0, 1, 3, 5}) && paths[2].cost == 8.0);
+
+    // Pedir más caminos de los que existen devuelve todos los simples
+    auto all = graphs::k_shortest_paths(g, 0, 5, 100);
+    std::vector<bool> on_path(6, false);
+    std::vector<double> brute;
+    all_simple_costs(g, 0, 5, 0.0, on_path, brute);
+    assert(all.size() == brute.size());
+
+    // Comparación con fuerza bruta en un grafo aleatorio, reutilizando la reserva
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> pick(0, 9);
+    std::uniform_real_distribution<double> weight(1.0, 9.0);
+    graphs::AdjList radj(10);
+    for (int i = 0; i < 30; ++i) {
+        int u = pick(rng), v = pick(rng);
+        if (u != v) radj[u].push_back({v, weight(rng)});
+    }
+    graphs::Graph rg(radj);
+    graphs::SearchPool pool;
+    for (int t = 1; t < 10; ++t) {
+        std::vector<bool> mark(10, false);
+        std::vector<double> costs;
+        all_simple_costs(rg, 0, t, 0.0, mark, costs);
+        std::sort(costs.begin(), costs.end());
+        auto ksp = graphs::k_shortest_paths(rg, 0, t, 5, pool, 3);
+        assert(ksp.size() == std::min<std::size_t>(5, costs.size()));
+        for (std::size_t i = 0; i < ksp.size(); ++i) {
+            assert(std::fabs(ksp[i].cost - costs[i]) < 1e-9);
+            // Los caminos son simples y empiezan y acaban donde deben
+            auto vs = ksp[i].vertices;
+            assert(vs.front() == 0 && vs.back() == t);
+            std::sort(vs.begin(), vs.end());
+            assert(std::adjacent_find(vs.begin(), vs.end()) == vs.end());
+        }
+    }
+    assert(pool.idle() > 0);
+    std::cout << "Todas las pruebas de k caminos mínimos se han superado.\n";
+    return 0;
+}
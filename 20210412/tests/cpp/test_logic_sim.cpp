@@ -0,0 +1,269 @@
+#include "logic_sim.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using graphs::Circuit;
+using graphs::GateKind;
+
+static const GateKind kBinary[] = {GateKind::And, GateKind::Or, GateKind::Xor,
+                                   GateKind::Nand, GateKind::Nor, GateKind::Xnor};
+
+static Circuit random_circuit(std::mt19937 &rng, unsigned inputs, unsigned gates, unsigned outputs) {
+    Circuit c(inputs);
+    for (unsigned g = 0; g < gates; ++g) {
+        const auto size = static_cast<std::uint32_t>(c.size());
+        if (rng() % 8 == 0) {
+            c.add_gate(rng() % 2 ? GateKind::Not : GateKind::Buf, rng() % size);
+        } else {
+            c.add_gate(kBinary[rng() % 6], rng() % size, rng() % size);
+        }
+    }
+    for (unsigned o = 0; o < outputs; ++o) {
+        c.add_output(static_cast<std::uint32_t>(c.size() - 1 - rng() % std::min<std::size_t>(c.size(), 8)));
+    }
+    return c;
+}
+
+// Misma función con cada puerta reescrita por De Morgan.  `mutate` cambia el
+// tipo de esa puerta (si es binaria).
+static Circuit de_morgan(const Circuit &c, std::size_t mutate = ~std::size_t(0)) {
+    Circuit out(c.inputs());
+    std::vector<std::uint32_t> map(c.size());
+    unsigned next_input = 0;
+    for (std::uint32_t i = 0; i < c.size(); ++i) {
+        const Circuit::Node &n = c.node(i);
+        if (n.kind == GateKind::Input) {
+            map[i] = out.input(next_input++);
+            continue;
+        }
+        if (n.kind == GateKind::Const0 || n.kind == GateKind::Const1) {
+            map[i] = out.constant(n.kind == GateKind::Const1);
+            continue;
+        }
+        const std::uint32_t a = map[n.a], b = map[n.b];
+        GateKind kind = n.kind;
+        if (i == mutate && kind >= GateKind::And) {
+            kind = kind == GateKind::And ? GateKind::Or : GateKind::And;
+        }
+        switch (kind) {
+        case GateKind::And:
+            map[i] = out.add_gate(GateKind::Nor, out.add_gate(GateKind::Not, a), out.add_gate(GateKind::Not, b));
+            break;
+        case GateKind::Or:
+            map[i] = out.add_gate(GateKind::Nand, out.add_gate(GateKind::Not, a), out.add_gate(GateKind::Not, b));
+            break;
+        case GateKind::Nand:
+            map[i] = out.add_gate(GateKind::Or, out.add_gate(GateKind::Not, a), out.add_gate(GateKind::Not, b));
+            break;
+        case GateKind::Nor:
+            map[i] = out.add_gate(GateKind::And, out.add_gate(GateKind::Not, a), out.add_gate(GateKind::Not, b));
+            break;
+        case GateKind::Xor:
+            map[i] = out.add_gate(GateKind::Xnor, out.add_gate(GateKind::Not, a), b);
+            break;
+        case GateKind::Xnor:
+            map[i] = out.add_gate(GateKind::Xor, out.add_gate(GateKind::Not, a), b);
+            break;
+        case GateKind::Not:
+            map[i] = out.add_gate(GateKind::Nand, a, a);
+            break;
+        default:
+            map[i] = out.add_gate(GateKind::Buf, a);
+            break;
+        }
+    }
+    for (std::uint32_t o : c.outputs()) {
+        out.add_output(map[o]);
+    }
+    return out;
+}
+
+// Sumador de `bits` bits: entradas a0..a(bits-1), b0..; salidas s0.. y
+// acarreo.  `majority` elige la forma del acarreo.
+static Circuit adder(unsigned bits, bool majority) {
+    Circuit c(2 * bits);
+    std::uint32_t carry = c.constant(false);
+    for (unsigned i = 0; i < bits; ++i) {
+        const std::uint32_t a = c.input(i), b = c.input(bits + i);
+        const std::uint32_t half = c.add_gate(GateKind::Xor, a, b);
+        c.add_output(c.add_gate(GateKind::Xor, half, carry));
+        const std::uint32_t both = c.add_gate(GateKind::And, a, b);
+        if (majority) {
+            carry = c.add_gate(GateKind::Or, both,
+                               c.add_gate(GateKind::Or, c.add_gate(GateKind::And, a, carry),
+                                          c.add_gate(GateKind::And, b, carry)));
+        } else {
+            carry = c.add_gate(GateKind::Or, both, c.add_gate(GateKind::And, carry, half));
+        }
+    }
+    c.add_output(carry);
+    return c;
+}
+
+int main() {
+    std::mt19937 rng(74);
+
+    // Construcción y evaluación puntual.
+    {
+        Circuit c(2);
+        const auto x = c.add_gate(GateKind::Xor, c.input(0), c.input(1));
+        c.add_output(x, "x");
+        c.add_output(c.add_gate(GateKind::Nand, c.input(0), c.input(1)));
+        assert((graphs::evaluate(c, 0b01) == std::vector<bool>{true, true}));
+        assert((graphs::evaluate(c, 0b11) == std::vector<bool>{false, false}));
+        assert(c.output_names()[0] == "x" && c.output_names()[1] == "y1" && c.input_names()[1] == "x1");
+    }
+
+    // Tabla de verdad frente a la evaluación vector a vector, con cada
+    // anchura de instrucción y con varios hilos.
+    for (int round = 0; round < 24; ++round) {
+        const unsigned n = 1 + round % 12;
+        const Circuit c = random_circuit(rng, n, 30 + round * 3, 1 + round % 3);
+        for (unsigned lanes : {64u, 256u, 512u}) {
+            graphs::SimOptions opts;
+            opts.lanes = lanes;
+            opts.threads = 1 + round % 3;
+            const auto table = graphs::truth_table(c, opts);
+            for (std::uint64_t t = 0; t < (std::uint64_t(1) << n); ++t) {
+                const std::vector<bool> expected = graphs::evaluate(c, t);
+                for (std::size_t o = 0; o < expected.size(); ++o) {
+                    assert(((table[o][t / 64] >> (t % 64)) & 1) == expected[o]);
+                }
+            }
+            if (n < 6) {
+                assert(table[0][0] >> (std::uint64_t(1) << n) == 0);
+            }
+        }
+    }
+    assert(graphs::simd_lanes() == 64 || graphs::simd_lanes() == 256 || graphs::simd_lanes() == 512);
+
+    // Equivalencia: reescritura por De Morgan (equivalente) y con una puerta
+    // cambiada; el contraejemplo es el primero de la búsqueda exhaustiva.
+    for (int round = 0; round < 30; ++round) {
+        const unsigned n = 2 + round % 14;
+        const Circuit a = random_circuit(rng, n, 40, 2);
+        graphs::SimOptions opts;
+        opts.threads = 1 + round % 4;
+        opts.lanes = round % 2 ? 64 : 0;
+        const auto same = graphs::check_equivalence(a, de_morgan(a), opts);
+        assert(same.equivalent && same.evaluated == (std::uint64_t(1) << n));
+
+        const Circuit b = de_morgan(a, n + rng() % 40);
+        std::uint64_t first = ~std::uint64_t(0);
+        unsigned output = 0;
+        for (std::uint64_t t = 0; t < (std::uint64_t(1) << n) && first == ~std::uint64_t(0); ++t) {
+            const auto va = graphs::evaluate(a, t), vb = graphs::evaluate(b, t);
+            for (unsigned o = 0; o < va.size(); ++o) {
+                if (va[o] != vb[o]) {
+                    first = t;
+                    output = o;
+                    break;
+                }
+            }
+        }
+        const auto diff = graphs::check_equivalence(a, b, opts);
+        assert(diff.equivalent == (first == ~std::uint64_t(0)));
+        if (!diff.equivalent) {
+            assert(diff.counterexample == first && diff.output == output);
+        }
+    }
+
+    // Sumadores de 10 bits (20 entradas): dos formas del acarreo.  Con un
+    // error en el acarreo, el contraejemplo se detiene pronto.
+    {
+        const Circuit ripple = adder(10, false), majority = adder(10, true);
+        const auto start = std::chrono::steady_clock::now();
+        const auto r = graphs::check_equivalence(ripple, majority);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        assert(r.equivalent && r.evaluated == (std::uint64_t(1) << 20));
+        std::cout << "Sumador de 10 bits: 2^20 vectores en " << seconds << " s (" << graphs::simd_lanes()
+                  << " vectores por instrucción)" << std::endl;
+
+        std::vector<std::string> names, exprs;
+        for (unsigned i = 0; i < 20; ++i) {
+            names.push_back((i < 10 ? "a" : "b") + std::to_string(i % 10));
+        }
+        for (unsigned i = 0; i < 11; ++i) {
+            exprs.push_back(i == 10 ? "a9 & b9" : "a" + std::to_string(i) + " ^ b" + std::to_string(i));
+        }
+        const auto wrong = graphs::check_equivalence(ripple, graphs::parse_expressions(exprs, names));
+        // a0 = b0 = 1 es el primer vector con acarreo.
+        assert(!wrong.equivalent && wrong.counterexample == ((1u << 10) | 1u) && wrong.output == 1);
+        assert(wrong.evaluated < (std::uint64_t(1) << 20));
+    }
+
+    // ISCAS c17 frente a su función escrita a mano.
+    {
+        std::istringstream in("# c17\n"
+                              "INPUT(1)\nINPUT(2)\nINPUT(3)\nINPUT(6)\nINPUT(7)\n"
+                              "OUTPUT(22)\nOUTPUT(23)\n"
+                              "22 = NAND(10, 16)\n23 = NAND(16, 19)\n"
+                              "10 = NAND(1, 3)\n11 = NAND(3, 6)\n16 = NAND(2, 11)\n19 = NAND(11, 7)\n");
+        const Circuit c17 = graphs::parse_bench(in);
+        assert(c17.inputs() == 5 && c17.outputs().size() == 2 && c17.output_names()[1] == "23");
+        const Circuit spec =
+            graphs::parse_expressions({"(a & c) | (b & ~c) | (b & ~d)", "(~c | ~d) & (b | e)"}, {"a", "b", "c", "d", "e"});
+        assert(graphs::check_equivalence(c17, spec).equivalent);
+
+        std::istringstream wide("INPUT(a)\nINPUT(b)\nINPUT(c)\nOUTPUT(z)\nz = NOR(a, b, c)\n");
+        const Circuit nor3 = graphs::parse_bench(wide);
+        assert(graphs::check_equivalence(nor3, graphs::parse_expressions({"~(a | b | c)"}, {"a", "b", "c"})).equivalent);
+    }
+
+    // Errores.
+    for (const char *bad : {"INPUT(a)\nOUTPUT(z)\nz = DFF(a)\n", "INPUT(a)\nOUTPUT(z)\nz = AND(a, w)\n",
+                            "INPUT(a)\nOUTPUT(z)\nz = AND(a, w)\nw = OR(z, a)\n", "INPUT(a)\nOUTPUT(z)\nz AND(a)\n",
+                            "INPUT(a)\nOUTPUT(z)\nz = NOT(a, a)\n"}) {
+        bool threw = false;
+        try {
+            std::istringstream in(bad);
+            graphs::parse_bench(in);
+        } catch (const std::runtime_error &e) {
+            threw = std::string(e.what()).find("línea") != std::string::npos;
+        }
+        assert(threw);
+    }
+    for (const char *bad : {"a &", "a & q", "(a | b", "a b"}) {
+        bool threw = false;
+        try {
+            graphs::parse_expressions({bad}, {"a", "b"});
+        } catch (const std::invalid_argument &) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    bool threw = false;
+    try {
+        graphs::check_equivalence(Circuit(2), Circuit(3));
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        Circuit c(1);
+        c.add_gate(GateKind::And, 0, 5);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        graphs::load_bench("/nonexistent/c17.bench");
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Simulación por rodajas de bits: todas las pruebas superadas" << std::endl;
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "dijkstra.hpp"
+#include "query_server.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+static graphs::Graph random_graph(int n, int m, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::uniform_real_distribution<double> weight(1.0, 10.0);
+    graphs::AdjList adj(n);
+    for (int i = 0; i < m; ++i) {
+        adj[vertex(rng)].push_back({vertex(rng), weight(rng)});
+    }
+    return graphs::Graph(adj);
+}
+
+int main() {
+    const int n = 3000;
+    const graphs::Graph g = random_graph(n, 15000, 66);
+    const graphs::SharedGraph shared(g);
+    const graphs::SharedGraph copy = shared;
+    assert(&copy.graph() == &shared.graph() && shared.use_count() == 2);
+    assert(copy.num_vertices() == n && copy.num_edges() == g.num_edges());
+
+    // Respuestas de referencia desde unos pocos orígenes.
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::vector<int> sources = {0, 1, 2, 3, 4, 5, 6, 7};
+    std::vector<std::vector<double>> ref;
+    for (int s : sources) {
+        ref.push_back(graphs::dijkstra(g, s));
+    }
+    std::vector<graphs::QueryRequest> requests;
+    for (int i = 0; i < 2000; ++i) {
+        requests.push_back({sources[i % sources.size()], vertex(rng)});
+    }
+    requests.push_back({5, 5});
+
+    // Lote en paralelo: mismas distancias y caminos coherentes.
+    const graphs::QueryServer server(shared);
+    graphs::BatchOptions opts;
+    opts.threads = 4;
+    opts.paths = true;
+    const graphs::BatchResult r = server.run(requests, opts);
+    assert(r.cost.size() == requests.size() && r.paths.size() == requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        const double expected = ref[requests[i].source][requests[i].target];
+        assert(r.cost[i] == expected);
+        const auto &p = r.paths[i];
+        if (std::isinf(expected)) {
+            assert(p.empty());
+            continue;
+        }
+        assert(p.front() == requests[i].source && p.back() == requests[i].target);
+        double cost = 0.0;
+        for (std::size_t k = 0; k + 1 < p.size(); ++k) {
+            double best = INFINITY;
+            for (std::size_t e = g.edge_begin(p[k]); e < g.edge_end(p[k]); ++e) {
+                if (g.target(e) == p[k + 1]) {
+                    best = std::min(best, g.weight(e));
+                }
+            }
+            cost += best;
+        }
+        assert(std::fabs(cost - expected) < 1e-9);
+    }
+    assert(r.cost.back() == 0.0 && r.paths.back() == std::vector<int>{5});
+
+    // Estadísticas del lote y workspaces devueltos a la reserva.
+    const graphs::LatencyStats &s = r.stats;
+    assert(s.queries == requests.size() && s.seconds > 0.0 && s.throughput > 0.0);
+    assert(s.p50 <= s.p90 && s.p90 <= s.p99 && s.p99 <= s.max && s.mean <= s.max);
+    assert(server.idle_workspaces() == 4);
+    assert(server.run(requests, {2, false}).paths.empty());
+    assert(server.idle_workspaces() == 4);
+    std::cout << "Lote: " << s.throughput << " consultas/s, p50 " << s.p50 << " us, p99 " << s.p99
+              << " us" << std::endl;
+
+    // Consultas individuales desde hilos propios sobre el mismo servidor.
+    {
+        std::vector<std::thread> pool;
+        std::vector<int> errors(4, 0);
+        for (int t = 0; t < 4; ++t) {
+            pool.emplace_back([&, t] {
+                for (std::size_t i = t; i < requests.size(); i += 4) {
+                    const double d = server.distance(requests[i].source, requests[i].target);
+                    errors[t] += d != r.cost[i];
+                }
+            });
+        }
+        for (auto &th : pool) {
+            th.join();
+        }
+        assert(errors == std::vector<int>(4, 0));
+        assert(server.idle_workspaces() >= 4);
+    }
+
+    // Percentiles por rango más cercano.
+    {
+        std::vector<double> lat;
+        for (int i = 100; i >= 1; --i) {
+            lat.push_back(i);
+        }
+        const graphs::LatencyStats st = graphs::summarize_latencies(lat, 2.0);
+        assert(st.p50 == 50 && st.p90 == 90 && st.p99 == 99 && st.max == 100);
+        assert(st.mean == 50.5 && st.throughput == 50.0);
+        std::vector<double> none;
+        assert(graphs::summarize_latencies(none, 1.0).throughput == 0.0);
+        assert(server.run({}).stats.queries == 0);
+    }
+
+    bool threw = false;
+    try {
+        server.run({{0, 1}, {0, n}});
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        graphs::QueryServer(graphs::SharedGraph(graphs::AdjList{{{1, -1.0}}, {}}));
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Servidor de consultas: todas las pruebas superadas" << std::endl;
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "quine_mccluskey.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using graphs::Cube;
+
+// Traducción literal de _quine_mccluskey (lib/boolean_logic.py) con cadenas.
+static std::vector<std::string> reference(const std::vector<std::uint64_t> &minterms,
+                                          const std::vector<std::uint64_t> &dont_cares, unsigned n) {
+    auto to_bits = [n](std::uint64_t t) {
+        std::string s(n, '0');
+        for (unsigned i = 0; i < n; ++i) {
+            s[n - 1 - i] = (t >> i) & 1 ? '1' : '0';
+        }
+        return s;
+    };
+    std::map<int, std::vector<std::string>> groups;
+    std::set<std::uint64_t> terms(minterms.begin(), minterms.end());
+    terms.insert(dont_cares.begin(), dont_cares.end());
+    for (std::uint64_t t : terms) {
+        const std::string s = to_bits(t);
+        groups[static_cast<int>(std::count(s.begin(), s.end(), '1'))].push_back(s);
+    }
+    std::set<std::string> primes;
+    while (!groups.empty()) {
+        std::set<std::string> used, next;
+        for (const auto &g : groups) {
+            const auto up = groups.find(g.first + 1);
+            if (up == groups.end()) {
+                continue;
+            }
+            for (const std::string &a : g.second) {
+                for (const std::string &b : up->second) {
+                    int diff = 0;
+                    std::string c = a;
+                    for (unsigned i = 0; i < n; ++i) {
+                        if (a[i] != b[i]) {
+                            ++diff;
+                            c[i] = '-';
+                        }
+                    }
+                    if (diff == 1) {
+                        used.insert(a);
+                        used.insert(b);
+                        next.insert(c);
+                    }
+                }
+            }
+        }
+        for (const auto &g : groups) {
+            for (const std::string &t : g.second) {
+                if (!used.count(t)) {
+                    primes.insert(t);
+                }
+            }
+        }
+        groups.clear();
+        for (const std::string &t : next) {
+            groups[static_cast<int>(std::count(t.begin(), t.end(), '1'))].push_back(t);
+        }
+    }
+    std::vector<std::string> out;
+    for (const std::string &p : primes) {
+        const Cube c = graphs::pattern_to_cube(p);
+        if (std::any_of(minterms.begin(), minterms.end(), [&](std::uint64_t m) { return c.covers(m); })) {
+            out.push_back(p);
+        }
+    }
+    return out;
+}
+
+static void random_function(std::mt19937 &rng, unsigned n, double on, double dc, std::vector<std::uint64_t> &minterms,
+                            std::vector<std::uint64_t> &dont_cares) {
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    minterms.clear();
+    dont_cares.clear();
+    for (std::uint64_t t = 0; t < (std::uint64_t(1) << n); ++t) {
+        const double x = u(rng);
+        if (x < on) {
+            minterms.push_back(t);
+        } else if (x < on + dc) {
+            dont_cares.push_back(t);
+        }
+    }
+}
+
+int main() {
+    // Resultados de minimize_function en Python.
+    assert(graphs::quine_mccluskey({3, 5, 6, 7}, {}, 3) == (std::vector<std::string>{"-11", "1-1", "11-"}));
+    assert(graphs::quine_mccluskey({1, 3, 7, 11, 15}, {0, 2, 5}, 4) ==
+           (std::vector<std::string>{"--11", "0--1", "00--"}));
+    assert(graphs::quine_mccluskey({4, 8, 10, 11, 12, 15}, {9, 14}, 4) ==
+           (std::vector<std::string>{"-100", "1--0", "1-1-", "10--"}));
+    assert(graphs::quine_mccluskey({0, 1, 2, 5, 6, 7, 8, 9, 10, 14}, {}, 4) ==
+           (std::vector<std::string>{"--10", "-0-0", "-00-", "0-01", "01-1", "011-"}));
+    assert(graphs::quine_mccluskey({}, {1, 2}, 2).empty());
+    assert(graphs::quine_mccluskey({0, 1, 2, 3}, {}, 2) == std::vector<std::string>{"--"});
+
+    // Funciones aleatorias frente a la traducción de Python, con 1 y 4 hilos.
+    std::mt19937 rng(71);
+    for (int round = 0; round < 30; ++round) {
+        const unsigned n = 3 + round % 6;
+        std::vector<std::uint64_t> on, dc;
+        random_function(rng, n, 0.4, 0.15, on, dc);
+        const auto ref = reference(on, dc, n);
+        for (unsigned threads : {1u, 4u}) {
+            graphs::QmOptions opts;
+            opts.threads = threads;
+            assert(graphs::quine_mccluskey(on, dc, n, opts) == ref);
+        }
+    }
+
+    // 12 variables: cada resultado es un implicante primo y cubre algún
+    // mintérmino; todo mintérmino queda cubierto.
+    {
+        const unsigned n = 12;
+        std::vector<std::uint64_t> on, dc;
+        random_function(rng, n, 0.45, 0.2, on, dc);
+        std::vector<char> value(std::size_t(1) << n, 0);
+        for (std::uint64_t m : on) {
+            value[m] = 1;
+        }
+        for (std::uint64_t m : dc) {
+            value[m] = 2;
+        }
+        auto implicant = [&](const Cube &c) {
+            const std::uint64_t free = ((std::uint64_t(1) << n) - 1) & ~c.mask;
+            std::uint64_t sub = 0;
+            do {
+                if (!value[c.value | sub]) {
+                    return false;
+                }
+                sub = (sub - free) & free;
+            } while (sub);
+            return true;
+        };
+        graphs::QmOptions opts;
+        opts.threads = 4;
+        const auto primes = graphs::prime_implicants(on, dc, n, opts);
+        opts.threads = 1;
+        assert(primes == graphs::prime_implicants(on, dc, n, opts));
+        for (const Cube &c : primes) {
+            assert(implicant(c));
+            for (std::uint64_t rest = c.mask; rest; rest &= rest - 1) {
+                const std::uint64_t bit = rest & (~rest + 1);
+                assert(!implicant({c.value & ~bit, c.mask & ~bit}));
+            }
+            assert(std::any_of(on.begin(), on.end(), [&](std::uint64_t m) { return c.covers(m); }));
+        }
+        for (std::uint64_t m : on) {
+            assert(std::any_of(primes.begin(), primes.end(), [&](const Cube &c) { return c.covers(m); }));
+        }
+    }
+
+    // Patrones y errores.
+    const Cube c = graphs::pattern_to_cube("1-0");
+    assert(c.value == 4 && c.mask == 5 && graphs::cube_to_pattern(c, 3) == "1-0");
+    bool threw = false;
+    try {
+        graphs::quine_mccluskey({8}, {}, 3);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        graphs::pattern_to_cube("1x0");
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Quine-McCluskey: todas las pruebas superadas" << std::endl;
+    return 0;
+}
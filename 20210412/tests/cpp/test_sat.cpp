@@ -0,0 +1,239 @@
+#include "sat.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using graphs::SatResult;
+using graphs::SatSolver;
+using Cnf = std::vector<std::vector<int>>;
+
+static Cnf random_3sat(std::mt19937 &rng, int vars, int clauses) {
+    Cnf cnf;
+    for (int c = 0; c < clauses; ++c) {
+        std::vector<int> clause;
+        for (int k = 0; k < 3; ++k) {
+            const int v = 1 + static_cast<int>(rng() % vars);
+            clause.push_back(rng() % 2 ? v : -v);
+        }
+        cnf.push_back(clause);
+    }
+    return cnf;
+}
+
+static bool satisfies(const Cnf &cnf, std::uint32_t assignment) {
+    for (const auto &clause : cnf) {
+        bool sat = false;
+        for (int l : clause) {
+            sat = sat || (((assignment >> (std::abs(l) - 1)) & 1) == (l > 0 ? 1u : 0u));
+        }
+        if (!sat) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool brute_force(const Cnf &cnf, int vars) {
+    for (std::uint32_t t = 0; t < (std::uint32_t(1) << vars); ++t) {
+        if (satisfies(cnf, t)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool model_satisfies(const SatSolver &s, const Cnf &cnf) {
+    for (const auto &clause : cnf) {
+        bool sat = false;
+        for (int l : clause) {
+            sat = sat || s.value(l);
+        }
+        if (!sat) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// n + 1 palomas en n huecos: insatisfacible y difícil para la resolución.
+static Cnf pigeonhole(int holes) {
+    Cnf cnf;
+    auto var = [holes](int p, int h) { return p * holes + h + 1; };
+    for (int p = 0; p <= holes; ++p) {
+        std::vector<int> some;
+        for (int h = 0; h < holes; ++h) {
+            some.push_back(var(p, h));
+        }
+        cnf.push_back(some);
+    }
+    for (int h = 0; h < holes; ++h) {
+        for (int p = 0; p <= holes; ++p) {
+            for (int q = p + 1; q <= holes; ++q) {
+                cnf.push_back({-var(p, h), -var(q, h)});
+            }
+        }
+    }
+    return cnf;
+}
+
+int main() {
+    std::mt19937 rng(75);
+
+    // 3-SAT aleatorio cerca del umbral frente a fuerza bruta.
+    for (int round = 0; round < 200; ++round) {
+        const int n = 3 + round % 12;
+        const Cnf cnf = random_3sat(rng, n, static_cast<int>(4.26 * n) + 1);
+        SatSolver s;
+        for (const auto &c : cnf) {
+            s.add_clause(c);
+        }
+        const SatResult r = s.solve();
+        assert((r == SatResult::Sat) == brute_force(cnf, n));
+        if (r == SatResult::Sat) {
+            assert(model_satisfies(s, cnf));
+        }
+    }
+
+    // Instancias mayores: fuerzan reinicios y borrado de aprendidas.
+    {
+        std::uint64_t deleted = 0;
+        for (int round = 0; round < 6; ++round) {
+            const Cnf cnf = random_3sat(rng, 170, 720);
+            SatSolver s;
+            for (const auto &c : cnf) {
+                s.add_clause(c);
+            }
+            const SatResult r = s.solve();
+            assert(r != SatResult::Unknown);
+            if (r == SatResult::Sat) {
+                assert(model_satisfies(s, cnf));
+            }
+            deleted += s.stats().deleted;
+        }
+        std::cout << "3-SAT con 170 variables: " << deleted << " cláusulas aprendidas borradas" << std::endl;
+    }
+
+    // Palomar.
+    for (int holes = 2; holes <= 6; ++holes) {
+        SatSolver s;
+        for (const auto &c : pigeonhole(holes)) {
+            s.add_clause(c);
+        }
+        assert(s.solve() == SatResult::Unsat && s.failed_assumptions().empty());
+        assert(!s.okay() && s.solve() == SatResult::Unsat);
+    }
+    {
+        SatSolver s;
+        for (const auto &c : pigeonhole(10)) {
+            s.add_clause(c);
+        }
+        assert(s.solve({}, 50) == SatResult::Unknown && s.stats().conflicts == 50);
+        assert(s.okay());
+    }
+
+    // Incremental: suposiciones y cláusulas nuevas entre llamadas.
+    for (int round = 0; round < 60; ++round) {
+        const int n = 8 + round % 6;
+        Cnf cnf = random_3sat(rng, n, 2 * n);
+        SatSolver s(n);
+        for (const auto &c : cnf) {
+            s.add_clause(c);
+        }
+        for (int step = 0; step < 12; ++step) {
+            std::vector<int> assumptions;
+            for (int k = 0; k < 1 + step % 5; ++k) {
+                const int v = 1 + static_cast<int>(rng() % n);
+                assumptions.push_back(rng() % 2 ? v : -v);
+            }
+            Cnf with = cnf;
+            for (int a : assumptions) {
+                with.push_back({a});
+            }
+            const SatResult r = s.solve(assumptions);
+            assert((r == SatResult::Sat) == brute_force(with, n));
+            if (r == SatResult::Sat) {
+                assert(model_satisfies(s, with));
+            } else if (s.okay()) {
+                // Las suposiciones culpables son un subconjunto que basta.
+                Cnf core = cnf;
+                for (int f : s.failed_assumptions()) {
+                    bool listed = false;
+                    for (int a : assumptions) {
+                        listed = listed || a == f;
+                    }
+                    assert(listed);
+                    core.push_back({f});
+                }
+                assert(!s.failed_assumptions().empty() && !brute_force(core, n));
+            }
+            if (step % 3 == 2) {
+                const auto extra = random_3sat(rng, n, 1)[0];
+                cnf.push_back(extra);
+                s.add_clause(extra);
+            }
+        }
+    }
+
+    // Suposiciones contradictorias y cláusulas triviales.
+    {
+        SatSolver s;
+        assert(s.add_clause({1, -1}) && s.add_clause({1, 2, 1}));
+        assert(s.clauses() == 1 && s.vars() == 2);
+        assert(s.solve({-1, -2}) == SatResult::Unsat && s.failed_assumptions().size() == 2);
+        assert(s.solve({3, -3}) == SatResult::Unsat);
+        assert(s.solve({-2}) == SatResult::Sat && s.value(1) && !s.value(-1));
+        assert(s.add_clause({-1}) && s.solve() == SatResult::Sat && s.value(2));
+        assert(!s.add_clause({-2}) && !s.okay());
+    }
+
+    // DIMACS.
+    {
+        std::istringstream in("c ejemplo\np cnf 3 4\n1 2 0\n-1 3\n0\n-2 -3 0\n-3 0\n%\n0\n");
+        SatSolver s = graphs::parse_dimacs(in);
+        assert(s.vars() == 3 && s.solve() == SatResult::Sat);
+        assert(!s.value(3) && !s.value(1) && s.value(2));
+    }
+    for (const char *bad : {"1 2 0\n", "p cnf 2 1\n1 3 0\n", "p cnf 2 1\n1 x 0\n", "p cnf 2 1\n1 2\n", "p dnf 2 1\n"}) {
+        bool threw = false;
+        try {
+            std::istringstream in(bad);
+            graphs::parse_dimacs(in);
+        } catch (const std::runtime_error &e) {
+            threw = std::string(e.what()).find("línea") != std::string::npos;
+        }
+        assert(threw);
+    }
+    bool threw = false;
+    try {
+        graphs::load_dimacs("/nonexistent/f.cnf");
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        SatSolver s;
+        s.add_clause({1, 0});
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        SatSolver s(2);
+        s.value(1);
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "SAT: todas las pruebas superadas" << std::endl;
+    return 0;
+}
@@ -0,0 +1,273 @@
+#include "sat_equivalence.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using graphs::Circuit;
+using graphs::GateKind;
+using graphs::SatResult;
+
+static const GateKind kBinary[] = {GateKind::And, GateKind::Or, GateKind::Xor,
+                                   GateKind::Nand, GateKind::Nor, GateKind::Xnor};
+
+static Circuit random_circuit(std::mt19937 &rng, unsigned inputs, unsigned gates, unsigned outputs) {
+    Circuit c(inputs);
+    for (unsigned g = 0; g < gates; ++g) {
+        const auto size = static_cast<std::uint32_t>(c.size());
+        if (rng() % 8 == 0) {
+            c.add_gate(rng() % 2 ? GateKind::Not : GateKind::Buf, rng() % size);
+        } else {
+            c.add_gate(kBinary[rng() % 6], rng() % size, rng() % size);
+        }
+    }
+    for (unsigned o = 0; o < outputs; ++o) {
+        c.add_output(static_cast<std::uint32_t>(c.size() - 1 - rng() % std::min<std::size_t>(c.size(), 8)));
+    }
+    return c;
+}
+
+// Copia de `c` con la puerta `mutate` (si es binaria) cambiada de tipo y
+// las AND reescritas como NOR de negaciones.
+static Circuit rewrite(const Circuit &c, std::size_t mutate = ~std::size_t(0)) {
+    Circuit out(c.inputs());
+    std::vector<std::uint32_t> map(c.size());
+    unsigned next_input = 0;
+    for (std::uint32_t i = 0; i < c.size(); ++i) {
+        const Circuit::Node &n = c.node(i);
+        if (n.kind == GateKind::Input) {
+            map[i] = out.input(next_input++);
+        } else if (n.kind == GateKind::Const0 || n.kind == GateKind::Const1) {
+            map[i] = out.constant(n.kind == GateKind::Const1);
+        } else {
+            GateKind kind = n.kind;
+            if (i == mutate && kind >= GateKind::And) {
+                kind = kind == GateKind::And ? GateKind::Or : GateKind::And;
+            }
+            if (kind == GateKind::And) {
+                map[i] = out.add_gate(GateKind::Nor, out.add_gate(GateKind::Not, map[n.a]),
+                                      out.add_gate(GateKind::Not, map[n.b]));
+            } else {
+                map[i] = out.add_gate(kind, map[n.a], map[n.b]);
+            }
+        }
+    }
+    for (std::uint32_t o : c.outputs()) {
+        out.add_output(map[o]);
+    }
+    return out;
+}
+
+// Evaluación con cualquier número de entradas.
+static std::vector<bool> simulate(const Circuit &c, const std::vector<bool> &inputs) {
+    std::vector<bool> value(c.size());
+    unsigned next_input = 0;
+    for (std::uint32_t i = 0; i < c.size(); ++i) {
+        const Circuit::Node &n = c.node(i);
+        const bool a = n.kind == GateKind::Input ? false : value[n.a], b = value[n.b];
+        switch (n.kind) {
+        case GateKind::Input: value[i] = inputs[next_input++]; break;
+        case GateKind::Const0: value[i] = false; break;
+        case GateKind::Const1: value[i] = true; break;
+        case GateKind::Buf: value[i] = a; break;
+        case GateKind::Not: value[i] = !a; break;
+        case GateKind::And: value[i] = a && b; break;
+        case GateKind::Or: value[i] = a || b; break;
+        case GateKind::Xor: value[i] = a != b; break;
+        case GateKind::Nand: value[i] = !(a && b); break;
+        case GateKind::Nor: value[i] = !(a || b); break;
+        case GateKind::Xnor: value[i] = a == b; break;
+        }
+    }
+    std::vector<bool> out;
+    for (std::uint32_t o : c.outputs()) {
+        out.push_back(value[o]);
+    }
+    return out;
+}
+
+// Sumadores de `bits` bits (entradas a0.., b0..; salidas s0.. y acarreo):
+// acarreo en serie con una de dos formas, o prefijos de Kogge-Stone.
+// `bug` invierte el acarreo que entra en ese bit.
+static Circuit ripple_adder(unsigned bits, bool majority, unsigned bug = ~0u) {
+    Circuit c(2 * bits);
+    std::uint32_t carry = c.constant(false);
+    for (unsigned i = 0; i < bits; ++i) {
+        const std::uint32_t a = c.input(i), b = c.input(bits + i);
+        if (i == bug) {
+            carry = c.add_gate(GateKind::Not, carry);
+        }
+        const std::uint32_t half = c.add_gate(GateKind::Xor, a, b);
+        c.add_output(c.add_gate(GateKind::Xor, half, carry));
+        const std::uint32_t both = c.add_gate(GateKind::And, a, b);
+        if (majority) {
+            carry = c.add_gate(GateKind::Or, both,
+                               c.add_gate(GateKind::Or, c.add_gate(GateKind::And, a, carry),
+                                          c.add_gate(GateKind::And, b, carry)));
+        } else {
+            carry = c.add_gate(GateKind::Or, both, c.add_gate(GateKind::And, carry, half));
+        }
+    }
+    c.add_output(carry);
+    return c;
+}
+
+static Circuit kogge_stone_adder(unsigned bits) {
+    Circuit c(2 * bits);
+    std::vector<std::uint32_t> g(bits), p(bits), half(bits);
+    for (unsigned i = 0; i < bits; ++i) {
+        g[i] = c.add_gate(GateKind::And, c.input(i), c.input(bits + i));
+        p[i] = half[i] = c.add_gate(GateKind::Xor, c.input(i), c.input(bits + i));
+    }
+    for (unsigned d = 1; d < bits; d *= 2) {
+        std::vector<std::uint32_t> ng = g, np = p;
+        for (unsigned i = d; i < bits; ++i) {
+            ng[i] = c.add_gate(GateKind::Or, g[i], c.add_gate(GateKind::And, p[i], g[i - d]));
+            np[i] = c.add_gate(GateKind::And, p[i], p[i - d]);
+        }
+        g = ng;
+        p = np;
+    }
+    c.add_output(half[0]);
+    for (unsigned i = 1; i < bits; ++i) {
+        c.add_output(c.add_gate(GateKind::Xor, half[i], g[i - 1]));
+    }
+    c.add_output(g[bits - 1]);
+    return c;
+}
+
+int main() {
+    std::mt19937 rng(75);
+
+    // Circuitos aleatorios frente a la comprobación exhaustiva.
+    for (int round = 0; round < 120; ++round) {
+        const unsigned n = 2 + round % 14;
+        const Circuit a = random_circuit(rng, n, 30 + round % 40, 1 + round % 4);
+        const Circuit b = round % 3 == 0 ? rewrite(a) : rewrite(a, n + rng() % 40);
+        graphs::SatEquivalenceOptions opts;
+        opts.stop_at_first = round % 2 == 0;
+        const auto sat = graphs::check_equivalence_sat(a, b, opts);
+        const auto sim = graphs::check_equivalence(a, b);
+        assert(sat.equivalent == sim.equivalent);
+        if (!sat.equivalent) {
+            // SAT da el primer par de salidas distinto y un contraejemplo
+            // cualquiera para él.
+            const auto va = simulate(a, sat.counterexample), vb = simulate(b, sat.counterexample);
+            assert(va[sat.output] != vb[sat.output]);
+            for (unsigned o = 0; o < sat.output; ++o) {
+                assert(va[o] == vb[o] && sat.outputs[o] == SatResult::Unsat);
+            }
+        }
+        if (!opts.stop_at_first) {
+            // Todos los pares, uno a uno sobre la misma codificación.
+            for (std::size_t o = 0; o < a.outputs().size(); ++o) {
+                bool differs = false;
+                for (std::uint64_t t = 0; t < (std::uint64_t(1) << n) && !differs; ++t) {
+                    differs = graphs::evaluate(a, t)[o] != graphs::evaluate(b, t)[o];
+                }
+                assert(sat.outputs[o] == (differs ? SatResult::Sat : SatResult::Unsat));
+            }
+        }
+    }
+
+    // Sumadores de 64 bits (128 entradas, fuera del alcance exhaustivo).
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const Circuit ripple = ripple_adder(64, false);
+        const auto r = graphs::check_equivalence_sat(ripple, ripple_adder(64, true));
+        assert(r.equivalent && r.counterexample.empty());
+        const auto ks = graphs::check_equivalence_sat(ripple, kogge_stone_adder(64));
+        assert(ks.equivalent);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Sumadores de 64 bits: " << ks.stats.conflicts << " conflictos, " << seconds << " s"
+                  << std::endl;
+
+        const Circuit wrong = ripple_adder(64, true, 40);
+        const auto w = graphs::check_equivalence_sat(kogge_stone_adder(64), wrong);
+        assert(!w.equivalent && w.output == 40 && w.counterexample.size() == 128);
+        assert(simulate(kogge_stone_adder(64), w.counterexample)[40] != simulate(wrong, w.counterexample)[40]);
+
+        graphs::SatEquivalenceOptions opts;
+        opts.stop_at_first = false;
+        const auto all = graphs::check_equivalence_sat(ripple, wrong, opts);
+        for (unsigned o = 0; o <= 64; ++o) {
+            // Invertir el acarreo del bit 40 cambia la suma 40 siempre y el
+            // resto sólo para algunas entradas.
+            assert(all.outputs[o] == (o < 40 ? SatResult::Unsat : SatResult::Sat));
+        }
+    }
+
+    // La codificación sola: el literal de cada salida sigue al circuito
+    // bajo cualquier suposición de entradas.
+    {
+        std::istringstream in("INPUT(1)\nINPUT(2)\nINPUT(3)\nINPUT(6)\nINPUT(7)\n"
+                              "OUTPUT(22)\nOUTPUT(23)\n"
+                              "22 = NAND(10, 16)\n23 = NAND(16, 19)\n"
+                              "10 = NAND(1, 3)\n11 = NAND(3, 6)\n16 = NAND(2, 11)\n19 = NAND(11, 7)\n");
+        const Circuit c17 = graphs::parse_bench(in);
+        graphs::SatSolver solver;
+        const std::vector<int> lit = graphs::encode_tseitin(c17, solver);
+        std::vector<int> inputs;
+        for (std::uint32_t i = 0; i < c17.size(); ++i) {
+            if (c17.node(i).kind == GateKind::Input) {
+                inputs.push_back(lit[i]);
+            }
+        }
+        for (std::uint64_t t = 0; t < 32; ++t) {
+            std::vector<int> assumptions;
+            for (unsigned i = 0; i < 5; ++i) {
+                assumptions.push_back((t >> i) & 1 ? inputs[i] : -inputs[i]);
+            }
+            assert(solver.solve(assumptions) == SatResult::Sat);
+            const auto expected = graphs::evaluate(c17, t);
+            for (std::size_t o = 0; o < expected.size(); ++o) {
+                assert(solver.value(lit[c17.outputs()[o]]) == expected[o]);
+            }
+        }
+        bool threw = false;
+        try {
+            graphs::encode_tseitin(c17, solver, {1, 2});
+        } catch (const std::invalid_argument &) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Límite de conflictos: sin contraejemplo y sin veredicto.
+    {
+        graphs::SatEquivalenceOptions opts;
+        opts.conflict_limit = 1;
+        const auto r = graphs::check_equivalence_sat(ripple_adder(32, false), kogge_stone_adder(32), opts);
+        const bool unknown = std::find(r.outputs.begin(), r.outputs.end(), SatResult::Unknown) != r.outputs.end();
+        assert(unknown && !r.equivalent && r.counterexample.empty());
+    }
+
+    // Salidas idénticas o complementarias sin llamar al resolvedor.
+    {
+        Circuit a(2), b(2);
+        a.add_output(a.add_gate(GateKind::And, a.input(0), a.input(1)));
+        b.add_output(b.add_gate(GateKind::Nand, b.input(1), b.input(0)));
+        const auto r = graphs::check_equivalence_sat(a, b);
+        assert(!r.equivalent && r.counterexample == std::vector<bool>(2, false) && r.stats.decisions == 0);
+        Circuit c(2);
+        c.add_output(c.add_gate(GateKind::Nor, c.add_gate(GateKind::Not, c.input(1)), c.add_gate(GateKind::Not, c.input(0))));
+        assert(graphs::check_equivalence_sat(a, c).equivalent);
+    }
+
+    bool threw = false;
+    try {
+        graphs::check_equivalence_sat(Circuit(2), Circuit(3));
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Equivalencia por SAT: todas las pruebas superadas" << std::endl;
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "graph_builder.hpp"
+#include "scc.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+
+// Dos particiones son iguales salvo por la numeración de las componentes.
+static bool same_partition(const graphs::SccResult &a, const graphs::SccResult &b) {
+    if (a.count != b.count || a.component.size() != b.component.size()) {
+        return false;
+    }
+    std::map<int, int> map;
+    for (std::size_t v = 0; v < a.component.size(); ++v) {
+        auto [it, inserted] = map.emplace(a.component[v], b.component[v]);
+        if (!inserted && it->second != b.component[v]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Toda arista entre componentes va de un índice menor a uno mayor.
+static bool topological(const graphs::Graph &g, const graphs::SccResult &scc) {
+    for (int u = 0; u < g.num_vertices(); ++u) {
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            if (scc.component[u] > scc.component[g.target(e)]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool is_cycle(const graphs::Graph &g, const std::vector<int> &cycle) {
+    for (std::size_t i = 0; i < cycle.size(); ++i) {
+        int u = cycle[i], v = cycle[(i + 1) % cycle.size()];
+        bool found = false;
+        for (std::size_t e = g.edge_begin(u); e < g.edge_end(u); ++e) {
+            found = found || g.target(e) == v;
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return !cycle.empty();
+}
+
+int main() {
+    const auto methods = {graphs::SccMethod::Tarjan, graphs::SccMethod::Kosaraju,
+                          graphs::SccMethod::ForwardBackward};
+
+    // {0,1,2} -> {3,4} -> {5}; 6 aislado con bucle
+    graphs::Graph g(graphs::AdjList{{{1, 1.0}},
+                                    {{2, 1.0}},
+                                    {{0, 1.0}, {3, 2.0}},
+                                    {{4, 1.0}},
+                                    {{3, 1.0}, {5, 1.0}},
+                                    {},
+                                    {{6, 1.0}}});
+    for (auto method : methods) {
+        auto scc = graphs::strongly_connected_components(g, method);
+        assert(scc.count == 4 && topological(g, scc));
+        assert(scc.component[0] == scc.component[2] && scc.component[3] == scc.component[4]);
+        assert(scc.component[0] < scc.component[3] && scc.component[3] < scc.component[5]);
+    }
+    auto scc = graphs::strongly_connected_components(g);
+    graphs::Graph dag = graphs::condensation(g, scc);
+    assert(dag.num_vertices() == 4 && dag.num_edges() == 2);
+    assert(!graphs::has_cycle(dag) && graphs::has_cycle(g));
+    auto sizes = scc.sizes();
+    assert(sizes[scc.component[0]] == 3 && sizes[scc.component[6]] == 1);
+
+    // Ciclos alcanzables desde un origen (como fsm_utils.has_cycle)
+    assert(graphs::has_cycle(g, 0) && !graphs::has_cycle(g, 5) && graphs::has_cycle(g, 6));
+    assert(is_cycle(g, graphs::find_cycle(g, 3)) && graphs::find_cycle(g, 3).size() == 2);
+    assert((graphs::find_cycle(g, 6) == std::vector<int>{6}));
+
+    // Cadena larga: sin desbordar la pila
+    const int chain = 1000000;
+    std::vector<graphs::EdgeRecord> edges;
+    for (int v = 0; v + 1 < chain; ++v) {
+        edges.push_back({v, v + 1, 1.0});
+    }
+    graphs::Graph path = graphs::build_csr(chain, edges);
+    assert(!graphs::has_cycle(path, 0));
+    edges.push_back({chain - 1, 0, 1.0});
+    graphs::Graph ring = graphs::build_csr(chain, edges);
+    assert(graphs::find_cycle(ring, 0).size() == static_cast<std::size_t>(chain));
+    for (auto method : methods) {
+        assert(graphs::strongly_connected_components(path, method).count == chain);
+        assert(graphs::strongly_connected_components(ring, method).count == 1);
+    }
+
+    // Grafos aleatorios: los tres métodos dan la misma partición
+    std::mt19937 rng(61);
+    for (int density : {1, 2, 4}) {
+        const int n = 60000;
+        std::vector<graphs::EdgeRecord> random;
+        for (int i = 0; i < density * n; ++i) {
+            random.push_back({static_cast<int>(rng() % n), static_cast<int>(rng() % n), 1.0});
+        }
+        graphs::Graph r = graphs::build_csr(n, random);
+        auto ref = graphs::strongly_connected_components(r, graphs::SccMethod::Tarjan);
+        assert(topological(r, ref));
+        auto kos = graphs::strongly_connected_components(r, graphs::SccMethod::Kosaraju);
+        auto fb = graphs::strongly_connected_components(r, graphs::SccMethod::ForwardBackward, 4);
+        assert(same_partition(ref, kos) && same_partition(ref, fb));
+        assert(topological(r, kos) && topological(r, fb));
+        assert(!graphs::has_cycle(graphs::condensation(r, fb)));
+    }
+
+    std::cout << "SCC: todas las pruebas superadas" << std::endl;
+    return 0;
+}
@@ -0,0 +1,186 @@
+#include "sequence_search.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using graphs::Condition;
+using graphs::SequenceGenerator;
+using graphs::SequenceOptions;
+using graphs::SequencePath;
+using graphs::TransitionTable;
+
+// Enumeración directa, como el DFS de Python, para comparar.
+static void brute(const TransitionTable &t, const std::function<bool(int, int, int)> &step,
+                  const std::function<bool(const std::vector<int> &, const std::vector<int> &)> &path,
+                  std::vector<int> &states, std::vector<int> &events, int length,
+                  std::vector<std::vector<int>> &out) {
+    if (static_cast<int>(events.size()) == length) {
+        out.push_back(events);
+        return;
+    }
+    for (int e = 0; e < t.num_events(); ++e) {
+        const int from = states.back(), to = t.next(from, e);
+        if (to < 0 || !step(from, e, to)) {
+            continue;
+        }
+        states.push_back(to);
+        events.push_back(e);
+        if (path(states, events)) {
+            brute(t, step, path, states, events, length, out);
+        }
+        states.pop_back();
+        events.pop_back();
+    }
+}
+
+int main() {
+    // Ejemplo de alg/backtracking_sequence_validator.py.
+    {
+        TransitionTable t({"IDLE", "RUN", "SAFE"}, {"start", "stop", "alarm", "reset"});
+        t.set("IDLE", "start", "RUN");
+        t.set("RUN", "stop", "IDLE");
+        t.set("RUN", "alarm", "SAFE");
+        t.set("SAFE", "reset", "IDLE");
+        SequenceGenerator gen(t, t.state_index("IDLE"));
+        gen.require("event == reset -> from == SAFE");
+        SequenceOptions opts;
+        opts.limit = 10;
+        const auto r = gen.generate(3, opts);
+        const std::vector<std::vector<int>> expected = {{0, 1, 0}, {0, 2, 3}};
+        assert(r.sequences == expected);
+        assert(gen.count(3) == 2);
+
+        const auto five = gen.generate(5);
+        const std::vector<std::vector<int>> expected5 = {
+            {0, 1, 0, 1, 0}, {0, 1, 0, 2, 3}, {0, 2, 3, 0, 1}, {0, 2, 3, 0, 2}};
+        assert(five.sequences == expected5);
+        assert(gen.generate(0).sequences == std::vector<std::vector<int>>{{}});
+    }
+
+    // Tabla aleatoria con invariantes de paso y de camino: mismo resultado
+    // que la enumeración directa con 1 y 4 hilos, con y sin memoización.
+    {
+        const int states = 7, events = 5, length = 8;
+        std::mt19937 rng(69);
+        std::uniform_int_distribution<int> next(-1, states - 1);
+        TransitionTable t(states, events);
+        for (int s = 0; s < states; ++s) {
+            for (int e = 0; e < events; ++e) {
+                t.set(s, e, next(rng));
+            }
+        }
+        const Condition step = !(Condition::event(2) && Condition::to(3)) && !Condition::from(5);
+        const auto from_text = graphs::parse_condition("!(event == 2 && to == 3) && from != 5", t);
+        for (int s = 0; s < states; ++s) {
+            for (int e = 0; e < events; ++e) {
+                assert(step(s, e, t.next(s, e)) == from_text(s, e, t.next(s, e)));
+            }
+        }
+        // Nunca el mismo evento tres veces seguidas.
+        auto no_triple = [](const int *ev, int depth) {
+            return depth < 3 || !(ev[depth - 1] == ev[depth - 2] && ev[depth - 2] == ev[depth - 3]);
+        };
+
+        std::vector<std::vector<int>> ref;
+        std::vector<int> st{0}, ev;
+        brute(
+            t, [&](int f, int e, int to) { return step(f, e, to); },
+            [&](const std::vector<int> &, const std::vector<int> &e) {
+                return no_triple(e.data(), static_cast<int>(e.size()));
+            },
+            st, ev, length, ref);
+        assert(!ref.empty());
+
+        SequenceGenerator gen(t, 0);
+        gen.require(step);
+        gen.require_path([&](const SequencePath &p) { return no_triple(p.events, p.depth); });
+        for (unsigned threads : {1u, 4u}) {
+            for (bool memoize : {true, false}) {
+                SequenceOptions opts;
+                opts.threads = threads;
+                opts.memoize = memoize;
+                const auto r = gen.generate(length, opts);
+                assert(r.sequences == ref);
+                assert(memoize || r.pruned == 0);
+                opts.limit = 7;
+                const auto first = gen.generate(length, opts);
+                assert(first.sequences.size() == std::min<std::size_t>(7, ref.size()));
+                assert(std::equal(first.sequences.begin(), first.sequences.end(), ref.begin()));
+            }
+            assert(gen.count(length, nullptr, threads) == ref.size());
+        }
+        // El camino recibe estados coherentes con la tabla.
+        SequenceGenerator checked(t, 0);
+        checked.require_path([&](const SequencePath &p) {
+            for (int i = 0; i < p.depth; ++i) {
+                if (t.next(p.states[i], p.events[i]) != p.states[i + 1]) {
+                    throw std::logic_error("camino incoherente");
+                }
+            }
+            return true;
+        });
+        checked.generate(length, SequenceOptions{0, 4, true});
+    }
+
+    // Conteo sin enumerar y saturación.
+    {
+        TransitionTable t(2, 10);
+        for (int e = 0; e < 10; ++e) {
+            t.set(0, e, e % 2);
+            t.set(1, e, 0);
+        }
+        SequenceGenerator gen(t, 0);
+        bool overflow = true;
+        assert(gen.count(12, &overflow) == 1000000000000ull && !overflow);
+        gen.require(Condition::event(9) || Condition::from(1));
+        // Desde 0 sólo el evento 9 (a 1); desde 1 cualquiera de los 10 (a 0).
+        assert(gen.count(12) == 1000000);
+        assert(gen.count(13) == 1000000);
+        SequenceGenerator big(t, 0);
+        gen.count(1, &overflow);
+        assert(!overflow);
+        big.count(20, &overflow);
+        assert(overflow);
+    }
+
+    bool threw = false;
+    try {
+        TransitionTable t({"A"}, {"x"});
+        graphs::parse_condition("from == A &&", t);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        TransitionTable t({"A"}, {"x"});
+        graphs::parse_condition("event == y", t);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        TransitionTable t(2, 2);
+        t.set(0, 2, 1);
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        SequenceGenerator(TransitionTable(1, 1), 0).generate(-1);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Secuencias: todas las pruebas superadas" << std::endl;
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "dijkstra.hpp"
+#include "graph_io.hpp"
+#include "snapshot.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#ifndef GLASS_SAMPLES_DIR
+#define GLASS_SAMPLES_DIR "../../data/samples"
+#endif
+
+static bool throws(const std::string &path, const graphs::SnapshotLoadOptions &opts) {
+    try {
+        graphs::load_snapshot(path, opts);
+    } catch (const std::runtime_error &) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    const std::string samples = GLASS_SAMPLES_DIR;
+    // Lectores de texto sobre los ejemplos del repositorio
+    graphs::LabeledGraph json = graphs::read_graph_file(samples + "/dijkstra_adj.json");
+    assert(json.graph.num_vertices() == 5 && json.graph.num_edges() == 7);
+    graphs::LabeledGraph csv = graphs::read_graph_file(samples + "/graph_edges.csv");
+    assert(csv.graph.num_vertices() == 5 && csv.graph.num_edges() == 5);
+    graphs::LabeledGraph dag = graphs::read_graph_file(samples + "/dag_adj.json");
+    assert(dag.graph.num_edges() == 4 && dag.find("3") >= 0);
+
+    const std::string path = "test_snapshot.gsnap";
+    auto ref = graphs::dijkstra(json.graph, json.find("0"));
+    for (auto enc : {graphs::OffsetEncoding::Raw64, graphs::OffsetEncoding::Raw32,
+                     graphs::OffsetEncoding::VarintDegrees}) {
+        graphs::SnapshotOptions options;
+        options.offsets = enc;
+        graphs::write_snapshot(path, json.graph, options, &json.names);
+        graphs::SnapshotLoadOptions load;
+        load.verify_checksums = true;
+        load.validate = true;
+        graphs::Snapshot snap = graphs::load_snapshot(path, load);
+        assert(snap.zero_copy_offsets == (enc == graphs::OffsetEncoding::Raw64));
+        assert(snap.names == json.names);
+        assert(snap.graph.num_edges() == json.graph.num_edges());
+        auto dist = graphs::dijkstra(snap.graph, json.find("0"));
+        for (std::size_t v = 0; v < dist.size(); ++v) {
+            assert(std::fabs(dist[v] - ref[v]) < 1e-12);
+        }
+    }
+
+    // El grafo cargado sigue siendo válido tras soltar el resto del resultado
+    graphs::Graph kept;
+    {
+        kept = graphs::load_snapshot(path).graph;
+    }
+    assert(kept.num_vertices() == 5);
+
+    // Un byte alterado en los pesos (última sección si no hay nombres) se
+    // detecta al verificar las sumas
+    graphs::write_snapshot(path, json.graph);
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekg(0, std::ios::end);
+        auto size = static_cast<long>(f.tellg());
+        f.seekp(size - 40);
+        char b = 0x5a;
+        f.write(&b, 1);
+    }
+    graphs::SnapshotLoadOptions verify;
+    verify.verify_checksums = true;
+    assert(throws(path, verify));
+    assert(!throws(path, graphs::SnapshotLoadOptions{}));
+
+    // Un destino fuera de rango (sin sumas que lo delaten) se rechaza por
+    // defecto; sólo con validate = false se confía en el archivo
+    {
+        graphs::SnapshotOptions plain;
+        plain.checksums = false;
+        graphs::write_snapshot(path, json.graph, plain);
+        std::string bytes;
+        {
+            std::ifstream f(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+        }
+        const std::string targets(reinterpret_cast<const char *>(json.graph.targets().data()),
+                                  json.graph.num_edges() * sizeof(int));
+        const auto at = bytes.find(targets);
+        assert(at != std::string::npos);
+        const int bad = 1 << 30;
+        bytes.replace(at, sizeof(bad), reinterpret_cast<const char *>(&bad), sizeof(bad));
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+        assert(throws(path, graphs::SnapshotLoadOptions{}));
+        graphs::SnapshotLoadOptions trusted;
+        trusted.validate = false;
+        assert(!throws(path, trusted));
+    }
+
+    // Un archivo que no es una instantánea se rechaza
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        f << "no es un grafo";
+    }
+    assert(throws(path, graphs::SnapshotLoadOptions{}));
+    std::remove(path.c_str());
+    std::cout << "Todas las pruebas de instantáneas se han superado.\n";
+    return 0;
+}
@@ -0,0 +1,229 @@
+#include "graph_builder.hpp"
+#include "spectral.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+static const double kPi = std::acos(-1.0);
+
+// Grafo con una arista u->v de peso 1 por par (W = A + A^T binaria).
+static graphs::Graph undirected(int n, const std::vector<std::pair<int, int>> &pairs) {
+    std::vector<graphs::EdgeRecord> edges;
+    for (auto [u, v] : pairs) {
+        edges.push_back({u, v, 1.0});
+    }
+    return graphs::build_csr(n, edges);
+}
+
+static graphs::Graph path(int n) {
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i + 1 < n; ++i) {
+        pairs.push_back({i, i + 1});
+    }
+    return undirected(n, pairs);
+}
+
+static double residual(const graphs::LaplacianOperator &L, const graphs::FiedlerResult &f) {
+    std::vector<double> y;
+    L.apply(f.vector, y);
+    double r = 0.0;
+    for (std::size_t i = 0; i < y.size(); ++i) {
+        r += (y[i] - f.value * f.vector[i]) * (y[i] - f.value * f.vector[i]);
+    }
+    return std::sqrt(r);
+}
+
+int main() {
+    // Operador frente a la matriz densa D - (A + A^T) con pesos, repetidas y bucles.
+    {
+        const int n = 30;
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> vertex(0, n - 1);
+        std::uniform_real_distribution<double> weight(0.5, 3.0);
+        std::vector<graphs::EdgeRecord> edges;
+        std::vector<double> w(n * n, 0.0);
+        for (int i = 0; i < 120; ++i) {
+            const int u = vertex(rng), v = vertex(rng);
+            const double x = weight(rng);
+            edges.push_back({u, v, x});
+            if (u != v) {
+                w[u * n + v] += x;
+                w[v * n + u] += x;
+            }
+        }
+        const graphs::Graph g = graphs::build_csr(n, edges);
+        for (auto kind : {graphs::LaplacianKind::Combinatorial, graphs::LaplacianKind::Normalized}) {
+            const graphs::LaplacianOperator L(g, kind);
+            std::vector<double> x(n), y;
+            for (double &v : x) {
+                v = weight(rng);
+            }
+            L.apply(x, y);
+            for (int u = 0; u < n; ++u) {
+                double d = 0.0, acc = 0.0;
+                for (int v = 0; v < n; ++v) {
+                    d += w[u * n + v];
+                }
+                assert(std::fabs(L.degrees()[u] - d) < 1e-12);
+                for (int v = 0; v < n; ++v) {
+                    if (kind == graphs::LaplacianKind::Combinatorial) {
+                        acc += ((u == v ? d : 0.0) - w[u * n + v]) * x[v];
+                    } else {
+                        double dv = 0.0;
+                        for (int k = 0; k < n; ++k) {
+                            dv += w[v * n + k];
+                        }
+                        const double lij = (u == v && d > 0 ? 1.0 : 0.0) -
+                                           (d > 0 && dv > 0 ? w[u * n + v] / std::sqrt(d * dv) : 0.0);
+                        acc += lij * x[v];
+                    }
+                }
+                assert(std::fabs(y[u] - acc) < 1e-10);
+            }
+            // El vector de núcleo conocido se anula.
+            L.apply(L.null_vector(), y);
+            for (double v : y) {
+                assert(std::fabs(v) < 1e-12);
+            }
+        }
+    }
+
+    // Valores de Fiedler conocidos.
+    {
+        const int n = 60;
+        // Camino dirigido: W binaria, lambda_2 = 2 - 2 cos(pi / n).
+        assert(std::fabs(graphs::fiedler_value(path(n)) - (2.0 - 2.0 * std::cos(kPi / n))) < 1e-9);
+
+        // Aristas en ambos sentidos: W = 2A, como laplacian_matrix en Python.
+        std::vector<graphs::EdgeRecord> both;
+        for (int i = 0; i + 1 < n; ++i) {
+            both.push_back({i, i + 1, 1.0});
+            both.push_back({i + 1, i, 1.0});
+        }
+        const double expected = 2.0 * (2.0 - 2.0 * std::cos(kPi / n));
+        assert(std::fabs(graphs::fiedler_value(graphs::build_csr(n, both)) - expected) < 1e-9);
+
+        // Ciclo: lambda_2 doble, 2 - 2 cos(2 pi / n).
+        std::vector<std::pair<int, int>> ring;
+        for (int i = 0; i < n; ++i) {
+            ring.push_back({i, (i + 1) % n});
+        }
+        const graphs::LaplacianOperator L(undirected(n, ring));
+        const graphs::FiedlerResult f = graphs::fiedler_vector(L);
+        assert(f.converged);
+        assert(std::fabs(f.value - (2.0 - 2.0 * std::cos(2.0 * kPi / n))) < 1e-9);
+        assert(residual(L, f) < 1e-6);
+        double sum = 0.0, norm = 0.0;
+        for (double v : f.vector) {
+            sum += v;
+            norm += v * v;
+        }
+        assert(std::fabs(sum) < 1e-8 && std::fabs(norm - 1.0) < 1e-10);
+
+        // Completo: lambda_2 = n; normalizada: n / (n - 1).
+        const int k = 12;
+        std::vector<std::pair<int, int>> clique;
+        for (int u = 0; u < k; ++u) {
+            for (int v = u + 1; v < k; ++v) {
+                clique.push_back({u, v});
+            }
+        }
+        const graphs::Graph complete = undirected(k, clique);
+        assert(std::fabs(graphs::fiedler_value(complete) - k) < 1e-9);
+        const graphs::LaplacianOperator N(complete, graphs::LaplacianKind::Normalized);
+        assert(std::fabs(graphs::fiedler_vector(N).value - double(k) / (k - 1)) < 1e-9);
+
+        // Grafo no conexo y casos triviales.
+        assert(graphs::fiedler_value(undirected(4, {{0, 1}, {2, 3}})) < 1e-9);
+        assert(graphs::fiedler_value(graphs::Graph()) == 0.0);
+        assert(graphs::fiedler_value(undirected(1, {})) == 0.0);
+        assert(std::fabs(graphs::fiedler_value(undirected(2, {{0, 1}})) - 2.0) < 1e-12);
+    }
+
+    // Bisección: dos cliques unidos por un puente.
+    {
+        std::vector<std::pair<int, int>> pairs;
+        for (int base : {0, 8}) {
+            for (int u = 0; u < 8; ++u) {
+                for (int v = u + 1; v < 8; ++v) {
+                    pairs.push_back({base + u, base + v});
+                }
+            }
+        }
+        pairs.push_back({3, 11});
+        const graphs::Graph g = undirected(16, pairs);
+        for (auto kind : {graphs::LaplacianKind::Combinatorial, graphs::LaplacianKind::Normalized}) {
+            const auto p = graphs::spectral_partition(g, 2, kind);
+            assert(p.parts == 2 && p.cut_weight == 1.0);
+            for (int u = 0; u < 8; ++u) {
+                assert(p.part[u] == p.part[0] && p.part[u + 8] == p.part[8]);
+            }
+            assert(p.part[0] != p.part[8]);
+        }
+    }
+
+    // Recursiva: cuatro cliques en anillo -> cuatro partes, corte 4.
+    {
+        std::vector<std::pair<int, int>> pairs;
+        for (int c = 0; c < 4; ++c) {
+            for (int u = 0; u < 6; ++u) {
+                for (int v = u + 1; v < 6; ++v) {
+                    pairs.push_back({6 * c + u, 6 * c + v});
+                }
+            }
+            pairs.push_back({6 * c, 6 * ((c + 1) % 4) + 1});
+        }
+        const auto p = graphs::spectral_partition(undirected(24, pairs), 4);
+        assert(p.parts == 4 && p.cut_weight == 4.0);
+        std::vector<int> sizes(4, 0);
+        for (int u = 0; u < 24; ++u) {
+            assert(p.part[u] == p.part[6 * (u / 6)]);
+            ++sizes[p.part[u]];
+        }
+        assert(std::count(sizes.begin(), sizes.end(), 6) == 4);
+    }
+
+    // Rejilla 60 x 20 en paralelo: el corte recto por el lado corto.
+    {
+        const int w = 60, h = 20;
+        std::vector<std::pair<int, int>> pairs;
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                if (x + 1 < w) {
+                    pairs.push_back({y * w + x, y * w + x + 1});
+                }
+                if (y + 1 < h) {
+                    pairs.push_back({y * w + x, (y + 1) * w + x});
+                }
+            }
+        }
+        graphs::FiedlerOptions opts;
+        opts.threads = 4;
+        const auto p = graphs::spectral_partition(undirected(w * h, pairs), 2,
+                                                  graphs::LaplacianKind::Combinatorial, opts);
+        assert(p.cut_weight == h);
+        assert(std::count(p.part.begin(), p.part.end(), 0) == w * h / 2);
+    }
+
+    bool threw = false;
+    try {
+        graphs::LaplacianOperator(graphs::build_csr(2, std::vector<graphs::EdgeRecord>{{0, 1, -1.0}}));
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        graphs::spectral_partition(path(3), 4);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Espectral: todas las pruebas superadas" << std::endl;
+    return 0;
+}
@@ -0,0 +1,205 @@
+#include "bfs.hpp"
+#include "state_space.hpp"
+
+#include <bitset>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+// Modelo del ciclo de scan de plc/twincat/src/FSMParidad.TcPOU.  El estado
+// es la imagen tras un scan: ArmState, OkSignal, ErrorSignal y las entradas
+// leídas (dos botones y DataWord recortada a `data_bits` bits).  Cada
+// sucesor corresponde a una combinación de entradas del scan siguiente; la
+// acción es esa combinación codificada (b1 | b2 << 1 | data << 2).
+class ParityFsm : public graphs::TransitionSystem {
+public:
+    explicit ParityFsm(unsigned data_bits) : data_bits_(data_bits) {
+        arm = layout_.add(1);
+        ok = layout_.add(1);
+        error = layout_.add(1);
+        b1 = layout_.add(1);
+        b2 = layout_.add(1);
+        data = layout_.add(data_bits);
+    }
+
+    std::size_t state_words() const override { return layout_.words(); }
+
+    void initial_states(graphs::SuccessorSink &out) const override { out.push(); }
+
+    void successors(const graphs::StateWord *s, graphs::SuccessorSink &out) const override {
+        const bool armed = graphs::BitLayout::get(s, arm);
+        for (std::uint64_t in = 0; in < (std::uint64_t(4) << data_bits_); ++in) {
+            const bool p1 = in & 1, p2 = in & 2;
+            const std::uint64_t word = in >> 2;
+            bool next_arm = armed, next_ok = false, next_error = false;
+            if (!armed) {
+                if (p1 && p2) {
+                    next_arm = next_ok = true;
+                }
+            } else if (std::bitset<64>(word).count() % 2) {
+                next_arm = false;
+            } else {
+                next_error = true;
+            }
+            graphs::StateWord *t = out.push(static_cast<int>(in));
+            graphs::BitLayout::set(t, arm, next_arm);
+            graphs::BitLayout::set(t, ok, next_ok);
+            graphs::BitLayout::set(t, error, next_error);
+            graphs::BitLayout::set(t, b1, p1);
+            graphs::BitLayout::set(t, b2, p2);
+            graphs::BitLayout::set(t, data, word);
+        }
+    }
+
+    graphs::BitField arm, ok, error, b1, b2, data;
+
+private:
+    unsigned data_bits_;
+    graphs::BitLayout layout_;
+};
+
+int main() {
+    using graphs::BitLayout;
+    const graphs::VisitedMode modes[] = {graphs::VisitedMode::Exact, graphs::VisitedMode::HashCompaction,
+                                         graphs::VisitedMode::Bitstate};
+
+    // Campos que cruzan el límite entre palabras.
+    {
+        BitLayout layout;
+        layout.add(60);
+        const graphs::BitField f = layout.add(10), g = layout.add(64);
+        assert(layout.bits() == 134 && layout.words() == 3);
+        graphs::State s(3, 0);
+        BitLayout::set(s.data(), f, 0x3ff);
+        BitLayout::set(s.data(), g, 0x8000000000000001ull);
+        assert(BitLayout::get(s.data(), f) == 0x3ff && BitLayout::get(s.data(), g) == 0x8000000000000001ull);
+        assert(s[0] == 0xf000000000000000ull && s[1] == 0x7f && s[2] == 0x20);
+        BitLayout::set(s.data(), f, 5);
+        assert(BitLayout::get(s.data(), f) == 5 && BitLayout::get(s.data(), g) == 0x8000000000000001ull);
+    }
+
+    // FSM de paridad: 13 * 2^(k-1) estados alcanzables y los invariantes
+    // de seguridad se cumplen en los tres modos.
+    {
+        const unsigned k = 6;
+        const ParityFsm fsm(k);
+        auto safe = [&](const graphs::StateWord *s) {
+            const bool ok = BitLayout::get(s, fsm.ok), err = BitLayout::get(s, fsm.error);
+            return !(ok && err) && (!err || BitLayout::get(s, fsm.arm));
+        };
+        for (auto mode : modes) {
+            graphs::ExploreOptions opts;
+            opts.mode = mode;
+            opts.threads = 4;
+            opts.bitstate_log2 = 20;
+            const graphs::ExploreResult r = graphs::explore(fsm, safe, opts);
+            assert(r.complete && !r.violated && r.counterexample.empty());
+            assert(r.states == 13u << (k - 1));
+            assert(r.transitions == r.states << (k + 2));
+            assert(r.depth == 3 && r.memory_bytes > 0);
+            assert(mode == graphs::VisitedMode::Exact ? r.omission_estimate == 0.0 : r.omission_estimate < 1e-3);
+        }
+
+        // "Nunca ErrorSignal" falla: pulsar ambos botones y leer paridad par.
+        const ParityFsm wide(8);
+        for (auto mode : modes) {
+            graphs::ExploreOptions opts;
+            opts.mode = mode;
+            opts.threads = 3;
+            opts.bitstate_log2 = 20;
+            const graphs::ExploreResult r = graphs::find_reachable(
+                wide, [&](const graphs::StateWord *s) { return BitLayout::get(s, wide.error) == 1; }, opts);
+            assert(r.violated && !r.complete && r.violation_depth == 2);
+            const graphs::Trace &t = r.counterexample;
+            assert(t.states.size() == 3 && t.actions.size() == 2);
+            assert(t.states[0] == graphs::State(1, 0));
+            assert((t.actions[0] & 3) == 3);
+            assert(std::bitset<64>(t.actions[1] >> 2).count() % 2 == 0);
+            const graphs::StateWord *mid = t.states[1].data(), *last = t.states[2].data();
+            assert(BitLayout::get(mid, wide.arm) && BitLayout::get(mid, wide.ok));
+            assert(BitLayout::get(last, wide.error) && !BitLayout::get(last, wide.ok));
+        }
+    }
+
+    // Grafo explícito: mismos alcanzables y caminos mínimos que el BFS.
+    {
+        const int n = 2000;
+        std::mt19937 rng(68);
+        std::uniform_int_distribution<int> vertex(0, n - 1);
+        graphs::AdjList adj(n);
+        for (int i = 0; i < 3000; ++i) {
+            adj[vertex(rng)].push_back({vertex(rng), 1.0});
+        }
+        const graphs::Graph g(adj);
+        const graphs::BfsResult ref = graphs::bfs_hops(g, 0);
+        const graphs::GraphSystem system(g, {0});
+        for (auto mode : modes) {
+            graphs::ExploreOptions opts;
+            opts.mode = mode;
+            opts.threads = 4;
+            opts.bitstate_log2 = 24;
+            const auto all = graphs::explore(system, {}, opts);
+            assert(all.complete && all.states == ref.visited && all.transitions > 0);
+            int far = 0;
+            for (int v = 0; v < n; ++v) {
+                far = ref.hops[v] > ref.hops[far] ? v : far;
+            }
+            const auto r = graphs::find_reachable(
+                system, [far](const graphs::StateWord *s) { return *s == graphs::StateWord(far); }, opts);
+            assert(r.violated && r.violation_depth == ref.hops[far]);
+            assert(r.counterexample.states.size() == std::size_t(ref.hops[far]) + 1);
+            for (std::size_t i = 0; i + 1 < r.counterexample.states.size(); ++i) {
+                const std::size_t e = r.counterexample.actions[i];
+                assert(g.target(e) == int(r.counterexample.states[i + 1][0]));
+                assert(e >= g.edge_begin(int(r.counterexample.states[i][0])) &&
+                       e < g.edge_end(int(r.counterexample.states[i][0])));
+            }
+        }
+        // Inalcanzable: exploración completa sin violación.
+        const auto none = graphs::find_reachable(system, [](const graphs::StateWord *) { return false; });
+        assert(none.complete && !none.violated);
+    }
+
+    // Límites de estados y profundidad; el estado inicial también se comprueba.
+    {
+        graphs::FunctionSystem counter(
+            2, [](graphs::SuccessorSink &out) { out.push()[1] = 7; },
+            [](const graphs::StateWord *s, graphs::SuccessorSink &out) {
+                graphs::StateWord *t = out.push_copy(s, 0);
+                ++t[0];
+                out.push_copy(s, 1)[1] ^= 1;
+            });
+        graphs::ExploreOptions opts;
+        opts.max_depth = 10;
+        auto r = graphs::explore(counter, {}, opts);
+        assert(!r.complete && r.depth == 10 && r.states == 21);
+        opts.max_depth = -1;
+        opts.max_states = 100;
+        r = graphs::explore(counter, {}, opts);
+        assert(!r.complete && r.states >= 100 && r.states < 110);
+        r = graphs::explore(counter, [](const graphs::StateWord *s) { return s[1] != 7; });
+        assert(r.violated && r.violation_depth == 0 && r.counterexample.states.size() == 1);
+    }
+
+    bool threw = false;
+    try {
+        graphs::BitLayout().add(65);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        graphs::ExploreOptions opts;
+        opts.mode = graphs::VisitedMode::Bitstate;
+        opts.bitstate_log2 = 3;
+        graphs::explore(graphs::GraphSystem(graphs::Graph(), {}), {}, opts);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Espacio de estados: todas las pruebas superadas" << std::endl;
+    return 0;
+}
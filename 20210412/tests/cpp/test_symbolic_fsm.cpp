@@ -0,0 +1,147 @@
+#include "symbolic_fsm.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using graphs::Bdd;
+using graphs::BddManager;
+using graphs::SymbolicFsm;
+
+// FSMParidad de plc/twincat/src/FSMParidad.TcPOU (el mismo modelo que en
+// test_state_space): estado arm, ok, error, b1, b2 y data[k]; entradas p1,
+// p2 y w[k] del scan siguiente.
+struct ParityModel {
+    enum { kArm, kOk, kError, kB1, kB2, kData };
+
+    ParityModel(BddManager &m, unsigned k) : bits(k), fsm(m, kData + k, 2 + k) {
+        Bdd parity = m.zero();
+        for (unsigned i = 0; i < k; ++i) {
+            parity ^= fsm.input(2 + i);
+        }
+        const Bdd armed = fsm.current(kArm), both = fsm.input(0) & fsm.input(1);
+        fsm.set_next(kArm, m.ite(armed, ~parity, both));
+        fsm.set_next(kOk, ~armed & both);
+        fsm.set_next(kError, armed & ~parity);
+        fsm.set_next(kB1, fsm.input(0));
+        fsm.set_next(kB2, fsm.input(1));
+        for (unsigned i = 0; i < k; ++i) {
+            fsm.set_next(kData + i, fsm.input(2 + i));
+        }
+    }
+
+    // Paso explícito para comprobar las trazas.
+    std::vector<bool> step(const std::vector<bool> &s, const std::vector<bool> &in) const {
+        std::vector<bool> t(s.size());
+        bool parity = false;
+        for (unsigned i = 0; i < bits; ++i) {
+            parity = parity != in[2 + i];
+            t[kData + i] = in[2 + i];
+        }
+        const bool both = in[0] && in[1];
+        t[kArm] = s[kArm] ? !parity : both;
+        t[kOk] = !s[kArm] && both;
+        t[kError] = s[kArm] && !parity;
+        t[kB1] = in[0];
+        t[kB2] = in[1];
+        return t;
+    }
+
+    unsigned bits;
+    SymbolicFsm fsm;
+};
+
+int main() {
+    // Mismo número de estados que la exploración explícita: 13 * 2^(k-1).
+    for (unsigned k : {6u, 40u}) {
+        BddManager m;
+        ParityModel model(m, k);
+        SymbolicFsm &fsm = model.fsm;
+        const Bdd init = fsm.state(std::vector<bool>(fsm.state_bits(), false));
+        const graphs::ReachResult r = graphs::reachable(fsm, init);
+        assert(r.complete && !r.violated && r.depth == 2);
+        assert(r.states == 13.0 * std::ldexp(1.0, static_cast<int>(k) - 1));
+        assert(r.frontier_nodes.size() == 3 && m.node_count(r.reached) < 1000);
+
+        // Invariantes de seguridad: nunca ok y error a la vez; error sólo armado.
+        const Bdd ok = fsm.current(ParityModel::kOk), err = fsm.current(ParityModel::kError);
+        const Bdd bad = (ok & err) | (err & ~fsm.current(ParityModel::kArm));
+        const auto safe = graphs::check_invariant(fsm, init, bad);
+        assert(safe.complete && !safe.violated && safe.counterexample.empty());
+
+        // "Nunca ErrorSignal" falla en dos scans; la traza es ejecutable.
+        const auto cex = graphs::check_invariant(fsm, init, err);
+        assert(cex.violated && !cex.complete && cex.violation_depth == 2);
+        const graphs::SymbolicTrace &t = cex.counterexample;
+        assert(t.states.size() == 3 && t.inputs.size() == 2);
+        assert(t.states[0] == std::vector<bool>(fsm.state_bits(), false));
+        for (std::size_t i = 0; i + 1 < t.states.size(); ++i) {
+            assert(model.step(t.states[i], t.inputs[i]) == t.states[i + 1]);
+        }
+        assert(t.states[2][ParityModel::kError]);
+
+        // La preimagen de los sucesores contiene el origen.
+        const Bdd post = fsm.image(init);
+        assert((fsm.preimage(post) & init) == init);
+        assert(fsm.count(post) == std::ldexp(1.0, static_cast<int>(k) + 2));
+    }
+
+    // Registro de desplazamiento de 60 bits: 2^60 estados en 60 imágenes.
+    {
+        const unsigned n = 60;
+        BddManager m;
+        SymbolicFsm fsm(m, n, 1);
+        fsm.set_next(0, fsm.input(0));
+        for (unsigned i = 1; i < n; ++i) {
+            fsm.set_next(i, fsm.current(i - 1));
+        }
+        const Bdd init = fsm.state(std::vector<bool>(n, false));
+        graphs::ReachOptions opts;
+        opts.max_depth = 10;
+        const auto partial = graphs::reachable(fsm, init, opts);
+        assert(!partial.complete && partial.depth == 10 && partial.states == 1024.0);
+        const auto r = graphs::reachable(fsm, init);
+        assert(r.complete && r.depth == static_cast<int>(n));
+        assert(r.states == std::ldexp(1.0, static_cast<int>(n)));
+        assert(r.reached.is_one());
+
+        // Todo unos: el contraejemplo más corto mete n unos seguidos.
+        std::vector<bool> ones(n, true);
+        const auto cex = graphs::check_invariant(fsm, init, fsm.state(ones));
+        assert(cex.violated && cex.violation_depth == static_cast<int>(n));
+        for (const auto &in : cex.counterexample.inputs) {
+            assert(in.size() == 1 && in[0]);
+        }
+    }
+
+    // Restricción general: un contador de 3 bits que sólo avanza con la entrada
+    // y se queda en 5; bits libres no restringidos duplican los estados.
+    {
+        BddManager m;
+        SymbolicFsm fsm(m, 4, 1);
+        const Bdd go = fsm.input(0);
+        auto value = [&](unsigned v, bool next) {
+            Bdd r = m.one();
+            for (unsigned i = 0; i < 3; ++i) {
+                const Bdd lit = next ? fsm.next(i) : fsm.current(i);
+                r &= (v >> i) & 1 ? lit : ~lit;
+            }
+            return r;
+        };
+        Bdd rel = m.zero();
+        for (unsigned v = 0; v < 8; ++v) {
+            const unsigned w = v == 5 ? 5 : (v + 1) % 8;
+            rel |= value(v, false) & ((go & value(w, true)) | (~go & value(v, true)));
+        }
+        fsm.add_constraint(rel);
+        const Bdd init = fsm.state({false, false, false, false});
+        const auto r = graphs::reachable(fsm, init);
+        assert(r.complete && r.depth == 5);
+        // Valores 0..5 del contador por 2 del bit 3 (libre tras el primer paso).
+        assert(r.states == 12.0);
+    }
+
+    std::cout << "FSM simbólica: todas las pruebas superadas" << std::endl;
+    return 0;
+}
@@ -0,0 +1,215 @@
+#include "unate_cover.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using graphs::CoverMatrix;
+using graphs::CoverOptions;
+
+// Coste mínimo por fuerza bruta (pocas columnas).
+static std::uint64_t brute_force(const CoverMatrix &m, const std::vector<unsigned> &costs) {
+    std::uint64_t best = ~std::uint64_t(0);
+    for (std::uint64_t subset = 0; subset < (std::uint64_t(1) << m.columns()); ++subset) {
+        std::vector<char> covered(m.rows(), 0);
+        std::uint64_t cost = 0;
+        for (std::size_t c = 0; c < m.columns(); ++c) {
+            if ((subset >> c) & 1) {
+                cost += costs.empty() ? 1 : costs[c];
+                for (std::uint32_t r : m.column(c)) {
+                    covered[r] = 1;
+                }
+            }
+        }
+        if (std::all_of(covered.begin(), covered.end(), [](char x) { return x != 0; })) {
+            best = std::min(best, cost);
+        }
+    }
+    return best;
+}
+
+static bool is_cover(const CoverMatrix &m, const std::vector<std::size_t> &cols) {
+    std::vector<char> covered(m.rows(), 0);
+    for (std::size_t c : cols) {
+        for (std::uint32_t r : m.column(c)) {
+            covered[r] = 1;
+        }
+    }
+    return std::all_of(covered.begin(), covered.end(), [](char x) { return x != 0; });
+}
+
+// La suma de productos vale 1 exactamente en los mintérminos (salvo
+// indiferencias).
+static bool implements(const std::vector<graphs::Cube> &cover, const std::vector<std::uint64_t> &on,
+                       const std::vector<std::uint64_t> &dc, unsigned n) {
+    for (std::uint64_t t = 0; t < (std::uint64_t(1) << n); ++t) {
+        const bool want = std::find(on.begin(), on.end(), t) != on.end();
+        const bool free = std::find(dc.begin(), dc.end(), t) != dc.end();
+        const bool got = std::any_of(cover.begin(), cover.end(), [&](const graphs::Cube &c) { return c.covers(t); });
+        if (!free && got != want) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    // Matrices aleatorias frente a la fuerza bruta, con y sin costes.
+    std::mt19937 rng(72);
+    for (int round = 0; round < 60; ++round) {
+        const std::size_t rows = 5 + round % 20, cols = 4 + round % 9;
+        CoverMatrix m(rows, cols);
+        std::bernoulli_distribution cell(0.3);
+        for (std::size_t r = 0; r < rows; ++r) {
+            m.set(r, rng() % cols);
+            for (std::size_t c = 0; c < cols; ++c) {
+                if (cell(rng)) {
+                    m.set(r, c);
+                }
+            }
+        }
+        CoverOptions opts;
+        if (round % 2) {
+            for (std::size_t c = 0; c < cols; ++c) {
+                opts.costs.push_back(1 + rng() % 5);
+            }
+        }
+        const graphs::CoverResult exact = graphs::solve_cover(m, opts);
+        assert(exact.optimal && is_cover(m, exact.columns));
+        assert(exact.cost == brute_force(m, opts.costs) && exact.lower_bound == exact.cost);
+        assert(std::is_sorted(exact.columns.begin(), exact.columns.end()));
+
+        // Sin tiempo: sólo la voraz, válida y no mejor que el óptimo.
+        opts.time_budget = 0;
+        const graphs::CoverResult quick = graphs::solve_cover(m, opts);
+        assert(!quick.optimal && is_cover(m, quick.columns) && quick.cost >= exact.cost);
+    }
+
+    // Ciclo de 2k filas y 2k columnas (cada columna cubre dos filas
+    // consecutivas): sin esenciales ni dominancias, óptimo k.
+    {
+        const std::size_t k = 9;
+        CoverMatrix m(2 * k, 2 * k);
+        for (std::size_t c = 0; c < 2 * k; ++c) {
+            m.set(c, c);
+            m.set((c + 1) % (2 * k), c);
+        }
+        const auto r = graphs::solve_cover(m);
+        assert(r.optimal && r.cost == k && r.essentials == 0 && r.nodes > 0);
+    }
+
+    // Función cíclica clásica: seis primos de dos literales, ninguno
+    // esencial; bastan tres.
+    {
+        const auto r = graphs::minimize_cover({0, 1, 2, 5, 6, 7}, {}, 3);
+        assert(r.primes == 6 && r.optimal && r.cover.size() == 3);
+        assert(implements(r.cover, {0, 1, 2, 5, 6, 7}, {}, 3));
+    }
+
+    // Todos los primos son esenciales en la mayoría.
+    assert(graphs::minimize_function({3, 5, 6, 7}, 3) == (std::vector<std::string>{"-11", "1-1", "11-"}));
+    // De seis primos quedan tres; con indiferencias, dos.
+    assert(graphs::minimize_function({0, 1, 2, 5, 6, 7, 8, 9, 10, 14}, 4) ==
+           (std::vector<std::string>{"--10", "-00-", "01-1"}));
+    const auto dc = graphs::minimize_function({1, 3, 7, 11, 15}, 4, {0, 2, 5});
+    assert(dc.size() == 2 && dc[0] == "--11");
+    assert(graphs::minimize_function({}, 3).empty());
+
+    // Funciones aleatorias: la cobertura implementa la función y, con pocos
+    // primos, tiene el mínimo de términos de la fuerza bruta y, entre las de
+    // ese tamaño, el mínimo de literales.
+    for (int round = 0; round < 25; ++round) {
+        const unsigned n = 3 + round % 4;
+        std::vector<std::uint64_t> on, dc;
+        for (std::uint64_t t = 0; t < (std::uint64_t(1) << n); ++t) {
+            const unsigned x = rng() % 10;
+            if (x < 4) {
+                on.push_back(t);
+            } else if (x < 5) {
+                dc.push_back(t);
+            }
+        }
+        const auto r = graphs::minimize_cover(on, dc, n);
+        assert(r.optimal && implements(r.cover, on, dc, n));
+        const auto primes = graphs::prime_implicants(on, dc, n);
+        if (primes.size() <= 14) {
+            CoverMatrix m(on.size(), primes.size());
+            // Peso de un término mayor que cualquier total de literales.
+            const unsigned term = n * static_cast<unsigned>(on.size()) + 1;
+            std::vector<unsigned> costs;
+            for (std::size_t c = 0; c < primes.size(); ++c) {
+                for (std::size_t row = 0; row < on.size(); ++row) {
+                    if (primes[c].covers(on[row])) {
+                        m.set(row, c);
+                    }
+                }
+                costs.push_back(term + static_cast<unsigned>(__builtin_popcountll(primes[c].mask)));
+            }
+            std::uint64_t literals = 0;
+            for (const graphs::Cube &c : r.cover) {
+                literals += static_cast<unsigned>(__builtin_popcountll(c.mask));
+            }
+            const std::uint64_t best = brute_force(m, costs);
+            assert(r.cover.size() == brute_force(m, {}));
+            assert(r.cover.size() == best / term && literals == best % term);
+        }
+    }
+
+    // Una función de 7 variables: la búsqueda exacta termina y mejora (o
+    // iguala) a la voraz, que es lo que queda sin presupuesto.
+    {
+        const unsigned n = 7;
+        std::vector<std::uint64_t> on;
+        for (std::uint64_t t = 0; t < (std::uint64_t(1) << n); ++t) {
+            if (rng() % 2) {
+                on.push_back(t);
+            }
+        }
+        graphs::MinimizeOptions opts;
+        opts.time_budget = 60;
+        const auto exact = graphs::minimize_cover(on, {}, n, opts);
+        assert(exact.optimal && implements(exact.cover, on, {}, n));
+        opts.time_budget = 0;
+        const auto quick = graphs::minimize_cover(on, {}, n, opts);
+        assert(!quick.optimal && implements(quick.cover, on, {}, n));
+        assert(exact.cover.size() <= quick.cover.size());
+    }
+
+    // Errores.
+    bool threw = false;
+    try {
+        CoverMatrix m(2, 1);
+        m.set(0, 0);
+        graphs::solve_cover(m);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        CoverMatrix m(1, 1);
+        m.set(1, 0);
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        CoverMatrix m(1, 1);
+        m.set(0, 0);
+        CoverOptions opts;
+        opts.costs = {1, 2};
+        graphs::solve_cover(m, opts);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Cobertura unate: todas las pruebas superadas" << std::endl;
+    return 0;
+}
@@ -1,3 +1,4 @@
+import itertools
 import sys
 import json
 from pathlib import Path
@@ -22,6 +23,33 @@ def test_quine_mccluskey_majority():
     assert set(expressions) == {"A & B", "A & C", "B & C"}
 
 
+def test_espresso_method_and_pla():
+    try:
+        bl._espresso_command()
+    except RuntimeError:
+        pytest.skip("espresso_pla no está compilado")
+    # Mayoría con Espresso: mismos tres implicantes
+    assert bl.minimize_function([3, 5, 6, 7], 3, method="espresso") == ["-11", "1-1", "11-"]
+    # Con indiferencias la cobertura respeta la función
+    minterms, dont_cares = [0, 1, 2, 5, 6, 7, 8, 9, 10, 14], [4]
+    patterns = bl.minimize_function(minterms, 4, dont_cares, method="espresso")
+    for value in range(16):
+        covered = any(bl._covers(p, value) for p in patterns)
+        if value in minterms:
+            assert covered
+        elif value not in dont_cares:
+            assert not covered
+    # Sumador de un bit en formato PLA
+    pla = ".i 3\n.o 2\n.ilb a b cin\n.ob s cout\n001 10\n010 10\n100 10\n111 11\n011 01\n101 01\n110 01\n.e\n"
+    result = bl.minimize_pla(pla)
+    assert result["cout"] == ["-11", "1-1", "11-"]
+    assert len(result["s"]) == 4
+    with pytest.raises(ValueError):
+        bl.minimize_pla(".i 2\n.o 1\n1x 1\n")
+    with pytest.raises(ValueError):
+        bl.minimize_function([1], 2, method="petrick")
+
+
 def test_consensus_term():
     term1 = ('A', '~B')
     term2 = ('~A', 'C')
@@ -73,6 +101,30 @@ def test_miter_equivalence_and_parity():
     assert fu.parity_bit([1,1,1]) == 1  # 3 -> paridad impar
 
 
+def test_bit_sliced_expression_equivalence():
+    assert fu.check_expression_equivalence('~(A & B)', '~A | ~B', ['A', 'B']) == (True, None)
+    # el contraejemplo es el primero en el orden de itertools.product
+    expr1, expr2 = 'A ^ B ^ C', '(A | B) & C'
+    first = next(bits for bits in itertools.product([0, 1], repeat=3)
+                 if (bits[0] ^ bits[1] ^ bits[2]) != ((bits[0] | bits[1]) & bits[2]))
+    assert fu.check_expression_equivalence(expr1, expr2, ['A', 'B', 'C']) == (False, first)
+    # acarreo de un sumador de 10 bits (20 entradas) en dos formas, con
+    # trozos pequeños para recorrer varios
+    names = [f'a{i}' for i in range(10)] + [f'b{i}' for i in range(10)]
+    ripple = majority = '0'
+    for i in range(10):
+        a, b = f'a{i}', f'b{i}'
+        ripple = f'({a} & {b}) | (({ripple}) & ({a} ^ {b}))'
+        majority = f'({a} & {b}) | ({a} & c) | ({b} & c)'.replace('c', f'({majority})')
+    assert fu.check_expression_equivalence(ripple, majority, names, chunk_bits=12) == (True, None)
+    ok, cex = fu.check_expression_equivalence(ripple, f'{ripple} ^ (a9 & b0)', names, chunk_bits=12)
+    assert not ok and cex == tuple(1 if i in (9, 10) else 0 for i in range(20))
+    with pytest.raises(ValueError):
+        fu.check_expression_equivalence('A &', 'A', ['A'])
+    with pytest.raises(ValueError):
+        fu.check_expression_equivalence('A & Q', 'A', ['A'])
+
+
 def test_doublepulse():
     # no armado y dos pulsaciones activas -> salida verdadera
     assert fu.double_pulse(True, True, False) is True